@@ -43,7 +43,7 @@ v2f vertex new_city_vertex(
 half4 fragment new_city_fragment(v2f in [[stage_in]],
                                texture2d< half, access::sample > tex [[texture(0)]])
 {
-    constexpr sampler s(address::repeat, filter::nearest);
+    constexpr sampler s(address::repeat, filter::linear, mip_filter::linear);
     half3 texel = tex.sample(s, in.texcoord).rgb;
     return half4(texel, 1.0);
 }
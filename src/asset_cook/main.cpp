@@ -0,0 +1,349 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <graphics/backends/cpu/cpu_device.h>
+
+#include <asset/asset_database.h>
+
+#include <reflection/reflection.h>
+#include <asset/register.h>
+#include <entity/register.h>
+#include <entity/serialize.h>
+#include <graphics/register.h>
+#include <import/gltf/register.h>
+#include <import/texture/register.h>
+#include <renderer/register.h>
+#include <scene/register.h>
+
+#include <BS_thread_pool.hpp>
+#include <fmt/format.h>
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <cstdlib>
+
+/**
+ * Headless asset cooker, imports all input files in the input directory into the import cache in the load
+ * directory (and optionally packs them into an asset archive), without a GPU, e.g. on build machines.
+ * Input files whose import cache is up-to-date are only loaded, so cooking again is incremental.
+ *
+ * usage: asset_cook <input directory> <load directory> [--archive <path>] [--jobs <count>]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct CookParameters
+{
+    std::filesystem::path inputDirectory;
+    std::filesystem::path loadDirectory;
+    std::filesystem::path archivePath; // empty if no archive should be written
+    size_t jobs = std::max(1u, std::thread::hardware_concurrency());
+};
+
+struct CookedFile
+{
+    std::filesystem::path inputFile;
+    std::chrono::duration<double, std::milli> duration;
+    size_t artifactCount = 0;
+    bool success = false;
+    std::string error; // empty on success
+};
+
+// prints the progress and timing of each input file, and collects them for the summary
+class CookObserver final : public asset::IAssetDatabaseObserver
+{
+public:
+    explicit CookObserver(size_t total_) : total(total_) {}
+
+    void onImportStarted(std::filesystem::path const& inputFile) override
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        started[inputFile] = Clock::now();
+    }
+
+    void onImportComplete(std::filesystem::path const& inputFile, asset::ImportResult result) override
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        CookedFile& file = cooked.emplace_back(CookedFile{.inputFile = inputFile});
+        auto start = started.find(inputFile);
+        if (start != started.end())
+        {
+            file.duration = Clock::now() - start->second;
+            started.erase(start);
+        }
+        file.success = result.success();
+        if (file.success)
+        {
+            file.artifactCount = result.get().artifacts.size();
+        }
+        else
+        {
+            file.error = result.message();
+        }
+
+        std::cout << fmt::format("[{}/{}] {} {} ({:.1f} ms, {} artifacts)",
+                                 cooked.size(), total, file.success ? "cooked" : "FAILED",
+                                 inputFile.generic_string(), file.duration.count(), file.artifactCount);
+        if (!file.success)
+        {
+            std::cout << ": " << file.error;
+        }
+        std::cout << std::endl;
+        condition.notify_all();
+    }
+
+    // blocks until all input files have been cooked, returns the cooked files
+    [[nodiscard]] std::vector<CookedFile> wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return cooked.size() >= total; });
+        return cooked;
+    }
+
+private:
+    size_t const total;
+    std::unordered_map<std::filesystem::path, Clock::time_point> started;
+    std::vector<CookedFile> cooked;
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+void printUsage()
+{
+    std::cerr << "usage: asset_cook <input directory> <load directory> [--archive <path>] [--jobs <count>]" << std::endl;
+}
+
+[[nodiscard]] bool parseArguments(int argc, char* argv[], CookParameters& out)
+{
+    std::vector<std::string_view> positional;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view const argument = argv[i];
+        if (argument == "--archive" && i + 1 < argc)
+        {
+            out.archivePath = argv[++i];
+        }
+        else if (argument == "--jobs" && i + 1 < argc)
+        {
+            int const jobs = std::atoi(argv[++i]);
+            if (jobs <= 0)
+            {
+                return false;
+            }
+            out.jobs = static_cast<size_t>(jobs);
+        }
+        else if (argument.starts_with("--"))
+        {
+            return false;
+        }
+        else
+        {
+            positional.emplace_back(argument);
+        }
+    }
+
+    if (positional.size() != 2)
+    {
+        return false;
+    }
+    out.inputDirectory = positional[0];
+    out.loadDirectory = positional[1];
+    return true;
+}
+
+// returns the input files (relative to the input directory) that can be imported, largest first,
+// so that the slowest imports start early and don't end up running alone at the end
+[[nodiscard]] std::vector<std::filesystem::path> findInputFiles(asset::AssetDatabase& assets,
+                                                                CookParameters const& parameters)
+{
+    std::filesystem::path const loadDirectory = std::filesystem::weakly_canonical(parameters.loadDirectory);
+    std::vector<std::pair<uintmax_t, std::filesystem::path>> files;
+    for (auto& entry: std::filesystem::recursive_directory_iterator(parameters.inputDirectory))
+    {
+        if (!entry.is_regular_file())
+        {
+            continue;
+        }
+
+        // the load directory could be inside the input directory
+        std::filesystem::path const absolute = std::filesystem::weakly_canonical(entry.path());
+        auto const [end, _] = std::mismatch(loadDirectory.begin(), loadDirectory.end(), absolute.begin(), absolute.end());
+        if (end == loadDirectory.end())
+        {
+            continue;
+        }
+
+        std::filesystem::path inputFile = entry.path().lexically_relative(parameters.inputDirectory);
+        if (assets.acceptsFile(inputFile))
+        {
+            files.emplace_back(entry.file_size(), std::move(inputFile));
+        }
+    }
+
+    std::sort(files.begin(), files.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.first > rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+    });
+
+    std::vector<std::filesystem::path> out;
+    out.reserve(files.size());
+    for (auto& file: files)
+    {
+        out.emplace_back(std::move(file.second));
+    }
+    return out;
+}
+
+void printSummary(std::vector<CookedFile> cooked, std::chrono::duration<double> elapsed)
+{
+    size_t failed = 0;
+    size_t artifacts = 0;
+    std::chrono::duration<double, std::milli> total{};
+    for (auto& file: cooked)
+    {
+        failed += file.success ? 0 : 1;
+        artifacts += file.artifactCount;
+        total += file.duration;
+    }
+
+    std::cout << fmt::format("\ncooked {} input files ({} failed, {} artifacts) in {:.2f} s, {:.2f} s of import time\n",
+                             cooked.size(), failed, artifacts, elapsed.count(), total.count() / 1000.0);
+
+    constexpr size_t kSlowestCount = 10;
+    std::sort(cooked.begin(), cooked.end(), [](CookedFile const& lhs, CookedFile const& rhs) {
+        return lhs.duration > rhs.duration;
+    });
+    size_t const count = std::min(kSlowestCount, cooked.size());
+    if (count > 0)
+    {
+        std::cout << "slowest input files:\n";
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        std::cout << fmt::format("  {:>10.1f} ms  {}\n", cooked[i].duration.count(), cooked[i].inputFile.generic_string());
+    }
+
+    for (auto& file: cooked)
+    {
+        if (!file.success)
+        {
+            std::cout << fmt::format("failed: {}: {}\n", file.inputFile.generic_string(), file.error);
+        }
+    }
+    std::cout.flush();
+}
+
+int main(int argc, char* argv[])
+{
+    CookParameters parameters;
+    if (!parseArguments(argc, argv, parameters))
+    {
+        printUsage();
+        return 2;
+    }
+
+    if (!std::filesystem::is_directory(parameters.inputDirectory))
+    {
+        std::cerr << "input directory does not exist: " << parameters.inputDirectory << std::endl;
+        return 2;
+    }
+
+    // reflection
+    reflection::Reflection& reflection = reflection::Reflection::shared();
+    asset::register_(reflection);
+    entity::register_(reflection);
+    graphics::register_(reflection);
+    import_::gltf::register_(reflection);
+    import_::texture::register_(reflection);
+    renderer::register_(reflection);
+    scene::register_(reflection);
+
+    // import
+    asset::ImportRegistry importers{};
+    import_::gltf::register_(importers);
+    import_::texture::register_(importers);
+
+    // components that are saved with scenes
+    entity::RegistrySerializer components(reflection);
+    entity::register_(components);
+    renderer::register_(components);
+
+    // asset types
+    asset::AssetTypeRegistry assetTypes{};
+    graphics::register_(assetTypes);
+    renderer::register_(assetTypes);
+    scene::register_(assetTypes, components);
+
+    // no GPU, meshes and textures are kept in CPU memory until they are written to the import cache
+    graphics::cpu::CpuDevice device;
+
+    BS::thread_pool threadPool(parameters.jobs);
+
+    // the artifacts are not needed after they have been written, so nothing gets retained
+    asset::AssetDatabaseParameters databaseParameters{
+        .inputDirectory = parameters.inputDirectory,
+        .loadDirectory = parameters.loadDirectory,
+        .useImportCache = true,
+        .watchInputDirectory = false,
+        .memoryBudget = {},
+        .maxConcurrentLoads = parameters.jobs,
+        .maxConcurrentImports = parameters.jobs
+    };
+    asset::AssetDatabaseContext context{
+        .importers = importers,
+        .assetTypes = assetTypes,
+        .device = &device
+    };
+
+    std::vector<CookedFile> cooked;
+    bool archiveWritten = true;
+    Clock::time_point const start = Clock::now();
+    {
+        // the observer needs its total before it gets added, and should outlive the asset database
+        std::unique_ptr<CookObserver> observer;
+        asset::AssetDatabase assets{databaseParameters, context, threadPool};
+
+        std::vector<std::filesystem::path> inputFiles = findInputFiles(assets, parameters);
+        std::cout << fmt::format("cooking {} input files using {} threads", inputFiles.size(), parameters.jobs)
+                  << std::endl;
+
+        observer = std::make_unique<CookObserver>(inputFiles.size());
+        assets.observers.add(observer.get());
+        for (size_t i = 0; i < inputFiles.size(); i++)
+        {
+            assets.importFile(inputFiles[i], static_cast<int>(inputFiles.size() - i));
+        }
+        cooked = observer->wait();
+
+        if (!parameters.archivePath.empty())
+        {
+            archiveWritten = assets.writeArchive(parameters.archivePath);
+        }
+    }
+    std::chrono::duration<double> const elapsed = Clock::now() - start;
+
+    size_t const failed = std::count_if(cooked.begin(), cooked.end(), [](CookedFile const& file) {
+        return !file.success;
+    });
+    printSummary(std::move(cooked), elapsed);
+
+    if (!parameters.archivePath.empty())
+    {
+        if (!archiveWritten)
+        {
+            std::cerr << "failed to write asset archive: " << parameters.archivePath << std::endl;
+            return 1;
+        }
+        std::cout << "wrote asset archive: " << parameters.archivePath.generic_string() << std::endl;
+    }
+
+    return failed == 0 ? 0 : 1;
+}
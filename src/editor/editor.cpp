@@ -15,9 +15,15 @@ namespace editor
     {
         asset::Asset mesh;
         renderer::Material* material;
+        std::array<asset::Asset, renderer::kMaxMeshLods> lods{}; // levels of detail of the mesh, ordered by level
     };
 
-    void createObjectNew(entity::EntityRegistry& r, entity::EntityId entityId,
+    // added once the mesh of the MeshRendererNew has been loaded, so that we don't have to check each frame
+    struct MeshLoadedComponent
+    {
+    };
+
+    void createObjectNew(entity::EntityRegistry& r, common::IExecutor& executor, entity::EntityId entityId,
                          MeshRendererNew const& meshRenderer, bool visible = true)
     {
         r.createEntity(entityId);
@@ -29,6 +35,89 @@ namespace editor
         r.addComponent<renderer::TransformComponent>(entityId);
         r.addComponent<renderer::TransformDirtyComponent>(entityId); // to make sure the transform gets calculated on start
         r.addComponent<MeshRendererNew>(entityId, meshRenderer);
+
+        meshRenderer.mesh->then([&r, entityId](asset::AssetHandle& mesh) {
+            if (mesh.valid<renderer::Mesh>() && r.entityExists(entityId))
+            {
+                r.addComponent<MeshLoadedComponent>(entityId);
+            }
+        }, executor);
+    }
+
+    // copies the entities of an imported scene into the registry, and adds a MeshRendererNew with the given material
+    // to each entity that refers to a mesh
+    void instantiateScene(entity::EntityRegistry& r, asset::AssetDatabase& assets, common::IExecutor& executor,
+                          scene::Scene& source, renderer::Material* material)
+    {
+        std::vector<entity::EntityId> const& entities = source.entities.entities.denseArray();
+        entity::EntityId const firstId = r.instantiate(source.entities, entities, 1);
+        if (firstId == entity::kNullEntityId)
+        {
+            return;
+        }
+
+        std::vector<entity::size_type> local(source.entities.size(), entity::kNullEntityId);
+        for (entity::size_type i = 0; i < entities.size(); i++)
+        {
+            local[entities[i]] = i;
+        }
+
+        for (auto [sourceId, meshAsset]: source.entities.view<renderer::MeshAssetComponent>())
+        {
+            entity::EntityId const entityId = firstId + local[sourceId];
+            MeshRendererNew const meshRenderer{assets.get(meshAsset.mesh), material};
+            r.addComponent<renderer::VisibleComponent>(entityId);
+            r.addComponent<MeshRendererNew>(entityId, meshRenderer);
+
+            meshRenderer.mesh->then([&r, entityId](asset::AssetHandle& mesh) {
+                if (mesh.valid<renderer::Mesh>() && r.entityExists(entityId))
+                {
+                    r.addComponent<MeshLoadedComponent>(entityId);
+                }
+            }, executor);
+        }
+
+        // levels of detail are loaded alongside the full detail mesh, and used once loaded (see selectMesh)
+        for (auto [sourceId, lodAssets]: source.entities.view<renderer::MeshLodAssetComponent>())
+        {
+            entity::EntityId const entityId = firstId + local[sourceId];
+            if (!r.entityContainsComponent<MeshRendererNew>(entityId))
+            {
+                continue;
+            }
+            auto& meshRenderer = r.getComponent<MeshRendererNew>(entityId);
+            for (size_t i = 0; i < lodAssets.lods.size() && lodAssets.lods[i] != asset::AssetKey{}; i++)
+            {
+                meshRenderer.lods[i] = assets.get(lodAssets.lods[i]);
+            }
+        }
+    }
+
+    // gets the least detailed level of detail of the mesh whose error is not visible at its projected size on the
+    // screen. levels that have not been loaded yet (and the levels after them) are skipped
+    [[nodiscard]] renderer::Mesh& selectMesh(MeshRendererNew const& meshRenderer, math::Matrix4 const& localToWorld,
+                                             math::Vector3 const& cameraPosition, float verticalFieldOfView)
+    {
+        auto& mesh = meshRenderer.mesh->get<renderer::Mesh>();
+        std::array<float, renderer::kMaxMeshLods + 1> screenSizes{mesh.descriptor().lodScreenSize};
+        size_t count = 1;
+        for (asset::Asset const& lod: meshRenderer.lods)
+        {
+            if (!lod || !lod->valid<renderer::Mesh>())
+            {
+                break;
+            }
+            screenSizes[count++] = lod->get<renderer::Mesh>().descriptor().lodScreenSize;
+        }
+        if (count == 1)
+        {
+            return mesh;
+        }
+
+        // the levels of detail keep the bounding sphere of the full detail mesh
+        float const screenSize = renderer::projectedScreenSize(mesh.descriptor(), localToWorld, cameraPosition, verticalFieldOfView);
+        size_t const level = renderer::selectLod(std::span<float const>(screenSizes.data(), count), screenSize);
+        return level == 0 ? mesh : meshRenderer.lods[level - 1]->get<renderer::Mesh>();
     }
 
     Editor::Editor(asset::AssetDatabase& assets_) : assets(assets_) {}
@@ -125,9 +214,9 @@ namespace editor
         axesShader = std::make_unique<renderer::Shader>(device, shaderLibrary.get(), "axes_vertex", "axes_fragment");
 
         // textures
-        textureBaseColor = assets.get(asset::AssetId{"models/sea_house/textures/default_baseColor.png", "texture.texture"});
-        textureMaterial25 = assets.get(asset::AssetId{"models/sea_house/textures/11112_sheet_Material__25_baseColor.png", "texture.texture"});
-        textureMaterial37 = assets.get(asset::AssetId{"models/sea_house/textures/11112_sheet_Material__37_baseColor.png", "texture.texture"});
+        textureBaseColor = assets.get(asset::AssetId{"models/sea_house/textures/default_baseColor.png", "texture.ktx2"});
+        textureMaterial25 = assets.get(asset::AssetId{"models/sea_house/textures/11112_sheet_Material__25_baseColor.png", "texture.ktx2"});
+        textureMaterial37 = assets.get(asset::AssetId{"models/sea_house/textures/11112_sheet_Material__37_baseColor.png", "texture.ktx2"});
 
         // materials
         materialBaseColor = {newShader.get(), textureBaseColor};
@@ -144,41 +233,22 @@ namespace editor
         scene = std::make_unique<scene::Scene>();
 
         // create objects
-        createObjectNew(scene->entities, 0, MeshRendererNew{mesh0, &material25}, true);
-        createObjectNew(scene->entities, 1, MeshRendererNew{mesh1, &material25}, true);
-        createObjectNew(scene->entities, 2, MeshRendererNew{mesh2, &material37}, true);
-        createObjectNew(scene->entities, 3, MeshRendererNew{mesh3, &material37}, true);
-        createObjectNew(scene->entities, 4, MeshRendererNew{mesh4, &materialBaseColor}, true);
-        createObjectNew(scene->entities, 5, MeshRendererNew{dummyMesh, &newColorMaterial}, false);
-        createObjectNew(scene->entities, 6, MeshRendererNew{axesMesh, &axesMaterial}, true);
-
-        std::vector<std::string> meshNames{
-            "building_0.mesh",
-            "building_1.mesh",
-            "building_2.mesh",
-            "building_3.mesh",
-            "building_4.mesh",
-            "building_5.mesh",
-            "building_6.mesh",
-            "building_7.mesh",
-            "building_8.mesh",
-            "building_9.mesh",
-            "building_10.mesh",
-            "building_11.mesh",
-            "building_12.mesh",
-            "building_13.mesh",
-            "building_14.mesh",
-            "building_15.mesh",
-            "building_16.mesh"
-        };
-
-        size_t index = 6;
-        for (auto& meshName: meshNames)
-        {
-            asset::Asset a = assets.get(asset::AssetId{"models/city/city_2.gltf", meshName});
-            createObjectNew(scene->entities, index, MeshRendererNew{a, &newCityMaterial});
-            index++;
-        }
+        createObjectNew(scene->entities, mainThread, 0, MeshRendererNew{mesh0, &material25}, true);
+        createObjectNew(scene->entities, mainThread, 1, MeshRendererNew{mesh1, &material25}, true);
+        createObjectNew(scene->entities, mainThread, 2, MeshRendererNew{mesh2, &material37}, true);
+        createObjectNew(scene->entities, mainThread, 3, MeshRendererNew{mesh3, &material37}, true);
+        createObjectNew(scene->entities, mainThread, 4, MeshRendererNew{mesh4, &materialBaseColor}, true);
+        createObjectNew(scene->entities, mainThread, 5, MeshRendererNew{dummyMesh, &newColorMaterial}, false);
+        createObjectNew(scene->entities, mainThread, 6, MeshRendererNew{axesMesh, &axesMaterial}, true);
+
+        // the city is created from the scene that was imported from the gltf file
+        cityScene = assets.get(asset::AssetId{"models/city/city_2.gltf", "scene_0.scene"});
+        cityScene->then([this](asset::AssetHandle& handle) {
+            if (handle.valid<scene::Scene>())
+            {
+                instantiateScene(scene->entities, assets, mainThread, handle.get<scene::Scene>(), &newCityMaterial);
+            }
+        }, mainThread);
 
         // editor UI
         ui = std::make_unique<editor::UI>(device, window, shaderLibrary.get());
@@ -192,6 +262,11 @@ namespace editor
 
     void Editor::render(graphics::Window* _window)
     {
+        // swap reimported data into the asset handles while nothing is using the old data,
+        // then run the continuations of asset handles that were loaded since the last frame
+        assets.applyReloads();
+        mainThread.drain();
+
         std::unique_ptr<graphics::RenderPassDescriptor> renderPassDescriptor = _window->getRenderPassDescriptor();
 
         // todo: move into one render function that takes a scene render function as an argument
@@ -218,6 +293,9 @@ namespace editor
         // updates the transform components based on the hierarchy
         renderer::computeLocalToWorldMatrices(scene->entities);
 
+        // deliver batched component events to observers (once per frame, before drawing)
+        scene->entities.flushEvents();
+
         //-------------------------------------------------
         // Draw objects with MeshRenderers on the screen (should be refactored into renderer / scene abstraction)
         //-------------------------------------------------
@@ -230,16 +308,14 @@ namespace editor
         cmd->setTriangleFillMode(graphics::TriangleFillMode::Fill);
         cmd->setDepthStencilState(depthStencilState.get());
 
-        for (auto [entityId, meshRenderer, transform, visible]:
-            scene->entities.view<MeshRendererNew, renderer::TransformComponent, renderer::VisibleComponent>(
+        math::Matrix4 const viewProjection = camera->viewProjection();
+        float const verticalFieldOfView = math::degreesToRadians(camera->parameters().fieldOfViewInDegrees);
+
+        for (auto [entityId, meshRenderer, transform, visible, loaded]:
+            scene->entities.view<MeshRendererNew, renderer::TransformComponent, renderer::VisibleComponent, MeshLoadedComponent>(
                 entity::IterationPolicy::UseFirstComponent))
         {
-            if (!meshRenderer.mesh->success() || !meshRenderer.mesh->valid<renderer::Mesh>())
-            {
-                continue;
-            }
-
-            auto& mesh = meshRenderer.mesh->get<renderer::Mesh>();
+            auto& mesh = selectMesh(meshRenderer, transform.localToWorldTransform, camera->position(), verticalFieldOfView);
 
             renderer::Material* material = meshRenderer.material;
             cmd->setRenderPipelineState(material->shader->getRenderPipelineState());
@@ -270,7 +346,29 @@ namespace editor
                 cmd->setFragmentStageTexture(&material->texture->get<graphics::ITexture>(), 0);
             }
 
-            if (mesh.descriptor().hasIndexBuffer)
+            if (mesh.descriptor().hasIndexBuffer && !mesh.meshlets().empty())
+            {
+                // only draw the meshlets that are inside the view frustum
+                renderer::MeshletCullingView view = renderer::createMeshletCullingView(
+                    viewProjection, transform.localToWorldTransform, camera->position());
+                view.backfaceCulling = false; // the render pass doesn't cull back faces either (CullMode::None)
+
+                visibleRanges.clear();
+                renderer::cullMeshlets(mesh.meshlets(), view, visibleRanges);
+                size_t const indexStride = renderer::stride(mesh.descriptor().indexType);
+                for (renderer::IndexRange const& range: visibleRanges)
+                {
+                    cmd->drawIndexedPrimitives(
+                        mesh.descriptor().primitiveType,
+                        range.count, /*indexCount*/
+                        mesh.indexBuffer(), /*indexBuffer*/
+                        range.offset * indexStride, /*indexBufferOffset*/
+                        1, /*instanceCount*/
+                        0, /*baseVertex*/
+                        0); /*baseInstance*/
+                }
+            }
+            else if (mesh.descriptor().hasIndexBuffer)
             {
                 // draw with index buffer
                 cmd->drawIndexedPrimitives(
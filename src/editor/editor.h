@@ -36,6 +36,7 @@
 #include <renderer/shader.h>
 #include <renderer/material.h>
 #include <renderer/mesh_renderer.h>
+#include <renderer/mesh_simplification.h>
 #include <renderer/transform.h>
 #include <renderer/scene_renderer.h>
 
@@ -46,6 +47,8 @@
 
 #include <reflection/reflection.h>
 
+#include <common/executor.h>
+
 #include <BS_thread_pool.hpp>
 
 #include "ui.h"
@@ -82,6 +85,9 @@ namespace editor
     private:
         asset::AssetDatabase& assets;
 
+        // continuations of asset handles (e.g. when a mesh has been loaded), drained once per frame
+        common::MainThreadExecutor mainThread;
+
         // meshes
         asset::Asset mesh0;
         asset::Asset mesh1;
@@ -89,6 +95,7 @@ namespace editor
         asset::Asset mesh3;
         asset::Asset mesh4;
         asset::Asset dummyMesh;
+        asset::Asset cityScene;
 
         asset::Asset axesMesh;
 
@@ -110,6 +117,9 @@ namespace editor
         std::unique_ptr<renderer::Camera> camera;
         std::unique_ptr<CameraController> cameraController;
 
+        // index ranges of the visible meshlets of the mesh that is being drawn, reused between draws
+        std::vector<renderer::IndexRange> visibleRanges;
+
         // shaders
         std::unique_ptr<renderer::Shader> newColorShader;
         std::unique_ptr<renderer::Shader> newShader;
@@ -4,10 +4,12 @@
 #include <graphics/window.h>
 
 #include <asset/asset_database.h>
+#include <asset/file_watcher.h>
 
 #include <reflection/reflection.h>
 #include <asset/register.h>
 #include <entity/register.h>
+#include <entity/serialize.h>
 #include <graphics/register.h>
 #include <import/gltf/register.h>
 #include <import/texture/register.h>
@@ -28,6 +30,7 @@ int main(int argc, char* argv[])
     entity::register_(reflection);
     graphics::register_(reflection);
     import_::gltf::register_(reflection);
+    import_::texture::register_(reflection);
     renderer::register_(reflection);
     scene::register_(reflection);
 
@@ -36,10 +39,16 @@ int main(int argc, char* argv[])
     import_::gltf::register_(importers);
     import_::texture::register_(importers);
 
+    // components that are saved with scenes
+    entity::RegistrySerializer components(reflection);
+    entity::register_(components);
+    renderer::register_(components);
+
     // asset types
     asset::AssetTypeRegistry assetTypes{};
     graphics::register_(assetTypes);
     renderer::register_(assetTypes);
+    scene::register_(assetTypes, components);
 
     // application
     graphics::Application application{};
@@ -51,7 +60,9 @@ int main(int argc, char* argv[])
     asset::AssetDatabaseParameters parameters{
         .inputDirectory = inputDirectory,
         .loadDirectory = loadDirectory,
-        .useImportCache = false,
+        .useImportCache = true,
+        .watchInputDirectory = asset::FileWatcher::supported(),
+        .memoryBudget = {.cpu = 256 * 1024 * 1024, .device = 1024 * 1024 * 1024}
     };
     asset::AssetDatabaseContext context{
         .importers = importers,
@@ -208,6 +208,53 @@ namespace editor
         }
         ImGui::End();
 
+        if (ImGui::Begin("Registry Statistics"))
+        {
+            RegistryStats stats = r->stats();
+
+            ImGui::Text("Entities: %zu (sparse size: %zu)", stats.entities.liveCount, stats.entities.sparseSize);
+            ImGui::Text("Components: %zu in %zu pools", stats.componentCount, stats.components.size());
+            ImGui::Text("Memory: %.1f KiB (%.1f KiB unused)",
+                        static_cast<float>(stats.bytes) / 1024.0f,
+                        static_cast<float>(stats.wastedBytes) / 1024.0f);
+
+            ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable;
+            if (ImGui::BeginTable("##registry_statistics", 6, flags))
+            {
+                ImGui::TableSetupColumn("Type");
+                ImGui::TableSetupColumn("Live / Sparse");
+                ImGui::TableSetupColumn("Sparse Capacity");
+                ImGui::TableSetupColumn("Dense Capacity");
+                ImGui::TableSetupColumn("Tombstones");
+                ImGui::TableSetupColumn("KiB");
+                ImGui::TableHeadersRow();
+
+                auto row = [](PoolStats const& pool) {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(pool.name.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu / %zu", pool.liveCount, pool.sparseSize);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu", pool.sparseCapacity);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu", pool.denseCapacity);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f%%", pool.tombstoneRatio * 100.0f);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f", static_cast<float>(pool.bytes) / 1024.0f);
+                };
+
+                row(stats.entities);
+                for (auto& pool: stats.components)
+                {
+                    row(pool);
+                }
+                ImGui::EndTable();
+            }
+        }
+        ImGui::End();
+
         ImGuiIO& io = ImGui::GetIO();
 
         capturedKeyboard = io.WantCaptureKeyboard;
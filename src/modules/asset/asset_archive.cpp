@@ -0,0 +1,332 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "asset_archive.h"
+
+#include <common/logger.h>
+
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+namespace asset
+{
+    // all offsets are relative to the start of the archive
+    struct AssetArchive::Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t entryCount;
+        uint64_t tocOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+        uint64_t fileSize;
+    };
+
+    struct AssetArchive::TocEntry
+    {
+        uint64_t key;
+        uint64_t offset; // offset of the artifact
+        uint64_t size; // size of the artifact in bytes
+        uint64_t stringOffset; // offset into the string table of the input file path, directly followed by the artifact path
+        uint32_t inputFilePathSize;
+        uint32_t artifactPathSize;
+    };
+
+    [[nodiscard]] constexpr uint64_t alignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // writes zeros until the position is aligned
+    void pad(std::ostream& out, uint64_t& position, uint64_t alignment)
+    {
+        uint64_t const aligned = alignUp(position, alignment);
+        for (; position < aligned; position++)
+        {
+            out.put(0);
+        }
+    }
+
+    // compares a path stored in the archive (lexically normal, with '/' as separator) to the path of an asset id,
+    // which only gets normalized (and copied) if it isn't equal as is
+    [[nodiscard]] static bool storedPathEqual(std::string_view stored, std::filesystem::path const& path)
+    {
+#if defined(PLATFORM_WINDOWS)
+        return stored == path.lexically_normal().generic_string();
+#else
+        return stored == path.native() || stored == path.lexically_normal().native();
+#endif
+    }
+
+    bool AssetArchive::write(std::filesystem::path const& path, std::vector<AssetArchiveEntry> entries)
+    {
+        struct Item
+        {
+            uint64_t key;
+            std::string inputFilePath;
+            std::string artifactPath;
+            std::filesystem::path file;
+            uint64_t size;
+        };
+
+        std::vector<Item> items;
+        items.reserve(entries.size());
+        for (auto& entry: entries)
+        {
+            std::error_code error;
+            uint64_t const size = std::filesystem::file_size(entry.file, error);
+            if (error)
+            {
+                common::log::error("Failed to read artifact {} for asset archive ({})", entry.file.string(),
+                                   error.message());
+                return false;
+            }
+            items.emplace_back(Item{
+                .key = hash(entry.id),
+                .inputFilePath = entry.id.inputFilePath.lexically_normal().generic_string(),
+                .artifactPath = entry.id.artifactPath.lexically_normal().generic_string(),
+                .file = std::move(entry.file),
+                .size = size
+            });
+        }
+
+        std::sort(items.begin(), items.end(), [](Item const& lhs, Item const& rhs) { return lhs.key < rhs.key; });
+        for (size_t i = 1; i < items.size(); i++)
+        {
+            if (items[i - 1].key == items[i].key)
+            {
+                common::log::error("Asset archive key collision between {} and {}",
+                                   items[i - 1].inputFilePath + "/" + items[i - 1].artifactPath,
+                                   items[i].inputFilePath + "/" + items[i].artifactPath);
+                return false;
+            }
+        }
+
+        // layout
+        Header header{
+            .magic = kMagic,
+            .version = kVersion,
+            .entryCount = items.size(),
+            .tocOffset = alignUp(sizeof(Header), kAlignment)
+        };
+        header.stringsOffset = header.tocOffset + items.size() * sizeof(TocEntry);
+
+        std::vector<TocEntry> toc;
+        toc.reserve(items.size());
+        uint64_t stringOffset = 0;
+        uint64_t offset = 0; // offset of the artifacts relative to the first one
+        for (auto& item: items)
+        {
+            toc.emplace_back(TocEntry{
+                .key = item.key,
+                .offset = offset,
+                .size = item.size,
+                .stringOffset = stringOffset,
+                .inputFilePathSize = static_cast<uint32_t>(item.inputFilePath.size()),
+                .artifactPathSize = static_cast<uint32_t>(item.artifactPath.size())
+            });
+            stringOffset += item.inputFilePath.size() + item.artifactPath.size();
+            offset = alignUp(offset + item.size, kAlignment);
+        }
+        header.stringsSize = stringOffset;
+
+        uint64_t const artifactsOffset = alignUp(header.stringsOffset + header.stringsSize, kAlignment);
+        for (auto& entry: toc)
+        {
+            entry.offset += artifactsOffset;
+        }
+        header.fileSize = artifactsOffset + offset;
+
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+            {
+                common::log::error("Failed to open {} for writing the asset archive", temporaryPath.string());
+                return false;
+            }
+
+            uint64_t position = 0;
+            out.write(reinterpret_cast<char const*>(&header), sizeof(Header));
+            position += sizeof(Header);
+            pad(out, position, kAlignment);
+
+            out.write(reinterpret_cast<char const*>(toc.data()), static_cast<std::streamsize>(toc.size() * sizeof(TocEntry)));
+            position += toc.size() * sizeof(TocEntry);
+            for (auto& item: items)
+            {
+                out.write(item.inputFilePath.data(), static_cast<std::streamsize>(item.inputFilePath.size()));
+                out.write(item.artifactPath.data(), static_cast<std::streamsize>(item.artifactPath.size()));
+                position += item.inputFilePath.size() + item.artifactPath.size();
+            }
+            pad(out, position, kAlignment);
+
+            std::vector<char> buffer(1 << 16);
+            for (auto& item: items)
+            {
+                std::ifstream in(item.file, std::ios::binary);
+                uint64_t copied = 0;
+                while (in && copied < item.size)
+                {
+                    in.read(buffer.data(), static_cast<std::streamsize>(std::min<uint64_t>(buffer.size(), item.size - copied)));
+                    out.write(buffer.data(), in.gcount());
+                    copied += static_cast<uint64_t>(in.gcount());
+                }
+
+                if (copied != item.size)
+                {
+                    common::log::error("Failed to read artifact {} for asset archive", item.file.string());
+                    out.close();
+                    std::filesystem::remove(temporaryPath);
+                    return false;
+                }
+                position += copied;
+                pad(out, position, kAlignment);
+            }
+
+            if (!out.good())
+            {
+                common::log::error("Failed to write asset archive {}", temporaryPath.string());
+                out.close();
+                std::filesystem::remove(temporaryPath);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, path, error);
+        if (error)
+        {
+            common::log::error("Failed to write asset archive {} ({})", path.string(), error.message());
+            return false;
+        }
+        return true;
+    }
+
+    AssetArchive::AssetArchive(std::filesystem::path const& path) : file(path)
+    {
+        if (!file.valid())
+        {
+            return;
+        }
+        data = file.data();
+
+        valid_ = parse();
+        if (!valid_)
+        {
+            common::log::error("Invalid asset archive {}", path.string());
+        }
+    }
+
+    AssetArchive::~AssetArchive() = default;
+
+    bool AssetArchive::valid() const
+    {
+        return valid_;
+    }
+
+    size_t AssetArchive::size() const
+    {
+        return entryCount;
+    }
+
+    bool AssetArchive::contains(AssetId const& id) const
+    {
+        return findEntry(id) != nullptr;
+    }
+
+    std::vector<AssetId> AssetArchive::ids() const
+    {
+        std::vector<AssetId> out;
+        out.reserve(entryCount);
+        for (size_t i = 0; i < entryCount; i++)
+        {
+            TocEntry const& entry = toc[i];
+            out.emplace_back(AssetId{
+                std::string(strings + entry.stringOffset, entry.inputFilePathSize),
+                std::string(strings + entry.stringOffset + entry.inputFilePathSize, entry.artifactPathSize)
+            });
+        }
+        return out;
+    }
+
+    bool AssetArchive::find(AssetId const& id, std::span<uint8_t const>& out) const
+    {
+        TocEntry const* entry = findEntry(id);
+        if (!entry)
+        {
+            return false;
+        }
+        out = data.subspan(entry->offset, entry->size);
+        return true;
+    }
+
+    bool AssetArchive::parse()
+    {
+        Header header{};
+        if (data.size() < sizeof(Header))
+        {
+            return false;
+        }
+        std::memcpy(&header, data.data(), sizeof(Header));
+
+        if (header.magic != kMagic || header.version != kVersion || header.fileSize != data.size() ||
+            header.tocOffset % alignof(TocEntry) != 0 || header.tocOffset > data.size() ||
+            header.entryCount > (data.size() - header.tocOffset) / sizeof(TocEntry) ||
+            header.stringsOffset != header.tocOffset + header.entryCount * sizeof(TocEntry) ||
+            header.stringsSize > data.size() - header.stringsOffset)
+        {
+            return false;
+        }
+
+        // the table of contents is aligned inside the mapping, so it can be accessed in place
+        auto const* entries = reinterpret_cast<TocEntry const*>(data.data() + header.tocOffset);
+        for (uint64_t i = 0; i < header.entryCount; i++)
+        {
+            TocEntry const& entry = entries[i];
+            uint64_t const stringSize = static_cast<uint64_t>(entry.inputFilePathSize) + entry.artifactPathSize;
+            if (entry.offset % kAlignment != 0 || entry.offset > data.size() || entry.size > data.size() - entry.offset ||
+                entry.stringOffset > header.stringsSize || stringSize > header.stringsSize - entry.stringOffset ||
+                (i > 0 && entries[i - 1].key >= entry.key))
+            {
+                return false;
+            }
+        }
+
+        toc = entries;
+        entryCount = header.entryCount;
+        strings = reinterpret_cast<char const*>(data.data() + header.stringsOffset);
+        return true;
+    }
+
+    AssetArchive::TocEntry const* AssetArchive::findEntry(AssetId const& id) const
+    {
+        if (!valid_)
+        {
+            return nullptr;
+        }
+
+        uint64_t const key = hash(id);
+        TocEntry const* end = toc + entryCount;
+        TocEntry const* entry = std::lower_bound(toc, end, key, [](TocEntry const& e, uint64_t k) { return e.key < k; });
+        if (entry == end || entry->key != key)
+        {
+            return nullptr;
+        }
+
+        // a different asset id with the same key
+        std::string_view const inputFilePath(strings + entry->stringOffset, entry->inputFilePathSize);
+        std::string_view const artifactPath(strings + entry->stringOffset + entry->inputFilePathSize,
+                                            entry->artifactPathSize);
+        if (!storedPathEqual(inputFilePath, id.inputFilePath) || !storedPathEqual(artifactPath, id.artifactPath))
+        {
+            return nullptr;
+        }
+        return entry;
+    }
+}
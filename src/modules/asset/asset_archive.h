@@ -0,0 +1,94 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_ASSET_ARCHIVE_H
+#define SHAPEREALITY_ASSET_ARCHIVE_H
+
+#include "asset_id.h"
+
+#include <common/mapped_file.h>
+
+#include <filesystem>
+#include <vector>
+#include <span>
+#include <cstdint>
+
+namespace asset
+{
+    struct AssetArchiveEntry
+    {
+        AssetId id;
+        std::filesystem::path file; // native binary artifact (see AssetType::save) that gets copied into the archive
+    };
+
+    /**
+     * Packed asset archive for shipping builds, so that artifacts can be loaded without the input files,
+     * the import cache directory structure, or parsing json.
+     *
+     * A single file that contains:
+     *   - a header
+     *   - a table of contents sorted by the key (see AssetKey) of each asset id, so that a lookup is a binary search
+     *   - a string table with the asset ids, to detect key collisions
+     *   - the artifacts, each aligned to kAlignment bytes
+     *
+     * The archive is memory mapped, so artifacts are only paged in when accessed and are never copied by the archive.
+     * Written by AssetDatabase::writeArchive from the import cache.
+     */
+    class AssetArchive final
+    {
+    public:
+        constexpr static uint32_t kMagic = 0x43524153; // "SARC"
+        constexpr static uint32_t kVersion = 1;
+
+        // a cache line, which also satisfies the alignment of SIMD loads
+        constexpr static size_t kAlignment = 64;
+
+        // writes the provided artifacts to an archive at the provided path. the archive is written to a temporary
+        // file first, so that a partially written archive never replaces an existing one.
+        // returns false if an artifact could not be read or if two asset ids have the same key.
+        [[nodiscard]] static bool write(std::filesystem::path const& path, std::vector<AssetArchiveEntry> entries);
+
+        // maps the archive at the provided path into memory, check valid() afterward
+        explicit AssetArchive(std::filesystem::path const& path);
+
+        ~AssetArchive();
+
+        AssetArchive(AssetArchive const&) = delete;
+
+        AssetArchive& operator=(AssetArchive const&) = delete;
+
+        // whether the archive could be mapped and has a valid header and table of contents
+        [[nodiscard]] bool valid() const;
+
+        // amount of artifacts in the archive
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] bool contains(AssetId const& id) const;
+
+        // asset ids of all artifacts in the archive
+        [[nodiscard]] std::vector<AssetId> ids() const;
+
+        // returns a view into the mapped memory of the artifact with the provided asset id,
+        // which stays valid for the lifetime of the archive. returns false if the archive does not contain it
+        [[nodiscard]] bool find(AssetId const& id, std::span<uint8_t const>& out) const;
+
+    private:
+        struct Header;
+        struct TocEntry;
+
+        common::MappedFile file;
+        std::span<uint8_t const> data; // the complete archive
+        TocEntry const* toc = nullptr;
+        size_t entryCount = 0;
+        char const* strings = nullptr;
+        bool valid_ = false;
+
+        // validates the header, table of contents and string table
+        [[nodiscard]] bool parse();
+
+        [[nodiscard]] TocEntry const* findEntry(AssetId const& id) const;
+    };
+}
+
+#endif //SHAPEREALITY_ASSET_ARCHIVE_H
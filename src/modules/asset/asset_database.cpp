@@ -8,6 +8,10 @@
 #include <iostream>
 #include <fstream>
 #include <common/logger.h>
+#include <common/hash.h>
+#include <common/binary.h>
+#include <reflection/serialize/json.h>
+#include <unordered_set>
 #include <BS_thread_pool.hpp>
 
 namespace asset
@@ -15,61 +19,174 @@ namespace asset
     AssetDatabase::AssetDatabase(
         AssetDatabaseParameters parameters_,
         AssetDatabaseContext context,
-        BS::thread_pool& threadPool_)
+        BS::thread_pool& threadPool)
         :
         parameters(std::move(parameters_)),
         context_(context),
-        threadPool(threadPool_)
+        threadPool_(threadPool),
+        residency(std::make_shared<AssetResidency>(parameters.memoryBudget))
     {
+        assert(parameters.maxConcurrentLoads > 0 && parameters.maxConcurrentImports > 0);
+
         common::log::info(
             "created asset database with: \n\tinput directory: {}\n\tload directory: {}",
             parameters.inputDirectory.string(), parameters.loadDirectory.string());
+
+        if (!parameters.archivePath.empty())
+        {
+            archive = std::make_unique<AssetArchive>(parameters.archivePath);
+            if (!archive->valid())
+            {
+                archive.reset();
+            }
+            else
+            {
+                common::log::info("using asset archive {} with {} artifacts", parameters.archivePath.string(),
+                                  archive->size());
+
+                // so that the artifacts can be retrieved using only their key (e.g. from a deserialized scene)
+                for (AssetId const& id: archive->ids())
+                {
+                    (void)AssetKeyTable::shared().intern(id);
+                }
+            }
+        }
+
+        if (parameters.watchInputDirectory)
+        {
+            watcher = std::make_unique<FileWatcher>(parameters.inputDirectory,
+                                                    [this](std::vector<std::filesystem::path> const& files) {
+                                                        reimport(files);
+                                                    },
+                                                    [this]() { rescan(); });
+            if (!watcher->valid())
+            {
+                common::log::error("Can't watch input directory {}, changed input files won't be reimported",
+                                   parameters.inputDirectory.string());
+                watcher.reset();
+            }
+        }
     }
 
     AssetDatabase::~AssetDatabase()
     {
-        // for std::futures that were not created by std::async, we need to explicitly wait as the
-        // destructor of a std::future does not wait.
+        // stop watching first, so that no new imports get started from the watcher thread
+        watcher.reset();
 
         std::unique_lock<std::mutex> lock(importTasksMutex);
-        std::vector<std::shared_future<void>> copiedTasks;
-        copiedTasks.reserve(importTasks.size());
-        for (auto& task: importTasks)
+        stopping = true; // don't accept new imports and pending reimports
+
+        // queued imports get started when running imports complete, so wait until none are left
+        importsDone.wait(lock, [this]() { return importTasks.empty() && activeImports == 0; });
+
+        // release the asset ids that were interned by the constructor and updateImported()
+        if (archive)
         {
-            copiedTasks.emplace_back(task.second);
+            for (AssetId const& id: archive->ids())
+            {
+                AssetKeyTable::shared().release(AssetKey(id));
+            }
         }
-        lock.unlock();
-
-        for (auto& task: copiedTasks)
+        for (auto& [inputFile, record]: imported)
         {
-            task.wait();
+            for (auto& artifact: record.artifacts)
+            {
+                AssetKeyTable::shared().release(AssetKey(AssetId{inputFile, artifact}));
+            }
         }
     }
 
-    Asset AssetDatabase::get(AssetId const& id)
+    Asset AssetDatabase::get(AssetId const& id, int priority)
     {
+        return get(AssetKey(id), &id, priority);
+    }
+
+    Asset AssetDatabase::get(AssetKey key, int priority)
+    {
+        return get(key, nullptr, priority);
+    }
+
+    Asset AssetDatabase::get(AssetKey key, AssetId const* knownId, int priority)
+    {
+        // the asset id only needs to be looked up when the key was provided without it
+        AssetId id;
+        auto findId = [&]() {
+            if (knownId)
+            {
+                id = *knownId;
+                return true;
+            }
+            return AssetKeyTable::shared().find(key, id);
+        };
+
+        std::shared_ptr<AssetHandle> handle;
         {
-            std::lock_guard<std::mutex> guard(assetHandlesMutex);
+            AssetHandleShard& shard = assetHandleShard(key);
+            std::unique_lock<std::mutex> lock(shard.mutex);
 
             // check if asset handle has already been created
-            auto handle = assetHandles.find(id);
-            if (handle != assetHandles.end() && handle->second.expired())
+            auto existing = shard.handles.find(key);
+            if (existing != shard.handles.end() && (handle = existing->second.lock()))
             {
-                return handle->second.lock();
+                lock.unlock();
+                if (!handle->done() && findId())
+                {
+                    raiseImportPriority(id.inputFilePath, priority);
+                }
+                return handle;
             }
-        }
 
-        // otherwise, start import
-        importFile(id.inputFilePath);
+            // the asset was released, but is still retained
+            if (Asset retained = residency->acquire(key))
+            {
+                handle = residency->wrap(std::move(retained));
+                shard.handles[key] = handle;
+                return handle;
+            }
 
+            if (!findId())
+            {
+                lock.unlock();
+                common::log::error("No asset id was interned for asset key {}", common::toHexString(key.value));
+                handle = std::make_shared<AssetHandle>(AssetId{});
+                handle->setError(common::ResultCode::NotFound);
+                return handle;
+            }
+
+            // otherwise, create an empty, untyped asset handle, before starting the import,
+            // so that the import task can give the imported data to this handle
+            handle = residency->wrap(std::make_shared<AssetHandle>(id));
+            shard.handles[key] = handle;
+        }
+
+        // artifacts in the archive only need to be parsed from memory, so we don't start an import task.
+        // parsed on the thread pool, other threads that get this asset in the meantime receive the loading handle
+        std::span<uint8_t const> data;
+        if (archive && archive->find(id, data))
         {
-            // and create an empty, untyped asset handle
+            {
+                std::lock_guard<std::mutex> guard(importTasksMutex);
+                if (stopping)
+                {
+                    handle->setError(common::ResultCode::Cancelled);
+                    return handle;
+                }
+                activeImports++; // so that the destructor waits for the load
+            }
 
-            std::lock_guard<std::mutex> guard(assetHandlesMutex);
-            std::shared_ptr<AssetHandle> handle = std::make_shared<AssetHandle>(id);
-            assetHandles.emplace(id, handle);
+            threadPool_.detach_task([this, handle, data]() {
+                loadFromArchive(*handle, data);
+
+                std::lock_guard<std::mutex> guard(importTasksMutex);
+                activeImports--;
+                importsDone.notify_all();
+            });
             return handle;
         }
+
+        // and start import
+        requestImport(id.inputFilePath, priority, handle);
+        return handle;
     }
 
     std::filesystem::path AssetDatabase::absolutePath(std::filesystem::path const& inputFile) const
@@ -97,89 +214,1041 @@ namespace asset
 
     bool AssetDatabase::valid(ImportResultCache const& importResultCache) const
     {
-        std::filesystem::path path = absolutePath(importResultCache.inputFilePath);
-        return std::filesystem::last_write_time(path) != importResultCache.lastWriteTime;
+        if (importResultCache.contentHash.empty())
+        {
+            return false;
+        }
+
+        // fast path, avoids reading the files
+        if (lastWriteTimesEqual(importResultCache))
+        {
+            return true;
+        }
+
+        // last write times are not preserved when checking out or copying files, so compare the contents
+        uint64_t hash = 0;
+        return contentHash(importResultCache.inputFilePath, importResultCache.dependencies, hash) &&
+               common::toHexString(hash) == importResultCache.contentHash;
     }
 
-    void AssetDatabase::importFile(std::filesystem::path const& inputFile)
+    bool AssetDatabase::contentHash(std::filesystem::path const& inputFile,
+                                    std::vector<std::filesystem::path> const& dependencies,
+                                    uint64_t& out) const
     {
+        // the extension determines which importer is used, so identical contents with a different extension
+        // should not result in the same hash
+        common::Hasher hasher(kImportVersion);
+        hasher.update(extension(inputFile));
+        if (!common::hashFile(absolutePath(inputFile), hasher))
+        {
+            return false;
+        }
+
+        for (auto& dependency: dependencies)
+        {
+            hasher.update(dependency.generic_string());
+            if (!common::hashFile(absolutePath(dependency), hasher))
+            {
+                return false;
+            }
+        }
+
+        out = hasher.digest();
+        return true;
+    }
+
+    std::filesystem::path AssetDatabase::contentPath(uint64_t contentHash) const
+    {
+        return parameters.loadDirectory / kContentDirectoryName / common::toHexString(contentHash);
+    }
+
+    void AssetDatabase::setMemoryBudget(AssetMemory budget)
+    {
+        residency->setBudget(budget);
+    }
+
+    AssetMemory AssetDatabase::residentMemory() const
+    {
+        return residency->resident();
+    }
+
+    std::vector<AssetTypeMemoryStatistics> AssetDatabase::memoryStatistics() const
+    {
+        return residency->statistics();
+    }
+
+    std::filesystem::path AssetDatabase::importResultCachePath(std::filesystem::path const& inputFile) const
+    {
+        return absoluteLoadPath(inputFile) / kImportResultFileName;
+    }
+
+    void AssetDatabase::importFile(std::filesystem::path const& inputFile, int priority)
+    {
+        requestImport(inputFile, priority, nullptr);
+    }
+
+    void AssetDatabase::raiseImportPriority(std::filesystem::path const& inputFile, int priority)
+    {
+        AssetKey const key = inputFileKey(inputFile);
+        std::lock_guard<std::mutex> guard(importTasksMutex);
+        auto entry = importTasks.find(key);
+        if (entry == importTasks.end() || entry->second.running || priority <= entry->second.priority)
+        {
+            return;
+        }
+
+        ImportTask& task = entry->second;
+        std::set<QueuedImport>& queue = importQueues[static_cast<size_t>(task.kind)];
+        queue.erase(QueuedImport{task.priority, task.sequence, key});
+        task.priority = priority;
+        queue.insert(QueuedImport{task.priority, task.sequence, key});
+    }
+
+    bool AssetDatabase::importCancelled(std::filesystem::path const& inputFile)
+    {
+        AssetKey const key = inputFileKey(inputFile);
+        std::lock_guard<std::mutex> guard(importTasksMutex);
+        auto entry = importTasks.find(key);
+        return entry != importTasks.end() && cancelled(entry->second);
+    }
+
+    bool AssetDatabase::QueuedImport::operator<(QueuedImport const& rhs) const
+    {
+        if (priority != rhs.priority)
+        {
+            return priority > rhs.priority;
+        }
+        return sequence < rhs.sequence;
+    }
+
+    void AssetDatabase::requestImport(std::filesystem::path const& inputFile, int priority, Asset const& handle)
+    {
+        // the handle gets completed with an error, so that its continuations still get called
         if (!fileExists(inputFile))
         {
             common::log::error("File does not exist: {}", absolutePath(inputFile).string());
+            if (handle)
+            {
+                handle->setError(common::ResultCode::NotFound);
+            }
             return;
         }
 
         if (!acceptsFile(inputFile))
         {
             common::log::error("Unsupported file format: {}", extension(inputFile));
+            if (handle)
+            {
+                handle->setError(common::ResultCode::Unimplemented);
+            }
             return;
         }
 
+        // determine the kind of import before locking, as this accesses the file system
+        ImportKind const kind = parameters.useImportCache && std::filesystem::exists(importResultCachePath(inputFile))
+                                ? ImportKind::Load : ImportKind::Import;
+
+        AssetKey const key = inputFileKey(inputFile);
+        std::vector<StartedImport> started;
         {
             std::lock_guard<std::mutex> guard(importTasksMutex);
+            if (stopping)
+            {
+                if (handle)
+                {
+                    handle->setError(common::ResultCode::Cancelled);
+                }
+                return;
+            }
 
-            // 1. check if task is already running
-            if (importTasks.contains(inputFile) && importTasks.at(inputFile).valid())
+            // 1. check if task is already queued or running
+            if (auto existing = importTasks.find(key); existing != importTasks.end())
             {
-                common::log::infoDebug("Import task for {} already running", absolutePath(inputFile).string());
+                ImportTask& task = existing->second;
+                if (handle)
+                {
+                    task.handles.emplace_back(handle);
+                }
+                else
+                {
+                    task.requested = true;
+                }
+
+                if (task.running)
+                {
+                    // the running import might already have given its results to the other asset handles,
+                    // so import again once it is done
+                    if (handle && task.emplacing)
+                    {
+                        pendingReimports.insert(inputFile);
+                    }
+                    common::log::infoDebug("Import task for {} already running", absolutePath(inputFile).string());
+                    return;
+                }
+
+                if (priority > task.priority)
+                {
+                    std::set<QueuedImport>& queue = importQueues[static_cast<size_t>(task.kind)];
+                    queue.erase(QueuedImport{task.priority, task.sequence, key});
+                    task.priority = priority;
+                    queue.insert(QueuedImport{task.priority, task.sequence, key});
+                }
                 return;
             }
 
-            // 2. otherwise, start import task
-            common::log::infoDebug("Start import task for {}", absolutePath(inputFile).string());
-            observers.invoke<&IAssetDatabaseObserver::onImportStarted>(inputFile);
+            // 2. otherwise, queue import task
+            ImportTask& task = importTasks[key];
+            task.inputFile = inputFile;
+            task.kind = kind;
+            task.priority = priority;
+            task.sequence = importSequence++;
+            task.requested = handle == nullptr;
+            if (handle)
+            {
+                task.handles.emplace_back(handle);
+            }
+            importQueues[static_cast<size_t>(kind)].insert(QueuedImport{priority, task.sequence, key});
+
+            started = startImports();
+        }
+        submitImports(std::move(started));
+    }
+
+    std::vector<AssetDatabase::StartedImport> AssetDatabase::startImports()
+    {
+        std::vector<StartedImport> started;
+        for (size_t kind = 0; kind < static_cast<size_t>(ImportKind::Count); kind++)
+        {
+            size_t const maxConcurrent = static_cast<ImportKind>(kind) == ImportKind::Load
+                                         ? parameters.maxConcurrentLoads : parameters.maxConcurrentImports;
+            std::set<QueuedImport>& queue = importQueues[kind];
+            while (!queue.empty() && runningImports[kind] < maxConcurrent)
+            {
+                AssetKey const key = queue.begin()->key;
+                queue.erase(queue.begin());
+
+                ImportTask& task = importTasks.at(key);
+                if (cancelled(task))
+                {
+                    common::log::infoDebug("Cancelled import of {}", absolutePath(task.inputFile).string());
+                    importTasks.erase(key);
+                    continue;
+                }
+
+                task.running = true;
+                runningImports[kind]++;
+                activeImports++;
+                started.emplace_back(StartedImport{key, task.inputFile, static_cast<ImportKind>(kind)});
+            }
+        }
+        return started;
+    }
+
+    void AssetDatabase::submitImports(std::vector<StartedImport> started)
+    {
+        for (StartedImport& task: started)
+        {
+            common::log::infoDebug("Start import task for {}", absolutePath(task.inputFile).string());
+            observers.invoke<&IAssetDatabaseObserver::onImportStarted>(task.inputFile);
+
+            threadPool_.detach_task([this, task = std::move(task)]() {
+                runImport(task.inputFile);
+
+                // erase after running the import, so that get() calls during the import wait for this task
+                // instead of starting a new one
+                bool reimport;
+                std::vector<StartedImport> next;
+                {
+                    std::lock_guard<std::mutex> guard(importTasksMutex);
+                    importTasks.erase(task.key);
+                    runningImports[static_cast<size_t>(task.kind)]--;
+                    reimport = pendingReimports.erase(task.inputFile) > 0;
+                    next = startImports();
+                }
+                submitImports(std::move(next));
+
+                // the input file changed while importing
+                if (reimport)
+                {
+                    importFile(task.inputFile);
+                }
+
+                // notify while locked, so that the destructor can't finish before this task stops accessing `this`
+                std::lock_guard<std::mutex> guard(importTasksMutex);
+                activeImports--;
+                importsDone.notify_all();
+            });
+        }
+    }
+
+    AssetDatabase::AssetHandleShard& AssetDatabase::assetHandleShard(AssetKey key)
+    {
+        // the key is a hash, so its high bits are as random as its low bits, the low bits are left for the hash map
+        return assetHandleShards[(key.value >> 56) % kAssetHandleShardCount];
+    }
+
+    AssetKey AssetDatabase::inputFileKey(std::filesystem::path const& inputFile)
+    {
+        return AssetKey(AssetId{inputFile});
+    }
+
+    bool AssetDatabase::cancelled(ImportTask const& task)
+    {
+        if (task.requested || task.handles.empty())
+        {
+            return false;
+        }
+        return std::all_of(task.handles.begin(), task.handles.end(), [](auto& handle) { return handle.expired(); });
+    }
+
+    void AssetDatabase::runImport(std::filesystem::path const& inputFile)
+    {
+        std::optional<uint64_t> contentHash_;
+        ImportResult result = importOrLoadFromCache(inputFile, contentHash_);
+        if (result.error() && result.code() == common::ResultCode::Cancelled && importCancelled(inputFile))
+        {
+            common::log::infoDebug("Cancelled import of {}", absolutePath(inputFile).string());
+        }
+        else if (result.error())
+        {
+            common::log::error("Import failed for {} ({})", absolutePath(inputFile).string(), result.message());
+        }
+
+        // input files with dependencies could import differently depending on their location,
+        // so only the artifacts of input files without dependencies can be shared
+        if (contentHash_ && result.success() && result.get().dependencies.empty())
+        {
+            addImportedContent(*contentHash_, result.get());
+        }
 
-            // 2.1 create task
-            auto task = [&, inputFile]() {
-                ImportResult result = context_.importers.importFile(*this, inputFile);
-                if (result.error())
+        if (result.success())
+        {
+            updateImported(inputFile, result.get());
+
+            {
+                std::lock_guard<std::mutex> guard(importTasksMutex);
+                if (auto task = importTasks.find(inputFileKey(inputFile)); task != importTasks.end())
                 {
-                    common::log::error("Import failed for {} ({})", absolutePath(inputFile).string(), result.message());
+                    task->second.emplacing = true;
                 }
+            }
 
-                if (result.success())
+            // emplace asset handles
+            ImportResultData& data = result.get();
+            for (std::shared_ptr<AssetHandle>& artifact: data.artifacts)
+            {
+                AssetKey const key = artifact->key();
+                AssetHandleShard& shard = assetHandleShard(key);
                 {
-                    std::lock_guard<std::mutex> assetHandlesLock(assetHandlesMutex);
-                    // emplace asset handles
-                    ImportResultData& data = result.get();
-                    for (std::shared_ptr<AssetHandle>& artifact: data.artifacts)
+                    std::lock_guard<std::mutex> guard(shard.mutex);
+
+                    // if the asset handle for the given AssetId already exists, do a switcheroo
+                    // and give the asset data of the ImportResult to the existing handle
+                    auto existing = shard.handles.find(key);
+                    std::shared_ptr<AssetHandle> existingHandle;
+                    if (existing != shard.handles.end() && (existingHandle = existing->second.lock()))
                     {
-                        // if the asset handle for the given AssetId already exists, do a switcheroo
-                        // and give the asset data of the ImportResult to the existing handle
-                        if (assetHandles.contains(artifact->id()) && !assetHandles.at(artifact->id()).expired())
+                        if (existingHandle->done())
                         {
-                            std::shared_ptr<AssetHandle> existingHandle = assetHandles.at(artifact->id()).lock();
-                            existingHandle->swap(artifact);
+                            // reimported, the old data could still be in use by the main thread,
+                            // so the swap gets applied by applyReloads()
+                            std::lock_guard<std::mutex> reloadsGuard(reloadsMutex);
+                            pendingReloads.emplace_back(PendingReload{existingHandle, std::move(artifact)});
+                            artifact = nullptr;
                         }
                         else
                         {
-                            //common::log::infoDebug("we just placed a new one there");
-                            // otherwise simply move it into the asset handles dictionary
-                            assetHandles.emplace(artifact->id(), artifact);
+                            existingHandle->swap(artifact);
+                            artifact = existingHandle;
                         }
-
-                        common::log::infoDebug("emplaced {} into asset handles", artifact->id().artifactPath.string());
+                    }
+                    else
+                    {
+                        // otherwise simply move it into the asset handles dictionary
+                        artifact = residency->wrap(std::move(artifact));
+                        shard.handles[key] = artifact;
                     }
                 }
 
+                if (artifact)
                 {
-                    std::lock_guard<std::mutex> guard(importTasksMutex);
-                    importTasks.erase(inputFile);
+                    updateMemory(*artifact);
+                    common::log::infoDebug("emplaced {} into asset handles", artifact->id().artifactPath.string());
                 }
+            }
+        }
 
-                observers.invoke<&IAssetDatabaseObserver::onImportComplete>(inputFile, result);
+        observers.invoke<&IAssetDatabaseObserver::onImportComplete>(inputFile, result);
 
-                common::log::infoDebug("Import task done for {}", absolutePath(inputFile).string());
-            };
+        common::log::infoDebug("Import task done for {}", absolutePath(inputFile).string());
+    }
 
-            // 2.2 start and emplace task
-            std::shared_future<void> future = threadPool.submit_task(std::move(task));
-            importTasks.emplace(inputFile, std::move(future));
+    void AssetDatabase::applyReloads()
+    {
+        std::vector<PendingReload> reloads;
+        {
+            std::lock_guard<std::mutex> guard(reloadsMutex);
+            reloads.swap(pendingReloads);
         }
+
+        for (PendingReload& reload: reloads)
+        {
+            std::shared_ptr<AssetHandle> handle = reload.handle.lock();
+            if (!handle)
+            {
+                continue; // released in the meantime
+            }
+            handle->swap(reload.data);
+            updateMemory(*handle);
+            common::log::infoDebug("reloaded {}", handle->id().string());
+        }
+        // the old data gets destroyed here, on the calling thread
     }
 
     AssetDatabaseContext const& AssetDatabase::context()
     {
         return context_;
     }
-}
\ No newline at end of file
+
+    BS::thread_pool& AssetDatabase::threadPool()
+    {
+        return threadPool_;
+    }
+
+    bool AssetDatabase::lastWriteTimesEqual(ImportResultCache const& cache) const
+    {
+        std::error_code error;
+        std::filesystem::path path = absolutePath(cache.inputFilePath);
+        if (std::filesystem::last_write_time(path, error) != cache.lastWriteTime || error)
+        {
+            return false;
+        }
+
+        if (cache.dependencies.size() != cache.dependencyLastWriteTimes.size())
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < cache.dependencies.size(); i++)
+        {
+            std::filesystem::path dependency = absolutePath(cache.dependencies[i]);
+            if (std::filesystem::last_write_time(dependency, error) != cache.dependencyLastWriteTimes[i] || error)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool AssetDatabase::readLastWriteTimes(ImportResultCache& cache) const
+    {
+        std::error_code error;
+        cache.lastWriteTime = std::filesystem::last_write_time(absolutePath(cache.inputFilePath), error);
+        if (error)
+        {
+            return false;
+        }
+
+        cache.dependencyLastWriteTimes.clear();
+        for (auto& dependency: cache.dependencies)
+        {
+            cache.dependencyLastWriteTimes.emplace_back(std::filesystem::last_write_time(absolutePath(dependency), error));
+            if (error)
+            {
+                return false; // the dependency does not exist, so we can't validate the cache later
+            }
+        }
+        return true;
+    }
+
+    bool AssetDatabase::shareImportedContent(std::filesystem::path const& inputFile, uint64_t hash,
+                                             ImportResultData& out)
+    {
+        std::lock_guard<std::mutex> guard(importedContentMutex);
+        auto entry = importedContent.find(hash);
+        if (entry == importedContent.end())
+        {
+            return false;
+        }
+
+        std::vector<Asset> sources;
+        sources.reserve(entry->second.size());
+        for (auto& artifact: entry->second)
+        {
+            Asset source = artifact.lock();
+            if (!source)
+            {
+                importedContent.erase(entry); // not in memory anymore
+                return false;
+            }
+            sources.emplace_back(std::move(source));
+        }
+
+        for (Asset& source: sources)
+        {
+            Asset alias = std::make_shared<AssetHandle>(AssetId{inputFile, source->id().artifactPath});
+            alias->setAlias(std::move(source));
+            out.artifacts.emplace_back(std::move(alias));
+        }
+        return true;
+    }
+
+    void AssetDatabase::addImportedContent(uint64_t hash, ImportResultData& data)
+    {
+        if (std::any_of(data.artifacts.begin(), data.artifacts.end(), [](Asset const& a) { return a->isAlias(); }))
+        {
+            return; // shared from content that is already registered
+        }
+
+        std::vector<std::weak_ptr<AssetHandle>> content;
+        content.reserve(data.artifacts.size());
+        for (Asset& artifact: data.artifacts)
+        {
+            // the imported data gets stored in a separate asset handle that is never swapped, so that when the
+            // input file changes and gets reimported, other input files that share its old contents are unaffected
+            Asset alias = std::make_shared<AssetHandle>(artifact->id());
+            alias->setAlias(artifact);
+            content.emplace_back(artifact);
+            artifact = std::move(alias);
+        }
+
+        std::lock_guard<std::mutex> guard(importedContentMutex);
+        importedContent[hash] = std::move(content);
+    }
+
+    void AssetDatabase::updateImported(std::filesystem::path const& inputFile, ImportResultData const& data)
+    {
+        std::vector<std::filesystem::path> const& dependencies_ = data.dependencies;
+
+        // the last write times the input file was imported with, so that changes can be detected by rescan()
+        ImportResultCache record{.inputFilePath = inputFile, .dependencies = dependencies_};
+        if (!readLastWriteTimes(record))
+        {
+            record.dependencyLastWriteTimes.clear(); // never equal, so it gets reimported when rescanning
+        }
+
+        // the artifacts stay interned while they are imported, so that they can be retrieved by their key
+        // (e.g. from a scene) after all their asset handles have been destroyed
+        for (Asset const& artifact: data.artifacts)
+        {
+            (void)AssetKeyTable::shared().intern(artifact->id());
+            record.artifacts.emplace_back(artifact->id().artifactPath);
+        }
+
+        std::vector<std::filesystem::path> previousArtifacts;
+        {
+            std::lock_guard<std::mutex> guard(dependenciesMutex);
+
+            // remove the edges of the previous import
+            if (auto previous = imported.find(inputFile); previous != imported.end())
+            {
+                previousArtifacts = std::move(previous->second.artifacts);
+                removeDependents(inputFile, previous->second.dependencies);
+            }
+
+            for (auto& dependency: dependencies_)
+            {
+                dependents_[dependency].insert(inputFile);
+            }
+            imported[inputFile] = std::move(record);
+        }
+
+        for (auto& artifact: previousArtifacts)
+        {
+            AssetKeyTable::shared().release(AssetKey(AssetId{inputFile, artifact}));
+        }
+    }
+
+    void AssetDatabase::removeDependents(std::filesystem::path const& inputFile,
+                                         std::vector<std::filesystem::path> const& dependencies_)
+    {
+        for (auto& dependency: dependencies_)
+        {
+            auto entry = dependents_.find(dependency);
+            if (entry != dependents_.end())
+            {
+                entry->second.erase(inputFile);
+                if (entry->second.empty())
+                {
+                    dependents_.erase(entry);
+                }
+            }
+        }
+    }
+
+    void AssetDatabase::loadFromArchive(AssetHandle& handle, std::span<uint8_t const> data)
+    {
+        AssetId const& id = handle.id();
+        reflection::TypeId const typeId = context_.assetTypes.typeIdFromExtension(extension(id.artifactPath));
+        AssetType const* type = typeId != reflection::nullTypeId ? &context_.assetTypes.get(typeId) : nullptr;
+        if (!type || (!type->loadFromMemory && !type->load))
+        {
+            common::log::error("No load function for artifact {} in asset archive", id.artifactPath.string());
+            handle.setError(common::ResultCode::Unimplemented);
+            return;
+        }
+
+        Asset loaded = std::make_shared<AssetHandle>(id);
+        bool success;
+        if (type->loadFromMemory)
+        {
+            success = type->loadFromMemory(context_, data, *loaded);
+        }
+        else
+        {
+            common::binary::MemoryStreamBuffer buffer(data);
+            std::istream in(&buffer);
+            success = type->load(context_, in, *loaded);
+        }
+
+        if (!success)
+        {
+            common::log::error("Failed to load artifact {} from asset archive", id.string());
+            handle.setError(common::ResultCode::DataLoss);
+            return;
+        }
+
+        handle.swap(loaded);
+        updateMemory(handle);
+    }
+
+    bool AssetDatabase::writeArchive(std::filesystem::path const& path) const
+    {
+        std::vector<AssetArchiveEntry> entries;
+        std::filesystem::path const contentDirectory = parameters.loadDirectory / kContentDirectoryName;
+
+        std::error_code error;
+        for (auto it = std::filesystem::recursive_directory_iterator(parameters.loadDirectory, error);
+             it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+        {
+            if (error)
+            {
+                break;
+            }
+
+            // the content directory contains the artifacts, which are listed by the import result caches of the input files
+            if (it->path() == contentDirectory)
+            {
+                it.disable_recursion_pending();
+                continue;
+            }
+
+            if (it->path().filename() != kImportResultFileName)
+            {
+                continue;
+            }
+
+            ImportResultCache cache;
+            if (!readImportResultCache(it->path(), cache))
+            {
+                common::log::warning("Skipping invalid import cache {}", it->path().string());
+                continue;
+            }
+
+            if (!valid(cache))
+            {
+                common::log::warning("Skipping outdated import cache of {}", cache.inputFilePath.string());
+                continue;
+            }
+
+            for (auto& artifactPath: cache.artifacts)
+            {
+                entries.emplace_back(AssetArchiveEntry{
+                    .id = AssetId{cache.inputFilePath, artifactPath},
+                    .file = contentDirectory / cache.contentHash / artifactPath
+                });
+            }
+        }
+
+        if (error)
+        {
+            common::log::error("Failed to read load directory {} ({})", parameters.loadDirectory.string(),
+                               error.message());
+            return false;
+        }
+
+        common::log::info("writing asset archive {} with {} artifacts", path.string(), entries.size());
+        return AssetArchive::write(path, std::move(entries));
+    }
+
+    void AssetDatabase::updateMemory(AssetHandle& handle)
+    {
+        reflection::TypeId const typeId = handle.typeId();
+        if (!context_.assetTypes.contains(typeId) || !context_.assetTypes.get(typeId).memoryUsage)
+        {
+            return;
+        }
+        residency->update(handle, typeId, context_.assetTypes.get(typeId).memoryUsage(handle));
+    }
+
+    std::vector<std::filesystem::path> AssetDatabase::dependents(std::filesystem::path const& inputFile)
+    {
+        std::lock_guard<std::mutex> guard(dependenciesMutex);
+
+        // breadth first, so that direct dependents come first
+        std::vector<std::filesystem::path> out;
+        std::unordered_set<std::filesystem::path> visited{inputFile};
+        std::vector<std::filesystem::path> queue{inputFile};
+        for (size_t i = 0; i < queue.size(); i++)
+        {
+            auto entry = dependents_.find(queue[i]);
+            if (entry == dependents_.end())
+            {
+                continue;
+            }
+
+            for (auto& dependent: entry->second)
+            {
+                if (visited.insert(dependent).second)
+                {
+                    queue.emplace_back(dependent);
+                    out.emplace_back(dependent);
+                }
+            }
+        }
+        return out;
+    }
+
+    void AssetDatabase::reimport(std::vector<std::filesystem::path> const& changedFiles)
+    {
+        std::vector<std::filesystem::path> inputFiles;
+        std::unordered_set<std::filesystem::path> added;
+        for (auto& file: changedFiles)
+        {
+            bool wasImported;
+            {
+                std::lock_guard<std::mutex> guard(dependenciesMutex);
+                wasImported = imported.contains(file);
+            }
+
+            // files that were never imported (e.g. images that are only dependencies) don't need to be imported
+            if (wasImported && added.insert(file).second)
+            {
+                inputFiles.emplace_back(file);
+            }
+
+            // a created import parameters file is not a dependency of its input file yet
+            if (file.extension() == kImportParametersExtension)
+            {
+                std::filesystem::path inputFile = file;
+                inputFile.replace_extension();
+                std::lock_guard<std::mutex> guard(dependenciesMutex);
+                if (imported.contains(inputFile) && added.insert(inputFile).second)
+                {
+                    inputFiles.emplace_back(inputFile);
+                }
+            }
+
+            for (auto& dependent: dependents(file))
+            {
+                if (added.insert(dependent).second)
+                {
+                    inputFiles.emplace_back(dependent);
+                }
+            }
+        }
+
+        for (auto& inputFile: inputFiles)
+        {
+            common::log::info("Reimporting {}", inputFile.string());
+            {
+                // if an import task is already running, it might have read the old contents,
+                // so import again once it is done
+                std::lock_guard<std::mutex> guard(importTasksMutex);
+                auto task = importTasks.find(inputFileKey(inputFile));
+                if (task != importTasks.end() && task->second.running)
+                {
+                    pendingReimports.insert(inputFile);
+                    continue;
+                }
+            }
+            importFile(inputFile);
+        }
+    }
+
+    void AssetDatabase::rescan()
+    {
+        std::vector<ImportResultCache> records;
+        {
+            std::lock_guard<std::mutex> guard(dependenciesMutex);
+            records.reserve(imported.size());
+            for (auto& entry: imported)
+            {
+                records.emplace_back(entry.second);
+            }
+        }
+
+        // compare outside the lock, as this accesses the file system
+        std::vector<std::filesystem::path> changed;
+        for (ImportResultCache const& record: records)
+        {
+            if (!lastWriteTimesEqual(record) || importParametersAdded(record))
+            {
+                changed.emplace_back(record.inputFilePath);
+            }
+        }
+
+        common::log::info("Rescanned {} imported input files, {} changed", records.size(), changed.size());
+        reimport(changed);
+    }
+
+    ImportResult AssetDatabase::importOrLoadFromCache(std::filesystem::path const& inputFile,
+                                                      std::optional<uint64_t>& hash)
+    {
+        // hashing reads the entire input file, so only do it when the last write times can't validate the cache
+        auto const hashContents = [&]() {
+            uint64_t value = 0;
+            if (!hash && contentHash(inputFile, {}, value))
+            {
+                hash = value;
+            }
+            return hash.has_value();
+        };
+
+        // the artifacts of an input file with import parameters depend on more than the contents of the input file,
+        // so they can't be shared with other input files
+        bool const hasImportParameters = fileExists(importParametersPath(inputFile));
+
+        ImportResultCache cache;
+        std::filesystem::path const cachePath = importResultCachePath(inputFile);
+        bool const cached = parameters.useImportCache && readImportResultCache(cachePath, cache) &&
+                            cache.inputFilePath == inputFile && !importParametersAdded(cache);
+        bool const upToDate = cached && !cache.contentHash.empty() && lastWriteTimesEqual(cache);
+        if (upToDate && cache.dependencies.empty())
+        {
+            // without dependencies, the content hash of the cache is the content hash of the input file itself
+            uint64_t value = 0;
+            if (common::fromHexString(cache.contentHash, value))
+            {
+                hash = value;
+            }
+        }
+        else if (!upToDate)
+        {
+            hashContents();
+        }
+
+        // 1. an input file with identical contents is already loaded
+        ImportResultData shared;
+        if (hash && !hasImportParameters && shareImportedContent(inputFile, *hash, shared))
+        {
+            common::log::infoDebug("Shared artifacts of identical input file for {}", absolutePath(inputFile).string());
+            return ImportResult::makeSuccess(std::move(shared));
+        }
+
+        // 2. load from the import cache
+        if (parameters.useImportCache)
+        {
+            bool found = false;
+            bool updateCache = false;
+            if (cached)
+            {
+                found = upToDate || valid(cache);
+                updateCache = !upToDate;
+            }
+            else if (hash && !hasImportParameters)
+            {
+                // no cache for this input file (e.g. a copy of another input file), but the artifacts
+                // for its contents might already exist
+                found = readImportResultCache(contentPath(*hash) / kImportResultFileName, cache) &&
+                        cache.dependencies.empty() && cache.contentHash == common::toHexString(*hash);
+                cache.inputFilePath = inputFile;
+                updateCache = true;
+            }
+
+            if (found)
+            {
+                ImportResult loaded = loadFromCache(inputFile, cache);
+                if (loaded.success())
+                {
+                    common::log::infoDebug("Loaded {} from import cache", absolutePath(inputFile).string());
+                    if (updateCache && readLastWriteTimes(cache))
+                    {
+                        std::error_code error;
+                        std::filesystem::create_directories(cachePath.parent_path(), error);
+                        writeImportResultCache(cachePath, cache);
+                    }
+                    return loaded;
+                }
+                common::log::warning("Failed to load import cache for {} ({}), reimporting",
+                                     absolutePath(inputFile).string(), loaded.message());
+            }
+        }
+
+        // 3. import, unless none of the asset handles that requested it are referenced anymore
+        if (importCancelled(inputFile))
+        {
+            return ImportResult::makeError(common::ResultCode::Cancelled, "import was cancelled");
+        }
+
+        ImportResult result = context_.importers.importFile(*this, inputFile);
+        if (parameters.useImportCache && result.success())
+        {
+            ImportResultData const& data = result.get();
+            uint64_t fullHash = 0;
+            if (data.dependencies.empty() ? hashContents() : contentHash(inputFile, data.dependencies, fullHash))
+            {
+                writeToCache(inputFile, data, data.dependencies.empty() ? *hash : fullHash);
+            }
+        }
+        return result;
+    }
+
+    std::filesystem::path AssetDatabase::importParametersPath(std::filesystem::path const& inputFile)
+    {
+        return inputFile.string() + kImportParametersExtension;
+    }
+
+    bool AssetDatabase::importParametersAdded(ImportResultCache const& cache) const
+    {
+        std::filesystem::path const parametersFile = importParametersPath(cache.inputFilePath);
+        return fileExists(parametersFile) &&
+               std::find(cache.dependencies.begin(), cache.dependencies.end(), parametersFile) == cache.dependencies.end();
+    }
+
+    bool AssetDatabase::readImportParametersJson(std::filesystem::path const& inputFile, nlohmann::json& out,
+                                                 std::vector<std::filesystem::path>& dependencies) const
+    {
+        std::filesystem::path const parametersFile = importParametersPath(inputFile);
+        std::ifstream file(absolutePath(parametersFile));
+        if (!file.is_open())
+        {
+            out = nullptr;
+            return true;
+        }
+        dependencies.emplace_back(parametersFile);
+
+        out = nlohmann::json::parse(file, nullptr, /*allow_exceptions*/ false);
+        if (out.is_discarded() || !out.is_object())
+        {
+            common::log::error("Invalid import parameters file {}", absolutePath(parametersFile).string());
+            return false;
+        }
+        return true;
+    }
+
+    bool AssetDatabase::readImportResultCache(std::filesystem::path const& path, ImportResultCache& out) const
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        nlohmann::json json = nlohmann::json::parse(file, nullptr, /*allow_exceptions*/ false);
+        if (json.is_discarded() || !json.is_object())
+        {
+            return false;
+        }
+
+        try
+        {
+            reflection::Reflection::shared().json.fromJson(json, out);
+        }
+        catch (nlohmann::json::exception const& e)
+        {
+            common::log::warning("Invalid import cache {} ({})", path.string(), e.what());
+            return false;
+        }
+        return true;
+    }
+
+    void AssetDatabase::writeImportResultCache(std::filesystem::path const& path, ImportResultCache& cache) const
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << reflection::Reflection::shared().json.toJsonString(cache, kJsonIndentationAmount);
+    }
+
+    ImportResult AssetDatabase::loadFromCache(std::filesystem::path const& inputFile, ImportResultCache const& cache)
+    {
+        ImportResultData result;
+        result.dependencies = cache.dependencies;
+        result.artifacts.reserve(cache.artifacts.size());
+
+        std::filesystem::path const path = parameters.loadDirectory / kContentDirectoryName / cache.contentHash;
+        for (auto& artifactPath: cache.artifacts)
+        {
+            reflection::TypeId typeId = context_.assetTypes.typeIdFromExtension(extension(artifactPath));
+            if (typeId == reflection::nullTypeId || !context_.assetTypes.get(typeId).load)
+            {
+                return ImportResult::makeError(common::ResultCode::Unimplemented,
+                                               "no load function for artifact " + artifactPath.string());
+            }
+
+            std::ifstream file(path / artifactPath, std::ios::binary);
+            if (!file.is_open())
+            {
+                return ImportResult::makeError(common::ResultCode::NotFound,
+                                               "missing artifact " + artifactPath.string());
+            }
+
+            Asset asset = std::make_shared<AssetHandle>(AssetId{inputFile, artifactPath});
+            if (!context_.assetTypes.get(typeId).load(context_, file, *asset))
+            {
+                return ImportResult::makeError(common::ResultCode::DataLoss,
+                                               "failed to load artifact " + artifactPath.string());
+            }
+            result.artifacts.emplace_back(std::move(asset));
+        }
+
+        return ImportResult::makeSuccess(std::move(result));
+    }
+
+    void AssetDatabase::writeToCache(std::filesystem::path const& inputFile, ImportResultData const& data, uint64_t hash)
+    {
+        std::error_code error;
+        std::filesystem::path const cachePath = importResultCachePath(inputFile);
+
+        // remove the previous cache first, so that a partially written cache is never considered valid
+        std::filesystem::remove(cachePath, error);
+
+        ImportResultCache cache{
+            .inputFilePath = inputFile,
+            .dependencies = data.dependencies,
+            .contentHash = common::toHexString(hash)
+        };
+        if (!readLastWriteTimes(cache))
+        {
+            return;
+        }
+
+        for (Asset const& artifact: data.artifacts)
+        {
+            if (!context_.assetTypes.contains(artifact->typeId()) || !context_.assetTypes.get(artifact->typeId()).save)
+            {
+                common::log::infoDebug("Not caching {}, artifact {} can't be saved", inputFile.string(),
+                                       artifact->id().artifactPath.string());
+                return;
+            }
+            cache.artifacts.emplace_back(artifact->id().artifactPath);
+        }
+
+        // input files with identical contents share the artifacts, so only write them once
+        std::filesystem::path const path = contentPath(hash);
+        std::filesystem::path const contentCachePath = path / kImportResultFileName;
+        if (!std::filesystem::exists(contentCachePath, error))
+        {
+            for (Asset const& artifact: data.artifacts)
+            {
+                std::filesystem::path const artifactPath = path / artifact->id().artifactPath;
+                std::filesystem::create_directories(artifactPath.parent_path(), error);
+                std::ofstream file(artifactPath, std::ios::binary | std::ios::trunc);
+                if (!file.is_open() || !context_.assetTypes.get(artifact->typeId()).save(*artifact, file))
+                {
+                    common::log::error("Failed to write artifact {}", artifactPath.string());
+                    return;
+                }
+            }
+            writeImportResultCache(contentCachePath, cache);
+        }
+
+        std::filesystem::create_directories(cachePath.parent_path(), error);
+        if (error)
+        {
+            common::log::error("Failed to create load directory {} ({})", cachePath.parent_path().string(), error.message());
+            return;
+        }
+        writeImportResultCache(cachePath, cache);
+    }
+}
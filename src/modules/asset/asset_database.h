@@ -10,6 +10,9 @@
 #include "asset_type.h"
 #include "import_registry.h"
 #include "asset_type_registry.h"
+#include "file_watcher.h"
+#include "asset_residency.h"
+#include "asset_archive.h"
 
 #include <common/result.h>
 #include <common/observers.h>
@@ -18,11 +21,17 @@
 
 #include <filesystem>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <iostream>
 #include <chrono>
-#include <future>
+#include <condition_variable>
+#include <array>
 #include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <algorithm>
 
 namespace BS
 {
@@ -31,13 +40,17 @@ namespace BS
 
 namespace asset
 {
-    // cache
+    // cache, stored as kImportResultFileName inside the load path of the input file.
+    // the native binary artifacts are stored in the content path of the content hash,
+    // so that input files with identical contents share their artifacts.
     struct ImportResultCache
     {
         std::filesystem::path inputFilePath;
-        std::vector<std::filesystem::path> artifacts;
+        std::vector<std::filesystem::path> artifacts; // artifact paths, relative to the content path
         std::vector<std::filesystem::path> dependencies;
+        std::vector<std::filesystem::file_time_type> dependencyLastWriteTimes; // ordered 1:1 with dependencies
         std::filesystem::file_time_type lastWriteTime; // last write time of input file (not when it was imported)
+        std::string contentHash; // hex encoded hash of the contents of the input file and its dependencies
     };
 
     class IAssetDatabaseObserver
@@ -63,7 +76,24 @@ namespace asset
     {
         std::filesystem::path inputDirectory;
         std::filesystem::path loadDirectory;
-        bool useImportCache;
+        bool useImportCache; // whether to store imported artifacts in the load directory and load them on the next run
+        // whether to reimport input files (and their dependents) when they change, see FileWatcher::supported()
+        bool watchInputDirectory = false;
+
+        // released assets are retained in memory until the resident memory (referenced + retained assets) exceeds
+        // this budget, the least recently released assets get evicted first. evicted assets get loaded again
+        // (from the import cache if enabled) when requested. a budget of zero disables retention.
+        AssetMemory memoryBudget{};
+
+        // maximum amount of imports that run at the same time. loading from the import cache is mostly bound by I/O,
+        // and importing is mostly bound by the CPU, so these are limited separately. should be larger than zero.
+        size_t maxConcurrentLoads = 4;
+        size_t maxConcurrentImports = std::max(1u, std::thread::hardware_concurrency());
+
+        // optional packed asset archive (see AssetArchive and writeArchive), e.g. for shipping builds.
+        // artifacts that are contained in the archive are loaded from its memory mapping on the thread pool,
+        // instead of importing their input files.
+        std::filesystem::path archivePath{};
     };
 
     /**
@@ -81,6 +111,19 @@ namespace asset
         constexpr static char const* kImportResultFileName = "import_result.json";
         constexpr static int kJsonIndentationAmount = 2;
 
+        // directory inside the load directory that contains the artifacts, keyed by content hash
+        constexpr static char const* kContentDirectoryName = "content";
+
+        // seed of the content hash, increment when the import output changes for the same input
+        // (e.g. when changing an importer), so that existing caches get invalidated
+        constexpr static uint64_t kImportVersion = 9;
+
+        // queued imports with a higher priority start first
+        constexpr static int kDefaultImportPriority = 0;
+
+        // appended to the input file path, e.g. "models/scene.gltf.import" (see readImportParameters)
+        constexpr static char const* kImportParametersExtension = ".import";
+
         explicit AssetDatabase(
             AssetDatabaseParameters parameters,
             AssetDatabaseContext context,
@@ -90,15 +133,59 @@ namespace asset
 
         AssetDatabase(AssetDatabase const& rhs) = delete;
 
-        // get an asset handle with the provided asset id
-        [[nodiscard]] Asset get(AssetId const& id);
+        // get an asset handle with the provided asset id, if it is not loaded yet, its input file gets imported
+        // with the provided priority (or the priority gets raised if the import is already queued)
+        [[nodiscard]] Asset get(AssetId const& id, int priority = kDefaultImportPriority);
+
+        // same as above, but without hashing the asset id, e.g. for components that store the asset key.
+        // the asset id of the key should be interned (see AssetKey), otherwise the handle is in an error state
+        [[nodiscard]] Asset get(AssetKey key, int priority = kDefaultImportPriority);
 
         // gets list of all assets that are produced as a result of importing inputFile
-        void importFile(std::filesystem::path const& inputFile);
+        void importFile(std::filesystem::path const& inputFile, int priority = kDefaultImportPriority);
+
+        // raises the priority of a queued import, e.g. when one of its assets becomes visible.
+        // has no effect if the import already started, or if the provided priority is lower than the current one.
+        void raiseImportPriority(std::filesystem::path const& inputFile, int priority);
+
+        // returns whether the import of the input file was only requested using get(), and none of the returned
+        // asset handles are referenced anymore. cancelled imports that are queued never start, and
+        // importers can call this to stop early (cooperative cancellation).
+        [[nodiscard]] bool importCancelled(std::filesystem::path const& inputFile);
 
         // returns the absolute path of the provided input file
         [[nodiscard]] std::filesystem::path absolutePath(std::filesystem::path const& inputFile) const;
 
+        // reads the import parameters of an input file from its import parameters file (json, see
+        // kImportParametersExtension). members that are not in the file, or all members if the file doesn't exist,
+        // keep their value. the file gets added to the dependencies, so that changing it reimports the input file.
+        // returns false if the file is invalid
+        template<typename Type>
+        [[nodiscard]] bool readImportParameters(std::filesystem::path const& inputFile, Type& out,
+                                                std::vector<std::filesystem::path>& dependencies) const
+        {
+            nlohmann::json json;
+            if (!readImportParametersJson(inputFile, json, dependencies))
+            {
+                return false;
+            }
+
+            if (json.is_null())
+            {
+                return true;
+            }
+
+            try
+            {
+                reflection::Reflection::shared().json.fromJson(json, out);
+            }
+            catch (nlohmann::json::exception const&)
+            {
+                return false;
+            }
+            return true;
+        }
+
         // returns the absolute path of the load path that belongs to the provided input file
         // removes any dots from the file extension of the input file
         [[nodiscard]] std::filesystem::path absoluteLoadPath(std::filesystem::path const& inputFile) const;
@@ -111,25 +198,240 @@ namespace asset
         [[nodiscard]] bool acceptsFile(std::filesystem::path const& inputFile);
 
         // returns whether the cache is up-to-date or whether we have to reimport
+        // i.e. whether the input file and all its dependencies have the same last write time as when importing,
+        // or otherwise, whether their contents still hash to the same content hash (e.g. after a checkout or copy)
         [[nodiscard]] bool valid(ImportResultCache const& importResultCache) const;
 
+        // hashes the contents of the input file and the provided dependencies (relative paths)
+        // returns false if any of the files could not be read
+        [[nodiscard]] bool contentHash(std::filesystem::path const& inputFile,
+                                       std::vector<std::filesystem::path> const& dependencies,
+                                       uint64_t& out) const;
+
+        // returns the absolute path of the directory that contains the artifacts for the provided content hash
+        [[nodiscard]] std::filesystem::path contentPath(uint64_t contentHash) const;
+
+        // returns the input files that (transitively) depend on the provided input file,
+        // e.g. the gltf files that reference a png file
+        [[nodiscard]] std::vector<std::filesystem::path> dependents(std::filesystem::path const& inputFile);
+
+        // reimports the changed files that have been imported and all input files that depend on them.
+        // the existing asset handles get updated with the newly imported data by applyReloads().
+        // gets called by the file watcher when watchInputDirectory is enabled.
+        void reimport(std::vector<std::filesystem::path> const& changedFiles);
+
+        // gives the data of reimported assets to their existing asset handles, and destroys the old data.
+        // reimports complete on the thread pool while the old data could still be in use (e.g. for rendering),
+        // so this should be called on the main thread at a point where no asset data is in use (e.g. at the
+        // start of a frame)
+        void applyReloads();
+
+        // reimports the imported input files whose last write time (or that of one of their dependencies) differs
+        // from when they were imported. gets called by the file watcher when it dropped events, so changes
+        // could have been missed.
+        void rescan();
+
+        // returns the path of the import result cache (kImportResultFileName) of the provided input file
+        [[nodiscard]] std::filesystem::path importResultCachePath(std::filesystem::path const& inputFile) const;
+
+        // evicts retained assets until the resident memory fits inside the new budget
+        void setMemoryBudget(AssetMemory budget);
+
+        // memory of all loaded assets that are referenced or retained
+        [[nodiscard]] AssetMemory residentMemory() const;
+
+        // memory of loaded assets per asset type, only includes asset types that implement memoryUsage
+        [[nodiscard]] std::vector<AssetTypeMemoryStatistics> memoryStatistics() const;
+
+        // writes the artifacts of all input files in the import cache to a packed asset archive at the provided path.
+        // input files whose import cache is not up-to-date are skipped, so these should be imported first.
+        // returns false if the archive could not be written
+        [[nodiscard]] bool writeArchive(std::filesystem::path const& path) const;
+
         // observers for asset database events
         common::Observers<IAssetDatabaseObserver> observers;
 
         [[nodiscard]] AssetDatabaseContext const& context();
 
+        // the thread pool that runs the imports, importers can split their work over it using common::parallelFor
+        [[nodiscard]] BS::thread_pool& threadPool();
+
     private:
         AssetDatabaseContext context_;
         AssetDatabaseParameters parameters;
-        BS::thread_pool& threadPool;
+        BS::thread_pool& threadPool_;
+
+        // the asset handles are split over shards by asset key, each with their own lock, so that concurrent
+        // calls to get() and completing imports rarely wait on each other
+        constexpr static size_t kAssetHandleShardCount = 16;
+
+        struct AssetHandleShard
+        {
+            std::unordered_map<AssetKey, std::weak_ptr<AssetHandle>> handles;
+            std::mutex mutex;
+        };
+
+        std::array<AssetHandleShard, kAssetHandleShardCount> assetHandleShards;
+
+        // the asset handles in assetHandleShards are wrapped by the residency, so that they get retained when released
+        std::shared_ptr<AssetResidency> residency;
+
+        std::unique_ptr<AssetArchive> archive; // nullptr if no archive path was provided
+
+        enum class ImportKind
+        {
+            Load = 0, // the import cache contains a result for the input file
+            Import,
+            Count
+        };
+
+        struct ImportTask
+        {
+            std::filesystem::path inputFile;
+            ImportKind kind = ImportKind::Import;
+            int priority = kDefaultImportPriority;
+            uint64_t sequence = 0; // imports with the same priority start in the order they were requested
+            bool requested = false; // requested using importFile(), so it never gets cancelled
+            bool running = false;
+            bool emplacing = false; // the results are being given to the asset handles
+            std::vector<std::weak_ptr<AssetHandle>> handles; // handles returned by get() that wait for this import
+        };
 
-        std::unordered_map<AssetId, std::weak_ptr<AssetHandle>> assetHandles{};
-        std::mutex assetHandlesMutex;
+        // import that was started by startImports(), but still needs to be submitted to the thread pool
+        struct StartedImport
+        {
+            AssetKey key;
+            std::filesystem::path inputFile;
+            ImportKind kind;
+        };
 
-        // we use a shared future to enable copying in the destructor and waiting on them there,
-        // while still enabling removing them from tasks on completion.
-        std::unordered_map<std::filesystem::path, std::shared_future<void>> importTasks;
+        struct QueuedImport
+        {
+            int priority;
+            uint64_t sequence;
+            AssetKey key; // see inputFileKey()
+
+            // highest priority first
+            [[nodiscard]] bool operator<(QueuedImport const& rhs) const;
+        };
+
+        std::unordered_map<AssetKey, ImportTask> importTasks; // queued and running, keyed by inputFileKey()
+        std::set<QueuedImport> importQueues[static_cast<size_t>(ImportKind::Count)];
+        size_t runningImports[static_cast<size_t>(ImportKind::Count)]{};
+        uint64_t importSequence = 0;
+        size_t activeImports = 0; // imports and archive loads submitted to the thread pool and not completely done yet
+        std::condition_variable importsDone; // notified when an active import is done
+        std::unordered_set<std::filesystem::path> pendingReimports; // changed while the import task was running
+        bool stopping = false;
         std::mutex importTasksMutex;
+
+        // dependency graph, updated on each successful import.
+        // imported input files with their dependencies and artifacts, and the last write times they were imported with
+        std::unordered_map<std::filesystem::path, ImportResultCache> imported;
+        std::unordered_map<std::filesystem::path, std::unordered_set<std::filesystem::path>> dependents_; // dependency to input files
+        std::mutex dependenciesMutex;
+
+        std::unique_ptr<FileWatcher> watcher;
+
+        // reimported data for asset handles that were already loaded, see applyReloads()
+        struct PendingReload
+        {
+            std::weak_ptr<AssetHandle> handle;
+            std::shared_ptr<AssetHandle> data;
+        };
+
+        std::vector<PendingReload> pendingReloads;
+        std::mutex reloadsMutex;
+
+        // artifacts of imported input files without dependencies, keyed by content hash,
+        // so that input files with identical contents are only imported and kept in memory once
+        std::unordered_map<uint64_t, std::vector<std::weak_ptr<AssetHandle>>> importedContent;
+        std::mutex importedContentMutex;
+
+        // returns whether the input file and its dependencies have the same last write time as when importing
+        [[nodiscard]] bool lastWriteTimesEqual(ImportResultCache const& cache) const;
+
+        // sets the last write times of the input file and dependencies of the cache to their current values
+        [[nodiscard]] bool readLastWriteTimes(ImportResultCache& cache) const;
+
+        // if an input file with identical contents is loaded, returns aliases to its artifacts
+        [[nodiscard]] bool shareImportedContent(std::filesystem::path const& inputFile, uint64_t hash,
+                                                ImportResultData& out);
+
+        // registers the artifacts, and replaces them with aliases so that the asset handles that are
+        // given out never own the shared data
+        void addImportedContent(uint64_t hash, ImportResultData& data);
+
+        // relative path of the import parameters file of the input file (see kImportParametersExtension)
+        [[nodiscard]] static std::filesystem::path importParametersPath(std::filesystem::path const& inputFile);
+
+        // whether an import parameters file was created after the input file was imported
+        [[nodiscard]] bool importParametersAdded(ImportResultCache const& cache) const;
+
+        // see readImportParameters, `out` is null if the input file has no import parameters file
+        [[nodiscard]] bool readImportParametersJson(std::filesystem::path const& inputFile, nlohmann::json& out,
+                                                    std::vector<std::filesystem::path>& dependencies) const;
+
+        // records the dependencies and artifacts of a successful import
+        void updateImported(std::filesystem::path const& inputFile, ImportResultData const& data);
+
+        // removes the input file from the dependents of its previous dependencies, dependenciesMutex should be locked
+        void removeDependents(std::filesystem::path const& inputFile,
+                              std::vector<std::filesystem::path> const& dependencies);
+
+        // queues the import, or raises its priority if it is already queued.
+        // `handle` is the asset handle returned by get(), or nullptr if requested using importFile()
+        void requestImport(std::filesystem::path const& inputFile, int priority, Asset const& handle);
+
+        // marks queued imports as running in order of priority, until the maximum amount of concurrent imports
+        // is reached. skips cancelled imports. importTasksMutex should be locked.
+        [[nodiscard]] std::vector<StartedImport> startImports();
+
+        // invokes the observers and submits the started imports to the thread pool,
+        // importTasksMutex should not be locked
+        void submitImports(std::vector<StartedImport> started);
+
+        [[nodiscard]] AssetHandleShard& assetHandleShard(AssetKey key);
+
+        // if the asset id is not provided, it gets looked up in the AssetKeyTable when needed
+        [[nodiscard]] Asset get(AssetKey key, AssetId const* id, int priority);
+
+        // key of an input file itself (an asset id without artifact path), import tasks are keyed by it
+        [[nodiscard]] static AssetKey inputFileKey(std::filesystem::path const& inputFile);
+
+        // importTasksMutex should be locked
+        [[nodiscard]] static bool cancelled(ImportTask const& task);
+
+        // imports or loads the input file and gives the results to the asset handles, runs on the thread pool
+        void runImport(std::filesystem::path const& inputFile);
+
+        // loads the artifact from the provided memory inside the archive into the asset handle
+        void loadFromArchive(AssetHandle& handle, std::span<uint8_t const> data);
+
+        // updates the memory of the loaded asset handle, if its asset type implements memoryUsage
+        void updateMemory(AssetHandle& handle);
+
+        // loads the artifacts from the import cache if it is valid, otherwise imports the input file
+        // and writes the artifacts to the import cache (if enabled)
+        // `hash` is set to the content hash of the input file without dependencies, if it was needed and could be read.
+        // a valid import cache is loaded without reading the input file
+        [[nodiscard]] ImportResult importOrLoadFromCache(std::filesystem::path const& inputFile,
+                                                         std::optional<uint64_t>& hash);
+
+        // returns false if the cache file does not exist or could not be parsed
+        [[nodiscard]] bool readImportResultCache(std::filesystem::path const& path, ImportResultCache& out) const;
+
+        // writes the import result cache to the provided path
+        void writeImportResultCache(std::filesystem::path const& path, ImportResultCache& cache) const;
+
+        // loads the native binary artifacts listed in the cache for the provided input file,
+        // fails if any of them could not be loaded
+        [[nodiscard]] ImportResult loadFromCache(std::filesystem::path const& inputFile, ImportResultCache const& cache);
+
+        // writes the artifacts as native binary files to the content path (unless they already exist there)
+        // and the import result cache. the import result cache is written last and only if all artifacts
+        // were written successfully
+        void writeToCache(std::filesystem::path const& inputFile, ImportResultData const& data, uint64_t hash);
     };
 }
 
@@ -9,16 +9,26 @@
 namespace asset
 {
     AssetHandle::AssetHandle(asset::AssetId id)
-        : id_(std::move(id)), typeId_(reflection::nullTypeId)
+        : id_(std::move(id)), key_(AssetKeyTable::shared().intern(id_)), typeId_(reflection::nullTypeId)
     {
 
     }
 
+    AssetHandle::~AssetHandle()
+    {
+        AssetKeyTable::shared().release(key_);
+    }
+
     AssetId const& AssetHandle::id() const
     {
         return id_;
     }
 
+    AssetKey AssetHandle::key() const
+    {
+        return key_;
+    }
+
     reflection::TypeId AssetHandle::typeId() const
     {
         return typeId_;
@@ -26,52 +36,121 @@ namespace asset
 
     AssetHandle::State AssetHandle::state() const
     {
-        return state_;
+        return state_.load(std::memory_order_acquire);
     }
 
     common::ResultCode AssetHandle::code() const
     {
-        return code_;
+        return code_.load(std::memory_order_acquire);
     }
 
     bool AssetHandle::done() const
     {
-        return state_ == State::Done;
+        return state() == State::Done;
     }
 
     bool AssetHandle::success() const
     {
-        return state_ == State::Done && code_ == common::ResultCode::Success;
+        // code_ is written before state_, so read state_ first
+        return state() == State::Done && code_.load(std::memory_order_relaxed) == common::ResultCode::Success;
     }
 
     bool AssetHandle::error() const
     {
-        assert(state_ == State::Done && "state should be Done when checking for error()");
-        return code_ != common::ResultCode::Success;
+        assert(done() && "state should be Done when checking for error()");
+        return code_.load(std::memory_order_relaxed) != common::ResultCode::Success;
     }
 
     void AssetHandle::swap(std::shared_ptr<AssetHandle>& other)
     {
-        // swap all members of AssetHandle
+        // swap all members of AssetHandle, except for the continuations, which belong to this AssetHandle
         std::swap(id_, other->id_);
+        std::swap(key_, other->key_);
         std::swap(typeId_, other->typeId_);
-        std::swap(state_, other->state_);
-        std::swap(code_, other->code_);
         std::swap(data, other->data);
+        std::swap(alias_, other->alias_);
+
+        common::ResultCode const code = other->code_.load(std::memory_order_relaxed);
+        other->code_.store(code_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        code_.store(code, std::memory_order_relaxed);
+
+        // the state gets set last, so that the other members are visible to threads that observe the new state
+        State const state = other->state_.load(std::memory_order_relaxed);
+        other->state_.store(state_.load(std::memory_order_relaxed), std::memory_order_release);
+        if (state == State::Done)
+        {
+            complete(code);
+        }
+        else
+        {
+            state_.store(state, std::memory_order_release);
+        }
+    }
+
+    void AssetHandle::setAlias(std::shared_ptr<AssetHandle> source)
+    {
+        assert(source && source->success() && "source should be loaded successfully");
+        assert(source.get() != this && "asset handle can't alias itself");
+        data.reset();
+        reflection::TypeId typeId = source->typeId();
+        alias_ = std::move(source);
+        onSet(typeId);
+    }
+
+    bool AssetHandle::isAlias() const
+    {
+        return alias_ != nullptr;
     }
 
     void AssetHandle::setError(common::ResultCode code)
     {
         typeId_ = reflection::nullTypeId;
-        state_ = State::Done;
-        code_ = code;
         data.reset();
+        alias_.reset();
+        complete(code);
+    }
+
+    void AssetHandle::then(Continuation callback, common::IExecutor& executor)
+    {
+        {
+            std::lock_guard<std::mutex> guard(continuationsMutex);
+            if (!done())
+            {
+                continuations.emplace_back(std::move(callback), &executor);
+                return;
+            }
+        }
+
+        // already done
+        executor.execute([self = weak_from_this().lock(), this, callback = std::move(callback)]() {
+            callback(*this);
+        });
     }
 
     void AssetHandle::onSet(reflection::TypeId typeId)
     {
         typeId_ = typeId;
-        state_ = State::Done;
-        code_ = common::ResultCode::Success;
+        complete(common::ResultCode::Success);
+    }
+
+    void AssetHandle::complete(common::ResultCode code)
+    {
+        std::vector<std::pair<Continuation, common::IExecutor*>> current;
+        {
+            // lock, so that then() either observes the new state, or its callback gets called below
+            std::lock_guard<std::mutex> guard(continuationsMutex);
+            code_.store(code, std::memory_order_relaxed);
+            state_.store(State::Done, std::memory_order_release);
+            current.swap(continuations);
+        }
+
+        // keep the asset handle alive until the callbacks have been called
+        std::shared_ptr<AssetHandle> self = current.empty() ? nullptr : weak_from_this().lock();
+        for (auto& [callback, executor]: current)
+        {
+            executor->execute([self, this, callback = std::move(callback)]() {
+                callback(*this);
+            });
+        }
     }
 }
\ No newline at end of file
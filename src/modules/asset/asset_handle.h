@@ -8,11 +8,16 @@
 #include <string>
 
 #include <common/result.h>
+#include <common/executor.h>
 
 #include <renderer/mesh.h>
 #include <graphics/texture.h>
 #include <scene/scene.h>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <vector>
 #include <reflection/unique_any_pointer.h>
 
 #include "asset_id.h"
@@ -22,8 +27,12 @@ namespace asset
     /**
      * Contains a std::unique_ptr<Type> to an AssetHandleData
      * we could also store this as std::any
+     *
+     * The state is atomic, and gets set to Done last, so once state() returns Done (or valid() returns true),
+     * the data can be read from any thread. Use then() to get notified when the handle is done instead of
+     * checking it every frame.
      */
-    class AssetHandle final
+    class AssetHandle final : public std::enable_shared_from_this<AssetHandle>
     {
     public:
         enum class State
@@ -33,9 +42,14 @@ namespace asset
             Done
         };
 
-        // construct empty untyped AssetHandle
+        // gets called once the asset handle is done (successfully or not)
+        using Continuation = std::function<void(AssetHandle& handle)>;
+
+        // construct empty untyped AssetHandle, interns the asset id (see AssetKeyTable) while the asset handle exists
         explicit AssetHandle(AssetId id);
 
+        ~AssetHandle();
+
         // delete copy constructor and assignment operator
         AssetHandle(AssetHandle const&) = delete;
 
@@ -44,6 +58,9 @@ namespace asset
         //
         [[nodiscard]] AssetId const& id() const;
 
+        // interned key of id()
+        [[nodiscard]] AssetKey key() const;
+
         // to support casting from the AssetHandleBase to a AssetHandle<Type>, we store the typeId
         [[nodiscard]] reflection::TypeId typeId() const;
 
@@ -74,7 +91,7 @@ namespace asset
         template<typename Type>
         [[nodiscard]] bool valid() const
         {
-            if (state_ != State::Done || code_ != common::ResultCode::Success)
+            if (!success())
             {
                 return false;
             }
@@ -84,7 +101,7 @@ namespace asset
                 return false;
             }
 
-            if (!data)
+            if (!data && !alias_)
             {
                 return false;
             }
@@ -97,6 +114,10 @@ namespace asset
         [[nodiscard]] Type const& get() const
         {
             assert(valid<Type>() && "AssetHandle should be valid when calling get()");
+            if (alias_)
+            {
+                return alias_->get<Type>();
+            }
             return *data.get<Type>();
         }
 
@@ -105,6 +126,10 @@ namespace asset
         [[nodiscard]] Type& get()
         {
             assert(valid<Type>() && "AssetHandle should be valid when calling get()");
+            if (alias_)
+            {
+                return alias_->get<Type>();
+            }
             return *data.get<Type>();
         }
 
@@ -114,6 +139,7 @@ namespace asset
         {
             assert(data_ && "data should not be nullptr");
             data = std::move(data_);
+            alias_.reset();
             onSet(reflection::TypeIndex<Type>::value());
         }
 
@@ -121,24 +147,47 @@ namespace asset
         void set(Args&& ... args)
         {
             data = reflection::makeUniqueAny<Type>(std::forward<Args>(args)...);
+            alias_.reset();
             onSet(reflection::TypeIndex<Type>::value());
         }
 
         // swap the contents of this AssetHandle with the provided other AssetHandle
         void swap(std::shared_ptr<AssetHandle>& other);
 
+        // share the data of another (successfully loaded) asset handle instead of owning a copy,
+        // used for input files with identical contents. keeps `source` alive.
+        void setAlias(std::shared_ptr<AssetHandle> source);
+
+        // whether this asset handle shares the data of another asset handle
+        [[nodiscard]] bool isAlias() const;
+
         // set the asset handle into an error state, indicating that importing the asset with this AssetId was unsuccessful
         void setError(common::ResultCode code);
 
+        // calls the callback on the provided executor once the asset handle is done, or right away if it
+        // already is. each callback is called once, so not again when the asset gets reimported.
+        // if the asset handle is owned by a std::shared_ptr, it is kept alive until the callback has been called.
+        // pending callbacks are destroyed together with the asset handle, so the callback should not keep a
+        // std::shared_ptr to this asset handle (use a std::weak_ptr instead).
+        void then(Continuation callback, common::IExecutor& executor = common::InlineExecutor::shared());
+
     private:
         AssetId id_;
+        AssetKey key_;
         reflection::TypeId typeId_; // used for checking type at runtime for casting
-        State state_ = State::Uninitialized;
-        common::ResultCode code_ = common::ResultCode::Unknown;
+        std::atomic<State> state_ = State::Uninitialized;
+        std::atomic<common::ResultCode> code_ = common::ResultCode::Unknown;
 
         reflection::UniqueAnyPointer data;
+        std::shared_ptr<AssetHandle> alias_; // if set, data is empty
+
+        std::vector<std::pair<Continuation, common::IExecutor*>> continuations;
+        std::mutex continuationsMutex;
 
         void onSet(reflection::TypeId typeId);
+
+        // sets the state to Done and calls the continuations
+        void complete(common::ResultCode code);
     };
 
     // Asset is a shorthand for std::shared_ptr<AssetHandle>
@@ -4,6 +4,13 @@
 
 #include "asset_id.h"
 
+#include <common/application_info.h>
+#include <common/hash.h>
+#include <common/logger.h>
+
+#include <mutex>
+#include <cassert>
+
 namespace asset
 {
     std::string AssetId::string() const
@@ -11,9 +18,121 @@ namespace asset
         return "{ inputFilePath: " + inputFilePath.string() + ", artifactPath: " + artifactPath.string() + "}";
     }
 
+    // lexically_normal() allocates, so it only gets called for paths that could contain
+    // redundant elements (e.g. "a/./b", "a//b" or "a/../b")
+    [[nodiscard]] static bool maybeNotNormal(std::string_view path)
+    {
+        return path.find("./") != std::string_view::npos || path.find("//") != std::string_view::npos ||
+               path.ends_with("/.") || path.ends_with("/..") || path == "." || path == "..";
+    }
+
+    [[nodiscard]] static bool pathsEqual(std::filesystem::path const& lhs, std::filesystem::path const& rhs)
+    {
+        return lhs == rhs || lhs.lexically_normal() == rhs.lexically_normal();
+    }
+
     bool operator==(AssetId const& lhs, AssetId const& rhs)
     {
-        return lhs.artifactPath == rhs.artifactPath &&
-               lhs.inputFilePath == rhs.inputFilePath;
+        return pathsEqual(lhs.artifactPath, rhs.artifactPath) &&
+               pathsEqual(lhs.inputFilePath, rhs.inputFilePath);
+    }
+
+    // hashes the lexically normal path with '/' as separator, without copying it on platforms that already use it
+    static void hashPath(common::Hasher& hasher, std::filesystem::path const& path)
+    {
+#if defined(PLATFORM_WINDOWS)
+        hasher.update(path.lexically_normal().generic_string());
+#else
+        std::string const& native = path.native();
+        if (maybeNotNormal(native))
+        {
+            std::string const normal = path.lexically_normal().native();
+            hasher.update(normal.data(), normal.size());
+            return;
+        }
+        hasher.update(native.data(), native.size());
+#endif
+    }
+
+    uint64_t hash(AssetId const& id)
+    {
+        // separate the paths, so that e.g. {"ab", "c"} and {"a", "bc"} don't result in the same hash
+        uint8_t const separator = 0;
+        common::Hasher hasher;
+        hashPath(hasher, id.inputFilePath);
+        hasher.update(&separator, sizeof(separator));
+        hashPath(hasher, id.artifactPath);
+        return hasher.digest();
+    }
+
+    AssetKey::AssetKey(AssetId const& id) : value(hash(id))
+    {
+    }
+
+    AssetKeyTable& AssetKeyTable::shared()
+    {
+        static AssetKeyTable instance_;
+        return instance_;
+    }
+
+    AssetKey AssetKeyTable::intern(AssetId const& id)
+    {
+        uint64_t const key = hash(id);
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto existing = ids.find(key);
+            if (existing != ids.end())
+            {
+                if (!(existing->second.id == id))
+                {
+                    common::log::error("Asset key collision between {} and {}", existing->second.id.string(), id.string());
+                }
+                existing->second.references++;
+                return AssetKey(key);
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto [entry, inserted] = ids.try_emplace(key);
+        if (inserted)
+        {
+            entry->second.id = id;
+        }
+        entry->second.references++;
+        return AssetKey(key);
+    }
+
+    void AssetKeyTable::release(AssetKey key)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto entry = ids.find(key.value);
+        if (entry == ids.end())
+        {
+            assert(false && "asset key should have been interned");
+            return;
+        }
+
+        if (--entry->second.references == 0)
+        {
+            ids.erase(entry);
+        }
+    }
+
+    bool AssetKeyTable::find(AssetKey key, AssetId& out) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto entry = ids.find(key.value);
+        if (entry == ids.end())
+        {
+            return false;
+        }
+        out = entry->second.id;
+        return true;
+    }
+
+    size_t AssetKeyTable::size() const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return ids.size();
     }
-}
\ No newline at end of file
+}
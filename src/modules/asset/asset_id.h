@@ -6,6 +6,10 @@
 #define SHAPEREALITY_ASSET_ID_H
 
 #include <filesystem>
+#include <unordered_map>
+#include <shared_mutex>
+#include <atomic>
+#include <cstdint>
 
 namespace asset
 {
@@ -17,7 +21,68 @@ namespace asset
         [[nodiscard]] std::string string() const;
     };
 
+    // whether the lexically normal (see std::filesystem::path::lexically_normal) paths are equal
     [[nodiscard]] bool operator==(AssetId const& lhs, AssetId const& rhs);
+
+    // stable 64-bit hash of the lexically normal, generic paths of the asset id, the same on all platforms and runs
+    [[nodiscard]] uint64_t hash(AssetId const& id);
+
+    /**
+     * 64-bit key of an asset id (see hash()), so that hot paths (e.g. AssetDatabase::get) and components
+     * can refer to an asset without storing and hashing two paths.
+     *
+     * The asset id can be retrieved from the key while it is interned in the AssetKeyTable, which is the case
+     * while an AssetHandle with the asset id exists, or while the asset database knows the asset id
+     * (from importing its input file or from its asset archive).
+     */
+    struct AssetKey final
+    {
+        uint64_t value = 0;
+
+        AssetKey() = default;
+
+        // creates the key from an existing value, e.g. when deserializing. the asset id should have been interned
+        explicit AssetKey(uint64_t value_) : value(value_)
+        {
+        }
+
+        // hashes the asset id, does not intern it
+        explicit AssetKey(AssetId const& id);
+
+        [[nodiscard]] bool operator==(AssetKey const& rhs) const = default;
+
+        [[nodiscard]] auto operator<=>(AssetKey const& rhs) const = default;
+    };
+
+    // maps asset keys back to their asset ids, reference counted so that unused asset ids get removed. thread safe
+    class AssetKeyTable final
+    {
+    public:
+        [[nodiscard]] static AssetKeyTable& shared();
+
+        // returns the key of the asset id, stores the asset id if it was not stored yet and adds a reference to it.
+        // each call should be balanced by a call to release()
+        [[nodiscard]] AssetKey intern(AssetId const& id);
+
+        // removes a reference added by intern(), the asset id gets removed once no references are left
+        void release(AssetKey key);
+
+        // returns false if no asset id with this key was interned
+        [[nodiscard]] bool find(AssetKey key, AssetId& out) const;
+
+        // amount of interned asset ids
+        [[nodiscard]] size_t size() const;
+
+    private:
+        struct Entry
+        {
+            AssetId id;
+            std::atomic<size_t> references = 0; // incremented while holding a shared lock
+        };
+
+        std::unordered_map<uint64_t, Entry> ids;
+        mutable std::shared_mutex mutex;
+    };
 }
 
 // the c++ standard library shipped with XCode does not have the correct hash template
@@ -36,9 +101,16 @@ struct std::hash<asset::AssetId>
 {
     [[nodiscard]] size_t operator()(asset::AssetId const& id) const
     {
-        size_t inputFilePathHash = std::hash<std::filesystem::path>{}(id.inputFilePath);
-        size_t artifactPathHash = std::hash<std::filesystem::path>{}(id.artifactPath);
-        return inputFilePathHash ^ artifactPathHash;
+        return static_cast<size_t>(asset::hash(id));
+    }
+};
+
+template<>
+struct std::hash<asset::AssetKey>
+{
+    [[nodiscard]] size_t operator()(asset::AssetKey const& key) const
+    {
+        return static_cast<size_t>(key.value); // already a hash
     }
 };
 
@@ -0,0 +1,215 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "asset_residency.h"
+
+#include <algorithm>
+
+namespace asset
+{
+    inline void add(AssetMemory& lhs, AssetMemory const& rhs)
+    {
+        lhs.cpu += rhs.cpu;
+        lhs.device += rhs.device;
+    }
+
+    inline void subtract(AssetMemory& lhs, AssetMemory const& rhs)
+    {
+        lhs.cpu -= rhs.cpu;
+        lhs.device -= rhs.device;
+    }
+
+    AssetResidency::AssetResidency(AssetMemory budget) : budget_(budget)
+    {
+    }
+
+    Asset AssetResidency::wrap(Asset handle)
+    {
+        assert(handle && "handle should not be nullptr");
+        std::vector<Asset> destroy;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            auto entry = entries.find(handle->key());
+            if (entry != entries.end() && entry->second.handle != handle.get())
+            {
+                remove(entry, destroy); // replaced by a new handle, e.g. when reimporting
+            }
+            entries[handle->key()].handle = handle.get();
+        }
+
+        AssetHandle* pointer = handle.get();
+        return {pointer, [residency = weak_from_this(), handle = std::move(handle)](AssetHandle*) mutable {
+            if (std::shared_ptr<AssetResidency> r = residency.lock())
+            {
+                r->release(std::move(handle));
+            }
+        }};
+    }
+
+    Asset AssetResidency::acquire(AssetKey key)
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        auto entry = entries.find(key);
+        if (entry == entries.end() || !entry->second.retained)
+        {
+            return nullptr;
+        }
+
+        Entry& e = entry->second;
+        lru.erase(e.lru);
+        subtract(retained_, e.memory);
+        return std::move(e.retained);
+    }
+
+    void AssetResidency::update(AssetHandle const& handle, reflection::TypeId typeId, AssetMemory memory)
+    {
+        std::vector<Asset> destroy;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            auto entry = entries.find(handle.key());
+            if (entry == entries.end() || entry->second.handle != &handle)
+            {
+                return;
+            }
+
+            Entry& e = entry->second;
+            if (e.tracked)
+            {
+                subtract(resident_, e.memory);
+            }
+            e.typeId = typeId;
+            e.memory = memory;
+            e.tracked = true;
+            add(resident_, memory);
+            evict(destroy);
+        }
+    }
+
+    void AssetResidency::erase(AssetKey key)
+    {
+        std::vector<Asset> destroy;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            auto entry = entries.find(key);
+            if (entry != entries.end())
+            {
+                remove(entry, destroy);
+            }
+        }
+    }
+
+    void AssetResidency::setBudget(AssetMemory budget)
+    {
+        std::vector<Asset> destroy;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            budget_ = budget;
+            evict(destroy);
+        }
+    }
+
+    AssetMemory AssetResidency::budget() const
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        return budget_;
+    }
+
+    AssetMemory AssetResidency::resident() const
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        return resident_;
+    }
+
+    AssetMemory AssetResidency::retained() const
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        return retained_;
+    }
+
+    std::vector<AssetTypeMemoryStatistics> AssetResidency::statistics() const
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        std::vector<AssetTypeMemoryStatistics> out;
+        for (auto& [id, entry]: entries)
+        {
+            if (!entry.tracked)
+            {
+                continue;
+            }
+
+            auto it = std::find_if(out.begin(), out.end(), [&](auto& s) { return s.typeId == entry.typeId; });
+            if (it == out.end())
+            {
+                it = out.insert(out.end(), AssetTypeMemoryStatistics{.typeId = entry.typeId});
+            }
+
+            it->count++;
+            add(it->resident, entry.memory);
+            if (entry.retained)
+            {
+                it->retainedCount++;
+                add(it->retained, entry.memory);
+            }
+        }
+        return out;
+    }
+
+    void AssetResidency::release(Asset handle)
+    {
+        std::vector<Asset> destroy;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            auto entry = entries.find(handle->key());
+            if (entry == entries.end() || entry->second.handle != handle.get())
+            {
+                // no longer tracked, or replaced by a new handle
+            }
+            else if (!entry->second.tracked || !handle->success())
+            {
+                // unknown memory usage, or failed to load (which should be retried on the next get)
+                remove(entry, destroy);
+            }
+            else
+            {
+                Entry& e = entry->second;
+                lru.push_front(entry->first);
+                e.lru = lru.begin();
+                e.retained = std::move(handle);
+                add(retained_, e.memory);
+                evict(destroy);
+            }
+        }
+        // handle and destroy get destroyed here, outside the lock
+    }
+
+    void AssetResidency::evict(std::vector<Asset>& out)
+    {
+        while (exceedsBudget() && !lru.empty())
+        {
+            remove(entries.find(lru.back()), out);
+        }
+    }
+
+    void AssetResidency::remove(std::unordered_map<AssetKey, Entry>::iterator entry, std::vector<Asset>& out)
+    {
+        Entry& e = entry->second;
+        if (e.tracked)
+        {
+            subtract(resident_, e.memory);
+        }
+
+        if (e.retained)
+        {
+            subtract(retained_, e.memory);
+            lru.erase(e.lru);
+            out.emplace_back(std::move(e.retained));
+        }
+        entries.erase(entry);
+    }
+
+    bool AssetResidency::exceedsBudget() const
+    {
+        return resident_.cpu > budget_.cpu || resident_.device > budget_.device;
+    }
+}
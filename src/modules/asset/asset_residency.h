@@ -0,0 +1,106 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_ASSET_RESIDENCY_H
+#define SHAPEREALITY_ASSET_RESIDENCY_H
+
+#include "asset_id.h"
+#include "asset_handle.h"
+#include "asset_type.h"
+
+#include <reflection/type_id.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace asset
+{
+    struct AssetTypeMemoryStatistics
+    {
+        reflection::TypeId typeId = reflection::nullTypeId;
+        size_t count = 0; // amount of resident assets (referenced or retained)
+        size_t retainedCount = 0; // amount of assets that are only kept alive by the retention cache
+        AssetMemory resident; // memory of all resident assets, including retained assets
+        AssetMemory retained;
+    };
+
+    /**
+     * Keeps track of the memory of loaded assets, and retains assets after the last reference
+     * to them has been released, so that getting the same asset again does not require loading it.
+     *
+     * Retained assets are evicted in least recently released order once the resident memory
+     * (referenced + retained) exceeds the budget. Referenced assets are never evicted.
+     *
+     * The asset handles given out by the AssetDatabase are wrapped using wrap(), which returns
+     * the handle to the retention cache instead of destroying it.
+     */
+    class AssetResidency final : public std::enable_shared_from_this<AssetResidency>
+    {
+    public:
+        explicit AssetResidency(AssetMemory budget);
+
+        // returns a handle that shares the provided handle, and gives the handle to release()
+        // once all references to the returned handle have been released
+        [[nodiscard]] Asset wrap(Asset handle);
+
+        // removes the handle from the retention cache and returns it,
+        // returns nullptr if no handle with the provided key is retained
+        [[nodiscard]] Asset acquire(AssetKey key);
+
+        // sets the memory of a loaded (or reloaded) handle, evicts if this exceeds the budget
+        void update(AssetHandle const& handle, reflection::TypeId typeId, AssetMemory memory);
+
+        // stops tracking the handle with the provided key, e.g. when it gets replaced by a new handle
+        void erase(AssetKey key);
+
+        // evicts retained handles until the resident memory fits inside the new budget
+        void setBudget(AssetMemory budget);
+
+        [[nodiscard]] AssetMemory budget() const;
+
+        // memory of all tracked handles (referenced and retained)
+        [[nodiscard]] AssetMemory resident() const;
+
+        // memory of the handles in the retention cache
+        [[nodiscard]] AssetMemory retained() const;
+
+        [[nodiscard]] std::vector<AssetTypeMemoryStatistics> statistics() const;
+
+    private:
+        struct Entry
+        {
+            AssetHandle const* handle = nullptr; // the handle that is currently tracked for this key
+            reflection::TypeId typeId = reflection::nullTypeId;
+            AssetMemory memory;
+            bool tracked = false; // whether memory has been set using update(), only tracked handles get retained
+            Asset retained; // set when no references remain
+            std::list<AssetKey>::iterator lru; // only valid if retained
+        };
+
+        AssetMemory budget_;
+        AssetMemory resident_;
+        AssetMemory retained_;
+        std::unordered_map<AssetKey, Entry> entries;
+        std::list<AssetKey> lru; // front is the most recently released
+        mutable std::mutex mutex;
+
+        // gets called when all references returned by wrap() have been released
+        void release(Asset handle);
+
+        // removes least recently released handles until the resident memory fits inside the budget.
+        // the evicted handles are moved to `out`, so that they can be destroyed after unlocking, as
+        // destroying an asset can release other assets (e.g. the textures of a material).
+        void evict(std::vector<Asset>& out);
+
+        // removes the entry and moves its retained handle to `out`
+        void remove(std::unordered_map<AssetKey, Entry>::iterator entry, std::vector<Asset>& out);
+
+        [[nodiscard]] bool exceedsBudget() const;
+    };
+}
+
+#endif //SHAPEREALITY_ASSET_RESIDENCY_H
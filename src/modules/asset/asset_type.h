@@ -6,10 +6,25 @@
 #define SHAPEREALITY_ASSET_TYPE_H
 
 #include <string>
+#include <functional>
+#include <span>
+#include <cstdint>
+#include <iosfwd>
 #include <fmt/format.h>
 
 namespace asset
 {
+    class AssetHandle;
+
+    struct AssetDatabaseContext;
+
+    // memory used by an asset, in bytes
+    struct AssetMemory
+    {
+        size_t cpu = 0;
+        size_t device = 0; // e.g. vertex buffers and textures on the GPU
+    };
+
     /*
      * data for deserializing and serializing a specific asset
      * type. gets registered in a `AssetInfoRegistry`
@@ -17,6 +32,22 @@ namespace asset
     struct AssetType
     {
         std::string const fileExtension;
+
+        // optional, writes the data of an asset of this type to a native binary artifact in the import cache.
+        // if not set, input files that produce this asset type are always reimported.
+        std::function<bool(AssetHandle& asset, std::ostream& out)> save;
+
+        // optional, loads a native binary artifact written by `save` into `asset`
+        std::function<bool(AssetDatabaseContext const& context, std::istream& in, AssetHandle& asset)> load;
+
+        // optional, loads a native binary artifact written by `save` from memory (e.g. a memory mapped asset archive)
+        // without copying it first. the memory is only valid during the call. if not set, `load` is used instead.
+        std::function<bool(AssetDatabaseContext const& context, std::span<uint8_t const> data,
+                           AssetHandle& asset)> loadFromMemory;
+
+        // optional, returns the memory used by an asset of this type. if not set, assets of this type
+        // are not retained after they are released, as they can't be accounted for in the memory budget.
+        std::function<AssetMemory(AssetHandle& asset)> memoryUsage;
     };
 }
 
@@ -30,4 +30,16 @@ namespace asset
         assert(assetTypes.contains(typeId) && "AssetType should be registered");
         return assetTypes.at(typeId);
     }
-}
\ No newline at end of file
+
+    reflection::TypeId AssetTypeRegistry::typeIdFromExtension(std::string const& fileExtension) const
+    {
+        for (auto& [typeId, assetType]: assetTypes)
+        {
+            if (assetType.fileExtension == fileExtension)
+            {
+                return typeId;
+            }
+        }
+        return reflection::nullTypeId;
+    }
+}
@@ -51,6 +51,10 @@ namespace asset
             return get(typeId);
         }
 
+        // returns the type id of the asset type with the provided file extension (without leading dot),
+        // or nullTypeId if no asset type with that extension was registered
+        [[nodiscard]] reflection::TypeId typeIdFromExtension(std::string const& fileExtension) const;
+
         // convenience function for making an asset id for a given artifact name with a specific type
         // automatically adds the file extension
         template<typename Type, typename... Args>
@@ -0,0 +1,234 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "file_watcher.h"
+
+#include <common/logger.h>
+
+#include <set>
+#include <cstring>
+
+#if defined(PLATFORM_LINUX)
+
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+
+#endif
+
+namespace asset
+{
+#if defined(PLATFORM_LINUX)
+
+    constexpr uint32_t kWatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE;
+
+    FileWatcher::FileWatcher(std::filesystem::path directory_, Callback callback_, OverflowCallback overflowCallback_,
+                             std::chrono::milliseconds debounce_)
+        : directory(std::move(directory_)), callback(std::move(callback_)),
+          overflowCallback(std::move(overflowCallback_)), debounce(debounce_)
+    {
+        fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd < 0 || stopFd < 0)
+        {
+            common::log::error("Failed to create file watcher for {} ({})", directory.string(), std::strerror(errno));
+            return;
+        }
+
+        std::vector<std::filesystem::path> existingFiles;
+        addWatches({}, existingFiles);
+        thread = std::thread(&FileWatcher::run, this);
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        if (thread.joinable())
+        {
+            uint64_t value = 1;
+            [[maybe_unused]] ssize_t written = write(stopFd, &value, sizeof(value));
+            thread.join();
+        }
+
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+
+        if (stopFd >= 0)
+        {
+            close(stopFd);
+        }
+    }
+
+    bool FileWatcher::supported()
+    {
+        return true;
+    }
+
+    bool FileWatcher::valid() const
+    {
+        return thread.joinable();
+    }
+
+    void FileWatcher::addWatches(std::filesystem::path const& relativeDirectory, std::vector<std::filesystem::path>& files)
+    {
+        std::filesystem::path const path = directory / relativeDirectory;
+        int watch = inotify_add_watch(fd, path.c_str(), kWatchMask | IN_ONLYDIR);
+        if (watch < 0)
+        {
+            common::log::warning("Failed to watch directory {} ({})", path.string(), std::strerror(errno));
+            return;
+        }
+        watches[watch] = relativeDirectory;
+
+        std::error_code error;
+        for (auto const& entry: std::filesystem::directory_iterator(path, error))
+        {
+            std::filesystem::path const relativePath = relativeDirectory / entry.path().filename();
+            if (entry.is_directory(error))
+            {
+                addWatches(relativePath, files);
+            }
+            else
+            {
+                files.emplace_back(relativePath);
+            }
+        }
+    }
+
+    void FileWatcher::run()
+    {
+        using clock = std::chrono::steady_clock;
+
+        std::set<std::filesystem::path> changed; // ordered, so that the callback gets the files in a stable order
+        bool overflowed = false;
+        clock::time_point lastChange{};
+
+        alignas(inotify_event) char buffer[4096];
+        while (true)
+        {
+            // wait indefinitely if nothing changed, otherwise until the debounce duration has passed
+            int timeout = -1;
+            if (!changed.empty() || overflowed)
+            {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(lastChange + debounce - clock::now());
+                timeout = static_cast<int>(std::max<int64_t>(remaining.count(), 0));
+            }
+
+            pollfd fds[2]{
+                {.fd = fd, .events = POLLIN, .revents = 0},
+                {.fd = stopFd, .events = POLLIN, .revents = 0}
+            };
+            int count = poll(fds, 2, timeout);
+            if (count < 0 && errno != EINTR)
+            {
+                common::log::error("File watcher for {} stopped ({})", directory.string(), std::strerror(errno));
+                return;
+            }
+
+            if (fds[1].revents & POLLIN)
+            {
+                return; // stop
+            }
+
+            if (fds[0].revents & POLLIN)
+            {
+                ssize_t size;
+                while ((size = read(fd, buffer, sizeof(buffer))) > 0)
+                {
+                    for (char* p = buffer; p < buffer + size;)
+                    {
+                        auto* event = reinterpret_cast<inotify_event*>(p);
+                        p += sizeof(inotify_event) + event->len;
+
+                        if (event->mask & IN_Q_OVERFLOW)
+                        {
+                            common::log::warning("File watcher for {} dropped events, rescanning", directory.string());
+                            overflowed = true;
+                            continue;
+                        }
+
+                        if (event->mask & IN_IGNORED)
+                        {
+                            watches.erase(event->wd); // watched directory was removed
+                            continue;
+                        }
+
+                        if (!watches.contains(event->wd) || event->len == 0)
+                        {
+                            continue;
+                        }
+
+                        std::filesystem::path const relativePath = watches.at(event->wd) / event->name;
+                        if (event->mask & IN_ISDIR)
+                        {
+                            if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                            {
+                                std::vector<std::filesystem::path> files;
+                                addWatches(relativePath, files);
+                                changed.insert(files.begin(), files.end());
+                            }
+                        }
+                        else if (!(event->mask & IN_CREATE)) // wait for IN_CLOSE_WRITE instead
+                        {
+                            changed.insert(relativePath);
+                        }
+                    }
+                }
+                lastChange = clock::now();
+            }
+
+            if ((!changed.empty() || overflowed) && clock::now() - lastChange >= debounce)
+            {
+                if (!changed.empty())
+                {
+                    std::vector<std::filesystem::path> files(changed.begin(), changed.end());
+                    changed.clear();
+                    callback(files);
+                }
+
+                if (overflowed)
+                {
+                    // directories that were created while events were dropped aren't watched yet
+                    overflowed = false;
+                    std::vector<std::filesystem::path> files;
+                    addWatches({}, files);
+                    if (overflowCallback)
+                    {
+                        overflowCallback();
+                    }
+                }
+            }
+        }
+    }
+
+#else
+
+    FileWatcher::FileWatcher(std::filesystem::path directory_, Callback callback_, OverflowCallback overflowCallback_,
+                             std::chrono::milliseconds debounce_)
+        : directory(std::move(directory_)), callback(std::move(callback_)),
+          overflowCallback(std::move(overflowCallback_)), debounce(debounce_)
+    {
+        common::log::warning("Watching {} is not supported on this platform", directory.string());
+    }
+
+    FileWatcher::~FileWatcher() = default;
+
+    bool FileWatcher::supported()
+    {
+        return false;
+    }
+
+    bool FileWatcher::valid() const
+    {
+        return false;
+    }
+
+    void FileWatcher::run()
+    {
+    }
+
+#endif
+}
@@ -0,0 +1,80 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_FILE_WATCHER_H
+#define SHAPEREALITY_FILE_WATCHER_H
+
+#include <common/application_info.h>
+
+#include <filesystem>
+#include <functional>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+
+namespace asset
+{
+    /**
+     * Watches a directory (recursively) for modified, created, moved and deleted files on a background thread.
+     *
+     * Changes are debounced and coalesced: the callback gets called once no new changes have come in for
+     * the debounce duration, with each changed file at most once. This avoids importing a file that is still
+     * being written, or importing the same file multiple times when an application saves it in multiple steps.
+     *
+     * The callbacks are called from the background thread.
+     *
+     * Only implemented on Linux (inotify), on other platforms valid() returns false.
+     */
+    class FileWatcher final
+    {
+    public:
+        // changed file paths, relative to the watched directory
+        using Callback = std::function<void(std::vector<std::filesystem::path> const& files)>;
+
+        // called when the operating system dropped events (e.g. when too many files changed at once),
+        // so changes could have been missed and the receiver should compare the files against its own state
+        using OverflowCallback = std::function<void()>;
+
+        constexpr static std::chrono::milliseconds kDefaultDebounce{100};
+
+        explicit FileWatcher(std::filesystem::path directory, Callback callback, OverflowCallback overflowCallback,
+                             std::chrono::milliseconds debounce = kDefaultDebounce);
+
+        // whether watching is implemented on this platform
+        [[nodiscard]] static bool supported();
+
+        // stops watching and waits for the background thread to exit
+        ~FileWatcher();
+
+        FileWatcher(FileWatcher const&) = delete;
+
+        FileWatcher& operator=(FileWatcher const&) = delete;
+
+        // whether the directory is being watched
+        [[nodiscard]] bool valid() const;
+
+    private:
+        std::filesystem::path directory;
+        Callback callback;
+        OverflowCallback overflowCallback;
+        std::chrono::milliseconds debounce;
+        std::thread thread;
+
+#if defined(PLATFORM_LINUX)
+        int fd = -1; // inotify instance
+        int stopFd = -1; // eventfd for waking up the background thread when stopping
+        std::unordered_map<int, std::filesystem::path> watches; // watch descriptor to directory relative to `directory`
+
+        // adds watches for the directory and all its subdirectories, returns the files inside
+        // (as these could have been created before the watch was added)
+        void addWatches(std::filesystem::path const& relativeDirectory, std::vector<std::filesystem::path>& files);
+#endif
+
+        void run();
+    };
+}
+
+#endif //SHAPEREALITY_FILE_WATCHER_H
@@ -25,13 +25,25 @@ namespace asset
 
     void fileTimeFromJson(nlohmann::json const& in, std::filesystem::file_time_type* out)
     {
-        unsigned int timeSinceEpoch = in.get<unsigned int>();
+        // file times have nanosecond precision on most platforms, so these don't fit in 32 bits
+        auto timeSinceEpoch = in.get<std::filesystem::file_time_type::rep>();
         *out = std::filesystem::file_time_type() + std::filesystem::file_time_type::duration(timeSinceEpoch);
     }
 
     void fileTimeToJson(std::filesystem::file_time_type* in, nlohmann::json& out)
     {
-        out = static_cast<unsigned int>(in->time_since_epoch().count());
+        out = in->time_since_epoch().count();
+    }
+
+    // stored as a single 64-bit number, the asset id gets interned separately (e.g. when importing or opening an archive)
+    void assetKeyFromJson(nlohmann::json const& in, AssetKey* out)
+    {
+        *out = AssetKey(in.get<uint64_t>());
+    }
+
+    void assetKeyToJson(AssetKey* in, nlohmann::json& out)
+    {
+        out = in->value;
     }
 
     void register_(reflection::Reflection& reflection)
@@ -42,11 +54,16 @@ namespace asset
         reflection.types.emplace<std::filesystem::file_time_type>(std::make_unique<reflection::PrimitiveInfo>("FileTimeType"));
         reflection.json.emplace<std::filesystem::file_time_type>(fileTimeFromJson, fileTimeToJson);
 
+        reflection.types.emplace<AssetKey>(std::make_unique<reflection::PrimitiveInfo>("AssetKey"));
+        reflection.json.emplace<AssetKey>(assetKeyFromJson, assetKeyToJson);
+
         reflection::register_::Class<ImportResultCache>("ImportResultCache")
             .member<&ImportResultCache::inputFilePath>("inputFilePath")
             .member<&ImportResultCache::lastWriteTime>("lastWriteTime")
             .member<&ImportResultCache::dependencies>("dependencies")
+            .member<&ImportResultCache::dependencyLastWriteTimes>("dependencyLastWriteTimes")
             .member<&ImportResultCache::artifacts>("artifacts")
+            .member<&ImportResultCache::contentHash>("contentHash")
             .emplace(reflection.types);
 
         reflection::register_::Class<AssetId>("AssetId")
@@ -0,0 +1,184 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_COMMON_BINARY_H
+#define SHAPEREALITY_COMMON_BINARY_H
+
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <streambuf>
+#include <type_traits>
+
+// helpers for reading and writing native binary files (native endianness, no versioning, that is up to the caller)
+namespace common::binary
+{
+    template<typename Type>
+    requires std::is_trivially_copyable_v<Type>
+    void write(std::ostream& out, Type const& value)
+    {
+        out.write(reinterpret_cast<char const*>(&value), sizeof(Type));
+    }
+
+    template<typename Type>
+    requires std::is_trivially_copyable_v<Type>
+    [[nodiscard]] bool read(std::istream& in, Type& value)
+    {
+        in.read(reinterpret_cast<char*>(&value), sizeof(Type));
+        return !in.fail();
+    }
+
+    // writes a contiguous block of trivially copyable values (without its size)
+    template<typename Type>
+    requires std::is_trivially_copyable_v<Type>
+    void writeBlock(std::ostream& out, std::vector<Type> const& values)
+    {
+        out.write(reinterpret_cast<char const*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(Type)));
+    }
+
+    // number of bytes left in the stream, so that sizes read from a file can be checked before allocating
+    // memory for them. returns the maximum value if the stream is not seekable
+    [[nodiscard]] inline uint64_t remaining(std::istream& in)
+    {
+        std::istream::pos_type const position = in.tellg();
+        if (position == std::istream::pos_type(-1))
+        {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        in.seekg(0, std::ios_base::end);
+        std::istream::pos_type const end = in.tellg();
+        in.seekg(position);
+        if (end == std::istream::pos_type(-1) || end < position)
+        {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        return static_cast<uint64_t>(end - position);
+    }
+
+    // reads `count` values directly into the vector's memory
+    template<typename Type>
+    requires std::is_trivially_copyable_v<Type>
+    [[nodiscard]] bool readBlock(std::istream& in, std::vector<Type>& values, size_t count)
+    {
+        if (count > remaining(in) / sizeof(Type))
+        {
+            in.setstate(std::ios_base::failbit);
+            return false; // error: corrupt size, larger than the rest of the stream
+        }
+        values.resize(count);
+        in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(Type)));
+        return !in.fail();
+    }
+
+    // writes the size of the string, followed by its characters
+    inline void writeString(std::ostream& out, std::string const& value)
+    {
+        write(out, static_cast<uint64_t>(value.size()));
+        out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    [[nodiscard]] inline bool readString(std::istream& in, std::string& value)
+    {
+        uint64_t size = 0;
+        if (!read(in, size))
+        {
+            return false;
+        }
+        if (size > remaining(in))
+        {
+            in.setstate(std::ios_base::failbit);
+            return false;
+        }
+        value.resize(size);
+        in.read(value.data(), static_cast<std::streamsize>(size));
+        return !in.fail();
+    }
+
+    // reads from a contiguous block of memory (e.g. a memory mapped file), blocks are returned as views
+    // into the memory instead of being copied
+    class MemoryReader final
+    {
+    public:
+        explicit MemoryReader(std::span<uint8_t const> data_) : data(data_)
+        {
+        }
+
+        template<typename Type>
+        requires std::is_trivially_copyable_v<Type>
+        [[nodiscard]] bool read(Type& value)
+        {
+            if (remaining() < sizeof(Type))
+            {
+                return false;
+            }
+            std::memcpy(&value, data.data() + offset, sizeof(Type)); // the memory is not necessarily aligned
+            offset += sizeof(Type);
+            return true;
+        }
+
+        // returns a view of the next `size` bytes
+        [[nodiscard]] bool readBlock(size_t size, std::span<uint8_t const>& out)
+        {
+            if (remaining() < size)
+            {
+                return false;
+            }
+            out = data.subspan(offset, size);
+            offset += size;
+            return true;
+        }
+
+        [[nodiscard]] size_t remaining() const
+        {
+            return data.size() - offset;
+        }
+
+    private:
+        std::span<uint8_t const> data;
+        size_t offset = 0;
+    };
+
+    // read-only stream buffer over a contiguous block of memory, so that a std::istream can read from it
+    // without copying the memory first
+    class MemoryStreamBuffer final : public std::streambuf
+    {
+    public:
+        explicit MemoryStreamBuffer(std::span<uint8_t const> data)
+        {
+            // std::streambuf requires non-const pointers, but the get area is never written to
+            char* begin = const_cast<char*>(reinterpret_cast<char const*>(data.data()));
+            setg(begin, begin, begin + data.size());
+        }
+
+    protected:
+        pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override
+        {
+            if ((which & std::ios_base::in) == 0)
+            {
+                return pos_type(off_type(-1));
+            }
+
+            char* base = direction == std::ios_base::beg ? eback() : direction == std::ios_base::cur ? gptr() : egptr();
+            off_type const position = (base - eback()) + offset;
+            if (position < 0 || position > egptr() - eback())
+            {
+                return pos_type(off_type(-1));
+            }
+            setg(eback(), eback() + position, egptr());
+            return pos_type(position);
+        }
+
+        pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+        {
+            return seekoff(off_type(position), std::ios_base::beg, which);
+        }
+    };
+}
+
+#endif //SHAPEREALITY_COMMON_BINARY_H
@@ -0,0 +1,41 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "executor.h"
+
+namespace common
+{
+    InlineExecutor& InlineExecutor::shared()
+    {
+        static InlineExecutor instance_;
+        return instance_;
+    }
+
+    void InlineExecutor::execute(std::function<void()> task)
+    {
+        task();
+    }
+
+    void MainThreadExecutor::execute(std::function<void()> task)
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        tasks.emplace_back(std::move(task));
+    }
+
+    size_t MainThreadExecutor::drain()
+    {
+        std::vector<std::function<void()>> current;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            current.swap(tasks);
+        }
+
+        // run outside the lock, so that tasks can queue new tasks
+        for (auto& task: current)
+        {
+            task();
+        }
+        return current.size();
+    }
+}
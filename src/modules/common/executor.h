@@ -0,0 +1,52 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_EXECUTOR_H
+#define SHAPEREALITY_EXECUTOR_H
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace common
+{
+    // decides on which thread (and when) a task gets run, e.g. for continuations of asynchronous work
+    class IExecutor
+    {
+    public:
+        virtual ~IExecutor() = default;
+
+        virtual void execute(std::function<void()> task) = 0;
+    };
+
+    // runs the task immediately on the calling thread
+    class InlineExecutor final : public IExecutor
+    {
+    public:
+        [[nodiscard]] static InlineExecutor& shared();
+
+        void execute(std::function<void()> task) override;
+    };
+
+    /**
+     * Queues tasks from any thread, which get run on the thread that calls drain(),
+     * e.g. once per frame on the main thread, so that the tasks can safely access
+     * state that is only accessed from the main thread (e.g. the scene).
+     */
+    class MainThreadExecutor final : public IExecutor
+    {
+    public:
+        void execute(std::function<void()> task) override;
+
+        // runs the queued tasks, tasks that get queued while draining are run on the next call to drain()
+        // returns the amount of tasks that were run
+        size_t drain();
+
+    private:
+        std::vector<std::function<void()>> tasks;
+        std::mutex mutex;
+    };
+}
+
+#endif //SHAPEREALITY_EXECUTOR_H
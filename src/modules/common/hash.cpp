@@ -0,0 +1,209 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "hash.h"
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <bit>
+
+#include <fmt/format.h>
+
+namespace common
+{
+    constexpr uint64_t kPrime1 = 11400714785074694791ULL;
+    constexpr uint64_t kPrime2 = 14029467366897019727ULL;
+    constexpr uint64_t kPrime3 = 1609587929392839161ULL;
+    constexpr uint64_t kPrime4 = 9650029242287828579ULL;
+    constexpr uint64_t kPrime5 = 2870177450012600261ULL;
+
+    // the hash is defined on little endian input, reading the native representation is fine for the platforms we target
+    static_assert(std::endian::native == std::endian::little);
+
+    [[nodiscard]] inline uint64_t read64(uint8_t const* data)
+    {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(uint64_t));
+        return value;
+    }
+
+    [[nodiscard]] inline uint32_t read32(uint8_t const* data)
+    {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(uint32_t));
+        return value;
+    }
+
+    [[nodiscard]] inline uint64_t round(uint64_t accumulator, uint64_t input)
+    {
+        accumulator += input * kPrime2;
+        accumulator = std::rotl(accumulator, 31);
+        return accumulator * kPrime1;
+    }
+
+    [[nodiscard]] inline uint64_t mergeRound(uint64_t accumulator, uint64_t value)
+    {
+        accumulator ^= round(0, value);
+        return accumulator * kPrime1 + kPrime4;
+    }
+
+    // processes as many full 32 byte stripes as possible, returns the amount of bytes consumed
+    inline size_t consumeStripes(uint64_t (& accumulators)[4], uint8_t const* data, size_t size)
+    {
+        uint64_t v1 = accumulators[0];
+        uint64_t v2 = accumulators[1];
+        uint64_t v3 = accumulators[2];
+        uint64_t v4 = accumulators[3];
+
+        size_t offset = 0;
+        for (; offset + 32 <= size; offset += 32)
+        {
+            v1 = round(v1, read64(data + offset));
+            v2 = round(v2, read64(data + offset + 8));
+            v3 = round(v3, read64(data + offset + 16));
+            v4 = round(v4, read64(data + offset + 24));
+        }
+
+        accumulators[0] = v1;
+        accumulators[1] = v2;
+        accumulators[2] = v3;
+        accumulators[3] = v4;
+        return offset;
+    }
+
+    Hasher::Hasher(uint64_t seed_) : seed(seed_), accumulators{
+        seed_ + kPrime1 + kPrime2,
+        seed_ + kPrime2,
+        seed_,
+        seed_ - kPrime1
+    }, buffer{}
+    {
+    }
+
+    void Hasher::update(void const* data_, size_t size)
+    {
+        auto const* data = static_cast<uint8_t const*>(data_);
+        totalSize += size;
+
+        // fill up the buffer first
+        if (bufferSize > 0)
+        {
+            size_t const count = std::min(size, sizeof(buffer) - bufferSize);
+            std::memcpy(buffer + bufferSize, data, count);
+            bufferSize += count;
+            data += count;
+            size -= count;
+
+            if (bufferSize < sizeof(buffer))
+            {
+                return;
+            }
+            consumeStripes(accumulators, buffer, sizeof(buffer));
+            bufferSize = 0;
+        }
+
+        size_t const consumed = consumeStripes(accumulators, data, size);
+
+        // store the remainder for the next call to update() or digest()
+        std::memcpy(buffer, data + consumed, size - consumed);
+        bufferSize = size - consumed;
+    }
+
+    void Hasher::update(std::string const& string)
+    {
+        update(string.data(), string.size());
+    }
+
+    uint64_t Hasher::digest() const
+    {
+        uint64_t h;
+        if (totalSize >= 32)
+        {
+            h = std::rotl(accumulators[0], 1) + std::rotl(accumulators[1], 7) +
+                std::rotl(accumulators[2], 12) + std::rotl(accumulators[3], 18);
+            for (uint64_t accumulator: accumulators)
+            {
+                h = mergeRound(h, accumulator);
+            }
+        }
+        else
+        {
+            h = seed + kPrime5;
+        }
+        h += totalSize;
+
+        // remaining bytes that did not fill a full stripe
+        uint8_t const* data = buffer;
+        size_t remaining = bufferSize;
+        for (; remaining >= 8; data += 8, remaining -= 8)
+        {
+            h ^= round(0, read64(data));
+            h = std::rotl(h, 27) * kPrime1 + kPrime4;
+        }
+
+        if (remaining >= 4)
+        {
+            h ^= static_cast<uint64_t>(read32(data)) * kPrime1;
+            h = std::rotl(h, 23) * kPrime2 + kPrime3;
+            data += 4;
+            remaining -= 4;
+        }
+
+        for (; remaining > 0; data++, remaining--)
+        {
+            h ^= (*data) * kPrime5;
+            h = std::rotl(h, 11) * kPrime1;
+        }
+
+        // avalanche
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    uint64_t hash(void const* data, size_t size, uint64_t seed)
+    {
+        Hasher hasher(seed);
+        hasher.update(data, size);
+        return hasher.digest();
+    }
+
+    bool hashFile(std::filesystem::path const& path, Hasher& hasher)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        // read in large chunks, so that hashing is not bound by the amount of read calls
+        std::vector<char> chunk(1 << 16);
+        while (file)
+        {
+            file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            hasher.update(chunk.data(), static_cast<size_t>(file.gcount()));
+        }
+        return file.eof();
+    }
+
+    std::string toHexString(uint64_t hash)
+    {
+        return fmt::format("{:016x}", hash);
+    }
+
+    bool fromHexString(std::string const& string, uint64_t& out)
+    {
+        if (string.size() != 16)
+        {
+            return false;
+        }
+        auto const [end, error] = std::from_chars(string.data(), string.data() + string.size(), out, 16);
+        return error == std::errc() && end == string.data() + string.size();
+    }
+}
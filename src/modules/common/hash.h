@@ -0,0 +1,57 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_COMMON_HASH_H
+#define SHAPEREALITY_COMMON_HASH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <filesystem>
+
+namespace common
+{
+    /**
+     * Streaming 64-bit non-cryptographic content hash (XXH64).
+     *
+     * Input is consumed in 32 byte stripes by four independent accumulators, so that the
+     * multiplications don't depend on each other and the throughput is bound by memory bandwidth
+     * rather than latency. The result is the same regardless of how the input is split over calls to update().
+     *
+     * Used for detecting changed or duplicate files, not for security.
+     */
+    class Hasher final
+    {
+    public:
+        explicit Hasher(uint64_t seed = 0);
+
+        void update(void const* data, size_t size);
+
+        void update(std::string const& string);
+
+        // returns the hash of all data passed to update() so far, does not modify the state
+        [[nodiscard]] uint64_t digest() const;
+
+    private:
+        uint64_t seed;
+        uint64_t accumulators[4];
+        uint8_t buffer[32];
+        size_t bufferSize = 0;
+        uint64_t totalSize = 0;
+    };
+
+    [[nodiscard]] uint64_t hash(void const* data, size_t size, uint64_t seed = 0);
+
+    // streams the contents of the file at the provided path into the hasher,
+    // returns false if the file could not be read
+    [[nodiscard]] bool hashFile(std::filesystem::path const& path, Hasher& hasher);
+
+    // 16 character lowercase hexadecimal representation
+    [[nodiscard]] std::string toHexString(uint64_t hash);
+
+    // parses a string created by toHexString(), returns false if it is not a valid hash
+    [[nodiscard]] bool fromHexString(std::string const& string, uint64_t& out);
+}
+
+#endif //SHAPEREALITY_COMMON_HASH_H
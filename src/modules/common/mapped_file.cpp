@@ -0,0 +1,120 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "mapped_file.h"
+
+#include <common/logger.h>
+
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <utility>
+
+#if !defined(PLATFORM_WINDOWS)
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#endif
+
+namespace common
+{
+    MappedFile::MappedFile(std::filesystem::path const& path)
+    {
+#if defined(PLATFORM_WINDOWS)
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            log::error("Failed to open file {}", path.string());
+            return;
+        }
+        fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data_ = fallback;
+        valid_ = true;
+#else
+        int const fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            log::error("Failed to open file {} ({})", path.string(), std::strerror(errno));
+            return;
+        }
+
+        struct stat status{};
+        if (fstat(fd, &status) != 0)
+        {
+            log::error("Failed to read size of file {} ({})", path.string(), std::strerror(errno));
+        }
+        else if (status.st_size == 0)
+        {
+            valid_ = true; // mmap does not support mapping an empty file
+        }
+        else
+        {
+            size_t const size = static_cast<size_t>(status.st_size);
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED)
+            {
+                data_ = {static_cast<uint8_t const*>(mapping), size};
+                valid_ = true;
+            }
+            else
+            {
+                log::error("Failed to map file {} ({})", path.string(), std::strerror(errno));
+            }
+        }
+        close(fd); // the mapping stays valid after closing the file
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+        unmap();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, {})), valid_(std::exchange(other.valid_, false))
+    {
+#if defined(PLATFORM_WINDOWS)
+        fallback = std::move(other.fallback); // moving the vector keeps its memory, so data_ stays valid
+#endif
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            data_ = std::exchange(other.data_, {});
+            valid_ = std::exchange(other.valid_, false);
+#if defined(PLATFORM_WINDOWS)
+            fallback = std::move(other.fallback);
+#endif
+        }
+        return *this;
+    }
+
+    void MappedFile::unmap()
+    {
+#if !defined(PLATFORM_WINDOWS)
+        if (!data_.empty())
+        {
+            munmap(const_cast<uint8_t*>(data_.data()), data_.size());
+        }
+#endif
+        data_ = {};
+        valid_ = false;
+    }
+
+    bool MappedFile::valid() const
+    {
+        return valid_;
+    }
+
+    std::span<uint8_t const> MappedFile::data() const
+    {
+        return data_;
+    }
+}
@@ -0,0 +1,56 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_MAPPED_FILE_H
+#define SHAPEREALITY_MAPPED_FILE_H
+
+#include <common/application_info.h>
+
+#include <filesystem>
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace common
+{
+    /**
+     * Read-only memory mapping of a file, so that its pages are only read from disk when accessed, and can be
+     * evicted by the operating system instead of taking up memory. The mapping stays valid for the lifetime of
+     * the MappedFile.
+     */
+    class MappedFile final
+    {
+    public:
+        // maps the file at the provided path into memory, check valid() afterward
+        explicit MappedFile(std::filesystem::path const& path);
+
+        ~MappedFile();
+
+        MappedFile(MappedFile const&) = delete;
+
+        MappedFile& operator=(MappedFile const&) = delete;
+
+        // the moved from file is invalid and has no data
+        MappedFile(MappedFile&& other) noexcept;
+
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        // whether the file could be opened and mapped, an empty file is valid but has no data
+        [[nodiscard]] bool valid() const;
+
+        [[nodiscard]] std::span<uint8_t const> data() const;
+
+    private:
+        std::span<uint8_t const> data_;
+        bool valid_ = false;
+
+#if defined(PLATFORM_WINDOWS)
+        std::vector<uint8_t> fallback; // not memory mapped on Windows (yet), but read into memory
+#endif
+
+        void unmap();
+    };
+}
+
+#endif //SHAPEREALITY_MAPPED_FILE_H
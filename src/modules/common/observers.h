@@ -31,6 +31,11 @@ namespace common
             return false;
         }
 
+        [[nodiscard]] bool empty() const
+        {
+            return observers.empty();
+        }
+
         void add(Observer* observer)
         {
             assert(!contains(observer) && "observer was already added");
@@ -53,8 +58,15 @@ namespace common
         template<auto PointerToMemberFunction, typename... Args>
         void invoke(Args&&... args)
         {
-            for (Observer* o: observers)
+            // iterate a copy, as observers are allowed to add or remove observers while being notified.
+            // an observer that was removed by a previous observer doesn't get notified anymore
+            std::vector<Observer*> const snapshot = observers;
+            for (Observer* o: snapshot)
             {
+                if (!contains(o))
+                {
+                    continue;
+                }
                 (o->*PointerToMemberFunction)(std::forward<Args>(args)...);
                 // because std::invoke(PointerToMemberFunction, o, std::forward<Args>(args)...); has worse compile time error messages for when it fails
             }
@@ -6,6 +6,13 @@
 
 #include <BS_thread_pool.hpp>
 
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <algorithm>
+#include <exception>
+
 namespace common
 {
     BS::thread_pool& ThreadPool::shared()
@@ -13,4 +20,90 @@ namespace common
         static BS::thread_pool instance_;
         return instance_;
     }
-}
\ No newline at end of file
+
+    // shared with the helper tasks, as these could start after parallelFor returned
+    struct ParallelFor
+    {
+        size_t count;
+        std::function<void(size_t)> const* function; // only valid while not all indices have completed
+        std::atomic<size_t> next = 0;
+        size_t completed = 0;
+        std::atomic<bool> failed = false; // the remaining indices are skipped once a call has thrown
+        std::exception_ptr exception; // the first exception, rethrown on the calling thread
+        std::mutex mutex;
+        std::condition_variable condition;
+
+        // calls the function for indices that have not been claimed yet, returns the amount of indices that were
+        // claimed, which includes indices that threw or were skipped, so that the calling thread doesn't wait forever
+        size_t run()
+        {
+            size_t amount = 0;
+            for (size_t index = next++; index < count; index = next++)
+            {
+                amount++;
+                if (failed)
+                {
+                    continue;
+                }
+                try
+                {
+                    (*function)(index);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> guard(mutex);
+                    if (!exception)
+                    {
+                        exception = std::current_exception();
+                    }
+                    failed = true;
+                }
+            }
+            return amount;
+        }
+
+        void complete(size_t amount)
+        {
+            if (amount == 0)
+            {
+                return;
+            }
+            std::lock_guard<std::mutex> guard(mutex);
+            completed += amount;
+            if (completed == count)
+            {
+                condition.notify_all();
+            }
+        }
+    };
+
+    void parallelFor(BS::thread_pool& threadPool, size_t count, std::function<void(size_t index)> const& function)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        auto state = std::make_shared<ParallelFor>();
+        state->count = count;
+        state->function = &function;
+
+        // the calling thread is one of the workers
+        size_t const helpers = std::min(count - 1, static_cast<size_t>(threadPool.get_thread_count()));
+        for (size_t i = 0; i < helpers; i++)
+        {
+            threadPool.detach_task([state]() {
+                state->complete(state->run());
+            });
+        }
+        state->complete(state->run());
+
+        // all indices have been claimed, so we only wait for calls that are running on other threads
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->condition.wait(lock, [&]() { return state->completed == count; });
+        if (state->exception)
+        {
+            std::rethrow_exception(state->exception);
+        }
+    }
+}
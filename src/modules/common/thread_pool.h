@@ -5,6 +5,9 @@
 #ifndef SHAPEREALITY_THREAD_POOL_H
 #define SHAPEREALITY_THREAD_POOL_H
 
+#include <functional>
+#include <cstddef>
+
 namespace BS
 {
     class thread_pool;
@@ -19,6 +22,19 @@ namespace common
     {
         [[nodiscard]] static BS::thread_pool& shared();
     };
+
+    /**
+     * Calls function(index) for each index in [0, count) on the thread pool, and returns when all calls are done.
+     *
+     * The calling thread also calls the function while waiting, and only waits for calls that are already
+     * running on other threads. Calls that are still queued on the thread pool are taken over by the calling
+     * thread. Therefore, this can be used from a task that runs on the same thread pool (e.g. an ImportFunction)
+     * without a thread starvation deadlock, even if all other threads of the thread pool are busy.
+     *
+     * If a call throws, the indices that have not been called yet are skipped, and the first exception is
+     * rethrown on the calling thread once all running calls are done.
+     */
+    void parallelFor(BS::thread_pool& threadPool, size_t count, std::function<void(size_t index)> const& function);
 }
 
 #endif //SHAPEREALITY_THREAD_POOL_H
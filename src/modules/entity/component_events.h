@@ -0,0 +1,81 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_COMPONENT_EVENTS_H
+#define SHAPEREALITY_COMPONENT_EVENTS_H
+
+#include "config.h"
+
+#include <common/observers.h>
+#include <reflection/type_id.h>
+
+#include <vector>
+#include <span>
+#include <algorithm>
+
+namespace entity
+{
+    class EntityRegistry;
+
+    /**
+     * Observer for changes to a single component type (or multiple, the typeId is passed along).
+     *
+     * Events are not delivered synchronously when calling addComponent / removeComponent / destroyEntity,
+     * but buffered per component type and delivered in batches when calling EntityRegistry::flushEvents().
+     *
+     * Per flush, the events are delivered in the following order: destroyed, constructed, updated. Each list is
+     * sorted by entity id and contains no duplicates. This means that:
+     * - an entity that was destroyed and constructed again in the same batch gets an onDestroy and an onConstruct
+     * - an entity that was constructed and destroyed in the same batch only gets an onDestroy, so observers should
+     *   ignore entities they don't know about
+     * - constructed and updated only contain entities that still contain the component at the time of flushing
+     */
+    class IComponentObserver
+    {
+    public:
+        virtual ~IComponentObserver() = default;
+
+        virtual void onConstruct(EntityRegistry& r, reflection::TypeId typeId, std::span<EntityId const> entities) {}
+
+        virtual void onUpdate(EntityRegistry& r, reflection::TypeId typeId, std::span<EntityId const> entities) {}
+
+        virtual void onDestroy(EntityRegistry& r, reflection::TypeId typeId, std::span<EntityId const> entities) {}
+    };
+
+    // buffered events for a single component type, gets cleared on each flush
+    struct ComponentEvents final
+    {
+        std::vector<EntityId> constructed;
+        std::vector<EntityId> updated;
+        std::vector<EntityId> destroyed;
+
+        [[nodiscard]] bool empty() const
+        {
+            return constructed.empty() && updated.empty() && destroyed.empty();
+        }
+
+        void clear()
+        {
+            constructed.clear();
+            updated.clear();
+            destroyed.clear();
+        }
+    };
+
+    // sorts and removes duplicates, so that each entity gets delivered at most once per batch
+    inline void sortUnique(std::vector<EntityId>& entities)
+    {
+        std::sort(entities.begin(), entities.end());
+        entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+    }
+
+    // observers and buffered events for one component type
+    struct ComponentSignal final
+    {
+        common::Observers<IComponentObserver> observers;
+        ComponentEvents events;
+    };
+}
+
+#endif //SHAPEREALITY_COMPONENT_EVENTS_H
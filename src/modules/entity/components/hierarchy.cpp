@@ -4,6 +4,7 @@
 
 #include "hierarchy.h"
 
+#include <algorithm>
 #include <stack>
 
 namespace entity
@@ -384,33 +385,123 @@ namespace entity
         }
     }
 
+    std::vector<EntityId> instantiate(EntityRegistry& r, EntityRegistry& prefab, EntityId rootId, size_type count,
+                                      ParallelFor const& parallelFor)
+    {
+        if (!prefab.entityContainsComponent<HierarchyComponent>(rootId))
+        {
+            return {}; // error: root should be part of a hierarchy
+        }
+
+        // root gets local index 0
+        std::vector<EntityId> entities;
+        entities.reserve(prefab.getComponent<HierarchyComponent>(rootId).hierarchyCount);
+        depthFirstSearch(prefab, rootId, [&entities](EntityId entityId) {
+            entities.emplace_back(entityId);
+            return true;
+        });
+
+        EntityId const firstId = r.instantiate(prefab, entities, count, parallelFor);
+        if (firstId == kNullEntityId)
+        {
+            return {};
+        }
+
+        std::vector<EntityId> roots(count);
+        for (size_type i = 0; i < count; i++)
+        {
+            roots[i] = firstId + i * entities.size();
+        }
+        return roots;
+    }
+
     void sortHierarchy(EntityRegistry& r)
     {
-        // sorts with reverse order
-        r.sort<HierarchyComponent>([&r](EntityId lhsId, EntityId rhsId) {
-            auto const& lhs = r.getComponent<HierarchyComponent>(lhsId);
-            auto const& rhs = r.getComponent<HierarchyComponent>(rhsId);
+        SparseSet<HierarchyComponent>* set = r.getComponentType<HierarchyComponent>();
+        if (set == nullptr)
+        {
+            return;
+        }
+
+        // compute the depth of each entity with a single top-down traversal from the roots,
+        // instead of walking up the parents of each entity
+        std::vector<uint32_t> depths(set->size(), 0);
+        std::vector<EntityId> stack;
+        for (EntityId entityId: set->denseArray())
+        {
+            if (set->get(entityId).parent == kNullEntityId)
+            {
+                stack.emplace_back(entityId);
+            }
+        }
+        while (!stack.empty())
+        {
+            EntityId const entityId = stack.back();
+            stack.pop_back();
+            for (EntityId childId = set->get(entityId).firstChild; childId != kNullEntityId; childId = set->get(childId).next)
+            {
+                depths[childId] = depths[entityId] + 1;
+                stack.emplace_back(childId);
+            }
+        }
+
+        // sort by depth, so that parents are always iterated over before their children.
+        // iteration is done in reverse order, so the dense array should be sorted by descending depth.
+        r.sortByKey<HierarchyComponent>([&depths](EntityId entityId, HierarchyComponent const&) {
+            return std::numeric_limits<uint32_t>::max() - depths[entityId];
+        });
+    }
+
+    bool addHierarchy(EntityRegistry& r, std::span<EntityId const> entities, std::span<size_type const> parents)
+    {
+        size_type const count = entities.size();
+        if (parents.size() != count)
+        {
+            return false;
+        }
 
-            if (rhsId == lhsId)
+        std::vector<HierarchyComponent> hierarchies(count);
+        std::vector<size_type> lastChild(count, kNullEntityId); // local index of the last child of each entity
+        for (size_type i = 0; i < count; i++)
+        {
+            size_type const parent = parents[i];
+            if (parent == kNullEntityId)
+            {
+                continue;
+            }
+            if (parent >= i)
             {
-                return false;
+                return false; // error: parent should come before its children
             }
 
-            // if any parent of rhs is lhs, lhs should come before rhs
-            EntityId parentId = lhsId;
-            while (parentId != kNullEntityId)
+            HierarchyComponent& hierarchy = hierarchies[i];
+            HierarchyComponent& parentHierarchy = hierarchies[parent];
+            hierarchy.parent = entities[parent];
+            if (lastChild[parent] == kNullEntityId)
             {
-                if (rhsId == parentId)
-                {
-                    // lhs should come before rhs
-                    return false;
-                }
+                parentHierarchy.firstChild = entities[i];
+            }
+            else
+            {
+                hierarchy.previous = entities[lastChild[parent]];
+                hierarchies[lastChild[parent]].next = entities[i];
+            }
+            lastChild[parent] = i;
+            parentHierarchy.childCount++;
+        }
 
-                auto const& parent = r.getComponent<HierarchyComponent>(parentId);
-                parentId = parent.parent;
+        // children come after their parents, so accumulating in reverse adds complete subtrees
+        for (size_type i = count; i-- > 0;)
+        {
+            if (parents[i] != kNullEntityId)
+            {
+                hierarchies[parents[i]].hierarchyCount += hierarchies[i].hierarchyCount;
             }
+        }
 
-            return true;
-        });
+        // iteration is done in reverse order, so add the components in reverse
+        std::vector<EntityId> reversed(entities.rbegin(), entities.rend());
+        std::reverse(hierarchies.begin(), hierarchies.end());
+        return r.addComponents<HierarchyComponent>(reversed, std::move(hierarchies));
     }
-}
\ No newline at end of file
+}
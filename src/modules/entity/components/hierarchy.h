@@ -9,6 +9,7 @@
 
 #include <cassert>
 #include <functional>
+#include <span>
 
 namespace entity
 {
@@ -30,6 +31,21 @@ namespace entity
         size_type next{kNullEntityId}; // next sibling
     };
 
+    // remaps the hierarchy links when instantiating a prefab, links to entities outside the prefab are removed
+    template<>
+    struct RemapEntityIds<HierarchyComponent>
+    {
+        constexpr static bool enabled = true;
+
+        static void remap(HierarchyComponent& value, EntityRemap const& remap, size_type instance)
+        {
+            value.parent = remap(value.parent, instance);
+            value.firstChild = remap(value.firstChild, instance);
+            value.previous = remap(value.previous, instance);
+            value.next = remap(value.next, instance);
+        }
+    };
+
     // whether `entity` is root, i.e. does not have a parent
     [[nodiscard]] bool isRoot(EntityRegistry& r, EntityId entityId);
 
@@ -62,8 +78,30 @@ namespace entity
     // at each entity, a provided lambda is called, which should return whether to recurse to its children
     void depthFirstSearch(EntityRegistry& r, EntityId entityId, std::function<bool(EntityId)> const& function);
 
-    // sorts the entire hierarchy
-    void sortHierarchy(EntityRegistry& lhsId);
+    /**
+     * Instantiates the hierarchy of `rootId` in `prefab` (including all components) `count` times into `r`,
+     * see EntityRegistry::instantiate(). The roots of the instances don't have a parent.
+     *
+     * @return the ids of the roots of the instances, empty if instantiating failed
+     */
+    std::vector<EntityId> instantiate(EntityRegistry& r, EntityRegistry& prefab, EntityId rootId, size_type count,
+                                      ParallelFor const& parallelFor = {});
+
+    // sorts the entire hierarchy by depth, so that when iterating over the HierarchyComponents,
+    // parents are visited before their children
+    void sortHierarchy(EntityRegistry& r);
+
+    /**
+     * Adds HierarchyComponents to the given entities in one pass (e.g. when importing a scene), instead of inserting
+     * each entity into its parent, which walks the sibling list of the parent.
+     *
+     * @param parents the parent of each entity as an index into `entities`, or kNullEntityId for roots.
+     * parents should come before their children (e.g. depth first order), children are appended to their parent
+     * in the order they appear in `entities`.
+     * @return whether adding was successful. the components are ordered so that iterating over the
+     * HierarchyComponents visits the entities in the order of `entities`, so parents before their children.
+     */
+    bool addHierarchy(EntityRegistry& r, std::span<EntityId const> entities, std::span<size_type const> parents);
 }
 
 #endif //SHAPEREALITY_HIERARCHY_H
@@ -9,11 +9,21 @@
 #include "entity/type.h"
 #include "entity/sparse_set.h"
 #include "entity/view.h"
+#include "entity/component_events.h"
+#include "entity/registry_stats.h"
 
 #include <reflection/type_id.h>
 
 #include <vector>
+#include <span>
 #include <unordered_map>
+#include <iterator>
+#include <cassert>
+
+namespace reflection
+{
+    class TypeRegistry;
+}
 
 namespace entity
 {
@@ -67,6 +77,25 @@ namespace entity
             return success;
         }
 
+        // creates `count` entities with consecutive ids starting at the current size of the registry in one pass
+        // returns the id of the first entity, or kNullEntityId if count is 0 or the ids would be out of range
+        EntityId createEntities(size_type count)
+        {
+            EntityId const first = entities.size();
+            if (count == 0 || count >= kMaxSize - first)
+            {
+                return kNullEntityId;
+            }
+
+            std::vector<EntityId> ids(count);
+            for (size_type i = 0; i < count; i++)
+            {
+                ids[i] = first + i;
+            }
+            std::vector<EntityId> values(count); // the entity set doesn't use its values
+            return entities.emplaceAll(ids, std::move(values)) ? first : kNullEntityId;
+        }
+
         [[nodiscard]] bool entityExists(EntityId entity)
         {
             return entities.contains(entity);
@@ -90,10 +119,95 @@ namespace entity
             // remove components
             for (auto& component: components)
             {
-                component.second->remove(entity);
+                if (component.second->remove(entity))
+                {
+                    recordEvent(component.first, &ComponentEvents::destroyed, entity);
+                }
             }
         }
 
+        /**
+         * Copies the given entities and all their components from `prefab` into this registry `count` times.
+         *
+         * New entities get consecutive ids starting at the current size of the registry: instance `i` of
+         * entities[l] gets the id firstId + i * entities.size() + l. Component pools are copied in bulk per
+         * instance, entity ids inside components are remapped using RemapEntityIds (e.g. HierarchyComponent).
+         * References to entities that are not part of `entities` become kNullEntityId. Components that are not
+         * copy constructible (e.g. containing a std::unique_ptr) are skipped.
+         *
+         * @param parallelFor optional, used to copy the instances of each pool in parallel
+         * @return the id of the first entity of the first instance, or kNullEntityId if nothing was instantiated
+         */
+        EntityId instantiate(EntityRegistry const& prefab, std::span<EntityId const> sourceEntities, size_type count,
+                             ParallelFor const& parallelFor = {})
+        {
+            if (sourceEntities.empty() || count == 0)
+            {
+                return kNullEntityId;
+            }
+
+            // offset table from prefab entity id to local index
+            std::vector<size_type> table(prefab.entities.size(), kNullEntityId);
+            for (size_type i = 0; i < sourceEntities.size(); i++)
+            {
+                EntityId const source = sourceEntities[i];
+                if (!prefab.entities.contains(source) || table[source] != kNullEntityId)
+                {
+                    return kNullEntityId; // error: entity does not exist or is duplicate
+                }
+                table[source] = i;
+            }
+
+            EntityRemap const remap{
+                .table = table,
+                .entityCount = sourceEntities.size(),
+                .firstId = entities.size()
+            };
+            if (count > (kMaxSize - remap.firstId) / remap.entityCount)
+            {
+                return kNullEntityId; // error: out of range
+            }
+
+            entities.instantiate(prefab.entities, remap, count, parallelFor);
+
+            // collect the pools first, as prefab can be this registry
+            std::vector<std::pair<reflection::TypeId, SparseSetBase const*>> sources;
+            sources.reserve(prefab.components.size());
+            for (auto const& [typeId, set]: prefab.components)
+            {
+                sources.emplace_back(typeId, set.get());
+            }
+
+            for (auto const& [typeId, source]: sources)
+            {
+                auto& target = components[typeId];
+                if (!target)
+                {
+                    target = source->makeEmpty();
+                }
+                size_type const previousSize = target->denseSize();
+                bool const copied = target->instantiate(*source, remap, count, parallelFor);
+                if (target->denseSize() == 0)
+                {
+                    components.erase(typeId); // none of the entities contain this component
+                    continue;
+                }
+                if (!copied)
+                {
+                    continue; // move-only components are not copied to the instances
+                }
+
+                if (signals.contains(typeId))
+                {
+                    std::vector<size_type> const& dense = target->denseArray();
+                    std::vector<EntityId>& constructed = signals.at(typeId).events.constructed;
+                    constructed.insert(constructed.end(), dense.begin() + static_cast<std::ptrdiff_t>(previousSize), dense.end());
+                }
+            }
+
+            return remap.firstId;
+        }
+
         //--------------------------------------------------
         // Components
         //--------------------------------------------------
@@ -149,6 +263,55 @@ namespace entity
             // to the type specific one.
             getComponentType<Type>()->emplace(entity, std::forward<Args>(args)...);
 
+            recordEvent(typeId, &ComponentEvents::constructed, entity);
+            return true;
+        }
+
+        /**
+         * Adds a component to each of the given entities in one pass, values[i] is added to entities[i].
+         * The components are appended to the dense array in the given order, so they are iterated in reverse order.
+         *
+         * @return whether adding was successful, if not (an entity does not exist, is duplicate or already contains
+         * the component), no components are added
+         */
+        template<typename Type>
+        bool addComponents(std::span<EntityId const> entities_, std::vector<Type> values)
+        {
+            if (entities_.size() != values.size())
+            {
+                return false;
+            }
+
+            for (EntityId entity: entities_)
+            {
+                if (!entityExists(entity))
+                {
+                    return false;
+                }
+            }
+
+            reflection::TypeId typeId = reflection::TypeIndex<Type>::value();
+            auto& set = components[typeId];
+            if (!set)
+            {
+                // not yet initialized
+                set = std::make_unique<SparseSet<Type>>();
+            }
+
+            if (!static_cast<SparseSet<Type>*>(set.get())->emplaceAll(entities_, std::move(values)))
+            {
+                if (set->denseSize() == 0)
+                {
+                    components.erase(typeId);
+                }
+                return false; // error: duplicate entity or component was already added
+            }
+
+            if (signals.contains(typeId))
+            {
+                std::vector<EntityId>& constructed = signals.at(typeId).events.constructed;
+                constructed.insert(constructed.end(), entities_.begin(), entities_.end());
+            }
             return true;
         }
 
@@ -178,6 +341,7 @@ namespace entity
             }
 
             components.at(typeId)->remove(entity);
+            recordEvent(typeId, &ComponentEvents::destroyed, entity);
             return true;
         }
 
@@ -190,6 +354,7 @@ namespace entity
             }
 
             reflection::TypeId typeId = reflection::TypeIndex<Type>::value();
+            recordDestroyedForAll(typeId);
             components.erase(typeId);
             return true;
         }
@@ -210,6 +375,17 @@ namespace entity
             return getComponentType<Type>()->sort(std::move(compare), std::forward<Args>(args)...);
         }
 
+        // sorts the component type by a key that is extracted once per component, see SparseSet::sortByKey
+        template<typename Type, typename Function>
+        bool sortByKey(Function key)
+        {
+            if (!componentTypeExists<Type>())
+            {
+                return false;
+            }
+            return getComponentType<Type>()->sortByKey(std::move(key));
+        }
+
         template<typename... Types>
         [[nodiscard]] auto view(IterationPolicy iterationPolicy = IterationPolicy::UseSmallestComponent)
         {
@@ -233,15 +409,204 @@ namespace entity
             return components.at(typeId)->contains(entity);
         }
 
+        // replaces the pool of a component type with one that was built in bulk (e.g. loaded from a snapshot),
+        // and records construct events for all entities in it
+        void setComponentType(reflection::TypeId typeId, std::unique_ptr<SparseSetBase> set)
+        {
+            recordDestroyedForAll(typeId);
+            if (signals.contains(typeId))
+            {
+                std::vector<size_type> const& dense = set->denseArray();
+                std::vector<EntityId>& constructed = signals.at(typeId).events.constructed;
+                constructed.insert(constructed.end(), dense.begin(), dense.end());
+            }
+            components[typeId] = std::move(set);
+        }
+
         // clears all components and the entities they contain
         void clear()
         {
+            for (auto& component: components)
+            {
+                recordDestroyedForAll(component.first);
+            }
             entities.clear();
             components.clear();
         }
 
+        //--------------------------------------------------
+        // Statistics
+        //--------------------------------------------------
+
+        // memory usage and occupancy of the entities and each component pool,
+        // component type names are resolved using the given type registry
+        [[nodiscard]] RegistryStats stats(reflection::TypeRegistry& types) const;
+
+        // uses the shared Reflection instance for resolving type names
+        [[nodiscard]] RegistryStats stats() const;
+
+        //--------------------------------------------------
+        // Events
+        //--------------------------------------------------
+
+        // start receiving batched construct / update / destroy events for the given component type
+        // events are only buffered for component types that have at least one observer
+        template<typename Type>
+        void addObserver(IComponentObserver* observer)
+        {
+            reflection::TypeId typeId = reflection::TypeIndex<Type>::value();
+            signals[typeId].observers.add(observer);
+        }
+
+        template<typename Type>
+        void removeObserver(IComponentObserver* observer)
+        {
+            reflection::TypeId typeId = reflection::TypeIndex<Type>::value();
+            assert(signals.contains(typeId) && "trying to remove observer that was not added prior");
+            ComponentSignal& signal = signals.at(typeId);
+            signal.observers.remove(observer);
+            if (signal.observers.empty() && !flushing)
+            {
+                signals.erase(typeId); // no one is listening, so drop any pending events
+            }
+        }
+
+        // components are modified in place through getComponent, so updates need to be
+        // recorded explicitly. returns whether the entity contains the component
+        template<typename Type>
+        bool markUpdated(EntityId entity)
+        {
+            if (!entityContainsComponent<Type>(entity))
+            {
+                return false;
+            }
+
+            recordEvent(reflection::TypeIndex<Type>::value(), &ComponentEvents::updated, entity);
+            return true;
+        }
+
+        // calls `function` with a reference to the component and records an update event
+        template<typename Type, typename Function>
+        bool updateComponent(EntityId entity, Function&& function)
+        {
+            if (!entityContainsComponent<Type>(entity))
+            {
+                return false;
+            }
+
+            std::forward<Function>(function)(getComponent<Type>(entity));
+            recordEvent(reflection::TypeIndex<Type>::value(), &ComponentEvents::updated, entity);
+            return true;
+        }
+
+        // delivers all buffered events to the observers, one batch per component type and event kind.
+        // should be called at a defined point in the frame (e.g. before rendering), observers are allowed
+        // to modify the registry, any events that result from that are delivered in the next flush.
+        void flushEvents()
+        {
+            // signals are not erased while their observers are being notified, but after delivering all events
+            assert(!flushing && "flushEvents should not be called from an observer");
+            flushing = true;
+
+            // copy type ids, as observers could add or remove observers, which would invalidate iteration
+            std::vector<reflection::TypeId> typeIds;
+            for (auto& signal: signals)
+            {
+                if (!signal.second.events.empty())
+                {
+                    typeIds.emplace_back(signal.first);
+                }
+            }
+
+            for (reflection::TypeId typeId: typeIds)
+            {
+                ComponentEvents events;
+                std::swap(events, signals.at(typeId).events);
+
+                sortUnique(events.destroyed);
+                sortUnique(events.constructed);
+                sortUnique(events.updated);
+
+                // only deliver constructed and updated for entities that still contain the component
+                SparseSetBase* set = components.contains(typeId) ? components.at(typeId).get() : nullptr;
+                auto const removed = [set](EntityId entity) {
+                    return set == nullptr || !set->contains(entity);
+                };
+                std::erase_if(events.constructed, removed);
+                std::erase_if(events.updated, removed);
+
+                // constructed entities don't need an additional update event
+                std::vector<EntityId> updated;
+                updated.reserve(events.updated.size());
+                std::set_difference(events.updated.begin(), events.updated.end(),
+                                    events.constructed.begin(), events.constructed.end(),
+                                    std::back_inserter(updated));
+
+                deliver<&IComponentObserver::onDestroy>(typeId, events.destroyed);
+                deliver<&IComponentObserver::onConstruct>(typeId, events.constructed);
+                deliver<&IComponentObserver::onUpdate>(typeId, updated);
+
+                // give the allocated memory back to the signal, so that we don't reallocate each frame
+                if (signals.contains(typeId) && signals.at(typeId).events.empty())
+                {
+                    events.clear();
+                    std::swap(events, signals.at(typeId).events);
+                }
+            }
+
+            flushing = false;
+            std::erase_if(signals, [](auto const& signal) { return signal.second.observers.empty(); });
+        }
+
         SparseSet<EntityId> entities;
         std::unordered_map<reflection::TypeId, std::unique_ptr<SparseSetBase>> components;
+
+    private:
+        std::unordered_map<reflection::TypeId, ComponentSignal> signals;
+        bool flushing = false;
+
+        // buffers an event if the component type is observed
+        void recordEvent(reflection::TypeId typeId, std::vector<EntityId> ComponentEvents::* list, EntityId entity)
+        {
+            if (signals.empty())
+            {
+                return; // fast path, nothing is observed
+            }
+
+            auto signal = signals.find(typeId);
+            if (signal == signals.end())
+            {
+                return;
+            }
+
+            (signal->second.events.*list).emplace_back(entity);
+        }
+
+        // buffers destroy events for all entities of a component type, used before removing the entire type
+        void recordDestroyedForAll(reflection::TypeId typeId)
+        {
+            if (!signals.contains(typeId) || !components.contains(typeId))
+            {
+                return;
+            }
+
+            SparseSetBase* set = components.at(typeId).get();
+            std::vector<EntityId>& destroyed = signals.at(typeId).events.destroyed;
+            for (auto it = set->beginBase(); it != set->endBase(); ++it)
+            {
+                destroyed.emplace_back(*it);
+            }
+        }
+
+        template<auto PointerToMemberFunction>
+        void deliver(reflection::TypeId typeId, std::vector<EntityId> const& list)
+        {
+            if (list.empty() || !signals.contains(typeId))
+            {
+                return;
+            }
+            signals.at(typeId).observers.invoke<PointerToMemberFunction>(*this, typeId, std::span<EntityId const>(list));
+        }
     };
 }
 
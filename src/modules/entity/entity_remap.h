@@ -0,0 +1,66 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_ENTITY_REMAP_H
+#define SHAPEREALITY_ENTITY_REMAP_H
+
+#include "config.h"
+
+#include <span>
+#include <limits>
+#include <functional>
+
+namespace entity
+{
+    /**
+     * Maps entity ids of a prefab (the source registry) to the entity ids of its instances,
+     * see EntityRegistry::instantiate()
+     *
+     * All instances share a single offset table: instance `i` of a prefab entity with local index `l`
+     * gets the id firstId + i * entityCount + l
+     */
+    struct EntityRemap final
+    {
+        // source entity id -> local index within the prefab, kNullEntityId (max) if not part of the prefab
+        std::span<size_type const> table;
+        size_type entityCount = 0; // amount of entities per instance
+        EntityId firstId = 0; // id of the first entity of the first instance
+
+        // returns the id of `source` in the given instance, or kNullEntityId if `source` is not part of the prefab
+        [[nodiscard]] EntityId operator()(EntityId source, size_type instance) const
+        {
+            constexpr size_type null = std::numeric_limits<size_type>::max();
+            if (source >= table.size() || table[source] == null)
+            {
+                return null;
+            }
+            return firstId + instance * entityCount + table[source];
+        }
+    };
+
+    /**
+     * Specialize for component types that store entity ids, so that these refer to the entities of the
+     * instance instead of the prefab after instantiating. e.g.
+     *
+     * template<>
+     * struct RemapEntityIds<HierarchyComponent>
+     * {
+     *     constexpr static bool enabled = true;
+     *     static void remap(HierarchyComponent& value, EntityRemap const& remap, size_type instance);
+     * };
+     */
+    template<typename Type>
+    struct RemapEntityIds
+    {
+        constexpr static bool enabled = false;
+
+        static void remap(Type&, EntityRemap const&, size_type) {}
+    };
+
+    // calls `function(begin, end)` for ranges that together cover [0, count), these ranges may be executed
+    // in parallel (e.g. using the thread pool). an empty ParallelFor executes everything on the calling thread
+    using ParallelFor = std::function<void(size_type count, std::function<void(size_type begin, size_type end)> const& function)>;
+}
+
+#endif //SHAPEREALITY_ENTITY_REMAP_H
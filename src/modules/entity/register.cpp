@@ -5,6 +5,8 @@
 #include "register.h"
 
 #include <entity/entity_registry.h>
+#include <entity/serialize.h>
+#include <entity/components/hierarchy.h>
 
 #include <reflection/class.h>
 
@@ -15,5 +17,15 @@ namespace entity
         reflection::register_::Class<EntityRegistry>("EntityRegistry")
             //.property<&EntityRegistry::components>
             .emplace(reflection.types);
+
+        // saved as raw bytes, so its members don't have to be registered
+        reflection::register_::Class<HierarchyComponent>("HierarchyComponent")
+            .emplace(reflection.types);
+    }
+
+    void register_(RegistrySerializer& components)
+    {
+        static_assert(std::is_trivially_copyable_v<HierarchyComponent>, "HierarchyComponent should be saved as raw bytes");
+        components.emplace<HierarchyComponent>();
     }
 }
\ No newline at end of file
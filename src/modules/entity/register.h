@@ -9,7 +9,12 @@
 
 namespace entity
 {
+    class RegistrySerializer;
+
     void register_(reflection::Reflection& reflection);
+
+    // registers the component types of this module that should be saved with a registry (e.g. in a scene)
+    void register_(RegistrySerializer& components);
 }
 
 #endif //SHAPEREALITY_REGISTER_ENTITY_H
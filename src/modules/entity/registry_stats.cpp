@@ -0,0 +1,71 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "registry_stats.h"
+#include "entity_registry.h"
+
+#include <reflection/reflection.h>
+#include <reflection/type_info.h>
+
+namespace entity
+{
+    PoolStats getPoolStats(SparseSetBase const& set)
+    {
+        PoolStats stats{
+            .sparseSize = set.size(),
+            .sparseCapacity = set.sparseCapacity(),
+            .liveCount = set.denseSize(),
+            .denseCapacity = set.denseCapacity(),
+            .valueSize = set.valueSize(),
+            .bytes = set.memoryUsage()
+        };
+        if (stats.sparseSize > 0)
+        {
+            stats.tombstoneRatio = static_cast<float>(stats.sparseSize - stats.liveCount) /
+                                   static_cast<float>(stats.sparseSize);
+        }
+        return stats;
+    }
+
+    // bytes that are not used for storing live entries
+    static size_type wastedBytes(PoolStats const& stats)
+    {
+        size_type const used = stats.liveCount * (2 * sizeof(size_type) + stats.valueSize);
+        return stats.bytes > used ? stats.bytes - used : 0;
+    }
+
+    RegistryStats EntityRegistry::stats(reflection::TypeRegistry& types) const
+    {
+        RegistryStats result;
+
+        result.entities = getPoolStats(entities);
+        result.entities.typeId = reflection::TypeIndex<EntityId>::value();
+        result.entities.name = "entities";
+        result.bytes += result.entities.bytes;
+        result.wastedBytes += wastedBytes(result.entities);
+
+        result.components.reserve(components.size());
+        for (auto const& [typeId, set]: components)
+        {
+            PoolStats& pool = result.components.emplace_back(getPoolStats(*set));
+            pool.typeId = typeId;
+            pool.name = types.contains(typeId) ? types.get(typeId).name : "unregistered";
+
+            result.componentCount += pool.liveCount;
+            result.bytes += pool.bytes;
+            result.wastedBytes += wastedBytes(pool);
+        }
+
+        std::sort(result.components.begin(), result.components.end(), [](PoolStats const& lhs, PoolStats const& rhs) {
+            return lhs.bytes > rhs.bytes;
+        });
+
+        return result;
+    }
+
+    RegistryStats EntityRegistry::stats() const
+    {
+        return stats(reflection::Reflection::shared().types);
+    }
+}
@@ -0,0 +1,53 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_REGISTRY_STATS_H
+#define SHAPEREALITY_REGISTRY_STATS_H
+
+#include "config.h"
+
+#include <reflection/type_id.h>
+
+#include <string>
+#include <vector>
+
+namespace entity
+{
+    class SparseSetBase;
+
+    // memory usage and occupancy of a single sparse set (the entities, or one component type)
+    struct PoolStats final
+    {
+        reflection::TypeId typeId = reflection::nullTypeId;
+        std::string name; // name as registered in the TypeRegistry, or "unregistered" if not registered
+
+        size_type sparseSize = 0; // largest entity id + 1
+        size_type sparseCapacity = 0;
+        size_type liveCount = 0; // amount of entities that have this component (size of the dense array)
+        size_type denseCapacity = 0;
+        size_type valueSize = 0; // sizeof(Type)
+        size_type bytes = 0; // allocated bytes of sparse array, dense array and values
+
+        // fraction of the sparse array that is empty (0 when the sparse array is empty)
+        // a high ratio with a large sparse size means a lot of memory is wasted on a few components
+        float tombstoneRatio = 0.0f;
+    };
+
+    // statistics for an entire EntityRegistry, see EntityRegistry::stats()
+    struct RegistryStats final
+    {
+        PoolStats entities;
+        std::vector<PoolStats> components; // sorted by bytes, largest first
+
+        // totals, including the entities pool
+        size_type componentCount = 0; // sum of live counts of all component pools
+        size_type bytes = 0;
+        size_type wastedBytes = 0; // bytes allocated for tombstones and unused capacity
+    };
+
+    // fills in everything except the type id and name
+    [[nodiscard]] PoolStats getPoolStats(SparseSetBase const& set);
+}
+
+#endif //SHAPEREALITY_REGISTRY_STATS_H
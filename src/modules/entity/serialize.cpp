@@ -0,0 +1,186 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "serialize.h"
+
+#include <common/logger.h>
+
+namespace entity
+{
+    namespace internal
+    {
+        void writeIndices(std::ostream& out, SparseSetBase const& set)
+        {
+            common::binary::write(out, static_cast<uint64_t>(set.size()));
+            common::binary::write(out, static_cast<uint64_t>(set.denseSize()));
+            common::binary::writeBlock(out, set.denseArray());
+        }
+
+        bool readIndices(std::istream& in, SparseSetBase& set, size_type& count)
+        {
+            uint64_t sparseSize = 0;
+            uint64_t denseSize = 0;
+            if (!common::binary::read(in, sparseSize) || !common::binary::read(in, denseSize))
+            {
+                return false;
+            }
+
+            if (denseSize > sparseSize)
+            {
+                return false; // error: dense array can't contain more elements than the sparse array
+            }
+
+            if (!common::binary::readBlock(in, set.denseArray(), denseSize))
+            {
+                return false;
+            }
+
+            count = denseSize;
+            return set.rebuildSparse(sparseSize);
+        }
+    }
+
+    RegistrySerializer::RegistrySerializer(reflection::Reflection& reflection_) : reflection(reflection_)
+    {
+
+    }
+
+    bool RegistrySerializer::save(EntityRegistry& r, std::ostream& out)
+    {
+        // header
+        common::binary::write(out, kMagic);
+        common::binary::write(out, kVersion);
+        common::binary::write(out, static_cast<uint32_t>(sizeof(size_type)));
+
+        // entities
+        internal::writeIndices(out, r.entities);
+        common::binary::writeBlock(out, r.entities.values());
+
+        // pools
+        uint64_t poolCount = 0;
+        for (auto& component: r.components)
+        {
+            if (pools.contains(component.first))
+            {
+                poolCount++;
+            }
+        }
+        common::binary::write(out, poolCount);
+
+        for (auto& [typeId, set]: r.components)
+        {
+            if (!pools.contains(typeId))
+            {
+                continue; // skip unregistered component types
+            }
+
+            Functions& f = pools.at(typeId);
+            common::binary::writeString(out, f.name);
+            common::binary::write(out, f.encoding);
+
+            // write the payload size after writing the payload, so that we don't need to compute it up front
+            std::streampos sizePosition = out.tellp();
+            common::binary::write(out, static_cast<uint64_t>(0));
+            std::streampos payloadStart = out.tellp();
+
+            f.save(*set, out);
+
+            std::streampos payloadEnd = out.tellp();
+            out.seekp(sizePosition);
+            common::binary::write(out, static_cast<uint64_t>(payloadEnd - payloadStart));
+            out.seekp(payloadEnd);
+        }
+
+        return out.good();
+    }
+
+    bool RegistrySerializer::load(std::istream& in, EntityRegistry& r)
+    {
+        r.clear();
+        if (!loadInternal(in, r))
+        {
+            r.clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool RegistrySerializer::loadInternal(std::istream& in, EntityRegistry& r)
+    {
+        // header
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint32_t sizeTypeSize = 0;
+        if (!common::binary::read(in, magic) || !common::binary::read(in, version) || !common::binary::read(in, sizeTypeSize))
+        {
+            return false;
+        }
+
+        if (magic != kMagic)
+        {
+            return false; // error: not an entity registry snapshot
+        }
+
+        if (version != kVersion || sizeTypeSize != sizeof(size_type))
+        {
+            common::log::error("Unsupported entity registry snapshot (version {})", version);
+            return false;
+        }
+
+        // entities
+        size_type entityCount = 0;
+        if (!internal::readIndices(in, r.entities, entityCount) ||
+            !common::binary::readBlock(in, r.entities.values(), entityCount))
+        {
+            return false;
+        }
+
+        // pools
+        uint64_t poolCount = 0;
+        if (!common::binary::read(in, poolCount))
+        {
+            return false;
+        }
+
+        for (uint64_t i = 0; i < poolCount; i++)
+        {
+            std::string name;
+            Encoding encoding;
+            uint64_t payloadSize = 0;
+            if (!common::binary::readString(in, name) ||
+                !common::binary::read(in, encoding) ||
+                !common::binary::read(in, payloadSize))
+            {
+                return false;
+            }
+
+            if (!names.contains(name))
+            {
+                if (payloadSize > common::binary::remaining(in))
+                {
+                    return false;
+                }
+                common::log::warning("Skipped unregistered component type {} in entity registry snapshot", name);
+                in.seekg(static_cast<std::streamoff>(payloadSize), std::ios_base::cur);
+                continue;
+            }
+
+            reflection::TypeId typeId = names.at(name);
+            Functions& f = pools.at(typeId);
+            if (f.encoding != encoding)
+            {
+                return false; // error: component type changed from trivially copyable to non-trivially copyable or vice versa
+            }
+
+            std::unique_ptr<SparseSetBase> set = f.create();
+            if (!f.load(in, *set))
+            {
+                return false;
+            }
+            r.setComponentType(typeId, std::move(set));
+        }
+
+        return true;
+    }
+}
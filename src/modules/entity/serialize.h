@@ -5,9 +5,186 @@
 #ifndef SHAPEREALITY_SERIALIZE_H
 #define SHAPEREALITY_SERIALIZE_H
 
+#include "config.h"
+#include "entity/entity_registry.h"
+
+#include <common/binary.h>
+#include <reflection/reflection.h>
+#include <reflection/type_info.h>
+
+#include <nlohmann/json.hpp>
+
+#include <istream>
+#include <ostream>
+#include <functional>
+#include <type_traits>
+#include <string>
+
 namespace entity
 {
-    
+    namespace internal
+    {
+        // writes the sparse size and dense array of a sparse set
+        void writeIndices(std::ostream& out, SparseSetBase const& set);
+
+        // reads the dense array and rebuilds the sparse array from it
+        [[nodiscard]] bool readIndices(std::istream& in, SparseSetBase& set, size_type& count);
+    }
+
+    /**
+     * Saves and loads an EntityRegistry to and from a compact binary snapshot.
+     *
+     * Layout (native endianness, not meant as an interchange format):
+     *
+     * header:   magic, version, sizeof(size_type)
+     * entities: sparse size, dense count, dense array, dense values
+     * pools:    pool count, then for each pool:
+     *           name, encoding, payload size in bytes,
+     *           payload: sparse size, dense count, dense array, values
+     *
+     * Pools of trivially copyable component types are written as raw blocks (Encoding::Raw), so that loading
+     * is a single read into the dense values. Other component types are serialized using the JsonSerializer
+     * and stored as CBOR (Encoding::Reflection).
+     *
+     * On load, the sparse arrays are rebuilt from the dense arrays directly, instead of calling
+     * createEntity() and addComponent() for each entity. This also retains the order of the dense arrays
+     * (e.g. after sortHierarchy()).
+     *
+     * Pools are identified by the name the component type was registered with in the TypeRegistry, as TypeIds
+     * are not stable between runs. Pools of unregistered component types are skipped when saving or loading.
+     */
+    class RegistrySerializer final
+    {
+    public:
+        constexpr static uint32_t kMagic = 0x47455253; // "SREG"
+        constexpr static uint32_t kVersion = 1;
+
+        enum class Encoding : uint8_t
+        {
+            Raw = 0,
+            Reflection = 1
+        };
+
+        explicit RegistrySerializer(reflection::Reflection& reflection);
+
+        // delete copy constructor and assignment operator, the registered functions refer to this instance
+        RegistrySerializer(RegistrySerializer const&) = delete;
+
+        RegistrySerializer& operator=(RegistrySerializer const&) = delete;
+
+        // register a component type, it should already be registered in the TypeRegistry
+        template<typename Type>
+        void emplace()
+        {
+            reflection::TypeId typeId = reflection::TypeIndex<Type>::value();
+            assert(reflection.types.contains(typeId) && "component type should be registered in the TypeRegistry");
+            assert(!pools.contains(typeId) && "component type was already registered");
+
+            std::string const& name = reflection.types.get(typeId).name;
+            assert(!names.contains(name) && "component type with the same name was already registered");
+
+            Functions f{.name = name};
+            if constexpr (std::is_trivially_copyable_v<Type>)
+            {
+                f.encoding = Encoding::Raw;
+                f.save = [](SparseSetBase& set, std::ostream& out) {
+                    auto& values = static_cast<SparseSet<Type>&>(set).values();
+                    internal::writeIndices(out, set);
+                    common::binary::write(out, static_cast<uint64_t>(sizeof(Type)));
+                    common::binary::writeBlock(out, values);
+                };
+                f.load = [](std::istream& in, SparseSetBase& set) {
+                    size_type count = 0;
+                    if (!internal::readIndices(in, set, count))
+                    {
+                        return false;
+                    }
+
+                    uint64_t size = 0;
+                    if (!common::binary::read(in, size) || size != sizeof(Type))
+                    {
+                        return false; // error: layout of the component type has changed
+                    }
+                    return common::binary::readBlock(in, static_cast<SparseSet<Type>&>(set).values(), count);
+                };
+            }
+            else
+            {
+                f.encoding = Encoding::Reflection;
+                f.save = [this](SparseSetBase& set, std::ostream& out) {
+                    auto& values = static_cast<SparseSet<Type>&>(set).values();
+                    nlohmann::json array = nlohmann::json::array();
+                    for (Type& value: values)
+                    {
+                        array.emplace_back(reflection.json.toJson(value));
+                    }
+                    std::vector<uint8_t> bytes = nlohmann::json::to_cbor(array);
+
+                    internal::writeIndices(out, set);
+                    common::binary::write(out, static_cast<uint64_t>(bytes.size()));
+                    common::binary::writeBlock(out, bytes);
+                };
+                f.load = [this](std::istream& in, SparseSetBase& set) {
+                    size_type count = 0;
+                    if (!internal::readIndices(in, set, count))
+                    {
+                        return false;
+                    }
+
+                    uint64_t size = 0;
+                    std::vector<uint8_t> bytes;
+                    if (!common::binary::read(in, size) || !common::binary::readBlock(in, bytes, size))
+                    {
+                        return false;
+                    }
+
+                    nlohmann::json array = nlohmann::json::from_cbor(bytes, true, false);
+                    if (array.is_discarded() || !array.is_array() || array.size() != count)
+                    {
+                        return false;
+                    }
+
+                    auto& values = static_cast<SparseSet<Type>&>(set).values();
+                    values.resize(count);
+                    for (size_type i = 0; i < count; i++)
+                    {
+                        reflection.json.fromJson(array[i], values[i]);
+                    }
+                    return true;
+                };
+            }
+            f.create = []() -> std::unique_ptr<SparseSetBase> {
+                return std::make_unique<SparseSet<Type>>();
+            };
+
+            names.emplace(name, typeId);
+            pools.emplace(typeId, std::move(f));
+        }
+
+        // writes a snapshot of the registry, returns whether writing was successful
+        // `out` should be opened in binary mode and should be seekable
+        bool save(EntityRegistry& r, std::ostream& out);
+
+        // clears the registry and replaces its contents with the snapshot
+        // returns whether loading was successful, if not, the registry is left empty
+        bool load(std::istream& in, EntityRegistry& r);
+
+    private:
+        struct Functions
+        {
+            std::string name;
+            Encoding encoding = Encoding::Raw;
+            std::function<void(SparseSetBase&, std::ostream&)> save;
+            std::function<bool(std::istream&, SparseSetBase&)> load;
+            std::function<std::unique_ptr<SparseSetBase>()> create;
+        };
+
+        reflection::Reflection& reflection;
+        std::unordered_map<reflection::TypeId, Functions> pools;
+        std::unordered_map<std::string, reflection::TypeId> names;
+
+        [[nodiscard]] bool loadInternal(std::istream& in, EntityRegistry& r);
+    };
 }
 
 #endif //SHAPEREALITY_SERIALIZE_H
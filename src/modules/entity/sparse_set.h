@@ -6,9 +6,17 @@
 #define SHAPEREALITY_SPARSE_SET_H
 
 #include "config.h"
+#include "entity/entity_remap.h"
 
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#include <memory>
+#include <span>
+#include <utility>
 
 namespace entity
 {
@@ -160,6 +168,29 @@ namespace entity
             return dense.size();
         }
 
+        // capacity of the sparse array (number of indices that can be stored without reallocating)
+        [[nodiscard]] size_type sparseCapacity() const
+        {
+            return sparse.capacity();
+        }
+
+        [[nodiscard]] size_type denseCapacity() const
+        {
+            return dense.capacity();
+        }
+
+        // size in bytes of a single value, 0 if the set contains no values
+        [[nodiscard]] virtual size_type valueSize() const
+        {
+            return 0;
+        }
+
+        // number of bytes allocated by the sparse and dense arrays (and values)
+        [[nodiscard]] virtual size_type memoryUsage() const
+        {
+            return (sparse.capacity() + dense.capacity()) * sizeof(size_type);
+        }
+
         // resizes the sparse array
         bool resize(size_type size)
         {
@@ -224,6 +255,56 @@ namespace entity
             return base_iterator{&dense, 0}; // end at 0
         }
 
+        // direct access to the dense array (indices into the sparse array), e.g. for serialization
+        [[nodiscard]] std::vector<size_type>& denseArray()
+        {
+            return dense;
+        }
+
+        [[nodiscard]] std::vector<size_type> const& denseArray() const
+        {
+            return dense;
+        }
+
+        // rebuilds the sparse array from the dense array, for when the dense array was written to directly
+        // (e.g. when loading a snapshot). this avoids having to emplace each element individually.
+        // returns false if the dense array contains an index that is out of range or a duplicate index
+        bool rebuildSparse(size_type size)
+        {
+            if (size >= kMaxSize)
+            {
+                return false;
+            }
+
+            sparse.assign(size, kNullEntityId);
+            for (size_type i = 0; i < dense.size(); i++)
+            {
+                size_type const index = dense[i];
+                if (index >= size || sparse[index] != kNullEntityId)
+                {
+                    return false; // error: out of range or duplicate
+                }
+                sparse[index] = i;
+            }
+            return true;
+        }
+
+        // creates an empty sparse set with the same value type
+        [[nodiscard]] virtual std::unique_ptr<SparseSetBase> makeEmpty() const = 0;
+
+        /**
+         * Appends `count` instances of the elements of `source` that are part of the prefab described by `remap`.
+         * `source` should have the same value type. The values are copied in bulk per instance, and entity ids
+         * inside the values are remapped if RemapEntityIds is specialized for the value type.
+         *
+         * Instances are written to preallocated, disjoint ranges, so `parallelFor` can copy them in parallel.
+         *
+         * @return whether the values were copied, false if the value type is not copy constructible
+         * (e.g. a component that contains a std::unique_ptr), in which case the set is left unchanged
+         */
+        virtual bool instantiate(SparseSetBase const& source, EntityRemap const& remap, size_type count,
+                                 ParallelFor const& parallelFor) = 0;
+
         // clears the entire sparse set, both its sparse and dense array
         virtual void clear()
         {
@@ -241,6 +322,39 @@ namespace entity
         std::vector<size_type> dense; // contains indices to sparse array
     };
 
+    namespace internal
+    {
+        // unsigned integer type with the same size as the key type, used for radix sorting
+        template<typename Key>
+        using RadixBits = std::conditional_t<sizeof(Key) == 1, uint8_t,
+            std::conditional_t<sizeof(Key) == 2, uint16_t,
+                std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>>>;
+
+        // maps a key to an unsigned integer with the same ordering, so that it can be radix sorted
+        // signed integers: flip the sign bit
+        // floating point: flip all bits if negative, otherwise flip the sign bit (NaNs are sorted to the ends)
+        template<typename Key>
+        requires (std::is_arithmetic_v<Key> && !std::is_same_v<Key, bool> && sizeof(Key) <= 8)
+        [[nodiscard]] constexpr RadixBits<Key> toRadixKey(Key key)
+        {
+            using Bits = RadixBits<Key>;
+            constexpr Bits signBit = Bits{1} << (sizeof(Bits) * 8 - 1);
+            if constexpr (std::is_floating_point_v<Key>)
+            {
+                Bits const bits = std::bit_cast<Bits>(key);
+                return (bits & signBit) ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | signBit);
+            }
+            else if constexpr (std::is_signed_v<Key>)
+            {
+                return static_cast<Bits>(static_cast<Bits>(key) ^ signBit);
+            }
+            else
+            {
+                return static_cast<Bits>(key);
+            }
+        }
+    }
+
     // implementation of SparseSetBase, contains the dense array with *values*,
     // instead of just the dense and sparse array with indices
     template<typename Type>
@@ -280,8 +394,69 @@ namespace entity
 
             size_type denseIndex = dense.size() - 1;
             sparse[index] = denseIndex; // set dense index in sparse array
-            denseValues.emplace_back(args...); // emplace value in dense array
+            denseValues.emplace_back(std::forward<Args>(args)...); // emplace value in dense array
+
+            return true;
+        }
+
+        /**
+         * Appends a value for each index in one pass, resizing the sparse array at most once,
+         * instead of calling emplace() per index. values[i] is stored at indices[i].
+         *
+         * @return whether emplacing was successful, if not (an index is out of range, already exists or is
+         * duplicate), the set is left unchanged
+         */
+        bool emplaceAll(std::span<size_type const> indices, std::vector<Type> values)
+        {
+            if (indices.size() != values.size())
+            {
+                return false;
+            }
+
+            // validate before modifying anything
+            size_type const previousSize = sparse.size();
+            size_type size = previousSize;
+            for (size_type index: indices)
+            {
+                if ((index + 1) >= kMaxSize || contains(index))
+                {
+                    return false; // error: index out of range or entity at index already exists
+                }
+                size = std::max(size, index + 1);
+            }
+            if (size > sparse.size())
+            {
+                // resize and initialize with null indices
+                sparse.resize(size, kNullEntityId);
+            }
+
+            size_type const first = dense.size();
+            for (size_type i = 0; i < indices.size(); i++)
+            {
+                size_type const index = indices[i];
+                if (sparse[index] != kNullEntityId)
+                {
+                    // error: duplicate index, undo the indices that were set and the resize
+                    for (size_type j = 0; j < i; j++)
+                    {
+                        sparse[indices[j]] = kNullEntityId;
+                    }
+                    sparse.resize(previousSize);
+                    return false;
+                }
+                sparse[index] = first + i;
+            }
 
+            dense.insert(dense.end(), indices.begin(), indices.end());
+            if (denseValues.empty())
+            {
+                denseValues = std::move(values);
+            }
+            else
+            {
+                denseValues.insert(denseValues.end(), std::make_move_iterator(values.begin()),
+                                   std::make_move_iterator(values.end()));
+            }
             return true;
         }
 
@@ -310,11 +485,105 @@ namespace entity
             return false;
         }
 
+        /**
+         * Sorts the set by a key that gets extracted once per element, using a stable LSD radix sort
+         * (linear time, no comparisons and no lookups during sorting).
+         *
+         * The dense array is ordered by ascending key, note that iterating over the set is done in
+         * reverse, so iteration visits elements by descending key.
+         *
+         * @param key function with signature `Key(size_type index, Type const& value)`, where Key is
+         * an integer or floating point type
+         */
+        template<typename Function>
+        bool sortByKey(Function key)
+        {
+            using Key = std::invoke_result_t<Function&, size_type, Type const&>;
+            using Bits = internal::RadixBits<Key>;
+            static_assert(std::is_arithmetic_v<Key> && !std::is_same_v<Key, bool>,
+                          "key should be an integer or floating point type");
+
+            size_type const count = dense.size();
+            if (count < 2)
+            {
+                return true;
+            }
+
+            // extract keys once, together with the current dense index
+            std::vector<std::pair<Bits, size_type>> current(count);
+            std::vector<std::pair<Bits, size_type>> next(count);
+            for (size_type i = 0; i < count; i++)
+            {
+                current[i] = {internal::toRadixKey(key(dense[i], denseValues[i])), i};
+            }
+
+            // sort 8 bits per pass, starting with the least significant byte
+            for (size_type shift = 0; shift < sizeof(Bits) * 8; shift += 8)
+            {
+                std::array<size_type, 256> offsets{};
+                for (auto& element: current)
+                {
+                    offsets[(element.first >> shift) & 0xFF]++;
+                }
+
+                // skip passes where all keys have the same byte (e.g. the upper bytes of small integers)
+                if (offsets[(current[0].first >> shift) & 0xFF] == count)
+                {
+                    continue;
+                }
+
+                size_type offset = 0;
+                for (auto& o: offsets)
+                {
+                    size_type const c = o;
+                    o = offset;
+                    offset += c;
+                }
+
+                for (auto& element: current)
+                {
+                    next[offsets[(element.first >> shift) & 0xFF]++] = element;
+                }
+                std::swap(current, next);
+            }
+
+            // permute the dense array and dense values in one pass
+            std::vector<size_type> sortedDense(count);
+            std::vector<Type> sortedValues;
+            sortedValues.reserve(count);
+            for (size_type i = 0; i < count; i++)
+            {
+                size_type const from = current[i].second;
+                sortedDense[i] = dense[from];
+                sortedValues.emplace_back(std::move(denseValues[from]));
+            }
+            dense = std::move(sortedDense);
+            denseValues = std::move(sortedValues);
+
+            for (size_type i = 0; i < count; i++)
+            {
+                sparse[dense[i]] = i;
+            }
+
+            return true;
+        }
+
         Type& get(size_type index)
         {
             return denseValues[sparse[index]];
         }
 
+        // direct access to the dense values (ordered 1:1 with the dense array), e.g. for serialization
+        [[nodiscard]] std::vector<Type>& values()
+        {
+            return denseValues;
+        }
+
+        [[nodiscard]] std::vector<Type> const& values() const
+        {
+            return denseValues;
+        }
+
         // iterators, these enable range-based for loops
         [[nodiscard]] iterator begin()
         {
@@ -333,6 +602,36 @@ namespace entity
             denseValues.clear();
         }
 
+        [[nodiscard]] std::unique_ptr<SparseSetBase> makeEmpty() const override
+        {
+            return std::make_unique<SparseSet<Type>>();
+        }
+
+        bool instantiate(SparseSetBase const& source, EntityRemap const& remap, size_type count,
+                         ParallelFor const& parallelFor) override
+        {
+            // only instantiated for copyable types, so that move-only components still compile
+            if constexpr (std::is_copy_constructible_v<Type>)
+            {
+                instantiateCopies(static_cast<SparseSet<Type> const&>(source), remap, count, parallelFor);
+                return true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        [[nodiscard]] size_type valueSize() const override
+        {
+            return sizeof(Type);
+        }
+
+        [[nodiscard]] size_type memoryUsage() const override
+        {
+            return SparseSetBase::memoryUsage() + denseValues.capacity() * sizeof(Type);
+        }
+
     protected:
         void onSwap(entity::size_type lhsDenseIndex, entity::size_type rhsDenseIndex) override
         {
@@ -348,6 +647,69 @@ namespace entity
 
     private:
         std::vector<Type> denseValues; // contains values (ordered 1:1 with dense array)
+
+        // see instantiate()
+        void instantiateCopies(SparseSet<Type> const& s, EntityRemap const& remap, size_type count,
+                               ParallelFor const& parallelFor)
+        {
+            // gather the elements that are part of the prefab, so that each instance is a contiguous copy
+            // (this also makes instantiating from the set into itself safe)
+            std::vector<size_type> locals;
+            std::vector<Type> values;
+            for (size_type i = 0; i < s.dense.size(); i++)
+            {
+                size_type const sourceIndex = s.dense[i];
+                if (sourceIndex < remap.table.size() && remap.table[sourceIndex] != kNullEntityId)
+                {
+                    locals.emplace_back(remap.table[sourceIndex]);
+                    values.emplace_back(s.denseValues[i]);
+                }
+            }
+
+            size_type const n = locals.size();
+            if (n == 0 || count == 0)
+            {
+                return;
+            }
+
+            // allocate all instances up front
+            size_type const first = dense.size();
+            size_type const sparseSize = remap.firstId + count * remap.entityCount;
+            if (sparseSize > sparse.size())
+            {
+                sparse.resize(sparseSize, kNullEntityId);
+            }
+            dense.resize(first + count * n);
+            denseValues.resize(first + count * n);
+
+            auto copy = [&](size_type begin, size_type end) {
+                for (size_type instance = begin; instance < end; instance++)
+                {
+                    size_type const offset = first + instance * n;
+                    size_type const base = remap.firstId + instance * remap.entityCount;
+                    std::copy(values.begin(), values.end(), denseValues.begin() + static_cast<std::ptrdiff_t>(offset));
+                    for (size_type i = 0; i < n; i++)
+                    {
+                        size_type const index = base + locals[i];
+                        dense[offset + i] = index;
+                        sparse[index] = offset + i;
+                        if constexpr (RemapEntityIds<Type>::enabled)
+                        {
+                            RemapEntityIds<Type>::remap(denseValues[offset + i], remap, instance);
+                        }
+                    }
+                }
+            };
+
+            if (parallelFor)
+            {
+                parallelFor(count, copy);
+            }
+            else
+            {
+                copy(0, count);
+            }
+        }
     };
 }
 
@@ -0,0 +1,75 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "cpu_buffer.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace graphics::cpu
+{
+    CpuBuffer::CpuBuffer(BufferDescriptor const& descriptor, void* source, bool take) : Buffer(descriptor)
+    {
+        assert(source && "source should not be nullptr");
+
+        if (take)
+        {
+            data = source;
+        }
+        else
+        {
+            data = std::malloc(descriptor_.size);
+            assert(data && "failed to allocate buffer");
+            std::memcpy(data, source, descriptor_.size);
+        }
+    }
+
+    CpuBuffer::CpuBuffer(BufferDescriptor const& descriptor) : Buffer(descriptor)
+    {
+        data = std::calloc(descriptor_.size, 1);
+        assert((data || descriptor_.size == 0) && "failed to allocate buffer");
+    }
+
+    CpuBuffer::~CpuBuffer()
+    {
+        std::free(data);
+    }
+
+    void CpuBuffer::set(void* source, size_t size, size_t offset, bool synchronize_)
+    {
+        assert(offset + size <= descriptor_.size && "attempted to set memory outside range of buffer");
+        std::memcpy(static_cast<char*>(data) + offset, source, size);
+    }
+
+    void CpuBuffer::set(void* source, bool synchronize_)
+    {
+        set(source, descriptor_.size, 0, synchronize_);
+    }
+
+    void* CpuBuffer::take()
+    {
+        void* copy = std::malloc(descriptor_.size);
+        assert((copy || descriptor_.size == 0) && "failed to allocate buffer");
+        std::memcpy(copy, data, descriptor_.size);
+        return copy;
+    }
+
+    void* CpuBuffer::get()
+    {
+        return data;
+    }
+
+    void CpuBuffer::synchronize(size_t size, size_t offset)
+    {
+    }
+
+    void CpuBuffer::synchronize()
+    {
+    }
+
+    bool CpuBuffer::requiresSynchronization() const
+    {
+        return false;
+    }
+}
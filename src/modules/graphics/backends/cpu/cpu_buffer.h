@@ -0,0 +1,51 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_CPU_BUFFER_H
+#define SHAPEREALITY_CPU_BUFFER_H
+
+#include <graphics/buffer.h>
+
+namespace graphics::cpu
+{
+    // buffer that lives in CPU memory, regardless of its usage flags
+    class CpuBuffer final : public Buffer
+    {
+    public:
+        // if take is true, takes ownership of `source` (allocated using malloc) instead of copying it
+        explicit CpuBuffer(BufferDescriptor const& descriptor, void* source, bool take);
+
+        // zero initialized
+        explicit CpuBuffer(BufferDescriptor const& descriptor);
+
+        ~CpuBuffer() override;
+
+        CpuBuffer(CpuBuffer const&) = delete;
+
+        CpuBuffer& operator=(CpuBuffer const&) = delete;
+
+        // Buffer implementation
+
+        void set(void* source, size_t size, size_t offset, bool synchronize) override;
+
+        void set(void* source, bool synchronize) override;
+
+        // returns a copy allocated using malloc, which the caller should free
+        [[nodiscard]] void* take() override;
+
+        [[nodiscard]] void* get() override;
+
+        void synchronize(size_t size, size_t offset) override;
+
+        void synchronize() override;
+
+        // always false, there is no GPU copy
+        [[nodiscard]] bool requiresSynchronization() const override;
+
+    private:
+        void* data = nullptr; // allocated using malloc
+    };
+}
+
+#endif //SHAPEREALITY_CPU_BUFFER_H
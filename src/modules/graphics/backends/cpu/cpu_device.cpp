@@ -0,0 +1,72 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "cpu_device.h"
+#include "cpu_buffer.h"
+#include "cpu_texture.h"
+
+#include <graphics/window.h>
+#include <graphics/command_queue.h>
+#include <graphics/render_pipeline_state.h>
+#include <graphics/shader.h>
+
+namespace graphics::cpu
+{
+    CpuDevice::CpuDevice() = default;
+
+    CpuDevice::~CpuDevice() = default;
+
+    std::unique_ptr<Window>
+    CpuDevice::createWindow(WindowDescriptor const& descriptor) const
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<ICommandQueue>
+    CpuDevice::createCommandQueue(CommandQueueDescriptor const& descriptor) const
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<IRenderPipelineState>
+    CpuDevice::createRenderPipelineState(RenderPipelineDescriptor const& descriptor) const
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<IDepthStencilState>
+    CpuDevice::createDepthStencilState(DepthStencilDescriptor const& descriptor) const
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<IShaderLibrary>
+    CpuDevice::createShaderLibrary(std::filesystem::path const& path) const
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<Buffer>
+    CpuDevice::createBuffer(BufferDescriptor const& descriptor, void* source, bool take) const
+    {
+        return std::make_unique<CpuBuffer>(descriptor, source, take);
+    }
+
+    std::unique_ptr<Buffer>
+    CpuDevice::createBuffer(BufferDescriptor const& descriptor) const
+    {
+        return std::make_unique<CpuBuffer>(descriptor);
+    }
+
+    std::unique_ptr<ITexture>
+    CpuDevice::createTexture(TextureDescriptor const& descriptor) const
+    {
+        return std::make_unique<CpuTexture>(descriptor);
+    }
+
+    ICommandQueue* CpuDevice::transferCommandQueue() const
+    {
+        return nullptr;
+    }
+}
@@ -0,0 +1,62 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_CPU_DEVICE_H
+#define SHAPEREALITY_CPU_DEVICE_H
+
+#include <graphics/device.h>
+
+/**
+ * @namespace graphics::cpu
+ * @brief Headless backend that keeps buffers and textures in CPU memory
+ *
+ * Used for running the asset pipeline without a GPU (e.g. on build machines, see asset_cook), so that
+ * importers can create meshes and textures and write them to the import cache or an asset archive.
+ * Only supports creating buffers and textures, as nothing can be rendered.
+ */
+namespace graphics::cpu
+{
+    class CpuDevice final : public IDevice
+    {
+    public:
+        explicit CpuDevice();
+
+        ~CpuDevice() override;
+
+        // returns nullptr, there is nothing to present to
+        [[nodiscard]] std::unique_ptr<Window>
+        createWindow(WindowDescriptor const& descriptor) const override;
+
+        // returns nullptr, command buffers can't be executed
+        [[nodiscard]] std::unique_ptr<ICommandQueue>
+        createCommandQueue(CommandQueueDescriptor const& descriptor) const override;
+
+        // returns nullptr
+        [[nodiscard]] std::unique_ptr<IRenderPipelineState>
+        createRenderPipelineState(RenderPipelineDescriptor const& descriptor) const override;
+
+        // returns nullptr
+        [[nodiscard]] std::unique_ptr<IDepthStencilState>
+        createDepthStencilState(DepthStencilDescriptor const& descriptor) const override;
+
+        // returns nullptr
+        [[nodiscard]] std::unique_ptr<IShaderLibrary>
+        createShaderLibrary(std::filesystem::path const& path) const override;
+
+        // if take is true, `source` should have been allocated using malloc, as the buffer frees it using free
+        [[nodiscard]] std::unique_ptr<Buffer>
+        createBuffer(BufferDescriptor const& descriptor, void* source, bool take) const override;
+
+        [[nodiscard]] std::unique_ptr<Buffer>
+        createBuffer(BufferDescriptor const& descriptor) const override;
+
+        [[nodiscard]] std::unique_ptr<ITexture>
+        createTexture(TextureDescriptor const& descriptor) const override;
+
+        // returns nullptr, as buffers are set directly
+        [[nodiscard]] ICommandQueue* transferCommandQueue() const override;
+    };
+}
+
+#endif //SHAPEREALITY_CPU_DEVICE_H
@@ -0,0 +1,97 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "cpu_texture.h"
+
+#include <cstring>
+
+namespace graphics::cpu
+{
+    CpuTexture::CpuTexture(TextureDescriptor const& descriptor_) : descriptor(descriptor_)
+    {
+        pixels.resize(getTextureSize(descriptor));
+        for (unsigned int level = 0; level < descriptor.mipmapLevelCount; level++)
+        {
+            if (void const* data = getMipmapLevelData(descriptor, level))
+            {
+                std::memcpy(pixels.data() + getMipmapLevelOffset(descriptor.pixelFormat, descriptor.width, descriptor.height, level),
+                            data, getImageSize(descriptor.pixelFormat, getMipmapLevelSize(descriptor.width, level),
+                                               getMipmapLevelSize(descriptor.height, level)));
+            }
+        }
+        descriptor.data = nullptr;
+        descriptor.mipmapLevelData = {};
+    }
+
+    CpuTexture::~CpuTexture() = default;
+
+    TextureType CpuTexture::getTextureType() const
+    {
+        return TextureType::Type2D;
+    }
+
+    PixelFormat CpuTexture::getPixelFormat() const
+    {
+        return descriptor.pixelFormat;
+    }
+
+    unsigned int CpuTexture::getWidth() const
+    {
+        return descriptor.width;
+    }
+
+    unsigned int CpuTexture::getHeight() const
+    {
+        return descriptor.height;
+    }
+
+    unsigned int CpuTexture::getDepth() const
+    {
+        return 1;
+    }
+
+    unsigned int CpuTexture::getMipmapLevelCount() const
+    {
+        return descriptor.mipmapLevelCount;
+    }
+
+    unsigned int CpuTexture::getArrayLength() const
+    {
+        return 1;
+    }
+
+    std::uint8_t CpuTexture::getSampleCount() const
+    {
+        return 1;
+    }
+
+    bool CpuTexture::getIsFramebufferOnly() const
+    {
+        return false;
+    }
+
+    TextureUsage_ CpuTexture::getUsage() const
+    {
+        return descriptor.usage;
+    }
+
+    bool CpuTexture::getBytes(void* destination, size_t bytesPerRow, unsigned int mipmapLevel) const
+    {
+        size_t const rowSize = getBytesPerRow(descriptor.pixelFormat, getMipmapLevelSize(descriptor.width, mipmapLevel));
+        if (mipmapLevel >= descriptor.mipmapLevelCount || bytesPerRow < rowSize)
+        {
+            return false;
+        }
+
+        // rows of blocks, which are rows of pixels for uncompressed pixel formats
+        size_t const rowCount = getImageSize(descriptor.pixelFormat, getMipmapLevelSize(descriptor.width, mipmapLevel),
+                                             getMipmapLevelSize(descriptor.height, mipmapLevel)) / rowSize;
+        uint8_t const* level = pixels.data() + getMipmapLevelOffset(descriptor.pixelFormat, descriptor.width, descriptor.height, mipmapLevel);
+        for (size_t y = 0; y < rowCount; y++)
+        {
+            std::memcpy(static_cast<uint8_t*>(destination) + y * bytesPerRow, level + y * rowSize, rowSize);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,53 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_CPU_TEXTURE_H
+#define SHAPEREALITY_CPU_TEXTURE_H
+
+#include <graphics/texture.h>
+
+#include <vector>
+
+namespace graphics::cpu
+{
+    // 2D texture that lives in CPU memory, e.g. for importing textures without a GPU. all mipmap levels are
+    // stored after each other, like in TextureDescriptor::data (see getPixelFormatBlock() for the supported formats)
+    class CpuTexture final : public ITexture
+    {
+    public:
+        explicit CpuTexture(TextureDescriptor const& descriptor);
+
+        ~CpuTexture() override;
+
+        // ITexture interface
+
+        [[nodiscard]] TextureType getTextureType() const override;
+
+        [[nodiscard]] PixelFormat getPixelFormat() const override;
+
+        [[nodiscard]] unsigned int getWidth() const override;
+
+        [[nodiscard]] unsigned int getHeight() const override;
+
+        [[nodiscard]] unsigned int getDepth() const override;
+
+        [[nodiscard]] unsigned int getMipmapLevelCount() const override;
+
+        [[nodiscard]] unsigned int getArrayLength() const override;
+
+        [[nodiscard]] std::uint8_t getSampleCount() const override;
+
+        [[nodiscard]] bool getIsFramebufferOnly() const override;
+
+        [[nodiscard]] TextureUsage_ getUsage() const override;
+
+        [[nodiscard]] bool getBytes(void* destination, size_t bytesPerRow, unsigned int mipmapLevel) const override;
+
+    private:
+        TextureDescriptor descriptor; // data and mipmapLevelData are not used, as they are copied to pixels
+        std::vector<uint8_t> pixels; // all mipmap levels
+    };
+}
+
+#endif //SHAPEREALITY_CPU_TEXTURE_H
@@ -71,7 +71,6 @@ namespace graphics::metal
         : Buffer(descriptor), device(device_)
     {
         assert(descriptor.usage != BufferUsage_None && "buffer should at least have one use flag specified");
-        assert(!take && "taking ownership of the provided source data is not yet implemented");
 
         id <MTLDevice> metalDevice = static_cast<MetalDevice const*>(device)->metalDevice();
 
@@ -103,6 +102,12 @@ namespace graphics::metal
             }
         }
 
+        // the data has been copied, todo: use newBufferWithBytesNoCopy for page aligned shared buffers
+        if (take)
+        {
+            free(source);
+        }
+
         [buffer retain];
     }
 
@@ -49,6 +49,8 @@ namespace graphics::metal
 
         [[nodiscard]] TextureUsage_ getUsage() const override;
 
+        [[nodiscard]] bool getBytes(void* destination, size_t bytesPerRow, unsigned int mipmapLevel) const override;
+
     private:
         id <MTLTexture> _Nullable texture{nullptr};
         id <MTLDrawable> _Nullable drawable{nullptr};
@@ -21,22 +21,29 @@ namespace graphics::metal
         metalDescriptor.textureType = MTLTextureType2D;
         metalDescriptor.usage = convert(descriptor.usage);
         metalDescriptor.arrayLength = 1;
-
-        //metalDescriptor.mipmapLevelCount = 0;
+        metalDescriptor.mipmapLevelCount = descriptor.mipmapLevelCount;
 
         // todo: don't make these assumptions, just expose the entire texture API, including replaceRegion
 
         texture = [device newTextureWithDescriptor:metalDescriptor];
         [texture retain];
 
-        if (descriptor.data != nullptr)
+        // the mipmap levels are precomputed (e.g. at import), so they are uploaded instead of generated at runtime
+        for (unsigned int level = 0; level < descriptor.mipmapLevelCount; level++)
         {
-            MTLRegion region = MTLRegionMake2D(0, 0, descriptor.width, descriptor.height);
+            void const* data = getMipmapLevelData(descriptor, level);
+            if (data == nullptr)
+            {
+                break;
+            }
+            unsigned int const width = getMipmapLevelSize(descriptor.width, level);
+            unsigned int const height = getMipmapLevelSize(descriptor.height, level);
+            MTLRegion region = MTLRegionMake2D(0, 0, width, height);
             [texture replaceRegion:region
-                      mipmapLevel:0 // if no mipmaps: use 0
+                      mipmapLevel:level
                       slice:0 // for normal texture: use 0
-                      withBytes:descriptor.data
-                      bytesPerRow:descriptor.width * 4
+                      withBytes:data
+                      bytesPerRow:getBytesPerRow(descriptor.pixelFormat, width)
                       bytesPerImage:0]; // only a single image: use 0
         }
     }
@@ -127,4 +134,21 @@ namespace graphics::metal
     {
         return convertFromMetal(texture.usage);
     }
-}
\ No newline at end of file
+
+    bool MetalTexture::getBytes(void* destination, size_t bytesPerRow, unsigned int mipmapLevel) const
+    {
+        // private textures only live on the GPU and would require a blit to a shared texture first
+        if (texture == nullptr || texture.storageMode == MTLStorageModePrivate || mipmapLevel >= texture.mipmapLevelCount)
+        {
+            return false;
+        }
+
+        MTLRegion region = MTLRegionMake2D(0, 0, getMipmapLevelSize(texture.width, mipmapLevel),
+                                           getMipmapLevelSize(texture.height, mipmapLevel));
+        [texture getBytes:destination
+                 bytesPerRow:bytesPerRow
+                 fromRegion:region
+                 mipmapLevel:mipmapLevel];
+        return true;
+    }
+}
@@ -0,0 +1,293 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "ktx2.h"
+#include "device.h"
+
+#include <common/binary.h>
+#include <common/logger.h>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+namespace graphics
+{
+    constexpr std::array<uint8_t, 12> kKtx2Identifier{0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+    // identifier, header and index, after which the level index starts
+    constexpr size_t kKtx2HeaderSize = 80;
+    constexpr size_t kKtx2LevelIndexEntrySize = 24;
+
+    // data format descriptor (khronos basic descriptor block) values
+    constexpr uint8_t kColorModelRGBSDA = 1;
+    constexpr uint8_t kColorModelBC1A = 128;
+    constexpr uint8_t kColorModelBC2 = 129;
+    constexpr uint8_t kColorModelBC3 = 130;
+    constexpr uint8_t kColorModelBC4 = 131;
+    constexpr uint8_t kColorModelBC5 = 132;
+    constexpr uint8_t kColorModelBC7 = 134;
+    constexpr uint32_t kColorPrimariesBT709 = 1;
+    constexpr uint32_t kTransferFunctionLinear = 1;
+    constexpr uint32_t kTransferFunctionSRGB = 2;
+    constexpr uint8_t kChannelAlpha = 15;
+    constexpr uint8_t kChannelQualifierLinear = 1 << 4;
+
+    struct Ktx2Sample
+    {
+        uint8_t channel;
+        uint16_t bitOffset;
+        uint8_t bitLength;
+    };
+
+    struct Ktx2Format
+    {
+        PixelFormat pixelFormat;
+        uint32_t vkFormat;
+        uint8_t colorModel;
+        bool sRGB;
+        std::array<Ktx2Sample, 4> samples;
+        size_t sampleCount;
+    };
+
+    constexpr std::array<Ktx2Sample, 4> kRGBA8Samples{Ktx2Sample{0, 0, 8}, {1, 8, 8}, {2, 16, 8}, {kChannelAlpha, 24, 8}};
+    constexpr std::array<Ktx2Sample, 4> kBGRA8Samples{Ktx2Sample{2, 0, 8}, {1, 8, 8}, {0, 16, 8}, {kChannelAlpha, 24, 8}};
+    constexpr std::array<Ktx2Sample, 4> kAlphaColorSamples{Ktx2Sample{kChannelAlpha, 0, 64}, {0, 64, 64}}; // BC2 and BC3
+
+    constexpr std::array<Ktx2Format, 14> kKtx2Formats{
+        Ktx2Format{PixelFormat::RGBA8Unorm, 37, kColorModelRGBSDA, false, kRGBA8Samples, 4},
+        Ktx2Format{PixelFormat::RGBA8Unorm_sRGB, 43, kColorModelRGBSDA, true, kRGBA8Samples, 4},
+        Ktx2Format{PixelFormat::BGRA8Unorm, 44, kColorModelRGBSDA, false, kBGRA8Samples, 4},
+        Ktx2Format{PixelFormat::BGRA8Unorm_sRGB, 50, kColorModelRGBSDA, true, kBGRA8Samples, 4},
+        Ktx2Format{PixelFormat::BC1_RGBA, 133, kColorModelBC1A, false, {Ktx2Sample{1, 0, 64}}, 1}, // alpha present
+        Ktx2Format{PixelFormat::BC1_RGBA_sRGB, 134, kColorModelBC1A, true, {Ktx2Sample{1, 0, 64}}, 1},
+        Ktx2Format{PixelFormat::BC2_RGBA, 135, kColorModelBC2, false, kAlphaColorSamples, 2},
+        Ktx2Format{PixelFormat::BC2_RGBA_sRGB, 136, kColorModelBC2, true, kAlphaColorSamples, 2},
+        Ktx2Format{PixelFormat::BC3_RGBA, 137, kColorModelBC3, false, kAlphaColorSamples, 2},
+        Ktx2Format{PixelFormat::BC3_RGBA_sRGB, 138, kColorModelBC3, true, kAlphaColorSamples, 2},
+        Ktx2Format{PixelFormat::BC4_RUnorm, 139, kColorModelBC4, false, {Ktx2Sample{0, 0, 64}}, 1},
+        Ktx2Format{PixelFormat::BC5_RGUnorm, 141, kColorModelBC5, false, {Ktx2Sample{0, 0, 64}, {1, 64, 64}}, 2},
+        Ktx2Format{PixelFormat::BC7_RGBAUnorm, 145, kColorModelBC7, false, {Ktx2Sample{0, 0, 128}}, 1},
+        Ktx2Format{PixelFormat::BC7_RGBAUnorm_sRGB, 146, kColorModelBC7, true, {Ktx2Sample{0, 0, 128}}, 1}
+    };
+
+    [[nodiscard]] static Ktx2Format const* findFormat(PixelFormat pixelFormat)
+    {
+        auto it = std::ranges::find(kKtx2Formats, pixelFormat, &Ktx2Format::pixelFormat);
+        return it != kKtx2Formats.end() ? &*it : nullptr;
+    }
+
+    [[nodiscard]] static Ktx2Format const* findFormat(uint32_t vkFormat)
+    {
+        auto it = std::ranges::find(kKtx2Formats, vkFormat, &Ktx2Format::vkFormat);
+        return it != kKtx2Formats.end() ? &*it : nullptr;
+    }
+
+    uint32_t getVkFormat(PixelFormat pixelFormat)
+    {
+        Ktx2Format const* format = findFormat(pixelFormat);
+        return format ? format->vkFormat : 0;
+    }
+
+    // data format descriptor with a single basic descriptor block, which KTX2 requires to describe the pixel format
+    [[nodiscard]] static std::vector<uint32_t> createDataFormatDescriptor(Ktx2Format const& format)
+    {
+        PixelFormatBlock const block = getPixelFormatBlock(format.pixelFormat);
+        bool const compressed = block.width > 1;
+        auto const blockSize = static_cast<uint32_t>(24 + 16 * format.sampleCount);
+
+        std::vector<uint32_t> out{
+            4 + blockSize, // total size
+            0, // vendor id and descriptor type (khronos, basic)
+            2 | blockSize << 16, // version and descriptor block size
+            format.colorModel | kColorPrimariesBT709 << 8 |
+            (format.sRGB ? kTransferFunctionSRGB : kTransferFunctionLinear) << 16, // flags: straight alpha
+            (block.width - 1) | (block.height - 1) << 8,
+            block.size, // bytes of plane 0
+            0
+        };
+        for (size_t i = 0; i < format.sampleCount; i++)
+        {
+            Ktx2Sample const& sample = format.samples[i];
+            // alpha is linear, also if the color channels are sRGB
+            uint32_t const channelType = sample.channel | (format.sRGB && sample.channel == kChannelAlpha ? kChannelQualifierLinear : 0);
+            out.insert(out.end(), {
+                sample.bitOffset | static_cast<uint32_t>(sample.bitLength - 1) << 16 | channelType << 24,
+                0, // sample position
+                0, // lower
+                compressed ? 0xFFFFFFFF : (1u << sample.bitLength) - 1 // upper
+            });
+        }
+        return out;
+    }
+
+    bool writeKtx2(ITexture const& texture, std::ostream& out)
+    {
+        PixelFormat const pixelFormat = texture.getPixelFormat();
+        Ktx2Format const* format = findFormat(pixelFormat);
+        if (format == nullptr)
+        {
+            return false;
+        }
+
+        unsigned int const width = texture.getWidth();
+        unsigned int const height = texture.getHeight();
+        unsigned int const levelCount = texture.getMipmapLevelCount();
+        std::vector<uint32_t> const dataFormatDescriptor = createDataFormatDescriptor(*format);
+
+        // levels are stored from the smallest to the largest, each aligned to the block size and 4 bytes
+        size_t const alignment = std::lcm(static_cast<size_t>(getPixelFormatBlock(pixelFormat).size), size_t{4});
+        size_t const dataFormatDescriptorOffset = kKtx2HeaderSize + levelCount * kKtx2LevelIndexEntrySize;
+        std::vector<uint64_t> levelOffsets(levelCount);
+        size_t offset = dataFormatDescriptorOffset + dataFormatDescriptor.size() * sizeof(uint32_t);
+        for (unsigned int level = levelCount; level-- > 0;)
+        {
+            offset = (offset + alignment - 1) / alignment * alignment;
+            levelOffsets[level] = offset;
+            offset += getImageSize(pixelFormat, getMipmapLevelSize(width, level), getMipmapLevelSize(height, level));
+        }
+
+        out.write(reinterpret_cast<char const*>(kKtx2Identifier.data()), kKtx2Identifier.size());
+        common::binary::write(out, format->vkFormat);
+        common::binary::write(out, uint32_t{1}); // type size
+        common::binary::write(out, static_cast<uint32_t>(width));
+        common::binary::write(out, static_cast<uint32_t>(height));
+        common::binary::write(out, uint32_t{0}); // depth
+        common::binary::write(out, uint32_t{0}); // layer count, not an array texture
+        common::binary::write(out, uint32_t{1}); // face count
+        common::binary::write(out, static_cast<uint32_t>(levelCount));
+        common::binary::write(out, static_cast<uint32_t>(Ktx2Supercompression::None));
+
+        // index: data format descriptor, key / value data and supercompression global data
+        common::binary::write(out, static_cast<uint32_t>(dataFormatDescriptorOffset));
+        common::binary::write(out, static_cast<uint32_t>(dataFormatDescriptor.size() * sizeof(uint32_t)));
+        common::binary::write(out, uint32_t{0});
+        common::binary::write(out, uint32_t{0});
+        common::binary::write(out, uint64_t{0});
+        common::binary::write(out, uint64_t{0});
+
+        for (unsigned int level = 0; level < levelCount; level++)
+        {
+            uint64_t const size = getImageSize(pixelFormat, getMipmapLevelSize(width, level), getMipmapLevelSize(height, level));
+            common::binary::write(out, levelOffsets[level]);
+            common::binary::write(out, size);
+            common::binary::write(out, size); // uncompressed size
+        }
+        for (uint32_t value: dataFormatDescriptor)
+        {
+            common::binary::write(out, value);
+        }
+
+        size_t position = dataFormatDescriptorOffset + dataFormatDescriptor.size() * sizeof(uint32_t);
+        std::vector<uint8_t> data;
+        for (unsigned int level = levelCount; level-- > 0;)
+        {
+            unsigned int const levelWidth = getMipmapLevelSize(width, level);
+            data.assign(levelOffsets[level] - position, 0); // padding
+            out.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+            data.resize(getImageSize(pixelFormat, levelWidth, getMipmapLevelSize(height, level)));
+            if (!texture.getBytes(data.data(), getBytesPerRow(pixelFormat, levelWidth), level))
+            {
+                return false;
+            }
+            out.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+            position = levelOffsets[level] + data.size();
+        }
+        return out.good();
+    }
+
+    std::unique_ptr<ITexture> readKtx2(IDevice* device, std::istream& in)
+    {
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        return readKtx2(device, std::span<uint8_t const>(data));
+    }
+
+    std::unique_ptr<ITexture> readKtx2(IDevice* device, std::span<uint8_t const> data)
+    {
+        common::binary::MemoryReader in(data);
+
+        std::span<uint8_t const> identifier;
+        if (!in.readBlock(kKtx2Identifier.size(), identifier) || !std::ranges::equal(identifier, kKtx2Identifier))
+        {
+            return nullptr;
+        }
+
+        uint32_t vkFormat = 0;
+        uint32_t typeSize = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t depth = 0;
+        uint32_t layerCount = 0;
+        uint32_t faceCount = 0;
+        uint32_t levelCount = 0;
+        uint32_t supercompression = 0;
+        if (!in.read(vkFormat) || !in.read(typeSize) || !in.read(width) || !in.read(height) || !in.read(depth) ||
+            !in.read(layerCount) || !in.read(faceCount) || !in.read(levelCount) || !in.read(supercompression))
+        {
+            return nullptr;
+        }
+
+        // the data format descriptor, key / value data and supercompression global data are not needed,
+        // as vkFormat describes all supported pixel formats
+        std::span<uint8_t const> index;
+        if (!in.readBlock(kKtx2HeaderSize - kKtx2Identifier.size() - 9 * sizeof(uint32_t), index))
+        {
+            return nullptr;
+        }
+
+        if (depth != 0 || layerCount > 1 || faceCount != 1)
+        {
+            common::log::error("Only 2D textures are supported in KTX2 files");
+            return nullptr;
+        }
+        if (supercompression != static_cast<uint32_t>(Ktx2Supercompression::None))
+        {
+            common::log::error("Unsupported KTX2 supercompression scheme {}", supercompression);
+            return nullptr;
+        }
+        Ktx2Format const* format = findFormat(vkFormat);
+        if (format == nullptr)
+        {
+            common::log::error("Unsupported KTX2 vkFormat {}", vkFormat);
+            return nullptr;
+        }
+
+        levelCount = std::max(levelCount, 1u); // 0 means the mipmap levels should be generated, which we don't do
+        if (width == 0 || height == 0 || levelCount > getFullMipmapLevelCount(width, height))
+        {
+            return nullptr;
+        }
+
+        std::vector<void const*> levels(levelCount);
+        for (unsigned int level = 0; level < levelCount; level++)
+        {
+            uint64_t offset = 0;
+            uint64_t size = 0;
+            uint64_t uncompressedSize = 0;
+            if (!in.read(offset) || !in.read(size) || !in.read(uncompressedSize))
+            {
+                return nullptr;
+            }
+            if (size != getImageSize(format->pixelFormat, getMipmapLevelSize(width, level), getMipmapLevelSize(height, level)) ||
+                offset > data.size() || size > data.size() - offset)
+            {
+                return nullptr;
+            }
+            levels[level] = data.data() + offset;
+        }
+
+        TextureDescriptor const descriptor{
+            .width = width,
+            .height = height,
+            .pixelFormat = format->pixelFormat,
+            .usage = TextureUsage_ShaderRead, // KTX2 doesn't store the usage, imported textures are only sampled
+            .mipmapLevelCount = levelCount,
+            .mipmapLevelData = levels
+        };
+        return device->createTexture(descriptor);
+    }
+}
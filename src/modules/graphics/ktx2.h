@@ -0,0 +1,46 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_KTX2_H
+#define SHAPEREALITY_KTX2_H
+
+#include <graphics/texture.h>
+
+#include <memory>
+#include <span>
+#include <cstdint>
+#include <iosfwd>
+
+namespace graphics
+{
+    class IDevice;
+
+    // KTX 2.0 (https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html) is the native format of imported textures,
+    // so that cached and shipped textures can be inspected with other tools, and get loaded without decoding
+
+    enum class Ktx2Supercompression : uint32_t
+    {
+        None = 0,
+        BasisLZ = 1,
+        Zstandard = 2,
+        Zlib = 3
+    };
+
+    // VkFormat of the pixel format, or 0 (VK_FORMAT_UNDEFINED) if it can't be stored in a KTX2 file yet
+    [[nodiscard]] uint32_t getVkFormat(PixelFormat pixelFormat);
+
+    // writes the texture including all its mipmap levels, without supercompression.
+    // returns false if the pixel format is not supported, or the texture's data can't be read from the CPU
+    [[nodiscard]] bool writeKtx2(ITexture const& texture, std::ostream& out);
+
+    // reads a 2D texture from a KTX2 file and creates it on the provided device
+    [[nodiscard]] std::unique_ptr<ITexture> readKtx2(IDevice* device, std::istream& in);
+
+    // reads a 2D texture from a KTX2 file in memory (e.g. a memory mapped asset archive). the mipmap levels are
+    // uploaded directly from the provided memory, without copying them first.
+    // array textures, cube maps and supercompressed files are not supported yet
+    [[nodiscard]] std::unique_ptr<ITexture> readKtx2(IDevice* device, std::span<uint8_t const> data);
+}
+
+#endif //SHAPEREALITY_KTX2_H
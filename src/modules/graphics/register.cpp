@@ -7,6 +7,8 @@
 #include <reflection/enum.h>
 #include <graphics/types.h>
 #include <graphics/texture.h>
+#include <graphics/ktx2.h>
+#include <asset/asset_database.h>
 
 namespace graphics
 {
@@ -24,7 +26,36 @@ namespace graphics
     void register_(asset::AssetTypeRegistry& assetTypes)
     {
         assetTypes.emplace<ITexture>(asset::AssetType{
-            .fileExtension = "texture"
+            .fileExtension = "ktx2",
+            .save = [](asset::AssetHandle& asset, std::ostream& out) {
+                return writeKtx2(asset.get<ITexture>(), out);
+            },
+            .load = [](asset::AssetDatabaseContext const& context, std::istream& in, asset::AssetHandle& asset) {
+                std::unique_ptr<ITexture> texture = readKtx2(context.device, in);
+                if (!texture)
+                {
+                    return false;
+                }
+                asset.set<ITexture>(std::move(texture));
+                return true;
+            },
+            .loadFromMemory = [](asset::AssetDatabaseContext const& context, std::span<uint8_t const> data,
+                                 asset::AssetHandle& asset) {
+                std::unique_ptr<ITexture> texture = readKtx2(context.device, data);
+                if (!texture)
+                {
+                    return false;
+                }
+                asset.set<ITexture>(std::move(texture));
+                return true;
+            },
+            .memoryUsage = [](asset::AssetHandle& asset) {
+                ITexture& texture = asset.get<ITexture>();
+                size_t const size = getMipmapLevelOffset(texture.getPixelFormat(), texture.getWidth(), texture.getHeight(),
+                                                         texture.getMipmapLevelCount()) *
+                                    texture.getDepth() * texture.getArrayLength();
+                return asset::AssetMemory{.device = size};
+            }
         });
     }
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "texture.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace graphics
+{
+    PixelFormatBlock getPixelFormatBlock(PixelFormat pixelFormat)
+    {
+        switch (pixelFormat)
+        {
+            case PixelFormat::RGBA8Unorm:
+            case PixelFormat::RGBA8Unorm_sRGB:
+            case PixelFormat::RGBA8Snorm:
+            case PixelFormat::RGBA8Uint:
+            case PixelFormat::RGBA8Sint:
+            case PixelFormat::BGRA8Unorm:
+            case PixelFormat::BGRA8Unorm_sRGB: return PixelFormatBlock{1, 1, 4};
+            case PixelFormat::BC1_RGBA:
+            case PixelFormat::BC1_RGBA_sRGB:
+            case PixelFormat::BC4_RUnorm:
+            case PixelFormat::BC4_RSnorm: return PixelFormatBlock{4, 4, 8};
+            case PixelFormat::BC2_RGBA:
+            case PixelFormat::BC2_RGBA_sRGB:
+            case PixelFormat::BC3_RGBA:
+            case PixelFormat::BC3_RGBA_sRGB:
+            case PixelFormat::BC5_RGUnorm:
+            case PixelFormat::BC5_RGSnorm:
+            case PixelFormat::BC6H_RGBFloat:
+            case PixelFormat::BC6H_RGBUfloat:
+            case PixelFormat::BC7_RGBAUnorm:
+            case PixelFormat::BC7_RGBAUnorm_sRGB: return PixelFormatBlock{4, 4, 16};
+            default: return PixelFormatBlock{1, 1, 0};
+        }
+    }
+
+    size_t getBytesPerRow(PixelFormat pixelFormat, unsigned int width)
+    {
+        PixelFormatBlock const block = getPixelFormatBlock(pixelFormat);
+        return static_cast<size_t>((width + block.width - 1) / block.width) * block.size;
+    }
+
+    size_t getImageSize(PixelFormat pixelFormat, unsigned int width, unsigned int height)
+    {
+        PixelFormatBlock const block = getPixelFormatBlock(pixelFormat);
+        return getBytesPerRow(pixelFormat, width) * ((height + block.height - 1) / block.height);
+    }
+
+    unsigned int getFullMipmapLevelCount(unsigned int width, unsigned int height)
+    {
+        return static_cast<unsigned int>(std::bit_width(std::max({width, height, 1u})));
+    }
+
+    size_t getMipmapLevelOffset(PixelFormat pixelFormat, unsigned int width, unsigned int height, unsigned int mipmapLevel)
+    {
+        size_t offset = 0;
+        for (unsigned int i = 0; i < mipmapLevel; i++)
+        {
+            offset += getImageSize(pixelFormat, getMipmapLevelSize(width, i), getMipmapLevelSize(height, i));
+        }
+        return offset;
+    }
+
+    size_t getTextureSize(TextureDescriptor const& descriptor)
+    {
+        return getMipmapLevelOffset(descriptor.pixelFormat, descriptor.width, descriptor.height, descriptor.mipmapLevelCount);
+    }
+
+    void const* getMipmapLevelData(TextureDescriptor const& descriptor, unsigned int mipmapLevel)
+    {
+        if (!descriptor.mipmapLevelData.empty())
+        {
+            return descriptor.mipmapLevelData[mipmapLevel];
+        }
+        if (descriptor.data == nullptr)
+        {
+            return nullptr;
+        }
+        return static_cast<uint8_t const*>(descriptor.data) +
+               getMipmapLevelOffset(descriptor.pixelFormat, descriptor.width, descriptor.height, mipmapLevel);
+    }
+}
\ No newline at end of file
@@ -7,6 +7,10 @@
 
 #include <graphics/types.h>
 #include <utility>
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <cstdint>
 
 namespace graphics
 {
@@ -42,18 +46,62 @@ namespace graphics
         PixelFormat pixelFormat;
         TextureUsage_ usage;
 
-        // data of the texture
+        // amount of mipmap levels, including level 0. each level is half the size of the previous level
+        // (rounded down, at least 1), see getFullMipmapLevelCount() for a full mip chain
+        unsigned int mipmapLevelCount{1};
+
+        // data of the texture, all mipmap levels tightly packed after each other, starting with level 0
         void const* data{nullptr};
 
+        // data of each mipmap level, used instead of data if not empty. for uploading the levels directly from
+        // where they are, e.g. a KTX2 file, which stores the smallest level first
+        std::span<void const* const> mipmapLevelData;
+
         // size in bytes of the texture is calculated
-        // from the width, height and pixel format,
-        // so we don't have to specify it on texture creation
+        // from the width, height, mipmap level count and pixel format,
+        // so we don't have to specify it on texture creation (see getTextureSize())
 
         // todo: add all texture properties
         // e.g. depth, storage mode, anti-aliasing
-        // mip-mapping
     };
 
+    // amount of mipmap levels of a full mip chain, down to 1x1
+    [[nodiscard]] unsigned int getFullMipmapLevelCount(unsigned int width, unsigned int height);
+
+    // width or height of the given mipmap level
+    [[nodiscard]] constexpr unsigned int getMipmapLevelSize(unsigned int size, unsigned int mipmapLevel)
+    {
+        return std::max(size >> mipmapLevel, 1u);
+    }
+
+    // pixels are stored in blocks, 1x1 for uncompressed pixel formats and 4x4 for block compressed pixel formats (e.g. BC7)
+    struct PixelFormatBlock
+    {
+        unsigned int width;
+        unsigned int height;
+        unsigned int size; // in bytes
+    };
+
+    // returns a block with size 0 if the pixel format can't be used for texture data yet
+    [[nodiscard]] PixelFormatBlock getPixelFormatBlock(PixelFormat pixelFormat);
+
+    // size in bytes of one row of blocks of an image with the given width
+    [[nodiscard]] size_t getBytesPerRow(PixelFormat pixelFormat, unsigned int width);
+
+    // size in bytes of one image (e.g. a mipmap level), partial blocks at the edges take up a full block
+    [[nodiscard]] size_t getImageSize(PixelFormat pixelFormat, unsigned int width, unsigned int height);
+
+    // offset in bytes of the given mipmap level inside TextureDescriptor::data
+    [[nodiscard]] size_t getMipmapLevelOffset(PixelFormat pixelFormat, unsigned int width, unsigned int height,
+                                              unsigned int mipmapLevel);
+
+    // size in bytes of all mipmap levels of the texture
+    [[nodiscard]] size_t getTextureSize(TextureDescriptor const& descriptor);
+
+    // data of the mipmap level, from either TextureDescriptor::mipmapLevelData or TextureDescriptor::data.
+    // returns nullptr if the descriptor has no data
+    [[nodiscard]] void const* getMipmapLevelData(TextureDescriptor const& descriptor, unsigned int mipmapLevel);
+
     class ITexture
     {
     public:
@@ -80,6 +128,10 @@ namespace graphics
         [[nodiscard]] virtual bool getIsFramebufferOnly() const = 0;
 
         [[nodiscard]] virtual TextureUsage_ getUsage() const = 0;
+
+        // copies the pixel data of the mipmap level to `destination`, which should be at least bytesPerRow * the amount
+        // of rows of blocks of the level (see getImageSize()). returns false if the texture's data can't be read from the CPU
+        [[nodiscard]] virtual bool getBytes(void* destination, size_t bytesPerRow, unsigned int mipmapLevel) const = 0;
     };
 }
 
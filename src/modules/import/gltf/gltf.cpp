@@ -9,9 +9,24 @@
 #include "cgltf.h"
 
 #include <iostream>
+#include <atomic>
+#include <mutex>
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+#include <span>
+#include <unordered_map>
 #include <asset/asset_database.h>
 #include <common/logger.h>
+#include <common/thread_pool.h>
+#include <common/mapped_file.h>
+#include <renderer/mesh_optimization.h>
+#include <renderer/mesh_quantization.h>
+#include <renderer/mesh_simplification.h>
+#include <renderer/mesh_renderer.h>
+#include <renderer/transform.h>
 #include <scene/scene.h>
+#include <entity/components/hierarchy.h>
 #include <reflection/enum.h>
 
 namespace import_::gltf
@@ -74,19 +89,514 @@ namespace import_::gltf
         }
     }
 
+    // cgltf file callbacks that memory map the gltf, glb and bin files instead of reading them into memory,
+    // so that vertex data gets copied straight from the mapped files into the mesh buffers
+    struct MappedFiles
+    {
+        std::unordered_map<void const*, std::unique_ptr<common::MappedFile>> files; // keyed by start of the mapping
+        std::mutex mutex;
+    };
+
+    cgltf_result readMappedFile(cgltf_memory_options const* memoryOptions, cgltf_file_options const* fileOptions,
+                                char const* path, cgltf_size* size, void** data)
+    {
+        auto* mappedFiles = static_cast<MappedFiles*>(fileOptions->user_data);
+        auto file = std::make_unique<common::MappedFile>(path);
+        if (!file->valid())
+        {
+            return cgltf_result_file_not_found;
+        }
+        if (file->data().empty())
+        {
+            return cgltf_result_data_too_short;
+        }
+
+        // cgltf only reads from the file data, so casting away const is safe
+        *size = file->data().size();
+        *data = const_cast<uint8_t*>(file->data().data());
+        std::lock_guard<std::mutex> guard(mappedFiles->mutex);
+        mappedFiles->files.emplace(*data, std::move(file));
+        return cgltf_result_success;
+    }
+
+    void releaseMappedFile(cgltf_memory_options const* memoryOptions, cgltf_file_options const* fileOptions, void* data)
+    {
+        auto* mappedFiles = static_cast<MappedFiles*>(fileOptions->user_data);
+        std::lock_guard<std::mutex> guard(mappedFiles->mutex);
+        mappedFiles->files.erase(data);
+    }
+
+    // whether the elements of the accessor are stored contiguously without sparse substitution, so that its data
+    // can be copied directly from the buffer instead of being unpacked element by element
+    [[nodiscard]] bool tightlyPacked(cgltf_accessor const& accessor)
+    {
+        return !accessor.is_sparse &&
+               accessor.buffer_view != nullptr &&
+               accessor.stride == cgltf_calc_size(accessor.type, accessor.component_type) &&
+               cgltf_buffer_view_data(accessor.buffer_view) != nullptr;
+    }
+
+    // a primitive of a gltf mesh, each primitive gets imported as a separate renderer::Mesh
+    struct Primitive
+    {
+        cgltf_mesh* mesh;
+        size_t index; // index of the primitive inside the mesh
+    };
+
+    // copies the elements of an interleaved accessor into contiguous memory, keeping its component type
+    void copyStrided(cgltf_accessor const& accessor, uint8_t* destination)
+    {
+        size_t const size = cgltf_calc_size(accessor.type, accessor.component_type);
+
+        // accessors without a buffer view contain zeros (see the glTF specification)
+        if (!accessor.buffer_view || !cgltf_buffer_view_data(accessor.buffer_view))
+        {
+            std::memset(destination, 0, size * accessor.count);
+            return;
+        }
+
+        uint8_t const* source = cgltf_buffer_view_data(accessor.buffer_view) + accessor.offset;
+        for (size_t i = 0; i < accessor.count; i++)
+        {
+            std::memcpy(destination + i * size, source + i * accessor.stride, size);
+        }
+    }
+
+    // writes the vertex attributes of the primitive sequentially into a single allocation that gets handed to the
+    // vertex buffer (see createBuffer), so that each vertex is only copied once from the mapped file.
+    // attributes are unpacked to floats, unless GltfImportParameters::keepComponentTypes is set, in which case 8-bit
+    // and 16-bit attributes (e.g. from KHR_mesh_quantization) are copied as is, element by element if interleaved.
+    // sparse accessors are always unpacked to floats.
+    // returns the mesh, followed by its levels of detail if enabled, or nothing if the primitive is invalid.
+    // runs in parallel with the other primitives of the gltf file, so should only read shared data
+    [[nodiscard]] std::vector<asset::Asset> importPrimitive(asset::AssetDatabaseContext const& context,
+                                                            BS::thread_pool& threadPool,
+                                                            std::filesystem::path const& inputFile,
+                                                            GltfImportParameters const& importParameters,
+                                                            Primitive const& p)
+    {
+        cgltf_mesh& mesh = *p.mesh;
+        cgltf_primitive& primitive = mesh.primitives[p.index];
+        assert(primitive.attributes_count > 0 && "primitive should contain at least one attribute");
+
+        // 8-bit indices are not supported by the graphics backends, so these are widened to 16-bit
+        renderer::ComponentType indexType = renderer::ComponentType::UnsignedInt;
+        if (primitive.indices)
+        {
+            indexType = primitive.indices->component_type == cgltf_component_type_r_8u
+                        ? renderer::ComponentType::UnsignedShort
+                        : convert(primitive.indices->component_type);
+        }
+
+        renderer::MeshDescriptor outMeshDescriptor{
+            .primitiveType = convert(primitive.type),
+            .vertexCount = 0,
+            .hasIndexBuffer = primitive.indices != nullptr,
+            .indexCount = primitive.indices ? primitive.indices->count : 0,
+            .indexType = indexType,
+            .writable = true,
+        };
+
+        // vertex attributes
+
+        outMeshDescriptor.attributes.reserve(primitive.attributes_count);
+        std::vector<cgltf_accessor const*> accessors; // ordered 1:1 with outMeshDescriptor.attributes
+        for (size_t k = 0; k < primitive.attributes_count; k++)
+        {
+            cgltf_attribute& attribute = primitive.attributes[k];
+            if (attribute.type == cgltf_attribute_type_invalid)
+            {
+                common::log::warning("ignored attribute with name {}", attribute.name);
+                continue;
+            }
+            renderer::VertexAttribute_ type = convert(attribute.type);
+
+            // don't import vertex attributes that are not in the mask
+            if ((type & importParameters.vertexAttributesToImport) == 0)
+            {
+                continue;
+            }
+
+            // use position attribute for vertex count
+            if (type == renderer::VertexAttribute_Position)
+            {
+                outMeshDescriptor.vertexCount = attribute.data->count;
+            }
+
+            cgltf_accessor* a = attribute.data;
+
+            renderer::VertexAttributeDescriptor outAttribute{
+                .index = static_cast<size_t>(attribute.index),
+                .type = type,
+                .elementType = convert(a->type),
+                .componentType = convert(a->component_type),
+                .normalized = a->normalized != 0
+            };
+
+            // unpacked to floats, unless the component types should be kept (the shaders then have to read them).
+            // cgltf only applies sparse substitution when unpacking floats
+            if ((!importParameters.keepComponentTypes || a->is_sparse) &&
+                outAttribute.componentType != renderer::ComponentType::Float)
+            {
+                outAttribute.componentType = renderer::ComponentType::Float;
+                outAttribute.normalized = false;
+            }
+
+            outMeshDescriptor.attributes.emplace_back(outAttribute);
+            accessors.emplace_back(a);
+        }
+
+        // the data comes from a file, so it gets validated instead of asserted, as the copies below rely on it
+        size_t const vertexCount = outMeshDescriptor.vertexCount;
+        if (vertexCount == 0)
+        {
+            common::log::error("Primitive {} of mesh {} has no vertices", p.index, mesh.name ? mesh.name : "");
+            return {};
+        }
+        for (cgltf_accessor const* a: accessors)
+        {
+            if (a->count != vertexCount)
+            {
+                common::log::error("Vertex attributes of primitive {} of mesh {} have different amounts of elements",
+                                   p.index, mesh.name ? mesh.name : "");
+                return {};
+            }
+        }
+
+        // ownership gets transferred to the vertex and index buffers
+        renderer::MeshData meshData = renderer::MeshData::allocate(std::move(outMeshDescriptor));
+        renderer::MeshDescriptor const& descriptor = meshData.descriptor;
+        std::vector<size_t> const offsets = renderer::attributeOffsets(descriptor);
+        for (size_t k = 0; k < accessors.size(); k++)
+        {
+            cgltf_accessor const& a = *accessors[k];
+            renderer::VertexAttributeDescriptor const& attribute = descriptor.attributes[k];
+            uint8_t* destination = meshData.vertexData.get() + offsets[k];
+
+            if (attribute.componentType == convert(a.component_type) && tightlyPacked(a))
+            {
+                std::memcpy(destination, cgltf_buffer_view_data(a.buffer_view) + a.offset, renderer::elementSize(attribute) * vertexCount);
+            }
+            else if (attribute.componentType == convert(a.component_type) && attribute.componentType != renderer::ComponentType::Float)
+            {
+                copyStrided(a, destination);
+            }
+            else
+            {
+                // cgltf performs de-interleaving and applying sparse data
+                // see https://github.com/KhronosGroup/glTF-Tutorials/blob/main/gltfTutorial/gltfTutorial_005_BuffersBufferViewsAccessors.md
+                size_t const floatCount = vertexCount * renderer::componentCount(attribute.elementType);
+                if (cgltf_accessor_unpack_floats(&a, reinterpret_cast<cgltf_float*>(destination), floatCount) != floatCount)
+                {
+                    common::log::error("Failed to read vertex attribute {} of primitive {} of mesh {}",
+                                       k, p.index, mesh.name ? mesh.name : "");
+                    return {};
+                }
+            }
+        }
+
+        // index buffer
+        if (descriptor.hasIndexBuffer)
+        {
+            cgltf_accessor const& a = *primitive.indices;
+            size_t const indexStride = renderer::stride(indexType);
+            void* indexData = meshData.indexData.get();
+            if (tightlyPacked(a) && cgltf_component_size(a.component_type) == indexStride)
+            {
+                std::memcpy(indexData, cgltf_buffer_view_data(a.buffer_view) + a.offset, a.count * indexStride);
+            }
+            else
+            {
+                for (size_t i = 0; i < a.count; i++)
+                {
+                    cgltf_size const index = cgltf_accessor_read_index(&a, i);
+                    if (indexType == renderer::ComponentType::UnsignedShort)
+                    {
+                        static_cast<uint16_t*>(indexData)[i] = static_cast<uint16_t>(index);
+                    }
+                    else
+                    {
+                        static_cast<uint32_t*>(indexData)[i] = static_cast<uint32_t>(index);
+                    }
+                }
+            }
+        }
+
+        // optimization, simplification and meshlets index into the vertices
+        if (descriptor.hasIndexBuffer)
+        {
+            std::vector<uint32_t> const indices = renderer::readIndices(meshData);
+            if (std::any_of(indices.begin(), indices.end(), [&](uint32_t index) { return index >= vertexCount; }))
+            {
+                common::log::error("Primitive {} of mesh {} has indices outside of its {} vertices",
+                                   p.index, mesh.name ? mesh.name : "", vertexCount);
+                return {};
+            }
+        }
+
+        // optimization, the bounding sphere and simplification need float positions, so quantization happens last
+        if (importParameters.optimize)
+        {
+            meshData = renderer::optimize(std::move(meshData));
+        }
+        renderer::computeBoundingSphere(meshData);
+
+        // levels of detail are simplified from the float positions as well
+        std::vector<renderer::MeshData> levels;
+        if (importParameters.lodCount > 0)
+        {
+            renderer::LodParameters const lodParameters{
+                .levelCount = std::min(static_cast<size_t>(importParameters.lodCount), renderer::kMaxMeshLods)
+            };
+            levels = renderer::generateLods(meshData, threadPool, lodParameters);
+        }
+
+        auto makeMesh = [&](asset::AssetId const& id, renderer::MeshData data) {
+            if (importParameters.meshlets)
+            {
+                renderer::buildMeshlets(data);
+            }
+            if (importParameters.quantize)
+            {
+                data = renderer::quantize(std::move(data));
+            }
+            return makeAsset<renderer::Mesh>(id, context.device, std::move(data));
+        };
+
+        std::vector<asset::Asset> out;
+        out.reserve(1 + levels.size());
+        out.emplace_back(makeMesh(context.assetTypes.makeAssetId<renderer::Mesh>(inputFile, "{}_{}", mesh.name, p.index),
+                                  std::move(meshData)));
+        for (auto& level: levels)
+        {
+            size_t const lodLevel = level.descriptor.lodLevel;
+            out.emplace_back(makeMesh(context.assetTypes.makeAssetId<renderer::Mesh>(inputFile, "{}_{}_lod{}", mesh.name, p.index, lodLevel),
+                                      std::move(level)));
+        }
+        return out;
+    }
+
+    // gltf rotations use the standard convention, while createRotationMatrix() (from glm, indexed as row, column)
+    // rotates by the conjugate, so the quaternion gets conjugated to result in the same matrix
+    [[nodiscard]] math::Quaternionf convertRotation(float x, float y, float z, float w)
+    {
+        return math::Quaternionf{-x, -y, -z, w};
+    }
+
+    // decomposes a column major affine matrix into translation, rotation and scale (shear is lost)
+    void decompose(float const* m, renderer::TransformComponent& out)
+    {
+        out.localPosition = math::Vector3{m[12], m[13], m[14]};
+
+        std::array<math::Vector3, 3> columns{
+            math::Vector3{m[0], m[1], m[2]},
+            math::Vector3{m[4], m[5], m[6]},
+            math::Vector3{m[8], m[9], m[10]}
+        };
+        math::Vector3 scale{columns[0].magnitude(), columns[1].magnitude(), columns[2].magnitude()};
+        if (math::Vector3::dot(math::Vector3::cross(columns[0], columns[1]), columns[2]) < 0.0f)
+        {
+            scale[0] = -scale[0]; // mirrored
+        }
+        for (size_t i = 0; i < 3; i++)
+        {
+            if (scale[i] != 0.0f)
+            {
+                columns[i] = columns[i] / scale[i];
+            }
+        }
+        out.localScale = scale;
+
+        // rotation matrix to quaternion (standard convention), r(row, column) = columns[column][row]
+        auto r = [&columns](size_t row, size_t column) { return columns[column][row]; };
+        float const trace = r(0, 0) + r(1, 1) + r(2, 2);
+        math::Quaternionf q;
+        if (trace > 0.0f)
+        {
+            float const s = 0.5f / std::sqrt(trace + 1.0f);
+            q = convertRotation((r(2, 1) - r(1, 2)) * s, (r(0, 2) - r(2, 0)) * s, (r(1, 0) - r(0, 1)) * s, 0.25f / s);
+        }
+        else if (r(0, 0) > r(1, 1) && r(0, 0) > r(2, 2))
+        {
+            float const s = 2.0f * std::sqrt(1.0f + r(0, 0) - r(1, 1) - r(2, 2));
+            q = convertRotation(0.25f * s, (r(0, 1) + r(1, 0)) / s, (r(0, 2) + r(2, 0)) / s, (r(2, 1) - r(1, 2)) / s);
+        }
+        else if (r(1, 1) > r(2, 2))
+        {
+            float const s = 2.0f * std::sqrt(1.0f + r(1, 1) - r(0, 0) - r(2, 2));
+            q = convertRotation((r(0, 1) + r(1, 0)) / s, 0.25f * s, (r(1, 2) + r(2, 1)) / s, (r(0, 2) - r(2, 0)) / s);
+        }
+        else
+        {
+            float const s = 2.0f * std::sqrt(1.0f + r(2, 2) - r(0, 0) - r(1, 1));
+            q = convertRotation((r(0, 2) + r(2, 0)) / s, (r(1, 2) + r(2, 1)) / s, 0.25f * s, (r(1, 0) - r(0, 1)) / s);
+        }
+        out.localRotation = q;
+    }
+
+    [[nodiscard]] renderer::TransformComponent makeTransform(cgltf_node const& node)
+    {
+        renderer::TransformComponent transform;
+        if (node.has_matrix)
+        {
+            decompose(node.matrix, transform);
+        }
+        else
+        {
+            if (node.has_translation)
+            {
+                transform.localPosition = math::Vector3{node.translation[0], node.translation[1], node.translation[2]};
+            }
+            if (node.has_rotation)
+            {
+                transform.localRotation = convertRotation(node.rotation[0], node.rotation[1], node.rotation[2], node.rotation[3]);
+            }
+            if (node.has_scale)
+            {
+                transform.localScale = math::Vector3{node.scale[0], node.scale[1], node.scale[2]};
+            }
+        }
+        transform.localToParentTransform = math::createTRSMatrix(transform.localPosition, transform.localRotation, transform.localScale);
+        return transform;
+    }
+
+    // the asset keys of the full detail mesh of a primitive and its levels of detail
+    struct PrimitiveKeys
+    {
+        renderer::MeshAssetComponent mesh;
+        renderer::MeshLodAssetComponent lods;
+    };
+
+    /**
+     * Creates the entities of a gltf scene: each node becomes an entity with a HierarchyComponent and TransformComponent,
+     * and a MeshAssetComponent (and MeshLodAssetComponent if it has levels of detail) for the first primitive of its mesh.
+     * Additional primitives become child entities.
+     *
+     * The nodes are collected in depth first order, so that the registry can be built in one pass using bulk
+     * entity and component creation, with the transforms to world space computed while collecting.
+     *
+     * @param meshKeys the asset keys of the primitives of each mesh (indexed by mesh, then primitive)
+     * @return nullptr if a node is reached more than once (e.g. a cycle, which cgltf_validate doesn't reject)
+     */
+    [[nodiscard]] std::unique_ptr<scene::Scene> importScene(cgltf_data const& data, cgltf_scene const& gltfScene,
+                                                            std::vector<std::vector<PrimitiveKeys>> const& meshKeys)
+    {
+        std::vector<entity::size_type> parents; // index of the parent, or kNullEntityId for roots
+        std::vector<renderer::TransformComponent> transforms;
+        std::vector<std::pair<entity::size_type, PrimitiveKeys>> meshes; // index of the entity and its mesh
+
+        auto add = [&](entity::size_type parent, renderer::TransformComponent transform, PrimitiveKeys const& mesh) {
+            transform.localToWorldTransform = parent == entity::kNullEntityId
+                                              ? transform.localToParentTransform
+                                              : transforms[parent].localToWorldTransform * transform.localToParentTransform;
+            parents.emplace_back(parent);
+            transforms.emplace_back(transform);
+            if (mesh.mesh.mesh != asset::AssetKey{})
+            {
+                meshes.emplace_back(parents.size() - 1, mesh);
+            }
+            return parents.size() - 1;
+        };
+
+        // iterative depth first search, children are pushed in reverse so that they are visited in order.
+        // each node should be visited once, a node that is reached twice (e.g. a cycle) would never terminate
+        std::vector<bool> visited(data.nodes_count, false);
+        std::vector<std::pair<cgltf_node const*, entity::size_type>> stack;
+        for (size_t i = gltfScene.nodes_count; i-- > 0;)
+        {
+            stack.emplace_back(gltfScene.nodes[i], entity::kNullEntityId);
+        }
+        while (!stack.empty())
+        {
+            auto const [node, parent] = stack.back();
+            stack.pop_back();
+
+            auto const nodeIndex = static_cast<size_t>(node - data.nodes);
+            if (visited[nodeIndex])
+            {
+                common::log::error("Node {} is reached more than once in scene {}", nodeIndex, gltfScene.name ? gltfScene.name : "");
+                return nullptr;
+            }
+            visited[nodeIndex] = true;
+
+            std::span<PrimitiveKeys const> primitives;
+            if (node->mesh)
+            {
+                primitives = meshKeys[static_cast<size_t>(node->mesh - data.meshes)];
+            }
+            entity::size_type const index = add(parent, makeTransform(*node), primitives.empty() ? PrimitiveKeys{} : primitives[0]);
+            for (size_t i = 1; i < primitives.size(); i++)
+            {
+                add(index, renderer::TransformComponent{}, primitives[i]);
+            }
+
+            for (size_t i = node->children_count; i-- > 0;)
+            {
+                stack.emplace_back(node->children[i], index);
+            }
+        }
+
+        auto scene = std::make_unique<scene::Scene>();
+        scene->name = gltfScene.name ? gltfScene.name : "";
+        if (parents.empty())
+        {
+            return scene;
+        }
+
+        entity::EntityRegistry& r = scene->entities;
+        entity::EntityId const first = r.createEntities(parents.size());
+        std::vector<entity::EntityId> entities(parents.size());
+        std::iota(entities.begin(), entities.end(), first);
+
+        // added in reverse, so that iterating visits parents before their children (same as entity::addHierarchy)
+        std::vector<entity::EntityId> reversed(entities.rbegin(), entities.rend());
+        std::reverse(transforms.begin(), transforms.end());
+        std::vector<entity::EntityId> meshEntities;
+        std::vector<renderer::MeshAssetComponent> meshComponents;
+        std::vector<entity::EntityId> lodEntities;
+        std::vector<renderer::MeshLodAssetComponent> lodComponents;
+        for (auto it = meshes.rbegin(); it != meshes.rend(); ++it)
+        {
+            meshEntities.emplace_back(entities[it->first]);
+            meshComponents.emplace_back(it->second.mesh);
+            if (it->second.lods.lods[0] != asset::AssetKey{})
+            {
+                lodEntities.emplace_back(entities[it->first]);
+                lodComponents.emplace_back(it->second.lods);
+            }
+        }
+
+        if (!entity::addHierarchy(r, entities, parents) ||
+            !r.addComponents<renderer::TransformComponent>(reversed, std::move(transforms)) ||
+            !r.addComponents<renderer::MeshAssetComponent>(meshEntities, std::move(meshComponents)) ||
+            (!lodEntities.empty() && !r.addComponents<renderer::MeshLodAssetComponent>(lodEntities, std::move(lodComponents))))
+        {
+            return nullptr;
+        }
+        return scene;
+    }
+
     asset::ImportResult importGltf(asset::AssetDatabase& assetDatabase, std::filesystem::path const& inputFile)
     {
         std::filesystem::path const path = assetDatabase.absolutePath(inputFile);
         asset::ImportResultData result;
         asset::AssetDatabaseContext const& context = assetDatabase.context();
-        graphics::IDevice* device = context.device;
 
         GltfImportParameters importParameters;
+        if (!assetDatabase.readImportParameters(inputFile, importParameters, result.dependencies))
+        {
+            return asset::ImportResult::makeError(common::ResultCode::InvalidArgument, "Invalid import parameters");
+        }
 
-        // parse file
+        // parse file, the files stay mapped until cgltf_free
+        MappedFiles mappedFiles;
         cgltf_options options = {
             .type = cgltf_file_type_invalid, // = auto detect
-            .file = cgltf_file_options{}
+            .file = cgltf_file_options{
+                .read = readMappedFile,
+                .release = releaseMappedFile,
+                .user_data = &mappedFiles
+            }
         };
         cgltf_data* data = nullptr;
         cgltf_result parseFileResult = cgltf_parse_file(&options, path.c_str(), &data);
@@ -144,99 +654,73 @@ namespace import_::gltf
         // Meshes
         //---------------------------------------------------
 
+        std::vector<Primitive> primitives;
         for (size_t i = 0; i < data->meshes_count; i++)
         {
             cgltf_mesh& mesh = data->meshes[i];
             for (size_t j = 0; j < mesh.primitives_count; j++)
             {
-                cgltf_primitive& primitive = mesh.primitives[j];
-                assert(primitive.attributes_count > 0 && "primitive should contain at least one attribute");
-
-                renderer::MeshDescriptor outMeshDescriptor{
-                    .primitiveType = convert(primitive.type),
-                    .vertexCount = 0,
-                    .hasIndexBuffer = primitive.indices != nullptr,
-                    .indexCount = primitive.indices ? primitive.indices->count : 0,
-                    .indexType = primitive.indices ? convert(primitive.indices->component_type) : renderer::ComponentType::UnsignedInt,
-                    .writable = true,
-                };
-
-                // import index buffer
-                // because the index buffer does not support sparse data or interleaving,
-                // we can directly use the buffer view's data
-                void* outIndexBuffer = nullptr;
-                if (outMeshDescriptor.hasIndexBuffer)
-                {
-                    uint8_t const* d = cgltf_buffer_view_data(primitive.indices->buffer_view);
-                    d += primitive.indices->offset;
-                    outIndexBuffer = (void*)d;
-                }
-
-                // import vertex attributes
-
-                outMeshDescriptor.attributes.reserve(primitive.attributes_count);
-                std::vector<void*> attributeBuffers;
-                for (size_t k = 0; k < primitive.attributes_count; k++)
-                {
-                    cgltf_attribute& attribute = primitive.attributes[k];
-                    if (attribute.type == cgltf_attribute_type_invalid)
-                    {
-                        common::log::warning("ignored attribute with name {}", attribute.name);
-                        continue;
-                    }
-                    renderer::VertexAttribute_ type = convert(attribute.type);
-
-                    // don't import vertex attributes that are not in the mask
-                    if ((type & importParameters.vertexAttributesToImport) == 0)
-                    {
-                        continue;
-                    }
-
-                    // use position attribute for vertex count
-                    if (type == renderer::VertexAttribute_Position)
-                    {
-                        outMeshDescriptor.vertexCount = attribute.data->count;
-                    }
-
-                    cgltf_accessor* a = attribute.data;
-
-                    renderer::VertexAttributeDescriptor outAttribute{
-                        .index = static_cast<size_t>(attribute.index),
-                        .type = type,
-                        .elementType = convert(a->type),
-                        .componentType = convert(a->component_type)
-                    };
-
-                    assert(outAttribute.componentType == renderer::ComponentType::Float &&
-                           "only float is supported now, otherwise implement own version of cgltf_accessor_unpack_floats");
-                    size_t vertexCount = a->count;
+                primitives.emplace_back(Primitive{.mesh = &mesh, .index = j});
+            }
+        }
 
-                    // allocate out buffer and copy using cgltf unpack function (cgltf already performs de-interleaving and applying sparse data)
-                    // see https://github.com/KhronosGroup/glTF-Tutorials/blob/main/gltfTutorial/gltfTutorial_005_BuffersBufferViewsAccessors.md
+        // the primitives are imported in parallel on the thread pool of the asset database, so that files with many
+        // primitives (e.g. a city) use all cores. parallelFor also imports primitives on this thread while waiting,
+        // so that it can't deadlock when all threads of the thread pool are running imports.
+        std::vector<std::vector<asset::Asset>> meshes(primitives.size());
+        std::atomic<bool> cancelled = false;
+        std::atomic<bool> invalid = false;
+        common::parallelFor(assetDatabase.threadPool(), primitives.size(), [&](size_t index) {
+            // the assets of this file are not needed anymore
+            if (cancelled || invalid || assetDatabase.importCancelled(inputFile))
+            {
+                cancelled = true;
+                return;
+            }
+            meshes[index] = importPrimitive(context, assetDatabase.threadPool(), inputFile, importParameters, primitives[index]);
+            if (meshes[index].empty())
+            {
+                invalid = true;
+            }
+        });
 
-                    size_t bufferSize = vertexCount * renderer::elementSize(outAttribute);
-                    size_t floatCount = vertexCount * renderer::componentCount(outAttribute.elementType);
+        if (invalid)
+        {
+            cgltf_free(data);
+            return asset::ImportResult::makeError(common::ResultCode::InvalidArgument, "Invalid mesh primitive");
+        }
 
-                    auto* attributeBuffer = static_cast<cgltf_float*>(malloc(bufferSize));
-                    cgltf_size amountOfFloatsCopied = cgltf_accessor_unpack_floats(attribute.data, attributeBuffer, floatCount);
-                    common::log::infoDebug("amount of floats copied {}", amountOfFloatsCopied);
-                    assert(amountOfFloatsCopied != 0 && "unable to read gltf data into buffer");
+        if (cancelled)
+        {
+            cgltf_free(data);
+            return asset::ImportResult::makeError(common::ResultCode::Cancelled, "Import was cancelled");
+        }
 
-                    outMeshDescriptor.attributes.emplace_back(outAttribute);
-                    attributeBuffers.emplace_back(attributeBuffer);
+        // the scenes refer to the full detail mesh of each primitive and its levels of detail
+        std::vector<std::vector<PrimitiveKeys>> meshKeys(data->meshes_count);
+        for (size_t i = 0; i < primitives.size(); i++)
+        {
+            size_t const mesh = static_cast<size_t>(primitives[i].mesh - data->meshes);
+            PrimitiveKeys& keys = meshKeys[mesh].emplace_back();
+            for (size_t level = 0; level < meshes[i].size(); level++)
+            {
+                if (level == 0)
+                {
+                    keys.mesh.mesh = meshes[i][level]->key();
                 }
-
-                assert(outMeshDescriptor.vertexCount > 0 && "vertex count should be more than 0");
-
-                asset::AssetId outMeshId = context.assetTypes.makeAssetId<renderer::Mesh>(inputFile, "{}_{}", mesh.name, j);
-                asset::Asset outMesh = makeAsset<renderer::Mesh>(outMeshId, device, outMeshDescriptor, attributeBuffers, outIndexBuffer);
-
-                for (auto b: attributeBuffers)
+                else
                 {
-                    free(b);
+                    keys.lods.lods[level - 1] = meshes[i][level]->key();
                 }
+            }
+        }
 
-                result.artifacts.emplace_back(std::move(outMesh));
+        // in the same order as the primitives in the file, each followed by its levels of detail
+        for (auto& levels: meshes)
+        {
+            for (auto& mesh: levels)
+            {
+                result.artifacts.emplace_back(std::move(mesh));
             }
         }
 
@@ -247,33 +731,20 @@ namespace import_::gltf
 
         for (size_t i = 0; i < data->scenes_count; i++)
         {
-            // create scenes
-            cgltf_scene& scene = data->scenes[i];
-            common::log::infoDebug("scene {}: \n"
-                                   "\tname = {}\n"
-                                   "\tnodes_count = {}\n"
-                                   "\textensions_count = {}",
-                                   i,
-                                   scene.name,
-                                   scene.nodes_count,
-                                   scene.extensions_count);
-
-            for (size_t j = 0; j < scene.extensions_count; j++)
+            cgltf_scene const& gltfScene = data->scenes[i];
+            std::unique_ptr<scene::Scene> scene = importScene(*data, gltfScene, meshKeys);
+            if (!scene)
             {
-                cgltf_extension& extension = scene.extensions[j];
-                common::log::infoDebug("scene {} extension {}: \n"
-                                       "\tname = {}\n"
-                                       "\tdata = {}",
-                                       i,
-                                       j,
-                                       extension.name,
-                                       extension.data);
+                common::log::error("Failed to create scene {} of {}", i, inputFile.string());
+                continue;
             }
-
-            //scene::Scene s;
-            //s.name = scene.name;
+            // named by index, as scene names are optional and not unique (the name is stored in the scene)
+            result.artifacts.emplace_back(makeAsset<scene::Scene>(context.assetTypes.makeAssetId<scene::Scene>(inputFile, "scene_{}", i),
+                                                                  std::move(scene)));
         }
 
+        // the meshes have copied the data they need from the mapped files
+        cgltf_free(data);
         return asset::ImportResult::makeSuccess(std::move(result));
     }
 }
\ No newline at end of file
@@ -12,9 +12,32 @@
 
 namespace import_::gltf
 {
+    // read from the import parameters file of the input file (see asset::AssetDatabase::readImportParameters)
     struct GltfImportParameters
     {
         renderer::VertexAttribute_ vertexAttributesToImport = renderer::VertexAttribute_All;
+
+        // deduplicates the vertices and reorders the triangles and vertices for the vertex cache, overdraw and vertex
+        // fetch, and narrows the indices to 16 bits if possible (see renderer::optimize)
+        bool optimize = true;
+
+        // amount of levels of detail to generate besides the full detail mesh (at most renderer::kMaxMeshLods), using
+        // mesh simplification. these are imported as additional "{mesh}_{primitive}_lod{level}" artifacts
+        // (see renderer::generateLods), which the scenes refer to using a renderer::MeshLodAssetComponent
+        int lodCount = 0;
+
+        // splits each mesh (and level of detail) into meshlets for culling (see renderer::buildMeshlets)
+        bool meshlets = true;
+
+        // quantizes the vertex attributes at import time (see renderer::quantize), the shaders should then read the
+        // quantized component types and dequantize the positions using MeshDescriptor::positionOffset and positionScale
+        bool quantize = false;
+
+        // keeps 8-bit and 16-bit vertex attributes (e.g. from KHR_mesh_quantization, or normalized unsigned byte
+        // colors and texture coordinates) in their component type, instead of unpacking them to 32-bit floats.
+        // the shaders should then read these component types. the bounding sphere, simplification, overdraw
+        // optimization and meshlets require float positions, so are skipped for meshes with quantized positions
+        bool keepComponentTypes = false;
     };
 
     [[nodiscard]] asset::ImportResult importGltf(asset::AssetDatabase& assetDatabase, std::filesystem::path const& inputFile);
@@ -14,6 +14,11 @@ namespace import_::gltf
     {
         reflection::register_::Class<GltfImportParameters>("GltfImportParameters")
             .member<&GltfImportParameters::vertexAttributesToImport>("vertexAttributesToImport")
+            .member<&GltfImportParameters::optimize>("optimize")
+            .member<&GltfImportParameters::lodCount>("lodCount")
+            .member<&GltfImportParameters::meshlets>("meshlets")
+            .member<&GltfImportParameters::quantize>("quantize")
+            .member<&GltfImportParameters::keepComponentTypes>("keepComponentTypes")
             .emplace(reflection.types);
     }
 
@@ -0,0 +1,722 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "block_compression.h"
+
+#include <common/thread_pool.h>
+#include <graphics/texture.h>
+
+#include <BS_thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace import_::texture
+{
+    // the 16 pixels of a 4x4 block, in 8-bit units but as floats for fitting the endpoints
+    using BlockPixels = std::array<std::array<float, 4>, 16>;
+
+    // blocks that get compressed in one task, so that small mipmap levels don't get split into tiny tasks
+    constexpr size_t kBlocksPerTask = 256;
+
+    // interpolation weights of BC7 with 4-bit indices, out of 64
+    constexpr std::array<float, 16> kBc7Weights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    struct EncodeSettings
+    {
+        int iterations; // least squares refinement iterations of the endpoints
+        bool searchPBits; // tries all combinations of the BC7 p-bits instead of rounding each endpoint
+    };
+
+    [[nodiscard]] static EncodeSettings getEncodeSettings(CompressionQuality quality)
+    {
+        switch (quality)
+        {
+            case CompressionQuality::Fast: return EncodeSettings{0, false};
+            case CompressionQuality::Normal: return EncodeSettings{2, false};
+            case CompressionQuality::High: return EncodeSettings{8, true};
+        }
+        return EncodeSettings{2, false};
+    }
+
+    graphics::PixelFormat getPixelFormat(TextureCompression compression, bool sRGB)
+    {
+        switch (compression)
+        {
+            case TextureCompression::None: return sRGB ? graphics::PixelFormat::RGBA8Unorm_sRGB : graphics::PixelFormat::RGBA8Unorm;
+            case TextureCompression::BC1: return sRGB ? graphics::PixelFormat::BC1_RGBA_sRGB : graphics::PixelFormat::BC1_RGBA;
+            case TextureCompression::BC3: return sRGB ? graphics::PixelFormat::BC3_RGBA_sRGB : graphics::PixelFormat::BC3_RGBA;
+            case TextureCompression::BC5: return graphics::PixelFormat::BC5_RGUnorm;
+            case TextureCompression::BC7: return sRGB ? graphics::PixelFormat::BC7_RGBAUnorm_sRGB : graphics::PixelFormat::BC7_RGBAUnorm;
+        }
+        return graphics::PixelFormat::Undefined;
+    }
+
+    // pixels outside the image (for sizes that aren't a multiple of 4) repeat the last row or column
+    static void loadBlock(uint8_t const* level, unsigned int width, unsigned int height, unsigned int blockX,
+                          unsigned int blockY, BlockPixels& out)
+    {
+        for (unsigned int y = 0; y < 4; y++)
+        {
+            for (unsigned int x = 0; x < 4; x++)
+            {
+                size_t const pixelX = std::min(blockX * 4 + x, width - 1);
+                size_t const pixelY = std::min(blockY * 4 + y, height - 1);
+                uint8_t const* pixel = level + (pixelY * width + pixelX) * 4;
+                for (size_t c = 0; c < 4; c++)
+                {
+                    out[y * 4 + x][c] = pixel[c];
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] static float squaredError(std::array<float, 4> const& a, std::array<float, 4> const& b, size_t channelCount)
+    {
+        float error = 0.0f;
+        for (size_t c = 0; c < channelCount; c++)
+        {
+            error += (a[c] - b[c]) * (a[c] - b[c]);
+        }
+        return error;
+    }
+
+    // endpoints of the line through the pixels in the mask along their principal axis, which is computed with
+    // power iteration on the covariance matrix of the first channelCount channels
+    static void fitEndpoints(BlockPixels const& pixels, uint32_t mask, size_t channelCount,
+                             std::array<float, 4>& a, std::array<float, 4>& b)
+    {
+        std::array<float, 4> mean{};
+        float count = 0.0f;
+        for (size_t i = 0; i < 16; i++)
+        {
+            if ((mask >> i) & 1)
+            {
+                for (size_t c = 0; c < channelCount; c++)
+                {
+                    mean[c] += pixels[i][c];
+                }
+                count += 1.0f;
+            }
+        }
+        for (float& m: mean)
+        {
+            m /= count;
+        }
+
+        std::array<std::array<float, 4>, 4> covariance{};
+        for (size_t i = 0; i < 16; i++)
+        {
+            if ((mask >> i) & 1)
+            {
+                for (size_t j = 0; j < channelCount; j++)
+                {
+                    for (size_t k = 0; k < channelCount; k++)
+                    {
+                        covariance[j][k] += (pixels[i][j] - mean[j]) * (pixels[i][k] - mean[k]);
+                    }
+                }
+            }
+        }
+
+        // start with the row of the channel with the largest variance, which is never orthogonal to the principal axis
+        size_t largest = 0;
+        for (size_t c = 1; c < channelCount; c++)
+        {
+            largest = covariance[c][c] > covariance[largest][largest] ? c : largest;
+        }
+        std::array<float, 4> axis = covariance[largest];
+        for (int iteration = 0; iteration < 8; iteration++)
+        {
+            std::array<float, 4> next{};
+            float maximum = 0.0f;
+            for (size_t j = 0; j < channelCount; j++)
+            {
+                for (size_t k = 0; k < channelCount; k++)
+                {
+                    next[j] += covariance[j][k] * axis[k];
+                }
+                maximum = std::max(maximum, std::abs(next[j]));
+            }
+            if (maximum == 0.0f)
+            {
+                break;
+            }
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                axis[c] = next[c] / maximum;
+            }
+        }
+
+        float const length = std::sqrt(squaredError(axis, std::array<float, 4>{}, channelCount));
+        a = mean;
+        b = mean;
+        if (length < 1e-6f)
+        {
+            return; // all pixels are the same
+        }
+
+        float minimum = std::numeric_limits<float>::max();
+        float maximum = std::numeric_limits<float>::lowest();
+        for (size_t i = 0; i < 16; i++)
+        {
+            if ((mask >> i) & 1)
+            {
+                float t = 0.0f;
+                for (size_t c = 0; c < channelCount; c++)
+                {
+                    t += (pixels[i][c] - mean[c]) * axis[c] / length;
+                }
+                minimum = std::min(minimum, t);
+                maximum = std::max(maximum, t);
+            }
+        }
+        for (size_t c = 0; c < channelCount; c++)
+        {
+            a[c] = std::clamp(mean[c] + minimum * axis[c] / length, 0.0f, 255.0f);
+            b[c] = std::clamp(mean[c] + maximum * axis[c] / length, 0.0f, 255.0f);
+        }
+    }
+
+    // least squares endpoints for the interpolation weights of the pixels in the mask (0 is a, 1 is b).
+    // returns false if the weights don't determine the endpoints (e.g. all pixels use the same weight)
+    [[nodiscard]] static bool solveEndpoints(BlockPixels const& pixels, uint32_t mask, std::array<float, 16> const& weights,
+                                             size_t channelCount, std::array<float, 4>& a, std::array<float, 4>& b)
+    {
+        float aa = 0.0f;
+        float ab = 0.0f;
+        float bb = 0.0f;
+        std::array<float, 4> ax{};
+        std::array<float, 4> bx{};
+        for (size_t i = 0; i < 16; i++)
+        {
+            if ((mask >> i) & 1)
+            {
+                float const t = weights[i];
+                float const s = 1.0f - t;
+                aa += s * s;
+                ab += s * t;
+                bb += t * t;
+                for (size_t c = 0; c < channelCount; c++)
+                {
+                    ax[c] += s * pixels[i][c];
+                    bx[c] += t * pixels[i][c];
+                }
+            }
+        }
+
+        float const determinant = aa * bb - ab * ab;
+        if (std::abs(determinant) < 1e-6f)
+        {
+            return false;
+        }
+        for (size_t c = 0; c < channelCount; c++)
+        {
+            a[c] = std::clamp((bb * ax[c] - ab * bx[c]) / determinant, 0.0f, 255.0f);
+            b[c] = std::clamp((aa * bx[c] - ab * ax[c]) / determinant, 0.0f, 255.0f);
+        }
+        return true;
+    }
+
+    //-----------------------------------------------------
+    // BC1 color block (also used by BC3)
+    //-----------------------------------------------------
+
+    [[nodiscard]] static uint16_t toRgb565(std::array<float, 4> const& color)
+    {
+        auto quantize = [](float value, float maximum) {
+            return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 255.0f) * maximum / 255.0f));
+        };
+        return static_cast<uint16_t>(quantize(color[0], 31) << 11 | quantize(color[1], 63) << 5 | quantize(color[2], 31));
+    }
+
+    [[nodiscard]] static std::array<float, 4> fromRgb565(uint16_t color)
+    {
+        uint32_t const r = (color >> 11) & 31;
+        uint32_t const g = (color >> 5) & 63;
+        uint32_t const b = color & 31;
+        return {static_cast<float>(r << 3 | r >> 2), static_cast<float>(g << 2 | g >> 4), static_cast<float>(b << 3 | b >> 2), 255.0f};
+    }
+
+    struct ColorBlock
+    {
+        uint16_t color0;
+        uint16_t color1;
+        uint32_t indices; // 2 bits per pixel
+        float error;
+    };
+
+    // assigns the closest color of the palette to each pixel in the mask, the other (transparent) pixels get
+    // index 3, which is transparent in three color mode
+    [[nodiscard]] static ColorBlock evaluateColors(BlockPixels const& pixels, uint32_t mask, uint16_t color0,
+                                                   uint16_t color1, bool threeColorMode, std::array<float, 16>& weights)
+    {
+        std::array<float, 4> const a = fromRgb565(color0);
+        std::array<float, 4> const b = fromRgb565(color1);
+        std::array<float, 4> const paletteWeights = threeColorMode ? std::array<float, 4>{0.0f, 1.0f, 1.0f / 2.0f, 0.0f}
+                                                                   : std::array<float, 4>{0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+        size_t const paletteSize = threeColorMode ? 3 : 4;
+        std::array<std::array<float, 4>, 4> palette{};
+        for (size_t k = 0; k < paletteSize; k++)
+        {
+            for (size_t c = 0; c < 3; c++)
+            {
+                palette[k][c] = a[c] + (b[c] - a[c]) * paletteWeights[k];
+            }
+        }
+
+        ColorBlock out{color0, color1, 0, 0.0f};
+        for (size_t i = 0; i < 16; i++)
+        {
+            if (((mask >> i) & 1) == 0)
+            {
+                out.indices |= 3u << (2 * i);
+                weights[i] = 0.0f;
+                continue;
+            }
+            uint32_t best = 0;
+            float bestError = std::numeric_limits<float>::max();
+            for (uint32_t k = 0; k < paletteSize; k++)
+            {
+                float const error = squaredError(pixels[i], palette[k], 3);
+                if (error < bestError)
+                {
+                    best = k;
+                    bestError = error;
+                }
+            }
+            out.indices |= best << (2 * i);
+            out.error += bestError;
+            weights[i] = paletteWeights[best];
+        }
+        return out;
+    }
+
+    // with transparency (BC1), pixels with an alpha below 128 get encoded as transparent, using three color mode
+    static void encodeColorBlock(BlockPixels const& pixels, bool transparency, EncodeSettings settings, uint8_t* out)
+    {
+        uint32_t opaque = 0xFFFF;
+        for (size_t i = 0; transparency && i < 16; i++)
+        {
+            opaque &= pixels[i][3] < 128.0f ? ~(1u << i) : ~0u;
+        }
+        bool const threeColorMode = opaque != 0xFFFF;
+
+        ColorBlock best{0, 0, 0xFFFFFFFF, 0.0f}; // all pixels transparent
+        if (opaque != 0)
+        {
+            // the order of the endpoints selects the mode: four colors if color0 > color1, three colors otherwise
+            auto evaluate = [&](std::array<float, 4> const& a, std::array<float, 4> const& b, std::array<float, 16>& weights) {
+                uint16_t color0 = toRgb565(a);
+                uint16_t color1 = toRgb565(b);
+                if (threeColorMode ? color0 > color1 : color0 < color1)
+                {
+                    std::swap(color0, color1);
+                }
+                return evaluateColors(pixels, opaque, color0, color1, threeColorMode, weights);
+            };
+
+            std::array<float, 4> a{};
+            std::array<float, 4> b{};
+            fitEndpoints(pixels, opaque, 3, a, b);
+            std::array<float, 16> weights{};
+            best = evaluate(a, b, weights);
+            for (int iteration = 0; iteration < settings.iterations; iteration++)
+            {
+                if (!solveEndpoints(pixels, opaque, weights, 3, a, b))
+                {
+                    break;
+                }
+                std::array<float, 16> nextWeights{};
+                ColorBlock const next = evaluate(a, b, nextWeights);
+                if (next.error >= best.error)
+                {
+                    break;
+                }
+                best = next;
+                weights = nextWeights;
+            }
+        }
+
+        std::memcpy(out, &best.color0, 2);
+        std::memcpy(out + 2, &best.color1, 2);
+        std::memcpy(out + 4, &best.indices, 4);
+    }
+
+    //-----------------------------------------------------
+    // BC4 channel block (alpha of BC3, red and green of BC5)
+    //-----------------------------------------------------
+
+    struct ChannelBlock
+    {
+        uint8_t endpoint0;
+        uint8_t endpoint1;
+        uint64_t indices; // 3 bits per pixel
+        float error;
+    };
+
+    // eight values if endpoint0 > endpoint1, otherwise six values and 0 and 255 (indices 6 and 7),
+    // these don't lie on the line between the endpoints so get a weight of -1
+    [[nodiscard]] static ChannelBlock evaluateChannel(BlockPixels const& values, uint8_t endpoint0, uint8_t endpoint1,
+                                                      std::array<float, 16>& weights)
+    {
+        std::array<float, 8> palette{};
+        std::array<float, 8> paletteWeights{0.0f, 1.0f};
+        float const a = endpoint0;
+        float const b = endpoint1;
+        palette[0] = a;
+        palette[1] = b;
+        float const steps = endpoint0 > endpoint1 ? 7.0f : 5.0f;
+        for (size_t k = 1; k < static_cast<size_t>(steps); k++)
+        {
+            paletteWeights[k + 1] = static_cast<float>(k) / steps;
+            palette[k + 1] = a + (b - a) * paletteWeights[k + 1];
+        }
+        if (endpoint0 <= endpoint1)
+        {
+            palette[6] = 0.0f;
+            palette[7] = 255.0f;
+            paletteWeights[6] = -1.0f;
+            paletteWeights[7] = -1.0f;
+        }
+
+        ChannelBlock out{endpoint0, endpoint1, 0, 0.0f};
+        for (size_t i = 0; i < 16; i++)
+        {
+            uint64_t best = 0;
+            float bestError = std::numeric_limits<float>::max();
+            for (uint64_t k = 0; k < 8; k++)
+            {
+                float const error = (values[i][0] - palette[k]) * (values[i][0] - palette[k]);
+                if (error < bestError)
+                {
+                    best = k;
+                    bestError = error;
+                }
+            }
+            out.indices |= best << (3 * i);
+            out.error += bestError;
+            weights[i] = paletteWeights[best];
+        }
+        return out;
+    }
+
+    static void encodeChannelBlock(BlockPixels const& pixels, size_t channel, EncodeSettings settings, uint8_t* out)
+    {
+        BlockPixels values{};
+        float minimum = 255.0f;
+        float maximum = 0.0f;
+        float innerMinimum = 255.0f; // excluding 0 and 255
+        float innerMaximum = 0.0f;
+        for (size_t i = 0; i < 16; i++)
+        {
+            float const value = pixels[i][channel];
+            values[i][0] = value;
+            minimum = std::min(minimum, value);
+            maximum = std::max(maximum, value);
+            if (value > 0.0f && value < 255.0f)
+            {
+                innerMinimum = std::min(innerMinimum, value);
+                innerMaximum = std::max(innerMaximum, value);
+            }
+        }
+        auto toByte = [](float value) { return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 255.0f))); };
+
+        // eight values between the extremes
+        std::array<float, 16> weights{};
+        ChannelBlock best = evaluateChannel(values, toByte(maximum), toByte(minimum), weights);
+        for (int iteration = 0; iteration < settings.iterations && best.endpoint0 > best.endpoint1; iteration++)
+        {
+            std::array<float, 4> a{};
+            std::array<float, 4> b{};
+            if (!solveEndpoints(values, 0xFFFF, weights, 1, a, b))
+            {
+                break;
+            }
+            uint8_t const endpoint0 = toByte(std::max(a[0], b[0]));
+            uint8_t const endpoint1 = toByte(std::min(a[0], b[0]));
+            if (endpoint0 == endpoint1)
+            {
+                break;
+            }
+            std::array<float, 16> nextWeights{};
+            ChannelBlock const next = evaluateChannel(values, endpoint0, endpoint1, nextWeights);
+            if (next.error >= best.error)
+            {
+                break;
+            }
+            best = next;
+            weights = nextWeights;
+        }
+
+        // six values between the other values, with exact 0 and 255 (e.g. for alpha cutouts)
+        if ((minimum == 0.0f || maximum == 255.0f) && innerMinimum <= innerMaximum)
+        {
+            ChannelBlock const sixValues = evaluateChannel(values, toByte(innerMinimum), toByte(innerMaximum), weights);
+            if (sixValues.error < best.error)
+            {
+                best = sixValues;
+            }
+        }
+
+        out[0] = best.endpoint0;
+        out[1] = best.endpoint1;
+        for (size_t i = 0; i < 6; i++)
+        {
+            out[2 + i] = static_cast<uint8_t>(best.indices >> (8 * i));
+        }
+    }
+
+    //-----------------------------------------------------
+    // BC7 mode 6 block
+    //-----------------------------------------------------
+
+    struct Bc7Endpoint
+    {
+        std::array<uint8_t, 4> value; // 7 bits per channel
+        uint8_t pBit; // shared least significant bit of all channels
+    };
+
+    [[nodiscard]] static std::array<float, 4> decodeEndpoint(Bc7Endpoint const& endpoint)
+    {
+        std::array<float, 4> out{};
+        for (size_t c = 0; c < 4; c++)
+        {
+            out[c] = static_cast<float>(endpoint.value[c] << 1 | endpoint.pBit);
+        }
+        return out;
+    }
+
+    [[nodiscard]] static Bc7Endpoint quantizeEndpoint(std::array<float, 4> const& endpoint, uint8_t pBit)
+    {
+        Bc7Endpoint out{{}, pBit};
+        for (size_t c = 0; c < 4; c++)
+        {
+            out.value[c] = static_cast<uint8_t>(std::clamp(std::lround((endpoint[c] - pBit) / 2.0f), 0l, 127l));
+        }
+        return out;
+    }
+
+    // p-bit with the smallest quantization error of the endpoint itself
+    [[nodiscard]] static Bc7Endpoint quantizeEndpoint(std::array<float, 4> const& endpoint)
+    {
+        Bc7Endpoint const zero = quantizeEndpoint(endpoint, 0);
+        Bc7Endpoint const one = quantizeEndpoint(endpoint, 1);
+        return squaredError(decodeEndpoint(zero), endpoint, 4) <= squaredError(decodeEndpoint(one), endpoint, 4) ? zero : one;
+    }
+
+    struct Bc7Block
+    {
+        Bc7Endpoint endpoint0;
+        Bc7Endpoint endpoint1;
+        std::array<uint8_t, 16> indices;
+        float error;
+    };
+
+    // the palette lies on a line, so the closest index is the one closest to the projection of the pixel onto the line
+    [[nodiscard]] static Bc7Block evaluateBc7(BlockPixels const& pixels, Bc7Endpoint const& endpoint0,
+                                              Bc7Endpoint const& endpoint1, std::array<float, 16>& weights)
+    {
+        std::array<float, 4> const a = decodeEndpoint(endpoint0);
+        std::array<float, 4> const b = decodeEndpoint(endpoint1);
+        std::array<std::array<float, 4>, 16> palette{};
+        for (size_t k = 0; k < 16; k++)
+        {
+            for (size_t c = 0; c < 4; c++)
+            {
+                palette[k][c] = std::floor(((64.0f - kBc7Weights[k]) * a[c] + kBc7Weights[k] * b[c] + 32.0f) / 64.0f);
+            }
+        }
+        std::array<float, 4> direction{};
+        for (size_t c = 0; c < 4; c++)
+        {
+            direction[c] = b[c] - a[c];
+        }
+        float const lengthSquared = squaredError(direction, std::array<float, 4>{}, 4);
+
+        Bc7Block out{endpoint0, endpoint1, {}, 0.0f};
+        for (size_t i = 0; i < 16; i++)
+        {
+            size_t index = 0;
+            if (lengthSquared > 0.0f)
+            {
+                float t = 0.0f;
+                for (size_t c = 0; c < 4; c++)
+                {
+                    t += (pixels[i][c] - a[c]) * direction[c];
+                }
+                t = t / lengthSquared * 64.0f;
+                for (size_t k = 1; k < 16; k++)
+                {
+                    index = std::abs(kBc7Weights[k] - t) < std::abs(kBc7Weights[index] - t) ? k : index;
+                }
+            }
+            out.indices[i] = static_cast<uint8_t>(index);
+            out.error += squaredError(pixels[i], palette[index], 4);
+            weights[i] = kBc7Weights[index] / 64.0f;
+        }
+        return out;
+    }
+
+    struct BitWriter
+    {
+        uint8_t* out;
+        size_t position = 0;
+
+        void write(uint32_t value, size_t count)
+        {
+            for (size_t i = 0; i < count; i++, position++)
+            {
+                out[position / 8] |= static_cast<uint8_t>(((value >> i) & 1) << (position % 8));
+            }
+        }
+    };
+
+    static void encodeBc7Block(BlockPixels const& pixels, EncodeSettings settings, uint8_t* out)
+    {
+        auto evaluate = [&](std::array<float, 4> const& a, std::array<float, 4> const& b, std::array<float, 16>& weights) {
+            if (!settings.searchPBits)
+            {
+                return evaluateBc7(pixels, quantizeEndpoint(a), quantizeEndpoint(b), weights);
+            }
+            Bc7Block best{{}, {}, {}, std::numeric_limits<float>::max()};
+            for (uint8_t p = 0; p < 4; p++)
+            {
+                std::array<float, 16> pWeights{};
+                Bc7Block const block = evaluateBc7(pixels, quantizeEndpoint(a, p & 1), quantizeEndpoint(b, p >> 1), pWeights);
+                if (block.error < best.error)
+                {
+                    best = block;
+                    weights = pWeights;
+                }
+            }
+            return best;
+        };
+
+        std::array<float, 4> a{};
+        std::array<float, 4> b{};
+        fitEndpoints(pixels, 0xFFFF, 4, a, b);
+        std::array<float, 16> weights{};
+        Bc7Block best = evaluate(a, b, weights);
+        for (int iteration = 0; iteration < settings.iterations; iteration++)
+        {
+            if (!solveEndpoints(pixels, 0xFFFF, weights, 4, a, b))
+            {
+                break;
+            }
+            std::array<float, 16> nextWeights{};
+            Bc7Block const next = evaluate(a, b, nextWeights);
+            if (next.error >= best.error)
+            {
+                break;
+            }
+            best = next;
+            weights = nextWeights;
+        }
+
+        // the most significant bit of the index of the first pixel is implicitly 0
+        if (best.indices[0] >= 8)
+        {
+            std::swap(best.endpoint0, best.endpoint1);
+            for (uint8_t& index: best.indices)
+            {
+                index = static_cast<uint8_t>(15 - index);
+            }
+        }
+
+        std::memset(out, 0, 16);
+        BitWriter bits{out};
+        bits.write(1u << 6, 7); // mode 6
+        for (size_t c = 0; c < 4; c++)
+        {
+            bits.write(best.endpoint0.value[c], 7);
+            bits.write(best.endpoint1.value[c], 7);
+        }
+        bits.write(best.endpoint0.pBit, 1);
+        bits.write(best.endpoint1.pBit, 1);
+        for (size_t i = 0; i < 16; i++)
+        {
+            bits.write(best.indices[i], i == 0 ? 3 : 4);
+        }
+    }
+
+    static void encodeBlock(BlockPixels const& pixels, TextureCompression compression, EncodeSettings settings, uint8_t* out)
+    {
+        switch (compression)
+        {
+            case TextureCompression::BC1:
+                encodeColorBlock(pixels, true, settings, out);
+                break;
+            case TextureCompression::BC3:
+                encodeChannelBlock(pixels, 3, settings, out);
+                encodeColorBlock(pixels, false, settings, out + 8);
+                break;
+            case TextureCompression::BC5:
+                encodeChannelBlock(pixels, 0, settings, out);
+                encodeChannelBlock(pixels, 1, settings, out + 8);
+                break;
+            case TextureCompression::BC7:
+                encodeBc7Block(pixels, settings, out);
+                break;
+            case TextureCompression::None:
+                assert(false);
+                break;
+        }
+    }
+
+    std::vector<uint8_t> compressTexture(std::span<uint8_t const> image, unsigned int width, unsigned int height,
+                                         unsigned int mipmapLevelCount, TextureCompression compression,
+                                         BS::thread_pool& threadPool, CompressionQuality quality)
+    {
+        assert(compression != TextureCompression::None);
+        assert(image.size() == graphics::getMipmapLevelOffset(graphics::PixelFormat::RGBA8Unorm, width, height, mipmapLevelCount));
+        graphics::PixelFormat const pixelFormat = getPixelFormat(compression, false);
+        size_t const blockSize = graphics::getPixelFormatBlock(pixelFormat).size;
+        EncodeSettings const settings = getEncodeSettings(quality);
+        std::vector<uint8_t> out(graphics::getMipmapLevelOffset(pixelFormat, width, height, mipmapLevelCount));
+
+        // rows of blocks of all levels, split into tasks of similar size
+        struct Task
+        {
+            unsigned int level;
+            unsigned int firstRow;
+            unsigned int endRow;
+        };
+        std::vector<Task> tasks;
+        for (unsigned int level = 0; level < mipmapLevelCount; level++)
+        {
+            unsigned int const blocksPerRow = (graphics::getMipmapLevelSize(width, level) + 3) / 4;
+            unsigned int const rowCount = (graphics::getMipmapLevelSize(height, level) + 3) / 4;
+            auto const rowsPerTask = static_cast<unsigned int>(std::max<size_t>(kBlocksPerTask / blocksPerRow, 1));
+            for (unsigned int row = 0; row < rowCount; row += rowsPerTask)
+            {
+                tasks.emplace_back(Task{level, row, std::min(row + rowsPerTask, rowCount)});
+            }
+        }
+
+        common::parallelFor(threadPool, tasks.size(), [&](size_t index) {
+            Task const& task = tasks[index];
+            unsigned int const levelWidth = graphics::getMipmapLevelSize(width, task.level);
+            unsigned int const levelHeight = graphics::getMipmapLevelSize(height, task.level);
+            uint8_t const* in = image.data() + graphics::getMipmapLevelOffset(graphics::PixelFormat::RGBA8Unorm, width, height, task.level);
+            uint8_t* levelOut = out.data() + graphics::getMipmapLevelOffset(pixelFormat, width, height, task.level);
+            size_t const bytesPerRow = graphics::getBytesPerRow(pixelFormat, levelWidth);
+
+            BlockPixels pixels{};
+            for (unsigned int y = task.firstRow; y < task.endRow; y++)
+            {
+                for (unsigned int x = 0; x < (levelWidth + 3) / 4; x++)
+                {
+                    loadBlock(in, levelWidth, levelHeight, x, y, pixels);
+                    encodeBlock(pixels, compression, settings, levelOut + y * bytesPerRow + x * blockSize);
+                }
+            }
+        });
+        return out;
+    }
+}
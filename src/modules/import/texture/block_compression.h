@@ -0,0 +1,59 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_BLOCK_COMPRESSION_H
+#define SHAPEREALITY_BLOCK_COMPRESSION_H
+
+#include <graphics/types.h>
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace BS
+{
+    class thread_pool;
+}
+
+namespace import_::texture
+{
+    enum class TextureCompression
+    {
+        None, // 4 bytes per pixel
+        BC1, // RGB with 1-bit alpha, 0.5 bytes per pixel
+        BC3, // RGBA, 1 byte per pixel
+        BC5, // only red and green (e.g. normal maps), 1 byte per pixel
+        BC7 // RGBA with a higher quality than BC3, 1 byte per pixel
+    };
+
+    enum class CompressionQuality
+    {
+        Fast, // endpoints along the principal axis of the colors of each block
+        Normal, // refines the endpoints with least squares
+        High // more refinement iterations, and tries all BC7 p-bits
+    };
+
+    // pixel format of the compressed texture. BC5 doesn't have an sRGB variant
+    [[nodiscard]] graphics::PixelFormat getPixelFormat(TextureCompression compression, bool sRGB);
+
+    /**
+     * Compresses an RGBA image with 8 bits per channel and its mipmap levels to a block compressed pixel format,
+     * so that it takes up 4 to 8 times less GPU memory and bandwidth. Runs on the CPU, so that textures can be
+     * imported without a GPU (e.g. on a build machine).
+     *
+     * BC7 only uses mode 6 (a single subset with RGBA endpoints), which is fast to encode and decent for most
+     * textures. sRGB colors are compressed as is, the GPU decodes them to linear after decompressing.
+     *
+     * Rows of blocks are compressed in parallel on the thread pool (and this thread).
+     *
+     * @param image all mipmap levels, in the layout of graphics::TextureDescriptor::data
+     * @return all compressed mipmap levels, in the same layout (see graphics::getMipmapLevelOffset())
+     */
+    [[nodiscard]] std::vector<uint8_t> compressTexture(std::span<uint8_t const> image, unsigned int width,
+                                                       unsigned int height, unsigned int mipmapLevelCount,
+                                                       TextureCompression compression, BS::thread_pool& threadPool,
+                                                       CompressionQuality quality = CompressionQuality::Normal);
+}
+
+#endif //SHAPEREALITY_BLOCK_COMPRESSION_H
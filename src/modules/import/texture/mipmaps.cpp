@@ -0,0 +1,367 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "mipmaps.h"
+
+#include <common/thread_pool.h>
+#include <graphics/texture.h>
+
+#include <BS_thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SHAPEREALITY_MIPMAPS_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SHAPEREALITY_MIPMAPS_NEON
+#endif
+
+namespace import_::texture
+{
+    // one RGBA pixel, with one float per channel
+#if defined(SHAPEREALITY_MIPMAPS_SSE)
+    using Float4 = __m128;
+
+    [[nodiscard]] static inline Float4 load(float const* in) { return _mm_loadu_ps(in); }
+
+    static inline void store(float* out, Float4 value) { _mm_storeu_ps(out, value); }
+
+    [[nodiscard]] static inline Float4 splat(float value) { return _mm_set1_ps(value); }
+
+    // a * b + c
+    [[nodiscard]] static inline Float4 multiplyAdd(Float4 a, Float4 b, Float4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+    [[nodiscard]] static inline Float4 clamp01(Float4 value)
+    {
+        return _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    }
+#elif defined(SHAPEREALITY_MIPMAPS_NEON)
+    using Float4 = float32x4_t;
+
+    [[nodiscard]] static inline Float4 load(float const* in) { return vld1q_f32(in); }
+
+    static inline void store(float* out, Float4 value) { vst1q_f32(out, value); }
+
+    [[nodiscard]] static inline Float4 splat(float value) { return vdupq_n_f32(value); }
+
+    // a * b + c
+    [[nodiscard]] static inline Float4 multiplyAdd(Float4 a, Float4 b, Float4 c) { return vmlaq_f32(c, a, b); }
+
+    [[nodiscard]] static inline Float4 clamp01(Float4 value)
+    {
+        return vminq_f32(vmaxq_f32(value, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+    }
+#else
+    struct Float4
+    {
+        std::array<float, 4> v;
+    };
+
+    [[nodiscard]] static inline Float4 load(float const* in) { return Float4{in[0], in[1], in[2], in[3]}; }
+
+    static inline void store(float* out, Float4 value) { std::copy(value.v.begin(), value.v.end(), out); }
+
+    [[nodiscard]] static inline Float4 splat(float value) { return Float4{value, value, value, value}; }
+
+    // a * b + c
+    [[nodiscard]] static inline Float4 multiplyAdd(Float4 a, Float4 b, Float4 c)
+    {
+        for (size_t i = 0; i < 4; i++)
+        {
+            c.v[i] += a.v[i] * b.v[i];
+        }
+        return c;
+    }
+
+    [[nodiscard]] static inline Float4 clamp01(Float4 value)
+    {
+        for (float& v: value.v)
+        {
+            v = std::clamp(v, 0.0f, 1.0f);
+        }
+        return value;
+    }
+#endif
+
+    // size of the lookup table from linear to sRGB, fine enough that the
+    // steepest part of the curve (near black) still rounds to the correct 8-bit value
+    constexpr size_t kEncodeTableSize = 1 << 14;
+
+    // half width of the Kaiser filter in pixels of the destination level, and its shape
+    constexpr float kKaiserRadius = 3.0f;
+    constexpr float kKaiserAlpha = 4.0f;
+
+    // rows of a level that get filtered in one task, so that small levels don't get split into tiny tasks
+    constexpr size_t kPixelsPerTask = 16384;
+
+    struct ColorTables
+    {
+        std::array<float, 256> decode; // 8-bit sRGB to linear
+        std::array<uint8_t, kEncodeTableSize> encode; // linear (scaled to the table size) to 8-bit sRGB
+    };
+
+    [[nodiscard]] static ColorTables const& colorTables()
+    {
+        static ColorTables const tables = []() {
+            ColorTables out{};
+            for (size_t i = 0; i < out.decode.size(); i++)
+            {
+                float const c = static_cast<float>(i) / 255.0f;
+                out.decode[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            for (size_t i = 0; i < out.encode.size(); i++)
+            {
+                float const c = static_cast<float>(i) / static_cast<float>(kEncodeTableSize - 1);
+                float const s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+                out.encode[i] = static_cast<uint8_t>(std::lround(std::clamp(s, 0.0f, 1.0f) * 255.0f));
+            }
+            return out;
+        }();
+        return tables;
+    }
+
+    // zeroth order modified Bessel function of the first kind
+    [[nodiscard]] static float bessel0(float x)
+    {
+        float sum = 1.0f;
+        float term = 1.0f;
+        for (int k = 1; term > sum * 1e-8f; k++)
+        {
+            float const t = x / (2.0f * static_cast<float>(k));
+            term *= t * t;
+            sum += term;
+        }
+        return sum;
+    }
+
+    // t in pixels of the destination level
+    [[nodiscard]] static float kaiser(float t)
+    {
+        float const x = t / kKaiserRadius;
+        if (std::abs(x) >= 1.0f)
+        {
+            return 0.0f;
+        }
+        float const sinc = t == 0.0f ? 1.0f : std::sin(std::numbers::pi_v<float> * t) / (std::numbers::pi_v<float> * t);
+        return sinc * bessel0(kKaiserAlpha * std::sqrt(1.0f - x * x)) / bessel0(kKaiserAlpha);
+    }
+
+    struct Tap
+    {
+        uint32_t source; // pixel index in the source row or column
+        float weight;
+    };
+
+    // the taps of destination pixel i are taps[offsets[i]] to taps[offsets[i + 1]], with weights that sum to 1
+    struct Taps
+    {
+        std::vector<Tap> taps;
+        std::vector<size_t> offsets;
+    };
+
+    // computes the weights of the source pixels for each destination pixel along one axis. these are the same for each
+    // row (or column), so are computed once per level instead of per pixel.
+    [[nodiscard]] static Taps computeTaps(unsigned int sourceSize, unsigned int destinationSize, MipmapFilter filter)
+    {
+        Taps out;
+        out.offsets.reserve(destinationSize + 1);
+        out.offsets.emplace_back(0);
+
+        // pixels of the destination per pixel of the source, at most 1/2 except for when the size is already 1
+        float const scale = static_cast<float>(destinationSize) / static_cast<float>(sourceSize);
+        auto const last = static_cast<int>(sourceSize) - 1;
+        for (unsigned int d = 0; d < destinationSize; d++)
+        {
+            size_t const first = out.taps.size();
+            if (filter == MipmapFilter::Box)
+            {
+                // the source pixels covered by the destination pixel, weighted by how much they are covered,
+                // so that odd sizes (e.g. 7 -> 3) don't skip or favour pixels
+                float const begin = static_cast<float>(d) / scale;
+                float const end = static_cast<float>(d + 1) / scale;
+                for (auto s = static_cast<int>(std::floor(begin)); static_cast<float>(s) < end; s++)
+                {
+                    float const coverage = std::min(end, static_cast<float>(s + 1)) - std::max(begin, static_cast<float>(s));
+                    if (coverage > 1e-6f)
+                    {
+                        out.taps.emplace_back(Tap{static_cast<uint32_t>(std::clamp(s, 0, last)), coverage});
+                    }
+                }
+            }
+            else
+            {
+                // source pixels at the edges are repeated (clamp to edge)
+                float const center = (static_cast<float>(d) + 0.5f) / scale;
+                float const radius = kKaiserRadius / scale;
+                auto const begin = static_cast<int>(std::floor(center - radius));
+                auto const end = static_cast<int>(std::ceil(center + radius));
+                for (int s = begin; s <= end; s++)
+                {
+                    float const weight = kaiser((static_cast<float>(s) + 0.5f - center) * scale);
+                    if (weight != 0.0f)
+                    {
+                        out.taps.emplace_back(Tap{static_cast<uint32_t>(std::clamp(s, 0, last)), weight});
+                    }
+                }
+            }
+
+            float sum = 0.0f;
+            for (size_t i = first; i < out.taps.size(); i++)
+            {
+                sum += out.taps[i].weight;
+            }
+            for (size_t i = first; i < out.taps.size(); i++)
+            {
+                out.taps[i].weight /= sum;
+            }
+            out.offsets.emplace_back(out.taps.size());
+        }
+        return out;
+    }
+
+    // calls function(firstRow, endRow) for chunks of rows in parallel
+    static void parallelForRows(BS::thread_pool& threadPool, unsigned int rowCount, unsigned int width,
+                         std::function<void(unsigned int firstRow, unsigned int endRow)> const& function)
+    {
+        auto const rowsPerTask = static_cast<unsigned int>(std::max<size_t>(kPixelsPerTask / width, 1));
+        size_t const taskCount = (rowCount + rowsPerTask - 1) / rowsPerTask;
+        if (taskCount == 1)
+        {
+            function(0, rowCount);
+            return;
+        }
+        common::parallelFor(threadPool, taskCount, [&](size_t index) {
+            auto const firstRow = static_cast<unsigned int>(index) * rowsPerTask;
+            function(firstRow, std::min(firstRow + rowsPerTask, rowCount));
+        });
+    }
+
+    static void decodeRow(uint8_t const* in, float* out, unsigned int width, MipmapParameters const& parameters)
+    {
+        std::array<float, 256> const& decode = colorTables().decode;
+        for (size_t i = 0; i < static_cast<size_t>(width) * 4; i += 4)
+        {
+            float const alpha = static_cast<float>(in[i + 3]) / 255.0f;
+            float const weight = parameters.alphaWeighted ? alpha : 1.0f;
+            for (size_t c = 0; c < 3; c++)
+            {
+                out[i + c] = weight * (parameters.sRGB ? decode[in[i + c]] : static_cast<float>(in[i + c]) / 255.0f);
+            }
+            out[i + 3] = alpha;
+        }
+    }
+
+    static void encodeRow(float const* in, uint8_t* out, unsigned int width, MipmapParameters const& parameters)
+    {
+        bool const sRGB = parameters.sRGB;
+        std::array<uint8_t, kEncodeTableSize> const& encode = colorTables().encode;
+        Float4 const scale = splat(sRGB ? static_cast<float>(kEncodeTableSize - 1) : 255.0f);
+        Float4 const half = splat(0.5f);
+        for (size_t i = 0; i < static_cast<size_t>(width) * 4; i += 4)
+        {
+            // the sharpening of the Kaiser filter can overshoot
+            float pixel[4];
+            store(pixel, clamp01(load(in + i)));
+            if (parameters.alphaWeighted)
+            {
+                float const inverseAlpha = pixel[3] > 0.0f ? 1.0f / pixel[3] : 0.0f;
+                for (size_t c = 0; c < 3; c++)
+                {
+                    pixel[c] = std::min(pixel[c] * inverseAlpha, 1.0f);
+                }
+            }
+            float scaled[4];
+            store(scaled, multiplyAdd(load(pixel), scale, half));
+            for (size_t c = 0; c < 3; c++)
+            {
+                auto const value = static_cast<size_t>(scaled[c]);
+                out[i + c] = sRGB ? encode[value] : static_cast<uint8_t>(value);
+            }
+            out[i + 3] = static_cast<uint8_t>(pixel[3] * 255.0f + 0.5f);
+        }
+    }
+
+    unsigned int generateMipmaps(std::vector<uint8_t>& image, unsigned int width, unsigned int height,
+                                 BS::thread_pool& threadPool, MipmapParameters const& parameters)
+    {
+        assert(image.size() == static_cast<size_t>(width) * height * 4);
+        unsigned int const levelCount = graphics::getFullMipmapLevelCount(width, height);
+        if (levelCount == 1)
+        {
+            return 1;
+        }
+        image.resize(graphics::getMipmapLevelOffset(graphics::PixelFormat::RGBA8Unorm, width, height, levelCount));
+
+        // level 0 in linear space
+        std::vector<float> source(static_cast<size_t>(width) * height * 4);
+        parallelForRows(threadPool, height, width, [&](unsigned int firstRow, unsigned int endRow) {
+            for (unsigned int y = firstRow; y < endRow; y++)
+            {
+                size_t const offset = static_cast<size_t>(y) * width * 4;
+                decodeRow(image.data() + offset, source.data() + offset, width, parameters);
+            }
+        });
+
+        std::vector<float> horizontal; // source rows filtered horizontally
+        std::vector<float> destination;
+        for (unsigned int level = 1; level < levelCount; level++)
+        {
+            unsigned int const sourceWidth = graphics::getMipmapLevelSize(width, level - 1);
+            unsigned int const sourceHeight = graphics::getMipmapLevelSize(height, level - 1);
+            unsigned int const levelWidth = graphics::getMipmapLevelSize(width, level);
+            unsigned int const levelHeight = graphics::getMipmapLevelSize(height, level);
+            Taps const columns = computeTaps(sourceWidth, levelWidth, parameters.filter);
+            Taps const rows = computeTaps(sourceHeight, levelHeight, parameters.filter);
+
+            // the filter is separable, so first filter each source row, then filter the columns of the result
+            horizontal.resize(static_cast<size_t>(levelWidth) * sourceHeight * 4);
+            parallelForRows(threadPool, sourceHeight, sourceWidth, [&](unsigned int firstRow, unsigned int endRow) {
+                for (unsigned int y = firstRow; y < endRow; y++)
+                {
+                    float const* in = source.data() + static_cast<size_t>(y) * sourceWidth * 4;
+                    float* out = horizontal.data() + static_cast<size_t>(y) * levelWidth * 4;
+                    for (unsigned int x = 0; x < levelWidth; x++)
+                    {
+                        Float4 sum = splat(0.0f);
+                        for (size_t i = columns.offsets[x]; i < columns.offsets[x + 1]; i++)
+                        {
+                            sum = multiplyAdd(load(in + static_cast<size_t>(columns.taps[i].source) * 4), splat(columns.taps[i].weight), sum);
+                        }
+                        store(out + static_cast<size_t>(x) * 4, sum);
+                    }
+                }
+            });
+
+            destination.assign(static_cast<size_t>(levelWidth) * levelHeight * 4, 0.0f);
+            uint8_t* const levelData = image.data() +
+                                       graphics::getMipmapLevelOffset(graphics::PixelFormat::RGBA8Unorm, width, height, level);
+            parallelForRows(threadPool, levelHeight, levelWidth, [&](unsigned int firstRow, unsigned int endRow) {
+                for (unsigned int y = firstRow; y < endRow; y++)
+                {
+                    float* out = destination.data() + static_cast<size_t>(y) * levelWidth * 4;
+                    for (size_t i = rows.offsets[y]; i < rows.offsets[y + 1]; i++)
+                    {
+                        float const* in = horizontal.data() + static_cast<size_t>(rows.taps[i].source) * levelWidth * 4;
+                        Float4 const weight = splat(rows.taps[i].weight);
+                        for (size_t x = 0; x < static_cast<size_t>(levelWidth) * 4; x += 4)
+                        {
+                            store(out + x, multiplyAdd(load(in + x), weight, load(out + x)));
+                        }
+                    }
+                    encodeRow(out, levelData + static_cast<size_t>(y) * levelWidth * 4, levelWidth, parameters);
+                }
+            });
+
+            // the next level is filtered from the unquantized values of this level
+            std::swap(source, destination);
+        }
+        return levelCount;
+    }
+}
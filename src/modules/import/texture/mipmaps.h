@@ -0,0 +1,52 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_MIPMAPS_H
+#define SHAPEREALITY_MIPMAPS_H
+
+#include <vector>
+#include <cstdint>
+
+namespace BS
+{
+    class thread_pool;
+}
+
+namespace import_::texture
+{
+    enum class MipmapFilter
+    {
+        Box, // averages the pixels covered by each pixel of the next level
+        Kaiser // Kaiser windowed sinc, sharper than a box filter, with less aliasing
+    };
+
+    struct MipmapParameters
+    {
+        MipmapFilter filter = MipmapFilter::Kaiser;
+
+        // whether the color channels are sRGB encoded, they are then filtered in linear space and encoded back to
+        // sRGB, so that downsampled levels don't get darker. alpha is always linear.
+        bool sRGB = true;
+
+        // weights the color channels by alpha while filtering (i.e. filters premultiplied colors), so that the color
+        // of transparent pixels doesn't bleed into the visible pixels around them. fully transparent pixels become black.
+        bool alphaWeighted = true;
+    };
+
+    /**
+     * Generates the full mip chain of an RGBA image with 8 bits per channel, down to 1x1 (see
+     * graphics::getFullMipmapLevelCount()). Each level is downsampled from the previous level, which is kept as
+     * 32-bit floats in linear space, so that quantization and gamma errors don't accumulate.
+     *
+     * The rows of each level are filtered in parallel on the thread pool (and this thread), four channels at a time
+     * using SIMD instructions where available (SSE or NEON).
+     *
+     * @param image level 0, the other levels get appended tightly packed, in the layout of graphics::TextureDescriptor::data
+     * @return the amount of mipmap levels, including level 0
+     */
+    unsigned int generateMipmaps(std::vector<uint8_t>& image, unsigned int width, unsigned int height,
+                                 BS::thread_pool& threadPool, MipmapParameters const& parameters = {});
+}
+
+#endif //SHAPEREALITY_MIPMAPS_H
@@ -34,11 +34,33 @@ namespace import_::texture
             return asset::ImportResult::makeError(common::ResultCode::Aborted, lodepng_error_text(error));
         }
 
+        PngImportParameters importParameters;
+        if (!assetDatabase.readImportParameters(inputFile, importParameters, result.dependencies))
+        {
+            return asset::ImportResult::makeError(common::ResultCode::InvalidArgument, "Invalid import parameters");
+        }
+
+        // lodepng decodes to 8-bit RGBA by default
+        unsigned int mipmapLevelCount = 1;
+        if (importParameters.mipmaps)
+        {
+            MipmapParameters const mipmapParameters{.filter = importParameters.mipmapFilter, .sRGB = importParameters.sRGB};
+            mipmapLevelCount = generateMipmaps(image, width, height, assetDatabase.threadPool(), mipmapParameters);
+        }
+
+        // compressed on the CPU, so that the compressed texture gets stored in the import cache
+        if (importParameters.compression != TextureCompression::None)
+        {
+            image = compressTexture(image, width, height, mipmapLevelCount, importParameters.compression,
+                                    assetDatabase.threadPool(), importParameters.compressionQuality);
+        }
+
         graphics::TextureDescriptor descriptor{
             .width = width,
             .height = height,
-            .pixelFormat = graphics::PixelFormat::RGBA8Unorm_sRGB, // todo: make generic
+            .pixelFormat = getPixelFormat(importParameters.compression, importParameters.sRGB),
             .usage = graphics::TextureUsage_ShaderRead,
+            .mipmapLevelCount = mipmapLevelCount,
             .data = image.data()
         };
 
@@ -8,10 +8,34 @@
 #include <asset/asset_id.h>
 #include <asset/import_registry.h>
 
+#include <texture/mipmaps.h>
+#include <texture/block_compression.h>
+
 #include <filesystem>
 
 namespace import_::texture
 {
+    // read from the import parameters file of the input file (see asset::AssetDatabase::readImportParameters)
+    struct PngImportParameters
+    {
+        // generates the full mip chain at import instead of only storing level 0 (see generateMipmaps)
+        bool mipmaps = true;
+
+        MipmapFilter mipmapFilter = MipmapFilter::Kaiser;
+
+        // whether the image contains sRGB encoded colors (e.g. a base color texture), or linear data
+        // (e.g. a normal or roughness map). selects an sRGB or linear pixel format, so that sampling decodes
+        // the colors, and colors are filtered in linear space when generating the mipmaps
+        bool sRGB = true;
+
+        // block compression of all mipmap levels, to reduce GPU memory and bandwidth (see compressTexture).
+        // none by default, as the BC formats are only supported on desktop GPUs (not on the iOS Metal target), so
+        // enable e.g. BC7 in the import parameters when only targeting macOS, Windows or Linux
+        TextureCompression compression = TextureCompression::None;
+
+        CompressionQuality compressionQuality = CompressionQuality::Normal;
+    };
+
     [[nodiscard]] asset::ImportResult importPng(asset::AssetDatabase& assetDatabase, std::filesystem::path const& inputFile);
 }
 
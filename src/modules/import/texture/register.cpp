@@ -6,8 +6,41 @@
 
 #include <texture/png.h>
 
+#include <reflection/class.h>
+#include <reflection/enum.h>
+
 namespace import_::texture
 {
+    void register_(reflection::Reflection& reflection)
+    {
+        reflection::register_::Enum<MipmapFilter>("MipmapFilter")
+            .case_(MipmapFilter::Box, "Box")
+            .case_(MipmapFilter::Kaiser, "Kaiser")
+            .emplace(reflection.types);
+
+        reflection::register_::Enum<TextureCompression>("TextureCompression")
+            .case_(TextureCompression::None, "None")
+            .case_(TextureCompression::BC1, "BC1")
+            .case_(TextureCompression::BC3, "BC3")
+            .case_(TextureCompression::BC5, "BC5")
+            .case_(TextureCompression::BC7, "BC7")
+            .emplace(reflection.types);
+
+        reflection::register_::Enum<CompressionQuality>("CompressionQuality")
+            .case_(CompressionQuality::Fast, "Fast")
+            .case_(CompressionQuality::Normal, "Normal")
+            .case_(CompressionQuality::High, "High")
+            .emplace(reflection.types);
+
+        reflection::register_::Class<PngImportParameters>("PngImportParameters")
+            .member<&PngImportParameters::mipmaps>("mipmaps")
+            .member<&PngImportParameters::mipmapFilter>("mipmapFilter")
+            .member<&PngImportParameters::sRGB>("sRGB")
+            .member<&PngImportParameters::compression>("compression")
+            .member<&PngImportParameters::compressionQuality>("compressionQuality")
+            .emplace(reflection.types);
+    }
+
     void register_(asset::ImportRegistry& importers)
     {
         importers.emplace(importPng, {"png"});
@@ -7,8 +7,14 @@
 
 #include <asset/import_registry.h>
 
+#include <reflection/reflection.h>
+
 namespace import_::texture
 {
+    // register reflection and importer
+
+    void register_(reflection::Reflection& reflection);
+
     void register_(asset::ImportRegistry& importers);
 }
 
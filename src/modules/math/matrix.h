@@ -30,19 +30,22 @@ namespace math
         // construct from initializer list with provided memory layout, default is row major
         constexpr Matrix(std::initializer_list<Type> data, MemoryLayout dataLayout = MemoryLayout::RowMajor);
 
+        // copy, move and destruct are defaulted, so that the type is trivially copyable
+        // (e.g. components containing vectors and matrices can be copied as raw bytes)
+
         // move constructor
-        constexpr Matrix(Matrix&& other) noexcept;
+        constexpr Matrix(Matrix&& other) noexcept = default;
 
         // move assignment operator
-        constexpr Matrix& operator=(Matrix&& other) noexcept;
+        constexpr Matrix& operator=(Matrix&& other) noexcept = default;
 
         // copy constructor
-        constexpr Matrix(Matrix const& other);
+        constexpr Matrix(Matrix const& other) = default;
 
         // copy assignment operator
-        constexpr Matrix& operator=(Matrix const& other);
+        constexpr Matrix& operator=(Matrix const& other) = default;
 
-        constexpr ~Matrix();
+        constexpr ~Matrix() = default;
 
         //-----------
         // Properties
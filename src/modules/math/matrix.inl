@@ -60,35 +60,6 @@ namespace math
         }
     }
 
-    MATRIX_TEMPLATE
-    constexpr MATRIX_TYPE::Matrix(Matrix&& other) noexcept
-        : data_(std::move(other.data_))
-    {
-    }
-
-    MATRIX_TEMPLATE
-    constexpr MATRIX_TYPE& MATRIX_TYPE::operator=(Matrix&& other) noexcept
-    {
-        data_ = std::move(other.data_);
-        return *this;
-    }
-
-    MATRIX_TEMPLATE
-    constexpr MATRIX_TYPE::Matrix(Matrix const& other)
-        : data_(other.data_)
-    {
-    }
-
-    MATRIX_TEMPLATE
-    constexpr MATRIX_TYPE& MATRIX_TYPE::operator=(Matrix const& other)
-    {
-        data_ = other.data_;
-        return *this;
-    }
-
-    MATRIX_TEMPLATE
-    constexpr MATRIX_TYPE::~Matrix() = default;
-
     //-----------
     // Properties
     //-----------
@@ -30,19 +30,22 @@ namespace math
         // construct from initializer list
         constexpr Vector(std::initializer_list<Type> data_);
 
+        // copy, move and destruct are defaulted, so that the type is trivially copyable
+        // (e.g. components containing vectors and matrices can be copied as raw bytes)
+
         // move constructor
-        constexpr Vector(Vector&& other) noexcept;
+        constexpr Vector(Vector&& other) noexcept = default;
 
         // move assignment operator
-        constexpr Vector& operator=(Vector&& other) noexcept;
+        constexpr Vector& operator=(Vector&& other) noexcept = default;
 
         // copy constructor
-        constexpr Vector(Vector const& other);
+        constexpr Vector(Vector const& other) = default;
 
         // copy assignment operator
-        constexpr Vector& operator=(Vector const& other);
+        constexpr Vector& operator=(Vector const& other) = default;
 
-        constexpr ~Vector();
+        constexpr ~Vector() = default;
 
         //-----------
         // Conversion
@@ -5,6 +5,7 @@
 
 #include <sstream>
 #include <algorithm>
+#include <cmath>
 
 // inline definitions for vector.h
 
@@ -29,35 +30,6 @@ namespace math
         std::copy_n(data_.begin(), data_.size(), data.begin());
     }
 
-    VECTOR_TEMPLATE
-    constexpr VECTOR_TYPE::Vector(Vector&& other) noexcept
-        : data(std::move(other.data))
-    {
-    }
-
-    VECTOR_TEMPLATE
-    constexpr VECTOR_TYPE& VECTOR_TYPE::operator=(Vector&& other) noexcept
-    {
-        data = std::move(other.data);
-        return *this;
-    }
-
-    VECTOR_TEMPLATE
-    constexpr VECTOR_TYPE::Vector(Vector const& other)
-        : data(other.data)
-    {
-    }
-
-    VECTOR_TEMPLATE
-    constexpr VECTOR_TYPE& VECTOR_TYPE::operator=(Vector const& other)
-    {
-        data = other.data;
-        return *this;
-    }
-
-    VECTOR_TEMPLATE
-    constexpr VECTOR_TYPE::~Vector() = default;
-
     //-----------
     // Conversion
     //-----------
@@ -264,7 +236,7 @@ namespace math
     VECTOR_TEMPLATE
     constexpr void VECTOR_TYPE::operator/=(Type scalar)
     {
-        return operator*(1.0 / scalar);
+        operator*=(static_cast<Type>(1) / scalar);
     }
 
     VECTOR_TEMPLATE
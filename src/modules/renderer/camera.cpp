@@ -49,7 +49,7 @@ namespace renderer
         return rotation_;
     }
 
-    void Camera::updateBuffer()
+    math::Matrix4 Camera::viewProjection() const
     {
         math::Matrix4 t = math::createTranslationMatrix(-position_);
         math::Matrix4 r = math::createRotationMatrix(rotation_);
@@ -59,10 +59,13 @@ namespace renderer
         // perspective projection expects radians!
         math::Matrix4 projection = math::createPerspectiveProjectionMatrix(
             math::degreesToRadians(parameters_.fieldOfViewInDegrees), parameters_.aspectRatio, parameters_.zNear, parameters_.zFar);
-        math::Matrix4 viewProjection = projection * view;
+        return projection * view;
+    }
 
+    void Camera::updateBuffer()
+    {
         CameraData cameraData{
-            .viewProjection = viewProjection
+            .viewProjection = viewProjection()
         };
         buffer->set(&cameraData, sizeof(cameraData), 0, true);
     }
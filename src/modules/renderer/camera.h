@@ -45,6 +45,9 @@ namespace renderer
 
         [[nodiscard]] math::Quaternionf& rotation();
 
+        // get the view projection matrix from the current position, rotation and parameters
+        [[nodiscard]] math::Matrix4 viewProjection() const;
+
     private:
         struct CameraData
         {
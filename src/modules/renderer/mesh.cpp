@@ -1,5 +1,14 @@
 #include "mesh.h"
 
+#include <common/binary.h>
+
+#include <iterator>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+
 using namespace math;
 
 namespace renderer
@@ -65,6 +74,147 @@ namespace renderer
         return true;
     }
 
+    std::vector<size_t> attributeOffsets(MeshDescriptor const& descriptor)
+    {
+        std::vector<size_t> offsets(descriptor.attributes.size());
+        size_t offset = 0;
+        for (size_t i = 0; i < descriptor.attributes.size(); i++)
+        {
+            offsets[i] = offset;
+            offset += elementSize(descriptor.attributes[i]) * descriptor.vertexCount;
+            offset = (offset + kVertexAttributeAlignment - 1) / kVertexAttributeAlignment * kVertexAttributeAlignment;
+        }
+        return offsets;
+    }
+
+    size_t vertexBufferSize(MeshDescriptor const& descriptor)
+    {
+        if (descriptor.attributes.empty())
+        {
+            return 0;
+        }
+        // the last attribute does not need padding
+        VertexAttributeDescriptor const& last = descriptor.attributes.back();
+        return attributeOffsets(descriptor).back() + elementSize(last) * descriptor.vertexCount;
+    }
+
+    size_t indexBufferSize(MeshDescriptor const& descriptor)
+    {
+        return descriptor.hasIndexBuffer ? descriptor.indexCount * stride(descriptor.indexType) : 0;
+    }
+
+    void FreeDeleter::operator()(void* data) const
+    {
+        std::free(data);
+    }
+
+    MeshData MeshData::allocate(MeshDescriptor descriptor)
+    {
+        MeshData data{.descriptor = std::move(descriptor)};
+        data.vertexData.reset(static_cast<uint8_t*>(std::calloc(vertexBufferSize(data.descriptor), 1)));
+        if (data.descriptor.hasIndexBuffer)
+        {
+            data.indexData.reset(static_cast<uint8_t*>(std::calloc(indexBufferSize(data.descriptor), 1)));
+        }
+        return data;
+    }
+
+    bool computeBoundingSphere(MeshData& data)
+    {
+        MeshDescriptor& descriptor = data.descriptor;
+        std::vector<size_t> const offsets = attributeOffsets(descriptor);
+        for (size_t k = 0; k < descriptor.attributes.size(); k++)
+        {
+            VertexAttributeDescriptor const& attribute = descriptor.attributes[k];
+            if (attribute.type != VertexAttribute_Position || attribute.index != 0 ||
+                attribute.elementType != ElementType::Vector3 || attribute.componentType != ComponentType::Float)
+            {
+                continue;
+            }
+
+            // center of the axis aligned bounds, which is close enough to the optimal sphere for meshes
+            auto const* positions = reinterpret_cast<float const*>(data.vertexData.get() + offsets[k]);
+            float const infinity = std::numeric_limits<float>::infinity();
+            Vector3 min{Vector3{infinity, infinity, infinity}};
+            Vector3 max = -min;
+            for (size_t v = 0; v < descriptor.vertexCount; v++)
+            {
+                Vector3 const position{positions[v * 3], positions[v * 3 + 1], positions[v * 3 + 2]};
+                min = Vector3::min(min, position);
+                max = Vector3::max(max, position);
+            }
+            Vector3 const center = (min + max) * 0.5f;
+            float radiusSquared = 0.0f;
+            for (size_t v = 0; v < descriptor.vertexCount; v++)
+            {
+                Vector3 const position{positions[v * 3], positions[v * 3 + 1], positions[v * 3 + 2]};
+                radiusSquared = std::max(radiusSquared, (position - center).magnitudeSquared());
+            }
+
+            for (int i = 0; i < 3; i++)
+            {
+                descriptor.boundsCenter[i] = descriptor.positionOffset[i] + descriptor.positionScale[i] * center[i];
+            }
+            float const scale = std::max({std::abs(descriptor.positionScale[0]), std::abs(descriptor.positionScale[1]),
+                                          std::abs(descriptor.positionScale[2])});
+            descriptor.boundsRadius = std::sqrt(radiusSquared) * scale;
+            return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] static std::vector<uint32_t> readIndices(MeshDescriptor const& descriptor, uint8_t const* indexData)
+    {
+        std::vector<uint32_t> indices;
+        if (!descriptor.hasIndexBuffer)
+        {
+            indices.resize(descriptor.vertexCount);
+            std::iota(indices.begin(), indices.end(), 0);
+            return indices;
+        }
+
+        indices.resize(descriptor.indexCount);
+        if (descriptor.indexType == ComponentType::UnsignedShort)
+        {
+            auto const* source = reinterpret_cast<uint16_t const*>(indexData);
+            std::copy(source, source + descriptor.indexCount, indices.begin());
+        }
+        else
+        {
+            std::memcpy(indices.data(), indexData, descriptor.indexCount * sizeof(uint32_t));
+        }
+        return indices;
+    }
+
+    std::vector<uint32_t> readIndices(MeshData const& data)
+    {
+        return readIndices(data.descriptor, data.indexData.get());
+    }
+
+    void writeIndices(MeshData& data, std::span<uint32_t const> indices)
+    {
+        MeshDescriptor& descriptor = data.descriptor;
+        if (!descriptor.hasIndexBuffer)
+        {
+            descriptor.hasIndexBuffer = true;
+            descriptor.indexType = ComponentType::UnsignedInt;
+        }
+        descriptor.indexCount = indices.size();
+
+        data.indexData.reset(static_cast<uint8_t*>(std::malloc(indexBufferSize(descriptor))));
+        if (descriptor.indexType == ComponentType::UnsignedShort)
+        {
+            auto* destination = reinterpret_cast<uint16_t*>(data.indexData.get());
+            std::transform(indices.begin(), indices.end(), destination, [](uint32_t index) {
+                return static_cast<uint16_t>(index);
+            });
+        }
+        else
+        {
+            std::memcpy(data.indexData.get(), indices.data(), indices.size() * sizeof(uint32_t));
+        }
+    }
+
     // VertexAttributesIterator
 
     VertexAttributesIterator::VertexAttributesIterator(renderer::Mesh const& mesh_, size_t index_) : mesh(mesh_)
@@ -146,6 +296,32 @@ namespace renderer
         }
     }
 
+    Mesh::Mesh(graphics::IDevice* device_, MeshDescriptor descriptor, void* vertexData, void* indexData, bool take)
+        : device(device_), descriptor_(std::move(descriptor))
+    {
+        assert(device && "graphics device was not set");
+        assert(descriptor_.valid() && "descriptor should be valid");
+        assert(vertexData && "provided vertex data should not be nullptr");
+        assert((indexData != nullptr) == descriptor_.hasIndexBuffer && "index data should be provided if and only if hasIndexBuffer is true");
+
+        graphics::BufferDescriptor vertexBufferDescriptor{
+            .usage = bufferUsage(),
+            .size = desiredVertexBufferSize(),
+        };
+        vertexBuffer_ = device->createBuffer(vertexBufferDescriptor, vertexData, take);
+        if (descriptor_.hasIndexBuffer)
+        {
+            indexBuffer_ = device->createBuffer(indexBufferDescriptor(), indexData, take);
+        }
+        updateOffsets();
+    }
+
+    Mesh::Mesh(graphics::IDevice* device_, MeshData data)
+        : Mesh(device_, std::move(data.descriptor), data.vertexData.release(), data.indexData.release(), true)
+    {
+        meshlets_ = std::move(data.meshlets);
+    }
+
     Mesh::~Mesh() = default;
 
     void Mesh::clear()
@@ -167,16 +343,12 @@ namespace renderer
     {
         assert(descriptor_.attributes.size() == attributesData.size());
 
-        size_t offset = 0;
         for (size_t i = 0; i < attributesData.size(); i++)
         {
             void* attributeData = attributesData[i];
             VertexAttributeDescriptor const& attribute = descriptor_.attributes[i];
             size_t size = elementSize(attribute) * descriptor_.vertexCount;
-            vertexBuffer_->set(attributeData, size, offset, false);
-
-            // update offset
-            offset += size;
+            vertexBuffer_->set(attributeData, size, offsets[i], false);
         }
         vertexBuffer_->synchronize();
     }
@@ -196,6 +368,39 @@ namespace renderer
         indexBuffer_->set(indexData, true);
     }
 
+    void Mesh::setMeshlets(std::vector<Meshlet> meshlets)
+    {
+        meshlets_ = std::move(meshlets);
+    }
+
+    bool Mesh::buildMeshlets(MeshletParameters const& parameters)
+    {
+        if (!descriptor_.hasIndexBuffer)
+        {
+            return false;
+        }
+
+        std::vector<uint32_t> indices = readIndices(descriptor_, static_cast<uint8_t const*>(indexBuffer_->get()));
+        std::vector<Meshlet> meshlets = renderer::buildMeshlets(
+            descriptor_, static_cast<uint8_t const*>(vertexBuffer_->get()), indices, parameters);
+        if (meshlets.empty())
+        {
+            return false;
+        }
+
+        // same amount of indices, so the index buffer keeps its size
+        MeshData data{.descriptor = descriptor_};
+        writeIndices(data, indices);
+        setIndexData(data.indexData.get());
+        meshlets_ = std::move(meshlets);
+        return true;
+    }
+
+    std::span<Meshlet const> Mesh::meshlets() const
+    {
+        return meshlets_;
+    }
+
     MeshDescriptor const& Mesh::descriptor() const
     {
         return descriptor_;
@@ -225,12 +430,7 @@ namespace renderer
 
     size_t Mesh::desiredVertexBufferSize()
     {
-        size_t sum = 0;
-        for (auto& attribute: descriptor_.attributes)
-        {
-            sum += elementSize(attribute) * descriptor_.vertexCount;
-        }
-        return sum;
+        return vertexBufferSize(descriptor_);
     }
 
     void Mesh::createVertexBuffer()
@@ -258,12 +458,16 @@ namespace renderer
     {
         assert(descriptor_.hasIndexBuffer);
 
-        graphics::BufferDescriptor indexBufferDescriptor{
+        indexBuffer_ = device->createBuffer(indexBufferDescriptor());
+    }
+
+    graphics::BufferDescriptor Mesh::indexBufferDescriptor() const
+    {
+        return graphics::BufferDescriptor{
             .usage = bufferUsage(),
-            .size = descriptor_.indexCount * stride(descriptor_.indexType),
+            .size = indexBufferSize(descriptor_),
             .stride = stride(descriptor_.indexType)
         };
-        indexBuffer_ = device->createBuffer(indexBufferDescriptor);
     }
 
     graphics::BufferUsage_ Mesh::bufferUsage() const
@@ -276,16 +480,7 @@ namespace renderer
 
     void Mesh::updateOffsets()
     {
-        offsets.resize(descriptor_.attributes.size());
-        size_t offset = 0;
-        for (size_t i = 0; i < descriptor_.attributes.size(); i++)
-        {
-            offsets[i] = offset;
-
-            VertexAttributeDescriptor const& attribute = descriptor_.attributes[i];
-            size_t size = elementSize(attribute) * descriptor_.vertexCount;
-            offset += size;
-        }
+        offsets = attributeOffsets(descriptor_);
     }
 
     size_t Mesh::getAttributeIndex(VertexAttribute_ attribute, size_t index) const
@@ -300,4 +495,210 @@ namespace renderer
         }
         assert(false && "Mesh does not contain attribute type with provided index");
     }
-}
\ No newline at end of file
+
+    constexpr uint32_t kMeshMagic = 0x48534D53; // "SMSH"
+    constexpr uint32_t kMeshVersion = 4; // 2: normalized, encoding and position dequantization, 3: bounds and lod, 4: meshlets
+
+    bool writeMesh(Mesh& mesh, std::ostream& out)
+    {
+        MeshDescriptor const& descriptor = mesh.descriptor();
+
+        common::binary::write(out, kMeshMagic);
+        common::binary::write(out, kMeshVersion);
+        common::binary::write(out, static_cast<uint32_t>(descriptor.primitiveType));
+        common::binary::write(out, static_cast<uint64_t>(descriptor.attributes.size()));
+        for (auto& attribute: descriptor.attributes)
+        {
+            common::binary::write(out, static_cast<uint64_t>(attribute.index));
+            common::binary::write(out, static_cast<uint32_t>(attribute.type));
+            common::binary::write(out, static_cast<uint32_t>(attribute.elementType));
+            common::binary::write(out, static_cast<uint32_t>(attribute.componentType));
+            common::binary::write(out, static_cast<uint8_t>(attribute.normalized));
+            common::binary::write(out, static_cast<uint32_t>(attribute.encoding));
+        }
+        common::binary::write(out, static_cast<uint64_t>(descriptor.vertexCount));
+        common::binary::write(out, static_cast<uint8_t>(descriptor.hasIndexBuffer));
+        common::binary::write(out, static_cast<uint64_t>(descriptor.indexCount));
+        common::binary::write(out, static_cast<uint32_t>(descriptor.indexType));
+        common::binary::write(out, static_cast<uint8_t>(descriptor.writable));
+        for (size_t i = 0; i < 3; i++)
+        {
+            common::binary::write(out, descriptor.positionOffset[i]);
+            common::binary::write(out, descriptor.positionScale[i]);
+            common::binary::write(out, descriptor.boundsCenter[i]);
+        }
+        common::binary::write(out, descriptor.boundsRadius);
+        common::binary::write(out, static_cast<uint64_t>(descriptor.lodLevel));
+        common::binary::write(out, descriptor.lodScreenSize);
+
+        graphics::Buffer* vertexBuffer = mesh.vertexBuffer();
+        size_t const vertexSize = vertexBuffer->descriptor().size;
+        common::binary::write(out, static_cast<uint64_t>(vertexSize));
+        out.write(static_cast<char const*>(vertexBuffer->get()), static_cast<std::streamsize>(vertexSize));
+
+        if (descriptor.hasIndexBuffer)
+        {
+            graphics::Buffer* indexBuffer = mesh.indexBuffer();
+            size_t const indexSize = indexBuffer->descriptor().size;
+            common::binary::write(out, static_cast<uint64_t>(indexSize));
+            out.write(static_cast<char const*>(indexBuffer->get()), static_cast<std::streamsize>(indexSize));
+        }
+
+        std::span<Meshlet const> const meshlets = mesh.meshlets();
+        common::binary::write(out, static_cast<uint64_t>(meshlets.size()));
+        for (Meshlet const& meshlet: meshlets)
+        {
+            common::binary::write(out, meshlet.indexOffset);
+            common::binary::write(out, meshlet.triangleCount);
+            common::binary::write(out, meshlet.vertexCount);
+            for (size_t i = 0; i < 3; i++)
+            {
+                common::binary::write(out, meshlet.boundsCenter[i]);
+            }
+            common::binary::write(out, meshlet.boundsRadius);
+            for (size_t i = 0; i < 3; i++)
+            {
+                common::binary::write(out, meshlet.coneAxis[i]);
+            }
+            common::binary::write(out, meshlet.coneCutoff);
+        }
+        return out.good();
+    }
+
+    std::unique_ptr<Mesh> readMesh(graphics::IDevice* device, std::istream& in)
+    {
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        return readMesh(device, std::span<uint8_t const>(data));
+    }
+
+    std::unique_ptr<Mesh> readMesh(graphics::IDevice* device, std::span<uint8_t const> data)
+    {
+        common::binary::MemoryReader in(data);
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        if (!in.read(magic) || !in.read(version) || magic != kMeshMagic || version != kMeshVersion)
+        {
+            return nullptr;
+        }
+
+        MeshDescriptor descriptor{};
+        uint32_t primitiveType = 0;
+        uint64_t attributeCount = 0;
+        if (!in.read(primitiveType) || !in.read(attributeCount))
+        {
+            return nullptr;
+        }
+        descriptor.primitiveType = static_cast<graphics::PrimitiveType>(primitiveType);
+
+        for (uint64_t i = 0; i < attributeCount; i++)
+        {
+            uint64_t index = 0;
+            uint32_t type = 0;
+            uint32_t elementType = 0;
+            uint32_t componentType = 0;
+            uint8_t normalized = 0;
+            uint32_t encoding = 0;
+            if (!in.read(index) || !in.read(type) || !in.read(elementType) || !in.read(componentType) ||
+                !in.read(normalized) || !in.read(encoding))
+            {
+                return nullptr;
+            }
+            descriptor.attributes.emplace_back(VertexAttributeDescriptor{
+                .index = static_cast<size_t>(index),
+                .type = static_cast<VertexAttribute_>(type),
+                .elementType = static_cast<ElementType>(elementType),
+                .componentType = static_cast<ComponentType>(componentType),
+                .normalized = normalized != 0,
+                .encoding = static_cast<VertexAttributeEncoding>(encoding)
+            });
+        }
+
+        uint64_t vertexCount = 0;
+        uint8_t hasIndexBuffer = 0;
+        uint64_t indexCount = 0;
+        uint32_t indexType = 0;
+        uint8_t writable = 0;
+        if (!in.read(vertexCount) || !in.read(hasIndexBuffer) || !in.read(indexCount) || !in.read(indexType) ||
+            !in.read(writable))
+        {
+            return nullptr;
+        }
+        descriptor.vertexCount = static_cast<size_t>(vertexCount);
+        descriptor.hasIndexBuffer = hasIndexBuffer != 0;
+        descriptor.indexCount = static_cast<size_t>(indexCount);
+        descriptor.indexType = static_cast<ComponentType>(indexType);
+        descriptor.writable = writable != 0;
+        for (size_t i = 0; i < 3; i++)
+        {
+            if (!in.read(descriptor.positionOffset[i]) || !in.read(descriptor.positionScale[i]) ||
+                !in.read(descriptor.boundsCenter[i]))
+            {
+                return nullptr;
+            }
+        }
+        uint64_t lodLevel = 0;
+        if (!in.read(descriptor.boundsRadius) || !in.read(lodLevel) || !in.read(descriptor.lodScreenSize))
+        {
+            return nullptr;
+        }
+        descriptor.lodLevel = static_cast<size_t>(lodLevel);
+
+        // validate sizes before creating any buffers
+        size_t const expectedVertexSize = vertexBufferSize(descriptor);
+
+        // the buffers are created directly from the provided memory
+        uint64_t vertexSize = 0;
+        std::span<uint8_t const> vertexData;
+        if (!in.read(vertexSize) || vertexSize != expectedVertexSize || vertexSize == 0 ||
+            !in.readBlock(vertexSize, vertexData))
+        {
+            return nullptr;
+        }
+
+        std::span<uint8_t const> indexData;
+        if (descriptor.hasIndexBuffer)
+        {
+            uint64_t indexSize = 0;
+            if (!in.read(indexSize) || indexSize != indexBufferSize(descriptor) ||
+                !in.readBlock(indexSize, indexData))
+            {
+                return nullptr;
+            }
+        }
+
+        uint64_t meshletCount = 0;
+        if (!in.read(meshletCount) || (meshletCount > 0 && !descriptor.hasIndexBuffer))
+        {
+            return nullptr;
+        }
+        std::vector<Meshlet> meshlets;
+        meshlets.reserve(std::min<uint64_t>(meshletCount, descriptor.indexCount / 3));
+        for (uint64_t m = 0; m < meshletCount; m++)
+        {
+            Meshlet meshlet{};
+            if (!in.read(meshlet.indexOffset) || !in.read(meshlet.triangleCount) || !in.read(meshlet.vertexCount) ||
+                !in.read(meshlet.boundsCenter[0]) || !in.read(meshlet.boundsCenter[1]) ||
+                !in.read(meshlet.boundsCenter[2]) || !in.read(meshlet.boundsRadius) ||
+                !in.read(meshlet.coneAxis[0]) || !in.read(meshlet.coneAxis[1]) || !in.read(meshlet.coneAxis[2]) ||
+                !in.read(meshlet.coneCutoff))
+            {
+                return nullptr;
+            }
+
+            // meshlets should stay inside the index buffer
+            if (static_cast<uint64_t>(meshlet.indexOffset) + static_cast<uint64_t>(meshlet.triangleCount) * 3 > descriptor.indexCount)
+            {
+                return nullptr;
+            }
+            meshlets.emplace_back(meshlet);
+        }
+
+        // the mesh only copies from the provided data (take is false), so casting away const is safe
+        auto mesh = std::make_unique<Mesh>(device, descriptor, const_cast<uint8_t*>(vertexData.data()),
+                                           descriptor.hasIndexBuffer ? const_cast<uint8_t*>(indexData.data()) : nullptr,
+                                           false);
+        mesh->setMeshlets(std::move(meshlets));
+        return mesh;
+    }
+}
@@ -8,9 +8,16 @@
 #include <graphics/device.h>
 #include <graphics/buffer.h>
 
+#include <renderer/meshlet.h>
+
 #include "math/vector.h"
+#include "math/vector.inl"
 
 #include <vector>
+#include <span>
+#include <memory>
+#include <limits>
+#include <iosfwd>
 
 namespace renderer
 {
@@ -56,12 +63,26 @@ namespace renderer
     // get the stride for a given component type (in bytes)
     [[nodiscard]] size_t stride(ComponentType componentType);
 
+    /**
+     * How the components of a vertex attribute should be interpreted, on top of its component type
+     */
+    enum class VertexAttributeEncoding
+    {
+        None = 0,
+
+        // unit vector mapped onto the octahedron and unfolded onto [-1, 1]^2 (see encodeOctahedral()).
+        // normals use a Vector2, tangents a Vector3 where the third component is the sign of the bitangent.
+        Octahedral
+    };
+
     struct VertexAttributeDescriptor
     {
         size_t index = 0;
         VertexAttribute_ type = VertexAttribute_Position;
         ElementType elementType = ElementType::Vector3;
         ComponentType componentType = ComponentType::Float;
+        bool normalized = false; // integer components map to [0, 1] (unsigned) or [-1, 1] (signed) when read as float
+        VertexAttributeEncoding encoding = VertexAttributeEncoding::None;
     };
 
     [[nodiscard]] size_t elementSize(VertexAttributeDescriptor const& descriptor);
@@ -82,9 +103,70 @@ namespace renderer
 
         bool writable = false; // if this is set to true, we keep a copy of the mesh on the CPU that can be written to.
 
+        // dequantization transform for quantized positions: position = positionOffset + positionScale * stored,
+        // where stored is the position attribute as read by the shader (e.g. in [0, 1] for normalized unsigned shorts)
+        math::Vector3 positionOffset{math::Vector3{0, 0, 0}};
+        math::Vector3 positionScale{math::Vector3{1, 1, 1}};
+
+        // bounding sphere of the (dequantized) positions, see computeBoundingSphere()
+        math::Vector3 boundsCenter{math::Vector3{0, 0, 0}};
+        float boundsRadius = 0.0f;
+
+        // level of detail, 0 is the full detail mesh. a level should be used while the projected size of the
+        // bounding sphere on the screen (as fraction of the screen height) is at most lodScreenSize, see selectLod()
+        size_t lodLevel = 0;
+        float lodScreenSize = std::numeric_limits<float>::infinity();
+
         [[nodiscard]] bool valid() const;
     };
 
+    // each vertex attribute starts at a multiple of this inside the vertex buffer, as 8-bit and 16-bit
+    // attributes don't necessarily take up a multiple of 4 bytes
+    constexpr size_t kVertexAttributeAlignment = 4;
+
+    // get the offset of each vertex attribute inside the vertex buffer (in bytes), ordered 1:1 with descriptor.attributes
+    [[nodiscard]] std::vector<size_t> attributeOffsets(MeshDescriptor const& descriptor);
+
+    // get the size of the vertex buffer (in bytes)
+    [[nodiscard]] size_t vertexBufferSize(MeshDescriptor const& descriptor);
+
+    // get the size of the index buffer (in bytes), 0 if the mesh has no index buffer
+    [[nodiscard]] size_t indexBufferSize(MeshDescriptor const& descriptor);
+
+    // frees memory allocated using malloc
+    struct FreeDeleter
+    {
+        void operator()(void* data) const;
+    };
+
+    struct MeshData;
+
+    // sets the bounding sphere of the mesh descriptor from the 32-bit float positions of the mesh data,
+    // returns false if the mesh has no float positions
+    bool computeBoundingSphere(MeshData& data);
+
+    /**
+     * Vertex and index data of a mesh in CPU memory, so that it can be processed (e.g. quantized) at import time
+     * before the Mesh gets created from it. The data is allocated using malloc, so that its ownership can be
+     * transferred to the buffers of the Mesh without copying.
+     */
+    struct MeshData
+    {
+        MeshDescriptor descriptor;
+        std::unique_ptr<uint8_t[], FreeDeleter> vertexData; // attributes stored sequentially, see attributeOffsets()
+        std::unique_ptr<uint8_t[], FreeDeleter> indexData; // nullptr if the descriptor has no index buffer
+        std::vector<Meshlet> meshlets; // empty if no meshlets were built, see buildMeshlets()
+
+        // allocates zero initialized vertex and index data with the sizes required by the descriptor
+        [[nodiscard]] static MeshData allocate(MeshDescriptor descriptor);
+    };
+
+    // get the indices of the mesh data widened to 32 bits, or 0 to vertexCount - 1 if it has no index buffer
+    [[nodiscard]] std::vector<uint32_t> readIndices(MeshData const& data);
+
+    // replaces the index data of the mesh data, stored as descriptor.indexType (or 32 bits if it had no index buffer)
+    void writeIndices(MeshData& data, std::span<uint32_t const> indices);
+
     struct Mesh;
 
     // this iterator enables us to iterate over the vertex attributes in the Mesh abstraction
@@ -151,6 +233,16 @@ namespace renderer
         explicit Mesh(graphics::IDevice* device, MeshDescriptor descriptor, void* vertexData,
                       void* indexData = nullptr);
 
+        // construct mesh from memory that already contains the different attributes sequentially, the buffers are
+        // created directly from the provided memory. if take is true, the mesh takes ownership of vertexData and
+        // indexData (allocated using malloc), so that the graphics backend can avoid copying them (see createBuffer).
+        // indexData should only be provided if the descriptor has an index buffer.
+        explicit Mesh(graphics::IDevice* device, MeshDescriptor descriptor, void* vertexData, void* indexData,
+                      bool take);
+
+        // construct mesh by taking ownership of the vertex and index data
+        explicit Mesh(graphics::IDevice* device, MeshData data);
+
         // construct mesh from individual pieces of memory that contain the different attributes separately
         explicit Mesh(graphics::IDevice* device, MeshDescriptor descriptor, std::vector<void*> const& attributesData,
                       void* indexData = nullptr);
@@ -180,6 +272,17 @@ namespace renderer
         // set the index buffer data, indexData should not be nullptr
         void setIndexData(void* indexData);
 
+        // set the meshlets of the mesh, the triangles of each meshlet should be contiguous in the index buffer
+        void setMeshlets(std::vector<Meshlet> meshlets);
+
+        // builds meshlets from the vertex and index buffers and reorders the index buffer accordingly (see
+        // buildMeshlets()). requires the buffers to be readable from the CPU and an index buffer. returns false
+        // if the mesh is not an indexed triangle mesh with readable positions.
+        bool buildMeshlets(MeshletParameters const& parameters = {});
+
+        // get the meshlets of the mesh, empty if no meshlets were built
+        [[nodiscard]] std::span<Meshlet const> meshlets() const;
+
         [[nodiscard]] MeshDescriptor const& descriptor() const;
 
         // get vertex buffer
@@ -199,6 +302,7 @@ namespace renderer
         MeshDescriptor descriptor_; // description of what is inside the buffers, e.g. vertex count and the primitive type
         std::unique_ptr<graphics::Buffer> vertexBuffer_; // vertex buffer with non-interleaved (sequential) contiguous data for all vertex attributes
         std::unique_ptr<graphics::Buffer> indexBuffer_;
+        std::vector<Meshlet> meshlets_; // kept on the CPU for culling
         std::vector<size_t> offsets;
 
         // reallocates the vertex buffer if its size is not equal to the desired size
@@ -207,6 +311,8 @@ namespace renderer
         //
         void createIndexBuffer();
 
+        [[nodiscard]] graphics::BufferDescriptor indexBufferDescriptor() const;
+
         //
         [[nodiscard]] size_t desiredVertexBufferSize();
 
@@ -223,6 +329,17 @@ namespace renderer
 
         friend class VertexAttributesIterator;
     };
+
+    // writes the mesh descriptor and its vertex and index data to a native binary format,
+    // used for caching imported meshes. requires the buffers to be readable from the CPU.
+    [[nodiscard]] bool writeMesh(Mesh& mesh, std::ostream& out);
+
+    // reads a mesh written using writeMesh() and creates its buffers on the provided device
+    [[nodiscard]] std::unique_ptr<Mesh> readMesh(graphics::IDevice* device, std::istream& in);
+
+    // reads a mesh written using writeMesh() from memory (e.g. a memory mapped asset archive),
+    // the buffers are created directly from the provided memory
+    [[nodiscard]] std::unique_ptr<Mesh> readMesh(graphics::IDevice* device, std::span<uint8_t const> data);
 }
 
 #endif //SHAPEREALITY_MESH_H
@@ -0,0 +1,513 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "mesh_optimization.h"
+
+#include <common/hash.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace renderer
+{
+    constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    // cache size the Forsyth scoring function is tuned for
+    constexpr size_t kForsythCacheSize = 32;
+
+    // cache size used for finding cluster boundaries, small enough to match most GPUs
+    constexpr size_t kOverdrawCacheSize = 16;
+
+    // FIFO post-transform vertex cache
+    struct VertexCache
+    {
+        explicit VertexCache(size_t size) : entries(size, kInvalidIndex) {}
+
+        // returns whether the vertex was a miss, in which case it gets added
+        bool access(uint32_t vertex)
+        {
+            if (std::find(entries.begin(), entries.end(), vertex) != entries.end())
+            {
+                return false;
+            }
+            entries[head] = vertex;
+            head = (head + 1) % entries.size();
+            return true;
+        }
+
+        void clear()
+        {
+            std::fill(entries.begin(), entries.end(), kInvalidIndex);
+            head = 0;
+        }
+
+    private:
+        std::vector<uint32_t> entries;
+        size_t head = 0;
+    };
+
+    float averageCacheMissRatio(std::span<uint32_t const> indices, size_t cacheSize)
+    {
+        size_t const triangleCount = indices.size() / 3;
+        if (triangleCount == 0)
+        {
+            return 0.0f;
+        }
+
+        VertexCache cache(cacheSize);
+        size_t misses = 0;
+        for (uint32_t index: indices)
+        {
+            misses += cache.access(index) ? 1 : 0;
+        }
+        return static_cast<float>(misses) / static_cast<float>(triangleCount);
+    }
+
+    [[nodiscard]] static float vertexScore(int cachePosition, uint32_t valence)
+    {
+        if (valence == 0)
+        {
+            return -1.0f; // not used by any remaining triangle
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            // the vertices of the last triangle get a fixed score, so that the next triangle does not
+            // simply continue a strip from the last edge
+            score = cachePosition < 3
+                    ? 0.75f
+                    : std::pow(1.0f - static_cast<float>(cachePosition - 3) / static_cast<float>(kForsythCacheSize - 3), 1.5f);
+        }
+
+        // prefer vertices with few remaining triangles, so that no lone triangles are left behind
+        score += 2.0f * std::pow(static_cast<float>(valence), -0.5f);
+        return score;
+    }
+
+    std::vector<uint32_t> optimizeVertexCache(std::span<uint32_t const> indices, size_t vertexCount)
+    {
+        size_t const triangleCount = indices.size() / 3;
+
+        // triangles that use each vertex, valence is the amount of triangles that have not been emitted yet
+        std::vector<uint32_t> valence(vertexCount, 0);
+        for (uint32_t index: indices)
+        {
+            valence[index]++;
+        }
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            adjacencyOffsets[v + 1] = adjacencyOffsets[v] + valence[v];
+        }
+        std::vector<uint32_t> adjacency(indices.size());
+        {
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); i++)
+            {
+                adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        std::vector<int> cachePosition(vertexCount, -1);
+        std::vector<float> score(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            score[v] = vertexScore(-1, valence[v]);
+        }
+
+        std::vector<float> triangleScore(triangleCount);
+        std::vector<bool> emitted(triangleCount, false);
+        uint32_t best = 0;
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+            if (triangleScore[t] > triangleScore[best])
+            {
+                best = static_cast<uint32_t>(t);
+            }
+        }
+
+        std::vector<uint32_t> out;
+        out.reserve(triangleCount * 3);
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> newCache;
+        std::vector<uint32_t> evicted;
+        size_t cursor = 0; // next triangle in input order, for when no triangle uses a vertex in the cache
+
+        for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+        {
+            if (best == kInvalidIndex)
+            {
+                while (emitted[cursor])
+                {
+                    cursor++;
+                }
+                best = static_cast<uint32_t>(cursor);
+            }
+
+            uint32_t const triangle[3] = {indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2]};
+            out.insert(out.end(), std::begin(triangle), std::end(triangle));
+            emitted[best] = true;
+
+            // remove the triangle from the adjacency of its vertices
+            for (uint32_t v: triangle)
+            {
+                uint32_t* begin = adjacency.data() + adjacencyOffsets[v];
+                uint32_t* end = begin + valence[v];
+                uint32_t* it = std::find(begin, end, best);
+                *it = *(end - 1);
+                valence[v]--;
+            }
+
+            // the vertices of the triangle move to the front of the cache
+            newCache.clear();
+            for (uint32_t v: triangle)
+            {
+                if (std::find(newCache.begin(), newCache.end(), v) == newCache.end())
+                {
+                    newCache.emplace_back(v);
+                }
+            }
+            for (uint32_t v: cache)
+            {
+                if (std::find(std::begin(triangle), std::end(triangle), v) == std::end(triangle))
+                {
+                    newCache.emplace_back(v);
+                }
+            }
+            evicted.clear();
+            for (size_t i = kForsythCacheSize; i < newCache.size(); i++)
+            {
+                cachePosition[newCache[i]] = -1;
+                evicted.emplace_back(newCache[i]);
+            }
+            newCache.resize(std::min(newCache.size(), kForsythCacheSize));
+            std::swap(cache, newCache);
+
+            // update the scores of the vertices that moved, and of the triangles that use them
+            for (size_t i = 0; i < cache.size(); i++)
+            {
+                cachePosition[cache[i]] = static_cast<int>(i);
+                score[cache[i]] = vertexScore(static_cast<int>(i), valence[cache[i]]);
+            }
+            for (uint32_t v: evicted)
+            {
+                score[v] = vertexScore(-1, valence[v]);
+            }
+
+            best = kInvalidIndex;
+            float bestScore = -std::numeric_limits<float>::infinity();
+            for (std::vector<uint32_t> const* vertices: {&cache, &evicted})
+            {
+                for (uint32_t v: *vertices)
+                {
+                    for (uint32_t i = adjacencyOffsets[v]; i < adjacencyOffsets[v] + valence[v]; i++)
+                    {
+                        uint32_t const t = adjacency[i];
+                        triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+                        if (vertices == &cache && triangleScore[t] > bestScore)
+                        {
+                            best = t;
+                            bestScore = triangleScore[t];
+                        }
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+    /**
+     * Splits the triangles into clusters and sorts the clusters so that the ones facing outwards get drawn first,
+     * as these occlude the ones facing inwards. Clusters start where the vertex cache optimization started a new
+     * strip, and are split further as long as the average cache miss ratio stays within the threshold, see
+     * Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (2007).
+     */
+    [[nodiscard]] static std::vector<uint32_t> optimizeOverdraw(std::span<uint32_t const> indices, float const* positions,
+                                                                float threshold)
+    {
+        size_t const triangleCount = indices.size() / 3;
+
+        // hard boundaries, where all vertices of a triangle miss the cache
+        std::vector<size_t> hardBoundaries;
+        VertexCache cache(kOverdrawCacheSize);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            size_t misses = 0;
+            for (size_t k = 0; k < 3; k++)
+            {
+                misses += cache.access(indices[t * 3 + k]) ? 1 : 0;
+            }
+            if (t == 0 || misses == 3)
+            {
+                hardBoundaries.emplace_back(t);
+            }
+        }
+        hardBoundaries.emplace_back(triangleCount);
+
+        // soft boundaries, split a cluster as soon as its cache miss ratio so far is close to that of the whole cluster
+        std::vector<size_t> clusters;
+        for (size_t i = 0; i + 1 < hardBoundaries.size(); i++)
+        {
+            size_t const start = hardBoundaries[i];
+            size_t const end = hardBoundaries[i + 1];
+            float const clusterRatio = averageCacheMissRatio(indices.subspan(start * 3, (end - start) * 3), kOverdrawCacheSize);
+
+            cache.clear();
+            size_t clusterStart = start;
+            size_t misses = 0;
+            clusters.emplace_back(start);
+            for (size_t t = start; t < end; t++)
+            {
+                for (size_t k = 0; k < 3; k++)
+                {
+                    misses += cache.access(indices[t * 3 + k]) ? 1 : 0;
+                }
+                float const ratio = static_cast<float>(misses) / static_cast<float>(t - clusterStart + 1);
+                if (t + 1 < end && ratio <= clusterRatio * threshold)
+                {
+                    clusterStart = t + 1;
+                    misses = 0;
+                    cache.clear();
+                    clusters.emplace_back(clusterStart);
+                }
+            }
+        }
+        clusters.emplace_back(triangleCount);
+
+        // area weighted centroid and normal of each cluster, and of the whole mesh
+        struct Cluster
+        {
+            size_t start;
+            size_t end;
+            math::Vector3 centroid;
+            math::Vector3 normal;
+            float area = 0.0f;
+            float sortKey = 0.0f;
+        };
+        std::vector<Cluster> sorted(clusters.size() - 1);
+        math::Vector3 meshCentroid{math::Vector3{0, 0, 0}};
+        float meshArea = 0.0f;
+        for (size_t i = 0; i + 1 < clusters.size(); i++)
+        {
+            Cluster& cluster = sorted[i];
+            cluster.start = clusters[i];
+            cluster.end = clusters[i + 1];
+            for (size_t t = cluster.start; t < cluster.end; t++)
+            {
+                math::Vector3 p[3];
+                for (size_t k = 0; k < 3; k++)
+                {
+                    float const* position = positions + indices[t * 3 + k] * 3;
+                    p[k] = math::Vector3{position[0], position[1], position[2]};
+                }
+                math::Vector3 const normal = (p[1] - p[0]).cross(p[2] - p[0]);
+                float const area = normal.magnitude();
+                cluster.centroid += (p[0] + p[1] + p[2]) * (area / 3.0f);
+                cluster.normal += normal;
+                cluster.area += area;
+            }
+            meshCentroid += cluster.centroid;
+            meshArea += cluster.area;
+            if (cluster.area > 0.0f)
+            {
+                cluster.centroid /= cluster.area;
+            }
+        }
+        if (meshArea > 0.0f)
+        {
+            meshCentroid /= meshArea;
+        }
+
+        for (auto& cluster: sorted)
+        {
+            float const length = cluster.normal.magnitude();
+            cluster.sortKey = length > 0.0f ? (cluster.centroid - meshCentroid).dot(cluster.normal / length) : 0.0f;
+        }
+        std::stable_sort(sorted.begin(), sorted.end(), [](Cluster const& lhs, Cluster const& rhs) {
+            return lhs.sortKey > rhs.sortKey;
+        });
+
+        std::vector<uint32_t> out;
+        out.reserve(indices.size());
+        for (auto& cluster: sorted)
+        {
+            out.insert(out.end(), indices.begin() + static_cast<ptrdiff_t>(cluster.start * 3),
+                       indices.begin() + static_cast<ptrdiff_t>(cluster.end * 3));
+        }
+        return out;
+    }
+
+    // returns the vertex data with each vertex v moved to remap[v], vertices with an invalid index are dropped
+    [[nodiscard]] static std::unique_ptr<uint8_t[], FreeDeleter> remapVertices(MeshDescriptor const& descriptor,
+                                                                              uint8_t const* vertexData,
+                                                                              std::span<uint32_t const> remap,
+                                                                              size_t outVertexCount)
+    {
+        MeshDescriptor outDescriptor = descriptor;
+        outDescriptor.vertexCount = outVertexCount;
+        std::vector<size_t> const offsets = attributeOffsets(descriptor);
+        std::vector<size_t> const outOffsets = attributeOffsets(outDescriptor);
+
+        std::unique_ptr<uint8_t[], FreeDeleter> out(static_cast<uint8_t*>(std::calloc(vertexBufferSize(outDescriptor), 1)));
+        for (size_t k = 0; k < descriptor.attributes.size(); k++)
+        {
+            size_t const size = elementSize(descriptor.attributes[k]);
+            for (size_t v = 0; v < descriptor.vertexCount; v++)
+            {
+                if (remap[v] != kInvalidIndex)
+                {
+                    std::memcpy(out.get() + outOffsets[k] + remap[v] * size, vertexData + offsets[k] + v * size, size);
+                }
+            }
+        }
+        return out;
+    }
+
+    // returns the remap table that merges vertices with identical attributes, sets the unique vertex count
+    [[nodiscard]] static std::vector<uint32_t> deduplicateVertices(MeshDescriptor const& descriptor,
+                                                                   uint8_t const* vertexData, size_t& outVertexCount)
+    {
+        std::vector<size_t> const offsets = attributeOffsets(descriptor);
+
+        std::vector<uint64_t> hashes(descriptor.vertexCount);
+        for (size_t v = 0; v < descriptor.vertexCount; v++)
+        {
+            common::Hasher hasher;
+            for (size_t k = 0; k < descriptor.attributes.size(); k++)
+            {
+                size_t const size = elementSize(descriptor.attributes[k]);
+                hasher.update(vertexData + offsets[k] + v * size, size);
+            }
+            hashes[v] = hasher.digest();
+        }
+
+        auto hash = [&](uint32_t v) { return static_cast<size_t>(hashes[v]); };
+        auto equal = [&](uint32_t lhs, uint32_t rhs) {
+            for (size_t k = 0; k < descriptor.attributes.size(); k++)
+            {
+                size_t const size = elementSize(descriptor.attributes[k]);
+                uint8_t const* attribute = vertexData + offsets[k];
+                if (std::memcmp(attribute + lhs * size, attribute + rhs * size, size) != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+        std::unordered_map<uint32_t, uint32_t, decltype(hash), decltype(equal)> unique(descriptor.vertexCount, hash, equal);
+
+        std::vector<uint32_t> remap(descriptor.vertexCount);
+        outVertexCount = 0;
+        for (uint32_t v = 0; v < descriptor.vertexCount; v++)
+        {
+            auto [it, inserted] = unique.emplace(v, static_cast<uint32_t>(outVertexCount));
+            remap[v] = it->second;
+            if (inserted)
+            {
+                outVertexCount++;
+            }
+        }
+        return remap;
+    }
+
+    // returns the remap table that orders the vertices by their first use in the indices
+    [[nodiscard]] static std::vector<uint32_t> vertexFetchRemap(std::span<uint32_t const> indices, size_t vertexCount,
+                                                                size_t& outVertexCount)
+    {
+        std::vector<uint32_t> remap(vertexCount, kInvalidIndex);
+        outVertexCount = 0;
+        for (uint32_t index: indices)
+        {
+            if (remap[index] == kInvalidIndex)
+            {
+                remap[index] = static_cast<uint32_t>(outVertexCount++);
+            }
+        }
+        return remap;
+    }
+
+    MeshData optimize(MeshData data, OptimizationParameters const& parameters)
+    {
+        MeshDescriptor descriptor = data.descriptor;
+        if (descriptor.primitiveType != graphics::PrimitiveType::Triangle || descriptor.vertexCount == 0)
+        {
+            return data;
+        }
+
+        // indices outside the vertices can't be optimized (callers should validate these, e.g. when importing)
+        std::vector<uint32_t> indices = readIndices(data);
+        if (indices.empty() || indices.size() % 3 != 0 ||
+            std::any_of(indices.begin(), indices.end(), [&](uint32_t index) { return index >= descriptor.vertexCount; }))
+        {
+            return data;
+        }
+
+        auto vertexData = std::move(data.vertexData);
+        auto applyRemap = [&](std::vector<uint32_t> const& remap, size_t outVertexCount) {
+            vertexData = remapVertices(descriptor, vertexData.get(), remap, outVertexCount);
+            descriptor.vertexCount = outVertexCount;
+            for (uint32_t& index: indices)
+            {
+                index = remap[index];
+            }
+        };
+
+        if (parameters.deduplicateVertices)
+        {
+            size_t uniqueCount = 0;
+            std::vector<uint32_t> const remap = deduplicateVertices(descriptor, vertexData.get(), uniqueCount);
+            applyRemap(remap, uniqueCount);
+        }
+
+        if (parameters.optimizeVertexCache)
+        {
+            indices = optimizeVertexCache(indices, descriptor.vertexCount);
+        }
+
+        if (parameters.optimizeOverdraw)
+        {
+            std::vector<size_t> const offsets = attributeOffsets(descriptor);
+            for (size_t k = 0; k < descriptor.attributes.size(); k++)
+            {
+                VertexAttributeDescriptor const& attribute = descriptor.attributes[k];
+                if (attribute.type == VertexAttribute_Position && attribute.index == 0 &&
+                    attribute.elementType == ElementType::Vector3 && attribute.componentType == ComponentType::Float)
+                {
+                    auto const* positions = reinterpret_cast<float const*>(vertexData.get() + offsets[k]);
+                    indices = optimizeOverdraw(indices, positions, parameters.overdrawThreshold);
+                    break;
+                }
+            }
+        }
+
+        if (parameters.optimizeVertexFetch)
+        {
+            size_t usedCount = 0;
+            std::vector<uint32_t> const remap = vertexFetchRemap(indices, descriptor.vertexCount, usedCount);
+            applyRemap(remap, usedCount);
+        }
+
+        // the largest index stays below 0xFFFF, which is reserved as primitive restart value
+        bool const narrow = parameters.narrowIndices && descriptor.vertexCount <= std::numeric_limits<uint16_t>::max();
+        if (narrow)
+        {
+            descriptor.indexType = ComponentType::UnsignedShort;
+        }
+        else if (!descriptor.hasIndexBuffer)
+        {
+            descriptor.indexType = ComponentType::UnsignedInt;
+        }
+        descriptor.hasIndexBuffer = true;
+
+        MeshData out{.descriptor = std::move(descriptor), .vertexData = std::move(vertexData)};
+        writeIndices(out, indices);
+        return out;
+    }
+}
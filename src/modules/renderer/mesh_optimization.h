@@ -0,0 +1,43 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_MESH_OPTIMIZATION_H
+#define SHAPEREALITY_MESH_OPTIMIZATION_H
+
+#include <renderer/mesh.h>
+
+#include <vector>
+#include <span>
+
+namespace renderer
+{
+    // which optimizations should be applied, in the order they are applied
+    struct OptimizationParameters
+    {
+        bool deduplicateVertices = true; // merge vertices whose attributes are identical
+        bool optimizeVertexCache = true; // reorder triangles for the post-transform vertex cache (Forsyth)
+        bool optimizeOverdraw = true; // reorder clusters of triangles so that outward facing ones are drawn first
+        float overdrawThreshold = 1.05f; // allowed increase of the average cache miss ratio when splitting clusters
+        bool optimizeVertexFetch = true; // reorder vertices in the order they are first used by the indices
+        bool narrowIndices = true; // use 16-bit indices if the vertex count allows it
+    };
+
+    /**
+     * Optimizes a triangle mesh for rendering, without changing what gets rendered. Meshes without an index buffer
+     * get one. Overdraw optimization requires 32-bit float positions, so it should happen before quantize().
+     * Meshes with a primitive type other than triangles, or with indices outside of the vertices, are returned
+     * unchanged. Meshlets are discarded, as the triangles get reordered, so buildMeshlets() should happen after.
+     */
+    [[nodiscard]] MeshData optimize(MeshData data, OptimizationParameters const& parameters = {});
+
+    // average amount of vertex shader invocations per triangle for a FIFO post-transform vertex cache
+    // (0.5 is optimal for large regular grids, 3 is the worst)
+    [[nodiscard]] float averageCacheMissRatio(std::span<uint32_t const> indices, size_t cacheSize = 16);
+
+    // reorders the triangles to improve post-transform vertex cache hits,
+    // see Tom Forsyth, "Linear-Speed Vertex Cache Optimisation" (2006)
+    [[nodiscard]] std::vector<uint32_t> optimizeVertexCache(std::span<uint32_t const> indices, size_t vertexCount);
+}
+
+#endif //SHAPEREALITY_MESH_OPTIMIZATION_H
@@ -0,0 +1,246 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "mesh_quantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace renderer
+{
+    // how a vertex attribute gets quantized
+    enum class Quantization
+    {
+        None = 0,
+        Position,
+        Normal,
+        Tangent,
+        TextureCoordinate
+    };
+
+    [[nodiscard]] static float signNotZero(float value)
+    {
+        return value < 0.0f ? -1.0f : 1.0f;
+    }
+
+    [[nodiscard]] static int16_t toSnorm16(float value)
+    {
+        return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    [[nodiscard]] static uint16_t toUnorm16(float value)
+    {
+        return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    math::Vector2 encodeOctahedral(math::Vector3 direction)
+    {
+        float const sum = std::abs(direction.x()) + std::abs(direction.y()) + std::abs(direction.z());
+        if (sum == 0.0f)
+        {
+            return math::Vector2{0, 0};
+        }
+        float x = direction.x() / sum;
+        float y = direction.y() / sum;
+
+        // fold the lower hemisphere over the diagonals
+        if (direction.z() < 0.0f)
+        {
+            float const foldedX = (1.0f - std::abs(y)) * signNotZero(x);
+            float const foldedY = (1.0f - std::abs(x)) * signNotZero(y);
+            x = foldedX;
+            y = foldedY;
+        }
+        return math::Vector2{x, y};
+    }
+
+    math::Vector3 decodeOctahedral(math::Vector2 encoded)
+    {
+        float x = encoded.x();
+        float y = encoded.y();
+        float const z = 1.0f - std::abs(x) - std::abs(y);
+        if (z < 0.0f)
+        {
+            float const unfoldedX = (1.0f - std::abs(y)) * signNotZero(x);
+            float const unfoldedY = (1.0f - std::abs(x)) * signNotZero(y);
+            x = unfoldedX;
+            y = unfoldedY;
+        }
+        return math::Vector3{x, y, z}.normalized();
+    }
+
+    [[nodiscard]] static Quantization quantization(VertexAttributeDescriptor const& attribute, float const* values,
+                                                   size_t vertexCount, QuantizationParameters const& parameters)
+    {
+        if (attribute.componentType != ComponentType::Float || attribute.encoding != VertexAttributeEncoding::None)
+        {
+            return Quantization::None;
+        }
+
+        switch (attribute.type)
+        {
+            case VertexAttribute_Position:
+            {
+                // there is only one dequantization transform
+                bool const quantize = parameters.positions && attribute.index == 0 &&
+                                      attribute.elementType == ElementType::Vector3;
+                return quantize ? Quantization::Position : Quantization::None;
+            }
+            case VertexAttribute_Normal:
+            {
+                bool const quantize = parameters.normals && attribute.elementType == ElementType::Vector3;
+                return quantize ? Quantization::Normal : Quantization::None;
+            }
+            case VertexAttribute_Tangent:
+            {
+                bool const quantize = parameters.tangents && attribute.elementType == ElementType::Vector4;
+                return quantize ? Quantization::Tangent : Quantization::None;
+            }
+            case VertexAttribute_TextureCoordinate:
+            {
+                if (!parameters.textureCoordinates || attribute.elementType != ElementType::Vector2)
+                {
+                    return Quantization::None;
+                }
+                // repeating texture coordinates can't be stored as unorm16
+                bool const inside = std::all_of(values, values + vertexCount * 2, [](float value) {
+                    return value >= 0.0f && value <= 1.0f;
+                });
+                return inside ? Quantization::TextureCoordinate : Quantization::None;
+            }
+            default:
+            {
+                return Quantization::None;
+            }
+        }
+    }
+
+    MeshData quantize(MeshData data, QuantizationParameters const& parameters)
+    {
+        MeshDescriptor const& descriptor = data.descriptor;
+        size_t const vertexCount = descriptor.vertexCount;
+        std::vector<size_t> const offsets = attributeOffsets(descriptor);
+
+        MeshDescriptor outDescriptor = descriptor;
+        std::vector<Quantization> quantizations(descriptor.attributes.size());
+        for (size_t i = 0; i < descriptor.attributes.size(); i++)
+        {
+            auto const* values = reinterpret_cast<float const*>(data.vertexData.get() + offsets[i]);
+            quantizations[i] = quantization(descriptor.attributes[i], values, vertexCount, parameters);
+
+            VertexAttributeDescriptor& outAttribute = outDescriptor.attributes[i];
+            switch (quantizations[i])
+            {
+                case Quantization::None:
+                {
+                    continue;
+                }
+                case Quantization::Position:
+                case Quantization::TextureCoordinate:
+                {
+                    outAttribute.componentType = ComponentType::UnsignedShort;
+                    break;
+                }
+                case Quantization::Normal:
+                {
+                    outAttribute.componentType = ComponentType::SignedShort;
+                    outAttribute.elementType = ElementType::Vector2;
+                    outAttribute.encoding = VertexAttributeEncoding::Octahedral;
+                    break;
+                }
+                case Quantization::Tangent:
+                {
+                    outAttribute.componentType = ComponentType::SignedShort;
+                    outAttribute.elementType = ElementType::Vector3;
+                    outAttribute.encoding = VertexAttributeEncoding::Octahedral;
+                    break;
+                }
+            }
+            outAttribute.normalized = true;
+        }
+
+        MeshData out{.descriptor = std::move(outDescriptor)};
+        out.vertexData.reset(static_cast<uint8_t*>(std::calloc(vertexBufferSize(out.descriptor), 1)));
+        out.indexData = std::move(data.indexData);
+        out.meshlets = std::move(data.meshlets); // vertices and triangles keep their order
+        std::vector<size_t> const outOffsets = attributeOffsets(out.descriptor);
+
+        for (size_t i = 0; i < descriptor.attributes.size(); i++)
+        {
+            uint8_t const* source = data.vertexData.get() + offsets[i];
+            uint8_t* destination = out.vertexData.get() + outOffsets[i];
+            auto const* values = reinterpret_cast<float const*>(source);
+            auto* unorm = reinterpret_cast<uint16_t*>(destination);
+            auto* snorm = reinterpret_cast<int16_t*>(destination);
+
+            switch (quantizations[i])
+            {
+                case Quantization::None:
+                {
+                    std::memcpy(destination, source, elementSize(descriptor.attributes[i]) * vertexCount);
+                    break;
+                }
+                case Quantization::Position:
+                {
+                    float const infinity = std::numeric_limits<float>::infinity();
+                    math::Vector3 min{math::Vector3{infinity, infinity, infinity}};
+                    math::Vector3 max = -min;
+                    for (size_t j = 0; j < vertexCount; j++)
+                    {
+                        math::Vector3 const position{values[j * 3], values[j * 3 + 1], values[j * 3 + 2]};
+                        min = math::Vector3::min(min, position);
+                        max = math::Vector3::max(max, position);
+                    }
+                    math::Vector3 const extent = max - min;
+
+                    // the existing transform still applies on top of the quantized positions
+                    for (int k = 0; k < 3; k++)
+                    {
+                        out.descriptor.positionOffset[k] = descriptor.positionOffset[k] + descriptor.positionScale[k] * min[k];
+                        out.descriptor.positionScale[k] = descriptor.positionScale[k] * extent[k];
+                    }
+                    for (size_t j = 0; j < vertexCount * 3; j++)
+                    {
+                        size_t const k = j % 3;
+                        unorm[j] = extent[k] > 0.0f ? toUnorm16((values[j] - min[k]) / extent[k]) : 0;
+                    }
+                    break;
+                }
+                case Quantization::Normal:
+                {
+                    for (size_t j = 0; j < vertexCount; j++)
+                    {
+                        math::Vector2 const encoded = encodeOctahedral(math::Vector3{values[j * 3], values[j * 3 + 1], values[j * 3 + 2]});
+                        snorm[j * 2] = toSnorm16(encoded.x());
+                        snorm[j * 2 + 1] = toSnorm16(encoded.y());
+                    }
+                    break;
+                }
+                case Quantization::Tangent:
+                {
+                    for (size_t j = 0; j < vertexCount; j++)
+                    {
+                        math::Vector2 const encoded = encodeOctahedral(math::Vector3{values[j * 4], values[j * 4 + 1], values[j * 4 + 2]});
+                        snorm[j * 3] = toSnorm16(encoded.x());
+                        snorm[j * 3 + 1] = toSnorm16(encoded.y());
+                        snorm[j * 3 + 2] = toSnorm16(signNotZero(values[j * 4 + 3]));
+                    }
+                    break;
+                }
+                case Quantization::TextureCoordinate:
+                {
+                    for (size_t j = 0; j < vertexCount * 2; j++)
+                    {
+                        unorm[j] = toUnorm16(values[j]);
+                    }
+                    break;
+                }
+            }
+        }
+        return out;
+    }
+}
@@ -0,0 +1,38 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_MESH_QUANTIZATION_H
+#define SHAPEREALITY_MESH_QUANTIZATION_H
+
+#include <renderer/mesh.h>
+
+#include <math/vector.h>
+
+namespace renderer
+{
+    // which vertex attributes should be quantized
+    struct QuantizationParameters
+    {
+        bool positions = true; // unorm16, relative to the bounds of the mesh
+        bool normals = true; // octahedral snorm16
+        bool tangents = true; // octahedral snorm16, with the sign of the bitangent as third component
+        bool textureCoordinates = true; // unorm16, only if all texture coordinates are inside [0, 1]
+    };
+
+    /**
+     * Quantizes the 32-bit float vertex attributes of the mesh, which reduces the size of the vertex buffer by about
+     * 2 to 3 times. Sets MeshDescriptor::positionOffset and positionScale to dequantize the positions.
+     * Attributes that are not float, or that are not enabled in the parameters, are kept as they are.
+     * The index data and meshlets are moved to the returned mesh data.
+     */
+    [[nodiscard]] MeshData quantize(MeshData data, QuantizationParameters const& parameters = {});
+
+    // maps a unit vector onto the octahedron and unfolds it onto [-1, 1]^2
+    [[nodiscard]] math::Vector2 encodeOctahedral(math::Vector3 direction);
+
+    // inverse of encodeOctahedral(), returns a unit vector
+    [[nodiscard]] math::Vector3 decodeOctahedral(math::Vector2 encoded);
+}
+
+#endif //SHAPEREALITY_MESH_QUANTIZATION_H
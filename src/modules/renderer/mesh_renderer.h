@@ -5,6 +5,10 @@
 #ifndef SHAPEREALITY_MESH_RENDERER_H
 #define SHAPEREALITY_MESH_RENDERER_H
 
+#include <asset/asset_id.h>
+
+#include <array>
+
 namespace renderer
 {
     class Mesh;
@@ -16,6 +20,23 @@ namespace renderer
         Mesh* mesh; // unowned pointer
         Material* material; // unowned pointer
     };
+
+    // links an entity to a mesh asset (e.g. in a scene imported from a gltf file), the mesh is retrieved from the
+    // asset database using the key, so that the component stays trivially copyable and can be saved with the scene
+    struct MeshAssetComponent final
+    {
+        asset::AssetKey mesh;
+    };
+
+    // maximum amount of levels of detail besides the full detail mesh that a MeshLodAssetComponent refers to
+    constexpr size_t kMaxMeshLods = 4;
+
+    // the levels of detail of the mesh of the MeshAssetComponent on the same entity (see generateLods()),
+    // ordered by level, with empty keys for the unused entries. only added when the mesh has levels of detail
+    struct MeshLodAssetComponent final
+    {
+        std::array<asset::AssetKey, kMaxMeshLods> lods;
+    };
 }
 
 #endif //SHAPEREALITY_MESH_RENDERER_H
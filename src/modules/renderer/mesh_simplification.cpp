@@ -0,0 +1,475 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "mesh_simplification.h"
+#include "mesh_optimization.h"
+
+#include <common/thread_pool.h>
+
+#include "math/matrix.inl"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace renderer
+{
+    // sum of squared distances to a set of planes, stored as the unique coefficients of a symmetric 4x4 matrix
+    struct Quadric
+    {
+        double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+        double b0 = 0, b1 = 0, b2 = 0;
+        double c = 0;
+
+        // quadric of the plane n * p + d = 0, with n a unit normal
+        [[nodiscard]] static Quadric fromPlane(double const n[3], double d)
+        {
+            return Quadric{
+                .a00 = n[0] * n[0], .a01 = n[0] * n[1], .a02 = n[0] * n[2],
+                .a11 = n[1] * n[1], .a12 = n[1] * n[2], .a22 = n[2] * n[2],
+                .b0 = d * n[0], .b1 = d * n[1], .b2 = d * n[2],
+                .c = d * d
+            };
+        }
+
+        void operator+=(Quadric const& other)
+        {
+            a00 += other.a00;
+            a01 += other.a01;
+            a02 += other.a02;
+            a11 += other.a11;
+            a12 += other.a12;
+            a22 += other.a22;
+            b0 += other.b0;
+            b1 += other.b1;
+            b2 += other.b2;
+            c += other.c;
+        }
+
+        [[nodiscard]] double evaluate(double const p[3]) const
+        {
+            double const x = p[0], y = p[1], z = p[2];
+            double const error = a00 * x * x + a11 * y * y + a22 * z * z +
+                                 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                                 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return std::max(error, 0.0); // can be slightly negative due to rounding
+        }
+    };
+
+    struct Collapse
+    {
+        uint32_t from;
+        uint32_t to;
+        double cost;
+    };
+
+    // returns a pointer to the 32-bit float attribute, or nullptr if the mesh doesn't have it
+    [[nodiscard]] static float const* findFloatAttribute(MeshData const& data, VertexAttribute_ type, ElementType elementType)
+    {
+        MeshDescriptor const& descriptor = data.descriptor;
+        std::vector<size_t> const offsets = attributeOffsets(descriptor);
+        for (size_t k = 0; k < descriptor.attributes.size(); k++)
+        {
+            VertexAttributeDescriptor const& attribute = descriptor.attributes[k];
+            if (attribute.type == type && attribute.index == 0 && attribute.elementType == elementType &&
+                attribute.componentType == ComponentType::Float)
+            {
+                return reinterpret_cast<float const*>(data.vertexData.get() + offsets[k]);
+            }
+        }
+        return nullptr;
+    }
+
+    static void cross(double const a[3], double const b[3], double out[3])
+    {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    // non-normalized normal of the triangle
+    static void triangleNormal(double const* p0, double const* p1, double const* p2, double out[3])
+    {
+        double const e0[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+        double const e1[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+        cross(e0, e1, out);
+    }
+
+    std::vector<uint32_t> simplify(MeshData const& data, std::span<uint32_t const> indices, size_t targetIndexCount,
+                                   float maxError, SimplificationParameters const& parameters, float* outError)
+    {
+        MeshDescriptor const& descriptor = data.descriptor;
+        size_t const vertexCount = descriptor.vertexCount;
+        std::vector<uint32_t> result(indices.begin(), indices.end());
+        if (outError)
+        {
+            *outError = 0.0f;
+        }
+
+        float const* positions = findFloatAttribute(data, VertexAttribute_Position, ElementType::Vector3);
+        float const* normals = findFloatAttribute(data, VertexAttribute_Normal, ElementType::Vector3);
+        float const* textureCoordinates = findFloatAttribute(data, VertexAttribute_TextureCoordinate, ElementType::Vector2);
+        if (!positions || result.size() <= targetIndexCount)
+        {
+            return result;
+        }
+
+        // positions scaled to the unit cube, so that the errors are relative to the size of the mesh
+        double min[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+        double max[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            for (size_t k = 0; k < 3; k++)
+            {
+                min[k] = std::min(min[k], static_cast<double>(positions[v * 3 + k]));
+                max[k] = std::max(max[k], static_cast<double>(positions[v * 3 + k]));
+            }
+        }
+        double const extent = std::max({max[0] - min[0], max[1] - min[1], max[2] - min[2]});
+        double const scale = extent > 0.0 ? 1.0 / extent : 1.0;
+        std::vector<double> p(vertexCount * 3);
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            for (size_t k = 0; k < 3; k++)
+            {
+                p[v * 3 + k] = (positions[v * 3 + k] - min[k]) * scale;
+            }
+        }
+
+        // quadric of each vertex, from the planes of its triangles. these are not weighted by area, so that the cost of
+        // a collapse is a sum of squared distances, which is at least the squared distance to each of the planes
+        std::vector<Quadric> quadrics(vertexCount);
+        for (size_t t = 0; t < result.size() / 3; t++)
+        {
+            uint32_t const* triangle = &result[t * 3];
+            double n[3];
+            triangleNormal(&p[triangle[0] * 3], &p[triangle[1] * 3], &p[triangle[2] * 3], n);
+            double const length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length == 0.0)
+            {
+                continue;
+            }
+            for (double& component: n)
+            {
+                component /= length;
+            }
+            double const* p0 = &p[triangle[0] * 3];
+            double const d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+            Quadric const quadric = Quadric::fromPlane(n, d);
+            for (size_t k = 0; k < 3; k++)
+            {
+                quadrics[triangle[k]] += quadric;
+            }
+        }
+
+        // vertices on edges that are not shared by exactly two triangles (open borders and non-manifold edges)
+        std::vector<bool> locked(vertexCount, false);
+        if (parameters.lockBorder)
+        {
+            std::vector<uint64_t> edges;
+            edges.reserve(result.size());
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                uint32_t const a = result[i];
+                uint32_t const b = result[i - i % 3 + (i + 1) % 3];
+                edges.emplace_back(static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b));
+            }
+            std::sort(edges.begin(), edges.end());
+            for (size_t i = 0; i < edges.size();)
+            {
+                size_t j = i;
+                while (j < edges.size() && edges[j] == edges[i])
+                {
+                    j++;
+                }
+                if (j - i != 2)
+                {
+                    locked[edges[i] >> 32] = true;
+                    locked[edges[i] & 0xFFFFFFFF] = true;
+                }
+                i = j;
+            }
+        }
+
+        auto attributeDistance = [&](uint32_t a, uint32_t b) {
+            double distance = 0.0;
+            if (normals)
+            {
+                for (size_t k = 0; k < 3; k++)
+                {
+                    double const difference = normals[a * 3 + k] - normals[b * 3 + k];
+                    distance += difference * difference;
+                }
+            }
+            if (textureCoordinates)
+            {
+                for (size_t k = 0; k < 2; k++)
+                {
+                    double const difference = textureCoordinates[a * 2 + k] - textureCoordinates[b * 2 + k];
+                    distance += difference * difference;
+                }
+            }
+            return distance;
+        };
+
+        // moving `from` onto `to` should not flip any of the remaining triangles of `from`
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+        std::vector<uint32_t> adjacency;
+        auto flips = [&](uint32_t from, uint32_t to) {
+            for (uint32_t i = adjacencyOffsets[from]; i < adjacencyOffsets[from + 1]; i++)
+            {
+                uint32_t const* triangle = &result[adjacency[i] * 3];
+                if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+                {
+                    continue; // becomes degenerate and gets removed
+                }
+                double const* before[3];
+                double const* after[3];
+                for (size_t k = 0; k < 3; k++)
+                {
+                    before[k] = &p[triangle[k] * 3];
+                    after[k] = triangle[k] == from ? &p[to * 3] : before[k];
+                }
+                double nBefore[3];
+                double nAfter[3];
+                triangleNormal(before[0], before[1], before[2], nBefore);
+                triangleNormal(after[0], after[1], after[2], nAfter);
+                if (nBefore[0] * nAfter[0] + nBefore[1] * nAfter[1] + nBefore[2] * nAfter[2] <= 0.0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        double const maxCost = static_cast<double>(maxError) * static_cast<double>(maxError);
+        double appliedCost = 0.0;
+        std::vector<uint32_t> remap(vertexCount);
+        std::vector<bool> touched(vertexCount);
+        std::vector<uint64_t> edges;
+        std::vector<Collapse> collapses;
+
+        // each pass collapses the cheapest edges that don't share a triangle with another collapse of the same pass
+        while (result.size() > targetIndexCount)
+        {
+            // triangles of each vertex
+            std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+            for (uint32_t index: result)
+            {
+                adjacencyOffsets[index + 1]++;
+            }
+            std::partial_sum(adjacencyOffsets.begin(), adjacencyOffsets.end(), adjacencyOffsets.begin());
+            adjacency.resize(result.size());
+            {
+                std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+                for (size_t i = 0; i < result.size(); i++)
+                {
+                    adjacency[fill[result[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+            }
+
+            // cheapest direction of each edge
+            edges.clear();
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                uint32_t const a = result[i];
+                uint32_t const b = result[i - i % 3 + (i + 1) % 3];
+                edges.emplace_back(static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b));
+            }
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            collapses.clear();
+            for (uint64_t edge: edges)
+            {
+                auto const a = static_cast<uint32_t>(edge >> 32);
+                auto const b = static_cast<uint32_t>(edge & 0xFFFFFFFF);
+                Quadric quadric = quadrics[a];
+                quadric += quadrics[b];
+                double const attributeCost = parameters.attributeWeight * attributeDistance(a, b);
+
+                Collapse collapse{.from = a, .to = b, .cost = std::numeric_limits<double>::infinity()};
+                if (!locked[a])
+                {
+                    collapse.cost = quadric.evaluate(&p[b * 3]) + attributeCost;
+                }
+                if (!locked[b])
+                {
+                    double const cost = quadric.evaluate(&p[a * 3]) + attributeCost;
+                    if (cost < collapse.cost)
+                    {
+                        collapse = Collapse{.from = b, .to = a, .cost = cost};
+                    }
+                }
+                if (collapse.cost <= maxCost)
+                {
+                    collapses.emplace_back(collapse);
+                }
+            }
+            std::sort(collapses.begin(), collapses.end(), [](Collapse const& lhs, Collapse const& rhs) {
+                return lhs.cost < rhs.cost;
+            });
+
+            std::iota(remap.begin(), remap.end(), 0);
+            std::fill(touched.begin(), touched.end(), false);
+            size_t indexCount = result.size();
+            size_t collapsed = 0;
+            for (Collapse const& collapse: collapses)
+            {
+                if (indexCount <= targetIndexCount)
+                {
+                    break;
+                }
+                if (touched[collapse.from] || touched[collapse.to] || flips(collapse.from, collapse.to))
+                {
+                    continue;
+                }
+
+                remap[collapse.from] = collapse.to;
+                quadrics[collapse.to] += quadrics[collapse.from];
+                appliedCost = std::max(appliedCost, collapse.cost);
+                collapsed++;
+
+                // the triangles around `from` change, so their vertices can't be collapsed again in this pass
+                for (uint32_t i = adjacencyOffsets[collapse.from]; i < adjacencyOffsets[collapse.from + 1]; i++)
+                {
+                    uint32_t const* triangle = &result[adjacency[i] * 3];
+                    bool degenerate = false;
+                    for (size_t k = 0; k < 3; k++)
+                    {
+                        touched[triangle[k]] = true;
+                        degenerate = degenerate || triangle[k] == collapse.to;
+                    }
+                    indexCount -= degenerate ? 3 : 0;
+                }
+            }
+            if (collapsed == 0)
+            {
+                break;
+            }
+
+            // apply the collapses and remove the degenerate triangles
+            size_t write = 0;
+            for (size_t t = 0; t < result.size() / 3; t++)
+            {
+                uint32_t const a = remap[result[t * 3]];
+                uint32_t const b = remap[result[t * 3 + 1]];
+                uint32_t const c = remap[result[t * 3 + 2]];
+                if (a != b && b != c && a != c)
+                {
+                    result[write++] = a;
+                    result[write++] = b;
+                    result[write++] = c;
+                }
+            }
+            result.resize(write);
+        }
+
+        if (outError)
+        {
+            *outError = static_cast<float>(std::sqrt(appliedCost));
+        }
+        return result;
+    }
+
+    std::vector<MeshData> generateLods(MeshData const& data, BS::thread_pool& threadPool, LodParameters const& parameters)
+    {
+        MeshDescriptor const& descriptor = data.descriptor;
+        if (descriptor.primitiveType != graphics::PrimitiveType::Triangle || parameters.levelCount == 0)
+        {
+            return {};
+        }
+        std::vector<uint32_t> const indices = readIndices(data);
+
+        // each level is simplified from the full detail mesh, so that the levels can be generated in parallel
+        std::vector<std::vector<uint32_t>> levels(parameters.levelCount);
+        std::vector<float> errors(parameters.levelCount, 0.0f);
+        common::parallelFor(threadPool, parameters.levelCount, [&](size_t i) {
+            double const ratio = std::pow(static_cast<double>(parameters.triangleRatio), static_cast<double>(i + 1));
+            size_t const targetIndexCount = static_cast<size_t>(static_cast<double>(indices.size() / 3) * ratio) * 3;
+            levels[i] = simplify(data, indices, targetIndexCount, parameters.maxError, parameters.simplification, &errors[i]);
+        });
+
+        std::vector<MeshData> out;
+        size_t previousIndexCount = indices.size();
+        float previousError = 0.0f;
+        float previousScreenSize = descriptor.lodScreenSize;
+        for (size_t i = 0; i < levels.size(); i++)
+        {
+            std::vector<uint32_t> const& level = levels[i];
+
+            // stop when the mesh can't be simplified much further within the maximum error
+            if (level.empty() || static_cast<float>(level.size()) > static_cast<float>(previousIndexCount) * (1.0f + parameters.triangleRatio) * 0.5f)
+            {
+                break;
+            }
+
+            MeshDescriptor levelDescriptor = descriptor;
+            levelDescriptor.hasIndexBuffer = true;
+            levelDescriptor.indexCount = level.size();
+            levelDescriptor.indexType = ComponentType::UnsignedInt;
+            levelDescriptor.lodLevel = i + 1;
+
+            // the error is relative to the largest extent, which is at most the diameter of the bounding sphere.
+            // the error projected on the screen is error * screenSize, so the level can be used while
+            // screenSize <= maxScreenError / error
+            float const error = std::max(errors[i], previousError);
+            float const screenSize = error > 0.0f ? parameters.maxScreenError / error : std::numeric_limits<float>::infinity();
+            levelDescriptor.lodScreenSize = std::min(screenSize, previousScreenSize);
+
+            MeshData levelData = MeshData::allocate(std::move(levelDescriptor));
+            std::memcpy(levelData.vertexData.get(), data.vertexData.get(), vertexBufferSize(descriptor));
+            std::memcpy(levelData.indexData.get(), level.data(), level.size() * sizeof(uint32_t));
+
+            // removes the vertices that are not used anymore
+            out.emplace_back(optimize(std::move(levelData), OptimizationParameters{.deduplicateVertices = false}));
+
+            previousIndexCount = level.size();
+            previousError = error;
+            previousScreenSize = out.back().descriptor.lodScreenSize;
+        }
+        return out;
+    }
+
+    float projectedScreenSize(float radius, float distance, float verticalFieldOfView)
+    {
+        if (distance <= radius)
+        {
+            return std::numeric_limits<float>::infinity(); // inside the bounding sphere
+        }
+        return radius / (distance * std::tan(verticalFieldOfView * 0.5f));
+    }
+
+    float projectedScreenSize(MeshDescriptor const& descriptor, math::Matrix4 const& localToWorld,
+                              math::Vector3 const& cameraPosition, float verticalFieldOfView)
+    {
+        float distanceSquared = 0.0f;
+        float scaleSquared = 0.0f;
+        for (size_t r = 0; r < 3; r++)
+        {
+            float const center = localToWorld(r, 0) * descriptor.boundsCenter[0] +
+                                 localToWorld(r, 1) * descriptor.boundsCenter[1] +
+                                 localToWorld(r, 2) * descriptor.boundsCenter[2] + localToWorld(r, 3);
+            distanceSquared += (center - cameraPosition[r]) * (center - cameraPosition[r]);
+
+            float const column = localToWorld(0, r) * localToWorld(0, r) + localToWorld(1, r) * localToWorld(1, r) +
+                                 localToWorld(2, r) * localToWorld(2, r);
+            scaleSquared = std::max(scaleSquared, column);
+        }
+        return projectedScreenSize(descriptor.boundsRadius * std::sqrt(scaleSquared), std::sqrt(distanceSquared),
+                                   verticalFieldOfView);
+    }
+
+    size_t selectLod(std::span<float const> lodScreenSizes, float screenSize)
+    {
+        size_t level = 0;
+        for (size_t i = 1; i < lodScreenSizes.size() && screenSize <= lodScreenSizes[i]; i++)
+        {
+            level = i;
+        }
+        return level;
+    }
+}
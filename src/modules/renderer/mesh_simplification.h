@@ -0,0 +1,80 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_MESH_SIMPLIFICATION_H
+#define SHAPEREALITY_MESH_SIMPLIFICATION_H
+
+#include <renderer/mesh.h>
+
+#include "math/matrix.h"
+
+#include <vector>
+#include <span>
+
+namespace BS
+{
+    class thread_pool;
+}
+
+namespace renderer
+{
+    struct SimplificationParameters
+    {
+        // weight of the squared difference in normals and texture coordinates between the two vertices of a collapsed
+        // edge, which gets added to the squared geometric error. prevents collapses that would visibly change the shading
+        float attributeWeight = 0.01f;
+
+        // don't move vertices on open borders, which includes seams where vertices were split because of
+        // different normals or texture coordinates, so that no holes appear between the parts of a mesh
+        bool lockBorder = true;
+    };
+
+    /**
+     * Simplifies a triangle mesh using quadric error metrics, by collapsing edges into one of their two vertices,
+     * cheapest first, until the index count is at most targetIndexCount or the error of the next collapse exceeds
+     * maxError, see Garland and Heckbert, "Surface Simplification Using Quadric Error Metrics" (1997).
+     *
+     * Returns the indices of the simplified mesh into the vertices of the provided mesh data. maxError and outError
+     * are relative to the largest extent of the mesh. Requires 32-bit float positions.
+     */
+    [[nodiscard]] std::vector<uint32_t> simplify(MeshData const& data, std::span<uint32_t const> indices,
+                                                 size_t targetIndexCount, float maxError,
+                                                 SimplificationParameters const& parameters = {},
+                                                 float* outError = nullptr);
+
+    struct LodParameters
+    {
+        size_t levelCount = 3; // maximum amount of levels of detail besides the full detail mesh
+        float triangleRatio = 0.5f; // each level has at most this fraction of the triangles of the previous level
+        float maxError = 0.05f; // maximum simplification error, relative to the largest extent of the mesh
+        float maxScreenError = 1.0f / 1080.0f; // error allowed on screen, as fraction of the screen height
+        SimplificationParameters simplification;
+    };
+
+    /**
+     * Generates levels of detail for a triangle mesh, in parallel on the thread pool. Each level is simplified from
+     * the full detail mesh and gets optimized (see optimize()). Stops early when a level can't be simplified further
+     * within maxError.
+     *
+     * Sets lodLevel and lodScreenSize of the returned levels, so that a level gets used while its error projects
+     * to at most maxScreenError. The levels keep the bounding sphere of the full detail mesh, which should therefore
+     * be computed before (see computeBoundingSphere()). Requires 32-bit float positions.
+     */
+    [[nodiscard]] std::vector<MeshData> generateLods(MeshData const& data, BS::thread_pool& threadPool,
+                                                     LodParameters const& parameters = {});
+
+    // get the projected size of a bounding sphere on the screen, as fraction of the screen height
+    [[nodiscard]] float projectedScreenSize(float radius, float distance, float verticalFieldOfView);
+
+    // get the projected size of the bounding sphere of the mesh on the screen, as fraction of the screen height,
+    // with the bounding sphere transformed to world space (scaled by the largest scale of the transform)
+    [[nodiscard]] float projectedScreenSize(MeshDescriptor const& descriptor, math::Matrix4 const& localToWorld,
+                                            math::Vector3 const& cameraPosition, float verticalFieldOfView);
+
+    // get the level of detail to use for the projected screen size, lodScreenSizes should be ordered by level
+    // (i.e. the lodScreenSize of each level)
+    [[nodiscard]] size_t selectLod(std::span<float const> lodScreenSizes, float screenSize);
+}
+
+#endif //SHAPEREALITY_MESH_SIMPLIFICATION_H
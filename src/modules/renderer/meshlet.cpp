@@ -0,0 +1,389 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include "meshlet.h"
+
+#include "mesh.h"
+
+#include "math/vector.inl"
+#include "math/matrix.inl"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+using namespace math;
+
+namespace renderer
+{
+    constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    // amount of unused triangles after the first unused triangle that are considered when a meshlet can't be
+    // grown with an adjacent triangle (e.g. for meshes that consist of many disconnected parts)
+    constexpr size_t kSearchWindow = 64;
+
+    // reads the positions in the (dequantized) space of the mesh
+    [[nodiscard]] static bool readPositions(MeshDescriptor const& descriptor, uint8_t const* vertexData,
+                                            std::vector<Vector3>& out)
+    {
+        std::vector<size_t> const offsets = attributeOffsets(descriptor);
+        for (size_t k = 0; k < descriptor.attributes.size(); k++)
+        {
+            VertexAttributeDescriptor const& attribute = descriptor.attributes[k];
+            if (attribute.type != VertexAttribute_Position || attribute.index != 0 ||
+                attribute.elementType != ElementType::Vector3)
+            {
+                continue;
+            }
+
+            bool const isFloat = attribute.componentType == ComponentType::Float;
+            bool const isUnorm16 = attribute.componentType == ComponentType::UnsignedShort && attribute.normalized;
+            if (!isFloat && !isUnorm16)
+            {
+                continue;
+            }
+
+            out.resize(descriptor.vertexCount);
+            auto const* floats = reinterpret_cast<float const*>(vertexData + offsets[k]);
+            auto const* unorms = reinterpret_cast<uint16_t const*>(vertexData + offsets[k]);
+            for (size_t v = 0; v < descriptor.vertexCount; v++)
+            {
+                for (int i = 0; i < 3; i++)
+                {
+                    float const stored = isFloat ? floats[v * 3 + i] : static_cast<float>(unorms[v * 3 + i]) / 65535.0f;
+                    out[v][i] = descriptor.positionOffset[i] + descriptor.positionScale[i] * stored;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // sets the bounding sphere and normal cone of the meshlet from its triangles
+    static void computeBounds(Meshlet& meshlet, std::span<uint32_t const> triangles, std::span<uint32_t const> vertices,
+                              std::span<uint32_t const> indices, std::vector<Vector3> const& positions)
+    {
+        float const infinity = std::numeric_limits<float>::infinity();
+        Vector3 min{Vector3{infinity, infinity, infinity}};
+        Vector3 max = -min;
+        for (uint32_t v: vertices)
+        {
+            min = Vector3::min(min, positions[v]);
+            max = Vector3::max(max, positions[v]);
+        }
+        Vector3 const center = (min + max) * 0.5f;
+        float radiusSquared = 0.0f;
+        for (uint32_t v: vertices)
+        {
+            radiusSquared = std::max(radiusSquared, (positions[v] - center).magnitudeSquared());
+        }
+        meshlet.boundsCenter = center;
+        meshlet.boundsRadius = std::sqrt(radiusSquared);
+
+        // counter-clockwise front faces (as in glTF)
+        std::vector<Vector3> normals;
+        normals.reserve(triangles.size());
+        Vector3 sum{Vector3{0, 0, 0}};
+        for (uint32_t t: triangles)
+        {
+            Vector3 const& a = positions[indices[t * 3]];
+            Vector3 const normal = Vector3::cross(positions[indices[t * 3 + 1]] - a, positions[indices[t * 3 + 2]] - a);
+            float const length = normal.magnitude();
+            if (length > 0.0f)
+            {
+                normals.emplace_back(normal / length);
+                sum += normals.back();
+            }
+        }
+
+        meshlet.coneAxis = Vector3{0, 0, 1};
+        meshlet.coneCutoff = 1.0f;
+        float const sumLength = sum.magnitude();
+        if (normals.empty() || sumLength <= 0.0f)
+        {
+            return;
+        }
+        Vector3 const axis = sum / sumLength;
+        float minimumDot = 1.0f;
+        for (Vector3 const& normal: normals)
+        {
+            minimumDot = std::min(minimumDot, Vector3::dot(axis, normal));
+        }
+        meshlet.coneAxis = axis;
+
+        // the cone is too wide to ever be backfacing, or close to it so that culling rarely succeeds
+        if (minimumDot > 0.1f)
+        {
+            meshlet.coneCutoff = std::sqrt(1.0f - minimumDot * minimumDot);
+        }
+    }
+
+    std::vector<Meshlet> buildMeshlets(MeshDescriptor const& descriptor, uint8_t const* vertexData,
+                                       std::vector<uint32_t>& indices, MeshletParameters const& parameters)
+    {
+        assert(parameters.maxVertices >= 3 && parameters.maxTriangles >= 1 && "meshlet should fit at least one triangle");
+
+        std::vector<Vector3> positions;
+        if (descriptor.primitiveType != graphics::PrimitiveType::Triangle || indices.empty() || indices.size() % 3 != 0 ||
+            !readPositions(descriptor, vertexData, positions))
+        {
+            return {};
+        }
+        size_t const vertexCount = descriptor.vertexCount;
+        size_t const triangleCount = indices.size() / 3;
+
+        // triangles adjacent to each vertex
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (uint32_t index: indices)
+        {
+            adjacencyOffsets[index + 1]++;
+        }
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        }
+        std::vector<uint32_t> adjacency(indices.size());
+        {
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); i++)
+            {
+                adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        std::vector<Vector3> centroids(triangleCount);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            centroids[t] = (positions[indices[t * 3]] + positions[indices[t * 3 + 1]] + positions[indices[t * 3 + 2]]) / 3.0f;
+        }
+
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<uint32_t> localIndex(vertexCount, kInvalidIndex); // index of the vertex inside the current meshlet
+        std::vector<uint32_t> vertices; // vertices of the current meshlet
+        std::vector<uint32_t> triangles; // triangles of the current meshlet
+        Vector3 vertexSum{Vector3{0, 0, 0}};
+        std::vector<uint32_t> order; // triangles in the order of the meshlets
+        order.reserve(triangleCount);
+        std::vector<Meshlet> meshlets;
+
+        auto newVertexCount = [&](uint32_t t) {
+            uint32_t const a = indices[t * 3];
+            uint32_t const b = indices[t * 3 + 1];
+            uint32_t const c = indices[t * 3 + 2];
+            return static_cast<size_t>(localIndex[a] == kInvalidIndex) +
+                   static_cast<size_t>(localIndex[b] == kInvalidIndex && b != a) +
+                   static_cast<size_t>(localIndex[c] == kInvalidIndex && c != a && c != b);
+        };
+
+        auto add = [&](uint32_t t) {
+            emitted[t] = true;
+            triangles.emplace_back(t);
+            for (size_t k = 0; k < 3; k++)
+            {
+                uint32_t const v = indices[t * 3 + k];
+                if (localIndex[v] == kInvalidIndex)
+                {
+                    localIndex[v] = static_cast<uint32_t>(vertices.size());
+                    vertices.emplace_back(v);
+                    vertexSum += positions[v];
+                }
+            }
+        };
+
+        auto finish = [&]() {
+            // keep the relative order of the triangles, which is optimized for the vertex cache
+            std::sort(triangles.begin(), triangles.end());
+
+            Meshlet meshlet{
+                .indexOffset = static_cast<uint32_t>(order.size() * 3),
+                .triangleCount = static_cast<uint32_t>(triangles.size()),
+                .vertexCount = static_cast<uint32_t>(vertices.size())
+            };
+            computeBounds(meshlet, triangles, vertices, indices, positions);
+            meshlets.emplace_back(meshlet);
+            order.insert(order.end(), triangles.begin(), triangles.end());
+
+            for (uint32_t v: vertices)
+            {
+                localIndex[v] = kInvalidIndex;
+            }
+            vertices.clear();
+            triangles.clear();
+            vertexSum = Vector3{0, 0, 0};
+        };
+
+        size_t cursor = 0; // all triangles before the cursor have been emitted
+        for (size_t added = 0; added < triangleCount; added++)
+        {
+            uint32_t best = kInvalidIndex;
+            Vector3 const center = vertices.empty() ? Vector3{0, 0, 0} : vertexSum / static_cast<float>(vertices.size());
+
+            // adjacent triangle that adds the fewest vertices, closest to the center of the meshlet
+            size_t bestNewVertices = std::numeric_limits<size_t>::max();
+            float bestDistance = std::numeric_limits<float>::infinity();
+            for (uint32_t v: vertices)
+            {
+                for (uint32_t i = adjacencyOffsets[v]; i < adjacencyOffsets[v + 1]; i++)
+                {
+                    uint32_t const t = adjacency[i];
+                    if (emitted[t])
+                    {
+                        continue;
+                    }
+                    size_t const newVertices = newVertexCount(t);
+                    float const distance = (centroids[t] - center).magnitudeSquared();
+                    if (newVertices < bestNewVertices || (newVertices == bestNewVertices && distance < bestDistance))
+                    {
+                        best = t;
+                        bestNewVertices = newVertices;
+                        bestDistance = distance;
+                    }
+                }
+            }
+
+            // otherwise the closest of the next unused triangles
+            if (best == kInvalidIndex)
+            {
+                while (emitted[cursor])
+                {
+                    cursor++;
+                }
+                best = static_cast<uint32_t>(cursor);
+                if (!vertices.empty())
+                {
+                    size_t considered = 0;
+                    for (size_t t = cursor; t < triangleCount && considered < kSearchWindow; t++)
+                    {
+                        if (emitted[t])
+                        {
+                            continue;
+                        }
+                        considered++;
+                        float const distance = (centroids[t] - center).magnitudeSquared();
+                        if (distance < bestDistance)
+                        {
+                            best = static_cast<uint32_t>(t);
+                            bestDistance = distance;
+                        }
+                    }
+                }
+            }
+
+            if (vertices.size() + newVertexCount(best) > parameters.maxVertices ||
+                triangles.size() + 1 > parameters.maxTriangles)
+            {
+                finish();
+            }
+            add(best);
+        }
+        finish();
+
+        std::vector<uint32_t> reordered(indices.size());
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            std::copy_n(indices.begin() + static_cast<ptrdiff_t>(order[i] * 3), 3,
+                        reordered.begin() + static_cast<ptrdiff_t>(i * 3));
+        }
+        indices = std::move(reordered);
+        return meshlets;
+    }
+
+    bool buildMeshlets(MeshData& data, MeshletParameters const& parameters)
+    {
+        std::vector<uint32_t> indices = readIndices(data);
+        std::vector<Meshlet> meshlets = buildMeshlets(data.descriptor, data.vertexData.get(), indices, parameters);
+        if (meshlets.empty())
+        {
+            return false;
+        }
+        writeIndices(data, indices);
+        data.meshlets = std::move(meshlets);
+        return true;
+    }
+
+    MeshletCullingView createMeshletCullingView(Matrix4 const& viewProjection, Matrix4 const& localToWorld,
+                                                Vector3 const& cameraPosition)
+    {
+        // planes extracted from the rows of the local to clip space transform, see Gribb and Hartmann,
+        // "Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix" (2001)
+        Matrix4 const localToClip = viewProjection * localToWorld;
+        auto row = [&](size_t r) {
+            return Vector4{localToClip(r, 0), localToClip(r, 1), localToClip(r, 2), localToClip(r, 3)};
+        };
+        Vector4 const x = row(0);
+        Vector4 const y = row(1);
+        Vector4 const z = row(2);
+        Vector4 const w = row(3);
+
+        MeshletCullingView view;
+        view.planes = {w + x, w - x, w + y, w - y, z, w - z}; // left, right, bottom, top, near, far (depth from zero)
+        for (Vector4& plane: view.planes)
+        {
+            float const length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+            if (length > 0.0f)
+            {
+                plane /= length;
+            }
+        }
+
+        Matrix4 const worldToLocal = localToWorld.getInverse();
+        for (size_t r = 0; r < 3; r++)
+        {
+            view.cameraPosition[r] = worldToLocal(r, 0) * cameraPosition[0] + worldToLocal(r, 1) * cameraPosition[1] +
+                                     worldToLocal(r, 2) * cameraPosition[2] + worldToLocal(r, 3);
+        }
+        return view;
+    }
+
+    bool meshletVisible(Meshlet const& meshlet, MeshletCullingView const& view)
+    {
+        Vector3 const& center = meshlet.boundsCenter;
+        for (Vector4 const& plane: view.planes)
+        {
+            if (plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3] < -meshlet.boundsRadius)
+            {
+                return false;
+            }
+        }
+
+        // all triangles face away when the direction from the camera to any point in the bounding sphere lies
+        // within the normal cone, see "Optimizing the Graphics Pipeline with Compute" (Wihlidal, 2016)
+        if (view.backfaceCulling && meshlet.coneCutoff < 1.0f)
+        {
+            Vector3 const direction = center - view.cameraPosition;
+            if (Vector3::dot(direction, meshlet.coneAxis) >= meshlet.coneCutoff * direction.magnitude() + meshlet.boundsRadius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t cullMeshlets(std::span<Meshlet const> meshlets, MeshletCullingView const& view,
+                        std::vector<IndexRange>& outRanges)
+    {
+        size_t const first = outRanges.size();
+        size_t visibleCount = 0;
+        for (Meshlet const& meshlet: meshlets)
+        {
+            if (!meshletVisible(meshlet, view))
+            {
+                continue;
+            }
+            visibleCount++;
+
+            uint32_t const count = meshlet.triangleCount * 3;
+            if (outRanges.size() > first && outRanges.back().offset + outRanges.back().count == meshlet.indexOffset)
+            {
+                outRanges.back().count += count;
+            }
+            else
+            {
+                outRanges.emplace_back(IndexRange{.offset = meshlet.indexOffset, .count = count});
+            }
+        }
+        return visibleCount;
+    }
+}
@@ -0,0 +1,104 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_MESHLET_H
+#define SHAPEREALITY_MESHLET_H
+
+#include "math/vector.h"
+#include "math/matrix.h"
+
+#include <array>
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace renderer
+{
+    struct MeshDescriptor;
+    struct MeshData;
+
+    /**
+     * Small cluster of triangles of a mesh, used for culling parts of a mesh that are outside the view frustum or
+     * that face away from the camera. The triangles of a meshlet are stored contiguously in the index buffer of the
+     * mesh, so that the visible meshlets can be drawn using the regular index buffer.
+     *
+     * Stored as a table of fixed size records next to the vertex and index buffers (see writeMesh()).
+     * Bounds are in the (dequantized) space of the mesh.
+     */
+    struct Meshlet
+    {
+        uint32_t indexOffset = 0; // first index of the meshlet inside the index buffer
+        uint32_t triangleCount = 0;
+        uint32_t vertexCount = 0; // amount of unique vertices referenced by the triangles
+
+        // bounding sphere
+        math::Vector3 boundsCenter{math::Vector3{0, 0, 0}};
+        float boundsRadius = 0.0f;
+
+        // normal cone, all triangle normals are within the cone around coneAxis. coneCutoff is the sine of the
+        // cone's half angle, or 1 if the triangles face too many directions for the meshlet to be backface culled
+        math::Vector3 coneAxis{math::Vector3{0, 0, 1}};
+        float coneCutoff = 1.0f;
+    };
+
+    struct MeshletParameters
+    {
+        size_t maxVertices = 64;
+        size_t maxTriangles = 124; // common limit for mesh shaders, so that the meshlets can be used by them later
+    };
+
+    /**
+     * Splits the triangles into meshlets by greedily growing each meshlet with the adjacent triangle that adds the
+     * fewest new vertices, closest to the meshlet's center. Reorders the triangles in indices so that the triangles
+     * of each meshlet are contiguous, while keeping their relative order (e.g. from optimizeVertexCache()).
+     *
+     * Requires positions as 32-bit floats or normalized unsigned shorts (see quantize()).
+     * Returns an empty list if the mesh has no such positions.
+     */
+    [[nodiscard]] std::vector<Meshlet> buildMeshlets(MeshDescriptor const& descriptor, uint8_t const* vertexData,
+                                                     std::vector<uint32_t>& indices,
+                                                     MeshletParameters const& parameters = {});
+
+    // builds meshlets for the triangles of the mesh data and reorders its index buffer accordingly (adding one if
+    // the mesh data has none), returns false if the mesh data is not a triangle mesh with readable positions
+    bool buildMeshlets(MeshData& data, MeshletParameters const& parameters = {});
+
+    /**
+     * View used for culling meshlets, in the local space of the mesh, so that the bounds of each meshlet don't have
+     * to be transformed to world space
+     */
+    struct MeshletCullingView
+    {
+        // frustum planes facing inwards, (normal, distance) so that a point p is inside when dot(normal, p) + distance >= 0
+        std::array<math::Vector4, 6> planes;
+
+        math::Vector3 cameraPosition{math::Vector3{0, 0, 0}};
+
+        // backface culling assumes a perspective projection, and should be disabled for double sided materials
+        bool backfaceCulling = true;
+    };
+
+    // creates the culling view for a mesh with the provided transform, from the view projection matrix of the camera
+    // (left-handed, depth from zero to one, see createPerspectiveProjectionMatrix()) and the camera position in world space
+    [[nodiscard]] MeshletCullingView createMeshletCullingView(math::Matrix4 const& viewProjection,
+                                                              math::Matrix4 const& localToWorld,
+                                                              math::Vector3 const& cameraPosition);
+
+    // get whether the meshlet is at least partially inside the frustum and has triangles facing the camera
+    [[nodiscard]] bool meshletVisible(Meshlet const& meshlet, MeshletCullingView const& view);
+
+    // range of indices inside the index buffer
+    struct IndexRange
+    {
+        uint32_t offset = 0;
+        uint32_t count = 0;
+    };
+
+    // culls the meshlets and appends the index ranges of the visible meshlets to outRanges, adjacent visible meshlets
+    // are merged into one range so that they can be submitted using a single draw call. returns the amount of visible meshlets.
+    size_t cullMeshlets(std::span<Meshlet const> meshlets, MeshletCullingView const& view,
+                        std::vector<IndexRange>& outRanges);
+}
+
+#endif //SHAPEREALITY_MESHLET_H
@@ -6,6 +6,11 @@
 
 #include <reflection/enum.h>
 #include <renderer/mesh.h>
+#include <renderer/mesh_renderer.h>
+#include <renderer/transform.h>
+#include <reflection/class.h>
+#include <entity/serialize.h>
+#include <asset/asset_database.h>
 
 namespace renderer
 {
@@ -39,12 +44,72 @@ namespace renderer
             .case_(ComponentType::UnsignedInt, "UnsignedInt")
             .case_(ComponentType::Float, "Float")
             .emplace(reflection.types);
+
+        reflection::register_::Enum<VertexAttributeEncoding>("VertexAttributeEncoding")
+            .case_(VertexAttributeEncoding::None, "None")
+            .case_(VertexAttributeEncoding::Octahedral, "Octahedral")
+            .emplace(reflection.types);
+
+        // components are saved as raw bytes, so their members don't have to be registered
+        reflection::register_::Class<TransformComponent>("TransformComponent")
+            .emplace(reflection.types);
+
+        reflection::register_::Class<MeshAssetComponent>("MeshAssetComponent")
+            .emplace(reflection.types);
+
+        reflection::register_::Class<MeshLodAssetComponent>("MeshLodAssetComponent")
+            .emplace(reflection.types);
     }
 
     void register_(asset::AssetTypeRegistry& assetTypes)
     {
         assetTypes.emplace<Mesh>(asset::AssetType{
-            .fileExtension = "mesh"
+            .fileExtension = "mesh",
+            .save = [](asset::AssetHandle& asset, std::ostream& out) {
+                return writeMesh(asset.get<Mesh>(), out);
+            },
+            .load = [](asset::AssetDatabaseContext const& context, std::istream& in, asset::AssetHandle& asset) {
+                std::unique_ptr<Mesh> mesh = readMesh(context.device, in);
+                if (!mesh)
+                {
+                    return false;
+                }
+                asset.set<Mesh>(std::move(mesh));
+                return true;
+            },
+            .loadFromMemory = [](asset::AssetDatabaseContext const& context, std::span<uint8_t const> data,
+                                 asset::AssetHandle& asset) {
+                std::unique_ptr<Mesh> mesh = readMesh(context.device, data);
+                if (!mesh)
+                {
+                    return false;
+                }
+                asset.set<Mesh>(std::move(mesh));
+                return true;
+            },
+            .memoryUsage = [](asset::AssetHandle& asset) {
+                Mesh& mesh = asset.get<Mesh>();
+                asset::AssetMemory memory{.cpu = sizeof(Mesh)};
+                graphics::Buffer* indexBuffer = mesh.descriptor().hasIndexBuffer ? mesh.indexBuffer() : nullptr;
+                for (graphics::Buffer* buffer: {mesh.vertexBuffer(), indexBuffer})
+                {
+                    if (buffer)
+                    {
+                        memory.device += buffer->descriptor().size;
+                    }
+                }
+                return memory;
+            }
         });
     };
+
+    void register_(entity::RegistrySerializer& components)
+    {
+        static_assert(std::is_trivially_copyable_v<TransformComponent>, "TransformComponent should be saved as raw bytes");
+        components.emplace<TransformComponent>();
+        static_assert(std::is_trivially_copyable_v<MeshAssetComponent>, "MeshAssetComponent should be saved as raw bytes");
+        components.emplace<MeshAssetComponent>();
+        static_assert(std::is_trivially_copyable_v<MeshLodAssetComponent>, "MeshLodAssetComponent should be saved as raw bytes");
+        components.emplace<MeshLodAssetComponent>();
+    }
 }
\ No newline at end of file
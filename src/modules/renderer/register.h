@@ -8,11 +8,19 @@
 #include <reflection/reflection.h>
 #include <asset/asset_type_registry.h>
 
+namespace entity
+{
+    class RegistrySerializer;
+}
+
 namespace renderer
 {
     void register_(reflection::Reflection& reflection);
 
     void register_(asset::AssetTypeRegistry& assetTypes);
+
+    // registers the component types of this module that should be saved with a registry (e.g. in a scene)
+    void register_(entity::RegistrySerializer& components);
 }
 
 #endif //SHAPEREALITY_REGISTER_RENDERER_H
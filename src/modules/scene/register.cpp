@@ -7,6 +7,7 @@
 #include <reflection/class.h>
 #include <scene/scene.h>
 #include <reflection/type_registry.h>
+#include <asset/asset_handle.h>
 
 namespace scene
 {
@@ -17,4 +18,23 @@ namespace scene
             .member<&Scene::entities>("entities")
             .emplace(reflection.types);
     }
+
+    void register_(asset::AssetTypeRegistry& assetTypes, entity::RegistrySerializer& components)
+    {
+        assetTypes.emplace<Scene>(asset::AssetType{
+            .fileExtension = "scene",
+            .save = [&components](asset::AssetHandle& asset, std::ostream& out) {
+                return writeScene(asset.get<Scene>(), components, out);
+            },
+            .load = [&components](asset::AssetDatabaseContext const&, std::istream& in, asset::AssetHandle& asset) {
+                std::unique_ptr<Scene> scene = readScene(components, in);
+                if (!scene)
+                {
+                    return false;
+                }
+                asset.set<Scene>(std::move(scene));
+                return true;
+            }
+        });
+    }
 }
\ No newline at end of file
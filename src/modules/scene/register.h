@@ -6,10 +6,20 @@
 #define SHAPEREALITY_REGISTER_SCENE_H
 
 #include <reflection/reflection.h>
+#include <asset/asset_type_registry.h>
+
+namespace entity
+{
+    class RegistrySerializer;
+}
 
 namespace scene
 {
     void register_(reflection::Reflection& reflection);
+
+    // the entities of scenes are saved and loaded using `components`, which should contain the component
+    // types that should be saved (see entity::RegistrySerializer), and should outlive `assetTypes`
+    void register_(asset::AssetTypeRegistry& assetTypes, entity::RegistrySerializer& components);
 }
 
 #endif //SHAPEREALITY_REGISTER_SCENE_H
@@ -4,7 +4,26 @@
 
 #include "scene.h"
 
+#include <common/binary.h>
+#include <common/logger.h>
+#include <entity/serialize.h>
+
 namespace scene
 {
+    bool writeScene(Scene& scene, entity::RegistrySerializer& components, std::ostream& out)
+    {
+        common::binary::writeString(out, scene.name);
+        return components.save(scene.entities, out) && out.good();
+    }
 
-}
\ No newline at end of file
+    std::unique_ptr<Scene> readScene(entity::RegistrySerializer& components, std::istream& in)
+    {
+        std::unique_ptr<Scene> scene = std::make_unique<Scene>();
+        if (!common::binary::readString(in, scene->name) || !components.load(in, scene->entities))
+        {
+            common::log::error("Failed to read scene");
+            return nullptr;
+        }
+        return scene;
+    }
+}
@@ -7,6 +7,15 @@
 
 #include <entity/entity_registry.h>
 
+#include <istream>
+#include <memory>
+#include <ostream>
+
+namespace entity
+{
+    class RegistrySerializer;
+}
+
 /**
  * @namespace scene
  * @brief renderer-agnostic scene representation
@@ -28,6 +37,13 @@ namespace scene
         std::string name;
         entity::EntityRegistry entities;
     };
+
+    // writes the name and a snapshot of the entities of the scene, only the component types that are registered
+    // in `components` are saved. `out` should be seekable (see entity::RegistrySerializer)
+    bool writeScene(Scene& scene, entity::RegistrySerializer& components, std::ostream& out);
+
+    // returns nullptr if reading failed
+    [[nodiscard]] std::unique_ptr<Scene> readScene(entity::RegistrySerializer& components, std::istream& in);
 }
 
 #endif //SHAPEREALITY_SCENE_H
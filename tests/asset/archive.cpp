@@ -0,0 +1,113 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "asset_test_context.h"
+
+#include <asset/asset_archive.h>
+
+using namespace asset_test;
+
+namespace archive_test
+{
+    [[nodiscard]] std::string toString(std::span<uint8_t const> data)
+    {
+        return {reinterpret_cast<char const*>(data.data()), data.size()};
+    }
+
+    TEST(Archive, WriteAndFind)
+    {
+        std::filesystem::path root = std::filesystem::temp_directory_path() / "shapereality_archive_test";
+        std::filesystem::remove_all(root);
+        std::filesystem::create_directories(root);
+
+        std::vector<AssetArchiveEntry> entries;
+        for (int i = 0; i < 10; i++)
+        {
+            std::filesystem::path file = root / (std::to_string(i) + ".text");
+            writeFile(file, std::string(i * 7, static_cast<char>('a' + i)));
+            entries.emplace_back(AssetArchiveEntry{.id = AssetId{"input.txt", file.filename()}, .file = file});
+        }
+        ASSERT_TRUE(AssetArchive::write(root / "assets.archive", entries));
+
+        AssetArchive archive(root / "assets.archive");
+        ASSERT_TRUE(archive.valid());
+        ASSERT_EQ(archive.size(), 10);
+        for (int i = 0; i < 10; i++)
+        {
+            std::span<uint8_t const> data;
+            ASSERT_TRUE(archive.find(AssetId{"input.txt", std::to_string(i) + ".text"}, data));
+            ASSERT_EQ(toString(data), std::string(i * 7, static_cast<char>('a' + i)));
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(data.data()) % AssetArchive::kAlignment, 0);
+        }
+        ASSERT_FALSE(archive.contains(AssetId{"input.txt", "10.text"}));
+        ASSERT_FALSE(archive.contains(AssetId{"other.txt", "0.text"}));
+
+        // paths are compared lexically normal
+        ASSERT_TRUE(archive.contains(AssetId{"models/../input.txt", "./0.text"}));
+        ASSERT_EQ(archive.ids().size(), 10);
+
+        // the same asset id twice results in a key collision
+        entries.emplace_back(entries.front());
+        ASSERT_FALSE(AssetArchive::write(root / "invalid.archive", entries));
+        ASSERT_FALSE(std::filesystem::exists(root / "invalid.archive"));
+
+        // truncated archives are rejected
+        writeFile(root / "truncated.archive", "SARC");
+        ASSERT_FALSE(AssetArchive(root / "truncated.archive").valid());
+    }
+
+    TEST(Archive, LoadFromArchive)
+    {
+        std::atomic<uint8_t const*> loadedFrom = nullptr;
+        AssetType textType = textAssetType();
+        textType.loadFromMemory = [&](AssetDatabaseContext const& context, std::span<uint8_t const> data, AssetHandle& asset) {
+            loadedFrom = data.data();
+            asset.set<Text>(Text{toString(data)});
+            return true;
+        };
+
+        Context c("shapereality_archive_load_test", std::move(textType));
+        c.emplaceTextImporter();
+        writeFile(c.inputDirectory / "a.txt", "a");
+        writeFile(c.inputDirectory / "b.txt", "bb");
+
+        // build step: import into the import cache, and write the archive
+        {
+            CompletionObserver observer; // should outlive the asset database
+            AssetDatabase assets{c.parameters(true), c.context()};
+            assets.observers.add(&observer);
+            assets.importFile("a.txt");
+            assets.importFile("b.txt");
+            ASSERT_TRUE(observer.wait(2));
+            ASSERT_TRUE(assets.writeArchive(c.root / "assets.archive"));
+        }
+
+        // shipping build: no input files or import cache, only the archive
+        std::filesystem::remove_all(c.inputDirectory);
+        std::filesystem::remove_all(c.loadDirectory);
+
+        AssetDatabaseParameters parameters = c.parameters();
+        parameters.archivePath = c.root / "assets.archive";
+        AssetDatabase assets{parameters, c.context()};
+
+        // parsed on the thread pool
+        Asset b = assets.get(textId("b.txt"));
+        ASSERT_TRUE(waitFor([&]() { return b->done(); }));
+        ASSERT_TRUE(b->success());
+        ASSERT_EQ(b->get<Text>().value, "bb");
+
+        // loaded directly from the aligned memory inside the mapping
+        ASSERT_NE(loadedFrom.load(), nullptr);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(loadedFrom.load()) % AssetArchive::kAlignment, 0);
+
+        Asset a = assets.get(textId("a.txt"));
+        ASSERT_TRUE(waitFor([&]() { return a->done(); }));
+        ASSERT_TRUE(a->success());
+        ASSERT_EQ(a->get<Text>().value, "a");
+        ASSERT_EQ(assets.get(textId("a.txt")), a);
+        ASSERT_EQ(assets.get(AssetKey(textId("a.txt"))), a);
+    }
+}
@@ -0,0 +1,184 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_ASSET_TEST_CONTEXT_H
+#define SHAPEREALITY_ASSET_TEST_CONTEXT_H
+
+#include <asset/asset_database.h>
+#include <asset/register.h>
+
+#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+
+// shared fixtures for the asset database tests
+namespace asset_test
+{
+    using namespace asset;
+
+    // generous, so that slow CI machines don't fail, while a regression fails instead of hanging
+    constexpr std::chrono::seconds kTimeout{10};
+
+    // polls the predicate until it returns true, returns false on timeout
+    template<typename Predicate>
+    [[nodiscard]] bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = kTimeout)
+    {
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    struct Text
+    {
+        std::string value;
+    };
+
+    inline void writeFile(std::filesystem::path const& path, std::string const& contents)
+    {
+        std::ofstream file(path, std::ios::trunc | std::ios::binary);
+        file << contents;
+    }
+
+    [[nodiscard]] inline std::string readFile(std::filesystem::path const& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    // Text artifacts are stored as their value
+    [[nodiscard]] inline AssetType textAssetType()
+    {
+        return AssetType{
+            .fileExtension = "text",
+            .save = [](AssetHandle& asset, std::ostream& out) {
+                out << asset.get<Text>().value;
+                return out.good();
+            },
+            .load = [](AssetDatabaseContext const& context, std::istream& in, AssetHandle& asset) {
+                std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+                asset.set<Text>(Text{contents});
+                return true;
+            },
+            .memoryUsage = [](AssetHandle& asset) {
+                return AssetMemory{.cpu = asset.get<Text>().value.size()};
+            }
+        };
+    }
+
+    [[nodiscard]] inline AssetId textId(std::filesystem::path const& inputFile)
+    {
+        return AssetId{inputFile, "text.text"};
+    }
+
+    class CompletionObserver final : public IAssetDatabaseObserver
+    {
+    public:
+        void onImportStarted(std::filesystem::path const& inputFile) override
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            started_++;
+        }
+
+        void onImportComplete(std::filesystem::path const& inputFile, ImportResult result) override
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            completed_++;
+            condition.notify_all();
+        }
+
+        // waits until `count` imports have completed in total, returns false on timeout
+        [[nodiscard]] bool wait(int count, std::chrono::milliseconds timeout = kTimeout)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            return condition.wait_for(lock, timeout, [&]() { return completed_ >= count; });
+        }
+
+        [[nodiscard]] int started()
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            return started_;
+        }
+
+        [[nodiscard]] int completed()
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            return completed_;
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable condition;
+        int started_ = 0;
+        int completed_ = 0;
+    };
+
+    // empty input directory in the temporary directory, with the Text asset type registered
+    struct Context
+    {
+        std::filesystem::path root;
+        std::filesystem::path inputDirectory;
+        std::filesystem::path loadDirectory;
+        ImportRegistry importers{};
+        AssetTypeRegistry assetTypes{};
+        std::atomic<int> importCount = 0;
+
+        explicit Context(std::string const& name, AssetType textType = textAssetType())
+        {
+            root = std::filesystem::temp_directory_path() / name;
+            std::filesystem::remove_all(root);
+            inputDirectory = root / "input";
+            loadDirectory = root / "load";
+            std::filesystem::create_directories(inputDirectory);
+
+            if (!reflection::Reflection::shared().types.contains<ImportResultCache>())
+            {
+                asset::register_(reflection::Reflection::shared());
+            }
+
+            assetTypes.emplace<Text>(std::move(textType));
+        }
+
+        // imports a .txt file into a single text.text artifact that contains the file's contents
+        void emplaceTextImporter()
+        {
+            importers.emplace([&](AssetDatabase& assets, std::filesystem::path const& inputFile) {
+                importCount++;
+                ImportResultData data;
+                data.artifacts.emplace_back(makeAsset<Text>(textId(inputFile), Text{readFile(assets.absolutePath(inputFile))}));
+                return ImportResult::makeSuccess(std::move(data));
+            }, {"txt"});
+        }
+
+        [[nodiscard]] AssetDatabaseParameters parameters(bool useImportCache = false) const
+        {
+            return AssetDatabaseParameters{
+                .inputDirectory = inputDirectory,
+                .loadDirectory = loadDirectory,
+                .useImportCache = useImportCache
+            };
+        }
+
+        [[nodiscard]] AssetDatabaseContext context()
+        {
+            return AssetDatabaseContext{
+                .importers = importers,
+                .assetTypes = assetTypes,
+                .device = nullptr
+            };
+        }
+    };
+}
+
+#endif //SHAPEREALITY_ASSET_TEST_CONTEXT_H
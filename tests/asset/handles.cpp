@@ -6,6 +6,9 @@
 #include <gtest/gtest.h>
 
 #include <asset/asset_handle.h>
+#include <common/executor.h>
+
+#include <thread>
 
 namespace handles_test
 {
@@ -34,4 +37,77 @@ namespace handles_test
         ASSERT_TRUE(b->isType<AssetType2>());
         ASSERT_FALSE(c->isType<AssetType2>());
     }
-}
\ No newline at end of file
+
+    TEST(Asset, Then)
+    {
+        common::MainThreadExecutor mainThread;
+
+        // continuation of an asset handle that is not done yet gets called when the data is set
+        auto handle = std::make_shared<asset::AssetHandle>(asset::AssetId{"a", "a.type1"});
+        int calls = 0;
+        handle->then([&](asset::AssetHandle& h) {
+            ASSERT_TRUE(h.valid<AssetType1>());
+            calls++;
+        }, mainThread);
+        ASSERT_EQ(mainThread.drain(), 0);
+
+        // import threads give the data to the existing handle by swapping
+        std::thread thread([&]() {
+            asset::Asset imported = asset::makeAsset<AssetType1>(asset::AssetId{"a", "a.type1"});
+            handle->swap(imported);
+        });
+        thread.join();
+        ASSERT_EQ(calls, 0); // only called when draining
+        ASSERT_EQ(mainThread.drain(), 1);
+        ASSERT_EQ(calls, 1);
+
+        // already done, so gets called right away
+        handle->then([&](asset::AssetHandle& h) { calls++; });
+        ASSERT_EQ(calls, 2);
+
+        // errors also complete the asset handle
+        auto failed = std::make_shared<asset::AssetHandle>(asset::AssetId{"b", "b.type1"});
+        failed->then([&](asset::AssetHandle& h) {
+            ASSERT_TRUE(h.error());
+            calls++;
+        });
+        failed->setError(common::ResultCode::NotFound);
+        ASSERT_EQ(calls, 3);
+    }
+
+    TEST(Asset, Key)
+    {
+        asset::AssetId const id{"models/scene.gltf", "mesh_0.mesh"};
+        asset::AssetKey const key(id);
+        ASSERT_EQ(key, asset::AssetKey(asset::AssetId{"models/scene.gltf", "mesh_0.mesh"}));
+        ASSERT_EQ(key.value, asset::hash(id));
+
+        // swapped or shifted paths result in a different key
+        ASSERT_NE(key, asset::AssetKey(asset::AssetId{"mesh_0.mesh", "models/scene.gltf"}));
+        ASSERT_NE(asset::AssetKey(asset::AssetId{"ab", "c"}), asset::AssetKey(asset::AssetId{"a", "bc"}));
+
+        // paths that are lexically equal result in the same key
+        asset::AssetId const redundant{"models/./textures/../scene.gltf", "meshes//../mesh_0.mesh"};
+        ASSERT_EQ(asset::AssetKey(redundant), key);
+        ASSERT_EQ(redundant, id);
+
+        // interned while an asset handle exists, so the asset id can be retrieved from the key
+        // (e.g. after deserializing it)
+        asset::AssetId found;
+        ASSERT_FALSE(asset::AssetKeyTable::shared().find(asset::AssetKey(key.value), found));
+        {
+            asset::Asset handle = std::make_shared<asset::AssetHandle>(id);
+            asset::Asset other = std::make_shared<asset::AssetHandle>(redundant);
+            ASSERT_EQ(handle->key(), key);
+            ASSERT_TRUE(asset::AssetKeyTable::shared().find(asset::AssetKey(key.value), found));
+            ASSERT_EQ(found, id);
+            ASSERT_FALSE(asset::AssetKeyTable::shared().find(asset::AssetKey(key.value + 1), found));
+
+            other.reset();
+            ASSERT_TRUE(asset::AssetKeyTable::shared().find(asset::AssetKey(key.value), found));
+        }
+
+        // released once no asset handles are left
+        ASSERT_FALSE(asset::AssetKeyTable::shared().find(asset::AssetKey(key.value), found));
+    }
+}
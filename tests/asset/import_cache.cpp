@@ -0,0 +1,192 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "asset_test_context.h"
+
+#include <reflection/class.h>
+
+using namespace asset_test;
+
+namespace import_cache_test
+{
+    // imports the input file using a new asset database with the import cache enabled, and returns the imported text
+    std::string importText(Context& c, std::filesystem::path const& inputFile)
+    {
+        Asset text;
+        {
+            AssetDatabase assets{c.parameters(true), c.context()};
+            text = assets.get(textId(inputFile));
+        } // the destructor waits for the import task to complete
+        return text->success() ? text->get<Text>().value : "";
+    }
+
+    TEST(ImportCache, LoadFromCache)
+    {
+        Context c("shapereality_import_cache_test");
+        c.emplaceTextImporter();
+        writeFile(c.inputDirectory / "a.txt", "first");
+
+        ASSERT_EQ(importText(c, "a.txt"), "first");
+        ASSERT_EQ(c.importCount, 1);
+        ASSERT_TRUE(std::filesystem::exists(c.loadDirectory / "a_txt" / AssetDatabase::kImportResultFileName));
+        ASSERT_EQ(std::distance(std::filesystem::directory_iterator(c.loadDirectory / AssetDatabase::kContentDirectoryName),
+                                std::filesystem::directory_iterator()), 1);
+
+        // second run, loaded from the cache without calling the importer
+        ASSERT_EQ(importText(c, "a.txt"), "first");
+        ASSERT_EQ(c.importCount, 1);
+
+        // a different last write time with the same contents (e.g. after a checkout) does not invalidate the cache
+        std::filesystem::last_write_time(c.inputDirectory / "a.txt",
+                                         std::filesystem::last_write_time(c.inputDirectory / "a.txt") -
+                                         std::chrono::hours(1));
+        ASSERT_EQ(importText(c, "a.txt"), "first");
+        ASSERT_EQ(c.importCount, 1);
+
+        // modifying the input file invalidates the cache
+        writeFile(c.inputDirectory / "a.txt", "second");
+        ASSERT_EQ(importText(c, "a.txt"), "second");
+        ASSERT_EQ(c.importCount, 2);
+
+        // a missing artifact results in a reimport
+        std::filesystem::remove_all(c.loadDirectory / AssetDatabase::kContentDirectoryName);
+        ASSERT_EQ(importText(c, "a.txt"), "second");
+        ASSERT_EQ(c.importCount, 3);
+    }
+
+    TEST(ImportCache, IdenticalContentsOnDisk)
+    {
+        Context c("shapereality_import_cache_test");
+        c.emplaceTextImporter();
+        writeFile(c.inputDirectory / "a.txt", "same");
+        writeFile(c.inputDirectory / "b.txt", "same");
+
+        ASSERT_EQ(importText(c, "a.txt"), "same");
+        ASSERT_EQ(c.importCount, 1);
+
+        // b.txt has no cache yet, but the artifacts for its contents exist
+        ASSERT_EQ(importText(c, "b.txt"), "same");
+        ASSERT_EQ(c.importCount, 1);
+        ASSERT_TRUE(std::filesystem::exists(c.loadDirectory / "b_txt" / AssetDatabase::kImportResultFileName));
+    }
+
+    TEST(ImportCache, IdenticalContentsInMemory)
+    {
+        Context c("shapereality_import_cache_test");
+        c.emplaceTextImporter();
+        writeFile(c.inputDirectory / "a.txt", "same");
+        writeFile(c.inputDirectory / "b.txt", "same");
+        writeFile(c.inputDirectory / "c.txt", "different");
+
+        Asset a;
+        Asset b;
+        Asset other;
+        CompletionObserver observer; // should outlive the asset database
+        {
+            AssetDatabase assets{c.parameters(false), c.context()};
+            assets.observers.add(&observer);
+
+            a = assets.get(textId("a.txt"));
+            ASSERT_TRUE(observer.wait(1));
+            b = assets.get(textId("b.txt"));
+            other = assets.get(textId("c.txt"));
+        }
+        ASSERT_EQ(c.importCount, 2); // b.txt shares the artifacts of a.txt
+
+        ASSERT_TRUE(b->isAlias());
+        ASSERT_EQ(&a->get<Text>(), &b->get<Text>());
+        ASSERT_EQ(b->id().inputFilePath, "b.txt");
+        ASSERT_EQ(other->get<Text>().value, "different");
+    }
+
+    TEST(ImportCache, UpToDateCacheDoesNotReadInputFile)
+    {
+        Context c("shapereality_import_cache_test");
+        c.emplaceTextImporter();
+        writeFile(c.inputDirectory / "a.txt", "first");
+        writeFile(c.inputDirectory / "b.txt", "second");
+        ASSERT_EQ(importText(c, "a.txt"), "first");
+
+        // change the contents, but keep the last write time, so that reading the input file is the only way to notice
+        std::filesystem::file_time_type const lastWriteTime = std::filesystem::last_write_time(c.inputDirectory / "a.txt");
+        writeFile(c.inputDirectory / "a.txt", "second");
+        std::filesystem::last_write_time(c.inputDirectory / "a.txt", lastWriteTime);
+
+        CompletionObserver observer; // should outlive the asset database
+        AssetDatabase assets{c.parameters(true), c.context()};
+        assets.observers.add(&observer);
+        Asset b = assets.get(textId("b.txt"));
+        ASSERT_TRUE(observer.wait(1));
+
+        // if a.txt was hashed, it would share the artifacts of b.txt, which has the same contents
+        Asset a = assets.get(textId("a.txt"));
+        ASSERT_TRUE(observer.wait(2));
+        ASSERT_EQ(a->get<Text>().value, "first");
+        ASSERT_EQ(c.importCount, 2);
+    }
+
+    struct SuffixParameters
+    {
+        std::string suffix = "?";
+        bool twice = false;
+    };
+
+    TEST(ImportCache, ImportParameters)
+    {
+        Context c("shapereality_import_cache_test");
+        if (!reflection::Reflection::shared().types.contains<SuffixParameters>())
+        {
+            reflection::register_::Class<SuffixParameters>("SuffixParameters")
+                .member<&SuffixParameters::suffix>("suffix")
+                .member<&SuffixParameters::twice>("twice")
+                .emplace(reflection::Reflection::shared().types);
+        }
+
+        c.importers.emplace([&](AssetDatabase& assets, std::filesystem::path const& inputFile) {
+            c.importCount++;
+            ImportResultData data;
+            SuffixParameters parameters;
+            if (!assets.readImportParameters(inputFile, parameters, data.dependencies))
+            {
+                return ImportResult::makeError(common::ResultCode::InvalidArgument, "Invalid import parameters");
+            }
+            std::string value = readFile(assets.absolutePath(inputFile)) + parameters.suffix;
+            if (parameters.twice)
+            {
+                value += parameters.suffix;
+            }
+            data.artifacts.emplace_back(makeAsset<Text>(textId(inputFile), Text{value}));
+            return ImportResult::makeSuccess(std::move(data));
+        }, {"txt"});
+        writeFile(c.inputDirectory / "a.txt", "a");
+        writeFile(c.inputDirectory / "b.txt", "a");
+
+        // without import parameters file
+        ASSERT_EQ(importText(c, "a.txt"), "a?");
+        ASSERT_EQ(c.importCount, 1);
+
+        // creating the file invalidates the cache, members that are not in the file keep their value
+        std::filesystem::path const parametersFile = c.inputDirectory / "a.txt.import";
+        writeFile(parametersFile, R"({"twice": true})");
+        ASSERT_EQ(importText(c, "a.txt"), "a??");
+        ASSERT_EQ(c.importCount, 2);
+        ASSERT_EQ(importText(c, "a.txt"), "a??");
+        ASSERT_EQ(c.importCount, 2);
+
+        // an input file with the same contents, but without import parameters, doesn't share the artifacts
+        ASSERT_EQ(importText(c, "b.txt"), "a?");
+
+        // modifying the file invalidates the cache
+        writeFile(parametersFile, R"({"suffix": "!", "twice": true})");
+        std::filesystem::last_write_time(parametersFile,
+                                         std::filesystem::last_write_time(parametersFile) + std::chrono::seconds(1));
+        ASSERT_EQ(importText(c, "a.txt"), "a!!");
+
+        // invalid files fail the import
+        writeFile(parametersFile, "{");
+        ASSERT_EQ(importText(c, "a.txt"), "");
+    }
+}
@@ -0,0 +1,182 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "asset_test_context.h"
+
+using namespace asset_test;
+
+namespace import_scheduling_test
+{
+    // imports .txt files, the import of the file named "gate.txt" blocks until the gate is opened,
+    // so that other imports get queued
+    struct GateContext : Context
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool open = false;
+        std::vector<std::filesystem::path> order; // order in which the files were imported
+
+        std::atomic<int> running = 0;
+        std::atomic<int> maxRunning = 0;
+
+        explicit GateContext(std::vector<std::string> const& files) : Context("shapereality_import_scheduling_test")
+        {
+            for (auto& file: files)
+            {
+                writeFile(inputDirectory / file, file);
+            }
+
+            importers.emplace([&](AssetDatabase& assets, std::filesystem::path const& inputFile) {
+                int current = ++running;
+                int previous = maxRunning;
+                while (current > previous && !maxRunning.compare_exchange_weak(previous, current))
+                {
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    order.emplace_back(inputFile);
+                    if (inputFile == "gate.txt")
+                    {
+                        // times out so that a failing test doesn't wait forever in the asset database's destructor
+                        condition.wait_for(lock, kTimeout, [&]() { return open; });
+                    }
+                }
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                running--;
+
+                ImportResultData data;
+                data.artifacts.emplace_back(makeAsset<Text>(textId(inputFile), Text{inputFile.string()}));
+                return ImportResult::makeSuccess(std::move(data));
+            }, {"txt"});
+        }
+
+        [[nodiscard]] AssetDatabaseParameters parameters(size_t maxConcurrentImports) const
+        {
+            AssetDatabaseParameters out = Context::parameters();
+            out.maxConcurrentImports = maxConcurrentImports;
+            return out;
+        }
+
+        void openGate()
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            open = true;
+            condition.notify_all();
+        }
+
+        // waits until the import of the gate has started, so that subsequent imports get queued.
+        // returns false on timeout
+        [[nodiscard]] bool waitForGate()
+        {
+            return waitFor([&]() {
+                std::lock_guard<std::mutex> guard(mutex);
+                return std::find(order.begin(), order.end(), "gate.txt") != order.end();
+            });
+        }
+    };
+
+    TEST(ImportScheduling, Priority)
+    {
+        GateContext c({"gate.txt", "a.txt", "b.txt", "c.txt"});
+        CompletionObserver observer; // should outlive the asset database
+        AssetDatabase assets{c.parameters(1), c.context()};
+        assets.observers.add(&observer);
+
+        Asset gate = assets.get(textId("gate.txt"));
+        ASSERT_TRUE(c.waitForGate());
+        Asset a = assets.get(textId("a.txt"));
+        Asset b = assets.get(textId("b.txt"), 5);
+        Asset c_ = assets.get(textId("c.txt"));
+
+        // c becomes visible
+        Asset c2 = assets.get(textId("c.txt"), 10);
+        ASSERT_EQ(c_, c2);
+
+        c.openGate();
+        ASSERT_TRUE(observer.wait(4));
+        ASSERT_EQ(c.order, (std::vector<std::filesystem::path>{"gate.txt", "c.txt", "b.txt", "a.txt"}));
+        ASSERT_EQ(c.maxRunning, 1);
+        ASSERT_EQ(a->get<Text>().value, "a.txt");
+    }
+
+    TEST(ImportScheduling, CancelUnreferenced)
+    {
+        GateContext c({"gate.txt", "a.txt", "b.txt", "c.txt"});
+        CompletionObserver observer; // should outlive the asset database
+        AssetDatabase assets{c.parameters(1), c.context()};
+        assets.observers.add(&observer);
+
+        Asset gate = assets.get(textId("gate.txt"));
+        ASSERT_TRUE(c.waitForGate());
+
+        // not referenced anymore before the import started
+        (void)assets.get(textId("a.txt"));
+        ASSERT_TRUE(assets.importCancelled("a.txt"));
+
+        // explicitly requested imports are never cancelled
+        assets.importFile("b.txt");
+        ASSERT_FALSE(assets.importCancelled("b.txt"));
+
+        Asset other = assets.get(textId("c.txt"));
+        ASSERT_FALSE(assets.importCancelled("c.txt"));
+
+        c.openGate();
+        ASSERT_TRUE(observer.wait(3));
+        ASSERT_EQ(c.order, (std::vector<std::filesystem::path>{"gate.txt", "b.txt", "c.txt"}));
+        ASSERT_EQ(other->get<Text>().value, "c.txt");
+
+        // requesting it again imports it
+        Asset a = assets.get(textId("a.txt"));
+        ASSERT_TRUE(observer.wait(4));
+        ASSERT_EQ(a->get<Text>().value, "a.txt");
+    }
+
+    TEST(ImportScheduling, MaxConcurrentImports)
+    {
+        std::vector<std::string> files;
+        for (int i = 0; i < 16; i++)
+        {
+            files.emplace_back(std::to_string(i) + ".txt");
+        }
+        GateContext c(files);
+        c.openGate();
+
+        CompletionObserver observer; // should outlive the asset database
+        AssetDatabase assets{c.parameters(2), c.context()};
+        assets.observers.add(&observer);
+
+        std::vector<Asset> handles;
+        for (auto& file: files)
+        {
+            handles.emplace_back(assets.get(textId(file)));
+        }
+        ASSERT_TRUE(observer.wait(static_cast<int>(files.size())));
+        ASSERT_LE(c.maxRunning, 2);
+        ASSERT_EQ(c.order.size(), files.size());
+    }
+
+    // input files that can't be imported complete the handle with an error, instead of leaving it loading
+    TEST(ImportScheduling, MissingOrUnsupportedFile)
+    {
+        GateContext c({"unsupported.bin"});
+        c.openGate();
+        AssetDatabase assets{c.parameters(2), c.context()};
+
+        int calls = 0;
+        Asset missing = assets.get(textId("missing.txt"));
+        missing->then([&](AssetHandle& handle) { calls++; });
+        ASSERT_EQ(calls, 1);
+        ASSERT_TRUE(missing->error());
+        ASSERT_EQ(missing->code(), common::ResultCode::NotFound);
+
+        Asset unsupported = assets.get(textId("unsupported.bin"));
+        unsupported->then([&](AssetHandle& handle) { calls++; });
+        ASSERT_EQ(calls, 2);
+        ASSERT_EQ(unsupported->code(), common::ResultCode::Unimplemented);
+    }
+}
@@ -0,0 +1,182 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "asset_test_context.h"
+
+#include <asset/file_watcher.h>
+
+using namespace asset_test;
+
+namespace reimport_test
+{
+    /**
+     * .list files contain one relative file path per line (its dependencies),
+     * the imported text is the concatenated contents of these files
+     */
+    struct ListContext : Context
+    {
+        ListContext() : Context("shapereality_reimport_test")
+        {
+            std::filesystem::create_directories(inputDirectory / "textures");
+
+            importers.emplace([&](AssetDatabase& assets, std::filesystem::path const& inputFile) {
+                importCount++;
+                ImportResultData data;
+                std::ifstream file(assets.absolutePath(inputFile));
+                std::string value;
+                for (std::string line; std::getline(file, line);)
+                {
+                    data.dependencies.emplace_back(line);
+                    value += readFile(assets.absolutePath(line));
+                }
+                data.artifacts.emplace_back(makeAsset<Text>(textId(inputFile), Text{value}));
+                return ImportResult::makeSuccess(std::move(data));
+            }, {"list"});
+        }
+
+        [[nodiscard]] AssetDatabaseParameters parameters(bool watchInputDirectory) const
+        {
+            AssetDatabaseParameters out = Context::parameters();
+            out.watchInputDirectory = watchInputDirectory;
+            return out;
+        }
+    };
+
+    TEST(Reimport, Dependents)
+    {
+        ListContext c;
+        writeFile(c.inputDirectory / "textures/a.png", "a");
+        writeFile(c.inputDirectory / "textures/b.png", "b");
+        writeFile(c.inputDirectory / "first.list", "textures/a.png\ntextures/b.png");
+        writeFile(c.inputDirectory / "second.list", "textures/b.png");
+
+        CompletionObserver observer; // should outlive the asset database
+        AssetDatabase assets{c.parameters(false), c.context()};
+        assets.observers.add(&observer);
+
+        Asset first = assets.get(textId("first.list"));
+        Asset second = assets.get(textId("second.list"));
+        ASSERT_TRUE(observer.wait(2));
+        ASSERT_EQ(first->get<Text>().value, "ab");
+        ASSERT_EQ(second->get<Text>().value, "b");
+
+        ASSERT_EQ(assets.dependents("textures/a.png"), (std::vector<std::filesystem::path>{"first.list"}));
+        ASSERT_EQ(assets.dependents("textures/b.png").size(), 2);
+        ASSERT_TRUE(assets.dependents("first.list").empty());
+
+        // only the input files that depend on a.png get reimported, and the existing handles get updated
+        writeFile(c.inputDirectory / "textures/a.png", "c");
+        assets.reimport({"textures/a.png"});
+        ASSERT_TRUE(observer.wait(3));
+        ASSERT_EQ(c.importCount, 3);
+
+        // the reimported data only gets swapped into the handles when applying the reloads
+        ASSERT_EQ(first->get<Text>().value, "ab");
+        assets.applyReloads();
+        ASSERT_EQ(first->get<Text>().value, "cb");
+        ASSERT_EQ(second->get<Text>().value, "b");
+
+        // dependencies that are removed no longer trigger a reimport
+        writeFile(c.inputDirectory / "first.list", "textures/b.png");
+        assets.reimport({"first.list"});
+        ASSERT_TRUE(observer.wait(4));
+        assets.applyReloads();
+        ASSERT_TRUE(assets.dependents("textures/a.png").empty());
+        ASSERT_EQ(first->get<Text>().value, "b");
+    }
+
+    // used when the file watcher dropped events
+    TEST(Reimport, Rescan)
+    {
+        ListContext c;
+        writeFile(c.inputDirectory / "textures/a.png", "a");
+        writeFile(c.inputDirectory / "textures/b.png", "b");
+        writeFile(c.inputDirectory / "first.list", "textures/a.png");
+        writeFile(c.inputDirectory / "second.list", "textures/b.png");
+
+        CompletionObserver observer; // should outlive the asset database
+        AssetDatabase assets{c.parameters(false), c.context()};
+        assets.observers.add(&observer);
+
+        Asset first = assets.get(textId("first.list"));
+        Asset second = assets.get(textId("second.list"));
+        ASSERT_TRUE(observer.wait(2));
+
+        // only the input file whose dependency changed gets reimported
+        std::filesystem::path const a = c.inputDirectory / "textures/a.png";
+        writeFile(a, "c");
+        std::filesystem::last_write_time(a, std::filesystem::last_write_time(a) + std::chrono::seconds(1));
+        assets.rescan();
+        ASSERT_TRUE(observer.wait(3));
+        assets.applyReloads();
+        ASSERT_EQ(c.importCount, 3);
+        ASSERT_EQ(first->get<Text>().value, "c");
+        ASSERT_EQ(second->get<Text>().value, "b");
+    }
+
+#if defined(PLATFORM_LINUX)
+    TEST(Reimport, FileWatcher)
+    {
+        ListContext c;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::vector<std::vector<std::filesystem::path>> batches;
+
+        FileWatcher watcher(c.inputDirectory, [&](std::vector<std::filesystem::path> const& files) {
+            std::lock_guard<std::mutex> guard(mutex);
+            batches.emplace_back(files);
+            condition.notify_all();
+        }, [&]() {
+            // the test doesn't change enough files to overflow the event queue
+            ADD_FAILURE();
+        }, std::chrono::milliseconds(50));
+        ASSERT_TRUE(FileWatcher::supported());
+        ASSERT_TRUE(watcher.valid());
+
+        // multiple writes get coalesced into one batch
+        writeFile(c.inputDirectory / "textures/a.png", "a");
+        writeFile(c.inputDirectory / "textures/a.png", "aa");
+        std::filesystem::create_directories(c.inputDirectory / "new");
+        writeFile(c.inputDirectory / "new/b.png", "b");
+
+        // the new directory might get picked up in a separate batch
+        std::vector<std::filesystem::path> files;
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(condition.wait_for(lock, kTimeout, [&]() {
+            files.clear();
+            for (auto& batch: batches)
+            {
+                files.insert(files.end(), batch.begin(), batch.end());
+            }
+            return std::count(files.begin(), files.end(), "textures/a.png") > 0 &&
+                   std::count(files.begin(), files.end(), "new/b.png") > 0;
+        }));
+        ASSERT_EQ(std::count(files.begin(), files.end(), "textures/a.png"), 1);
+    }
+
+    TEST(Reimport, WatchInputDirectory)
+    {
+        ListContext c;
+        writeFile(c.inputDirectory / "textures/a.png", "a");
+        writeFile(c.inputDirectory / "first.list", "textures/a.png");
+
+        CompletionObserver observer; // should outlive the asset database
+        AssetDatabase assets{c.parameters(true), c.context()};
+        assets.observers.add(&observer);
+
+        Asset first = assets.get(textId("first.list"));
+        ASSERT_TRUE(observer.wait(1));
+        ASSERT_EQ(first->get<Text>().value, "a");
+
+        writeFile(c.inputDirectory / "textures/a.png", "b");
+        ASSERT_TRUE(observer.wait(2));
+        ASSERT_TRUE(waitFor([&]() {
+            assets.applyReloads();
+            return first->get<Text>().value == "b";
+        }));
+    }
+#endif
+}
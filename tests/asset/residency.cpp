@@ -0,0 +1,101 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "asset_test_context.h"
+
+#include <asset/asset_residency.h>
+
+using namespace asset_test;
+
+namespace residency_test
+{
+    Asset makeText(std::filesystem::path const& inputFile, std::string const& value)
+    {
+        return makeAsset<Text>(textId(inputFile), Text{value});
+    }
+
+    TEST(Residency, RetainAndEvict)
+    {
+        reflection::TypeId const typeId = reflection::TypeIndex<Text>::value();
+        auto residency = std::make_shared<AssetResidency>(AssetMemory{.cpu = 100});
+
+        Asset a = residency->wrap(makeText("a.txt", "a"));
+        Asset b = residency->wrap(makeText("b.txt", "b"));
+        Asset c = residency->wrap(makeText("c.txt", "c"));
+        residency->update(*a, typeId, AssetMemory{.cpu = 30});
+        residency->update(*b, typeId, AssetMemory{.cpu = 30});
+        residency->update(*c, typeId, AssetMemory{.cpu = 30});
+        ASSERT_EQ(residency->resident().cpu, 90);
+
+        // released assets are retained while within budget
+        a.reset();
+        b.reset();
+        ASSERT_EQ(residency->resident().cpu, 90);
+        ASSERT_EQ(residency->retained().cpu, 60);
+
+        // exceeding the budget evicts the least recently released asset
+        Asset d = residency->wrap(makeText("d.txt", "d"));
+        residency->update(*d, typeId, AssetMemory{.cpu = 30});
+        ASSERT_EQ(residency->resident().cpu, 90);
+        ASSERT_EQ(residency->acquire(AssetKey(textId("a.txt"))), nullptr);
+
+        Asset retained = residency->acquire(AssetKey(textId("b.txt")));
+        ASSERT_NE(retained, nullptr);
+        ASSERT_EQ(retained->get<Text>().value, "b");
+        ASSERT_EQ(residency->retained().cpu, 0);
+        b = residency->wrap(std::move(retained));
+
+        std::vector<AssetTypeMemoryStatistics> statistics = residency->statistics();
+        ASSERT_EQ(statistics.size(), 1);
+        ASSERT_EQ(statistics[0].typeId, typeId);
+        ASSERT_EQ(statistics[0].count, 3);
+        ASSERT_EQ(statistics[0].retainedCount, 0);
+
+        // referenced assets are never evicted
+        residency->setBudget(AssetMemory{});
+        ASSERT_EQ(residency->resident().cpu, 90);
+        b.reset();
+        ASSERT_EQ(residency->resident().cpu, 60);
+        ASSERT_EQ(residency->acquire(AssetKey(textId("b.txt"))), nullptr);
+    }
+
+    TEST(Residency, ReloadFromImportCache)
+    {
+        Context c("shapereality_residency_test");
+        c.emplaceTextImporter();
+        writeFile(c.inputDirectory / "a.txt", "a");
+
+        CompletionObserver observer; // should outlive the asset database
+        AssetDatabaseParameters parameters = c.parameters(true);
+        parameters.memoryBudget = {.cpu = 1024};
+        AssetDatabase assets{parameters, c.context()};
+        assets.observers.add(&observer);
+
+        AssetId const id = textId("a.txt");
+        Asset a = assets.get(id);
+        ASSERT_TRUE(observer.wait(1));
+        Text const* data = &a->get<Text>();
+        ASSERT_EQ(assets.residentMemory().cpu, 1);
+
+        // released, but retained, so getting it again does not load it
+        a.reset();
+        a = assets.get(id);
+        ASSERT_TRUE(a->success());
+        ASSERT_EQ(&a->get<Text>(), data);
+        ASSERT_EQ(observer.completed(), 1);
+
+        // evicted, so it gets loaded from the import cache
+        // (the import task might still reference the asset for a short moment after completing).
+        // the asset id stays interned while the input file is imported, so the key alone is enough
+        a.reset();
+        assets.setMemoryBudget(AssetMemory{});
+        ASSERT_TRUE(waitFor([&]() { return assets.residentMemory().cpu == 0; }));
+        a = assets.get(AssetKey(id));
+        ASSERT_TRUE(observer.wait(2));
+        ASSERT_EQ(a->get<Text>().value, "a");
+        ASSERT_EQ(c.importCount, 1);
+    }
+}
@@ -0,0 +1,126 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "asset_test_context.h"
+
+#include <random>
+
+using namespace asset_test;
+
+namespace stress_test
+{
+    constexpr int kFileCount = 64;
+    constexpr int kArtifactCount = 4;
+
+    [[nodiscard]] AssetId textId(int file, int artifact)
+    {
+        return AssetId{std::to_string(file) + ".txt", std::to_string(artifact) + ".text"};
+    }
+
+    // many threads getting overlapping assets while imports and forced reimports complete on the thread pool
+    TEST(Stress, ConcurrentGetAndImport)
+    {
+        Context c("shapereality_stress_test");
+        for (int i = 0; i < kFileCount; i++)
+        {
+            writeFile(c.inputDirectory / (std::to_string(i) + ".txt"), std::to_string(i));
+        }
+
+        // the sleep simulates the work of an importer, so that imports overlap with the getters
+        c.importers.emplace([&](AssetDatabase& assets, std::filesystem::path const& inputFile) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            ImportResultData data;
+            for (int i = 0; i < kArtifactCount; i++)
+            {
+                AssetId id{inputFile, std::to_string(i) + ".text"};
+                data.artifacts.emplace_back(makeAsset<Text>(id, Text{id.inputFilePath.string() + id.artifactPath.string()}));
+            }
+            return ImportResult::makeSuccess(std::move(data));
+        }, {"txt"});
+
+        constexpr int kGetterCount = 8;
+        constexpr int kIterations = 2000;
+        std::vector<std::vector<Asset>> handles(kGetterCount, std::vector<Asset>(kFileCount * kArtifactCount));
+
+        CompletionObserver observer; // should outlive the asset database
+        {
+            AssetDatabaseParameters parameters = c.parameters();
+            parameters.maxConcurrentImports = 4;
+            AssetDatabase assets{parameters, c.context()};
+            assets.observers.add(&observer);
+
+            std::atomic<bool> stop = false;
+
+            std::vector<std::thread> threads;
+            for (int t = 0; t < kGetterCount; t++)
+            {
+                threads.emplace_back([&, t]() {
+                    std::mt19937 random(t);
+                    for (int i = 0; i < kIterations; i++)
+                    {
+                        int const file = static_cast<int>(random() % kFileCount);
+                        int const artifact = static_cast<int>(random() % kArtifactCount);
+                        Asset handle = assets.get(textId(file, artifact), static_cast<int>(random() % 4));
+                        ASSERT_NE(handle, nullptr);
+                        handles[t][file * kArtifactCount + artifact] = std::move(handle);
+                    }
+                });
+            }
+
+            // forced reimports swap new data into the existing handles while they are being read
+            std::thread importer([&]() {
+                std::mt19937 random(kGetterCount);
+                while (!stop)
+                {
+                    assets.importFile(std::to_string(random() % kFileCount) + ".txt");
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                }
+            });
+
+            for (auto& thread: threads)
+            {
+                thread.join();
+            }
+            stop = true;
+            importer.join();
+
+            // all threads received the same handle for the same asset id
+            for (int i = 0; i < kFileCount * kArtifactCount; i++)
+            {
+                Asset const* first = nullptr;
+                for (auto& perThread: handles)
+                {
+                    if (!perThread[i])
+                    {
+                        continue;
+                    }
+                    if (first)
+                    {
+                        ASSERT_EQ(perThread[i], *first);
+                    }
+                    first = &perThread[i];
+                }
+            }
+        }
+
+        // the destructor waits for all imports (forced reimports could otherwise still swap data into the handles)
+        ASSERT_EQ(observer.started(), observer.completed());
+        for (auto& perThread: handles)
+        {
+            for (int i = 0; i < kFileCount * kArtifactCount; i++)
+            {
+                Asset const& handle = perThread[i];
+                if (!handle)
+                {
+                    continue;
+                }
+                ASSERT_TRUE(handle->success());
+                AssetId const id = textId(i / kArtifactCount, i % kArtifactCount);
+                ASSERT_EQ(handle->get<Text>().value, id.inputFilePath.string() + id.artifactPath.string());
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <common/mapped_file.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace mapped_file_test
+{
+    [[nodiscard]] std::filesystem::path writeFile(std::string const& name, std::string const& contents)
+    {
+        std::filesystem::path const path = std::filesystem::temp_directory_path() / name;
+        std::ofstream file(path, std::ios::trunc | std::ios::binary);
+        file << contents;
+        return path;
+    }
+
+    [[nodiscard]] std::string toString(std::span<uint8_t const> data)
+    {
+        return {reinterpret_cast<char const*>(data.data()), data.size()};
+    }
+
+    TEST(MappedFile, Map)
+    {
+        std::string contents(10000, 'a');
+        contents.back() = 'b';
+        common::MappedFile const file(writeFile("shapereality_mapped_file_test.bin", contents));
+        ASSERT_TRUE(file.valid());
+        ASSERT_EQ(file.data().size(), contents.size());
+        ASSERT_EQ(toString(file.data()), contents);
+    }
+
+    TEST(MappedFile, Empty)
+    {
+        common::MappedFile const file(writeFile("shapereality_mapped_file_empty_test.bin", ""));
+        ASSERT_TRUE(file.valid());
+        ASSERT_TRUE(file.data().empty());
+    }
+
+    TEST(MappedFile, MissingFile)
+    {
+        common::MappedFile const file(std::filesystem::temp_directory_path() / "shapereality_mapped_file_missing.bin");
+        ASSERT_FALSE(file.valid());
+        ASSERT_TRUE(file.data().empty());
+    }
+
+    TEST(MappedFile, Move)
+    {
+        std::filesystem::path const path = writeFile("shapereality_mapped_file_move_test.bin", "contents");
+        common::MappedFile a(path);
+        uint8_t const* data = a.data().data();
+
+        // the mapping moves along, without remapping the file
+        common::MappedFile b(std::move(a));
+        ASSERT_FALSE(a.valid());
+        ASSERT_TRUE(a.data().empty());
+        ASSERT_TRUE(b.valid());
+        ASSERT_EQ(b.data().data(), data);
+        ASSERT_EQ(toString(b.data()), "contents");
+
+        // move assignment unmaps the previous mapping
+        common::MappedFile c(writeFile("shapereality_mapped_file_move_other_test.bin", "other"));
+        c = std::move(b);
+        ASSERT_FALSE(b.valid());
+        ASSERT_TRUE(c.valid());
+        ASSERT_EQ(toString(c.data()), "contents");
+    }
+}
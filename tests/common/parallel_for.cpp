@@ -0,0 +1,82 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool.h>
+
+#include <BS_thread_pool.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+namespace parallel_for_test
+{
+    TEST(ParallelFor, CallsEachIndexOnce)
+    {
+        BS::thread_pool pool(4);
+        std::vector<std::atomic<int>> calls(1000);
+        common::parallelFor(pool, calls.size(), [&](size_t index) {
+            calls[index]++;
+        });
+        for (auto& call: calls)
+        {
+            ASSERT_EQ(call, 1);
+        }
+
+        common::parallelFor(pool, 0, [&](size_t index) {
+            FAIL();
+        });
+    }
+
+    // calling parallelFor from tasks that occupy all threads of the thread pool (like imports do)
+    // would deadlock if it only waited for the thread pool
+    TEST(ParallelFor, FromTasksOnSameThreadPool)
+    {
+        BS::thread_pool pool(2);
+        std::atomic<int> sum = 0;
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < 4; i++)
+        {
+            futures.emplace_back(pool.submit_task([&]() {
+                common::parallelFor(pool, 100, [&](size_t index) {
+                    // nested
+                    common::parallelFor(pool, 10, [&](size_t) {
+                        sum++;
+                    });
+                });
+            }));
+        }
+        for (auto& future: futures)
+        {
+            future.wait();
+        }
+        ASSERT_EQ(sum, 4 * 100 * 10);
+    }
+
+    TEST(ParallelFor, RethrowsException)
+    {
+        BS::thread_pool pool(4);
+        for (size_t throwing: {size_t{0}, size_t{500}, size_t{999}})
+        {
+            std::atomic<int> calls = 0;
+            EXPECT_THROW(common::parallelFor(pool, 1000, [&](size_t index) {
+                calls++;
+                if (index == throwing)
+                {
+                    throw std::runtime_error("index failed");
+                }
+            }), std::runtime_error);
+            EXPECT_GE(calls, 1);
+            EXPECT_LE(calls, 1000);
+        }
+
+        // the thread pool is still usable
+        std::atomic<int> sum = 0;
+        common::parallelFor(pool, 100, [&](size_t) { sum++; });
+        EXPECT_EQ(sum, 100);
+    }
+}
@@ -0,0 +1,198 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <entity/entity_registry.h>
+
+using namespace entity;
+
+namespace component_events_tests
+{
+    struct Position
+    {
+        float x = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float x = 0.0f;
+    };
+
+    class Observer final : public IComponentObserver
+    {
+    public:
+        std::vector<EntityId> constructed;
+        std::vector<EntityId> updated;
+        std::vector<EntityId> destroyed;
+        int batches = 0;
+
+        void onConstruct(EntityRegistry& r, reflection::TypeId typeId, std::span<EntityId const> entities) override
+        {
+            batches++;
+            constructed.insert(constructed.end(), entities.begin(), entities.end());
+        }
+
+        void onUpdate(EntityRegistry& r, reflection::TypeId typeId, std::span<EntityId const> entities) override
+        {
+            batches++;
+            updated.insert(updated.end(), entities.begin(), entities.end());
+        }
+
+        void onDestroy(EntityRegistry& r, reflection::TypeId typeId, std::span<EntityId const> entities) override
+        {
+            batches++;
+            destroyed.insert(destroyed.end(), entities.begin(), entities.end());
+        }
+    };
+
+    TEST(ComponentEvents, Batched)
+    {
+        EntityRegistry r;
+        Observer observer;
+        r.addObserver<Position>(&observer);
+
+        for (EntityId i = 0; i < 10; i++)
+        {
+            r.createEntity(i);
+            r.addComponent<Position>(i);
+            r.addComponent<Velocity>(i); // not observed
+        }
+
+        // nothing is delivered before flushing
+        ASSERT_TRUE(observer.constructed.empty());
+
+        r.flushEvents();
+        ASSERT_EQ(observer.batches, 1);
+        ASSERT_EQ(observer.constructed.size(), 10);
+        ASSERT_EQ(observer.constructed.front(), 0);
+        ASSERT_EQ(observer.constructed.back(), 9);
+
+        // flushing again delivers nothing
+        r.flushEvents();
+        ASSERT_EQ(observer.batches, 1);
+
+        r.updateComponent<Position>(3, [](Position& p) { p.x = 1.0f; });
+        r.markUpdated<Position>(3);
+        r.markUpdated<Position>(4);
+        ASSERT_FALSE(r.markUpdated<Position>(100));
+        r.removeComponent<Position>(5);
+        r.destroyEntity(6);
+        r.flushEvents();
+
+        ASSERT_EQ(r.getComponent<Position>(3).x, 1.0f);
+        ASSERT_EQ(observer.updated, (std::vector<EntityId>{3, 4}));
+        ASSERT_EQ(observer.destroyed, (std::vector<EntityId>{5, 6}));
+    }
+
+    TEST(ComponentEvents, Coalesce)
+    {
+        EntityRegistry r;
+        Observer observer;
+        r.addObserver<Position>(&observer);
+
+        r.createEntity(0);
+        r.createEntity(1);
+        r.addComponent<Position>(1);
+        r.flushEvents();
+        observer.constructed.clear();
+
+        // constructed and destroyed in the same batch: only destroy
+        r.addComponent<Position>(0);
+        r.markUpdated<Position>(0);
+        r.removeComponent<Position>(0);
+
+        // destroyed and constructed in the same batch: destroy, then construct
+        r.removeComponent<Position>(1);
+        r.addComponent<Position>(1);
+        r.markUpdated<Position>(1);
+
+        r.flushEvents();
+        ASSERT_EQ(observer.destroyed, (std::vector<EntityId>{0, 1}));
+        ASSERT_EQ(observer.constructed, (std::vector<EntityId>{1}));
+        ASSERT_TRUE(observer.updated.empty());
+    }
+
+    TEST(ComponentEvents, RemoveComponentType)
+    {
+        EntityRegistry r;
+        Observer observer;
+        r.addObserver<Position>(&observer);
+
+        for (EntityId i = 0; i < 4; i++)
+        {
+            r.createEntity(i);
+            r.addComponent<Position>(i);
+        }
+        r.flushEvents();
+
+        r.removeComponentType<Position>();
+        r.flushEvents();
+        ASSERT_EQ(observer.destroyed, (std::vector<EntityId>{0, 1, 2, 3}));
+
+        // after removing the observer, events are no longer buffered
+        r.removeObserver<Position>(&observer);
+        r.addComponent<Position>(0);
+        r.flushEvents();
+        ASSERT_EQ(observer.constructed.size(), 4);
+    }
+
+    // removes itself and another observer, and adds a new one, while being notified
+    class ReentrantObserver final : public IComponentObserver
+    {
+    public:
+        Observer* other = nullptr;
+        Observer* added = nullptr;
+        int batches = 0;
+
+        void onConstruct(EntityRegistry& r, reflection::TypeId typeId, std::span<EntityId const> entities) override
+        {
+            batches++;
+            r.removeObserver<Position>(this);
+            if (other != nullptr)
+            {
+                r.removeObserver<Position>(other);
+            }
+            if (added != nullptr)
+            {
+                r.addObserver<Position>(added);
+            }
+        }
+    };
+
+    TEST(ComponentEvents, ModifyObserversWhileNotifying)
+    {
+        EntityRegistry r;
+        Observer other;
+        Observer added;
+        ReentrantObserver reentrant;
+        reentrant.other = &other;
+        reentrant.added = &added;
+        r.addObserver<Position>(&reentrant);
+        r.addObserver<Position>(&other);
+
+        r.createEntity(0);
+        r.addComponent<Position>(0);
+        r.flushEvents();
+        ASSERT_EQ(reentrant.batches, 1);
+        ASSERT_EQ(other.batches, 0); // was removed before it got notified
+        ASSERT_EQ(added.batches, 0); // was added after the batch was delivered
+
+        r.removeObserver<Position>(&added);
+        r.flushEvents();
+
+        // the last observer removing itself while being notified drops the signal after flushing
+        ReentrantObserver last;
+        r.addObserver<Position>(&last);
+        r.createEntity(1);
+        r.addComponent<Position>(1);
+        r.flushEvents();
+        ASSERT_EQ(last.batches, 1);
+
+        r.createEntity(2);
+        r.addComponent<Position>(2);
+        r.flushEvents();
+        ASSERT_EQ(last.batches, 1);
+    }
+}
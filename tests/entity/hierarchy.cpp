@@ -8,7 +8,9 @@
 #include "entity/components/hierarchy.h"
 
 #include <algorithm>
+#include <numeric>
 #include <random>
+#include <thread>
 
 using namespace entity;
 
@@ -360,9 +362,114 @@ namespace hierarchy_tests
         sortHierarchy(r);
 
         std::cout << "sorted: " << std::endl;
+        std::vector<EntityId> visited;
         for (auto [entityId, hierarchy] : r.view<HierarchyComponent>())
         {
             std::cout << entityId << std::endl;
+
+            // parent should have been visited before its children
+            if (hierarchy.parent != kNullEntityId)
+            {
+                ASSERT_NE(std::find(visited.begin(), visited.end(), hierarchy.parent), visited.end());
+            }
+            visited.emplace_back(entityId);
+        }
+        ASSERT_EQ(visited.size(), child7Id + 1);
+    }
+
+    TEST(Hierarchy, Instantiate)
+    {
+        EntityRegistry prefab;
+        createTestHierarchy(prefab);
+        for (EntityId i = 0; i <= child7Id; i++)
+        {
+            prefab.addComponent<int>(i, static_cast<int>(i));
+        }
+
+        EntityRegistry r;
+        r.createEntity(0);
+        r.addComponent<HierarchyComponent>(0);
+
+        // instantiate the parent3 subtree (parent3, child6, child7) using threads
+        ParallelFor parallelFor = [](size_type count, std::function<void(size_type, size_type)> const& function) {
+            std::vector<std::thread> threads;
+            for (size_type i = 0; i < count; i += 2)
+            {
+                threads.emplace_back(function, i, std::min(i + 2, count));
+            }
+            for (auto& thread: threads)
+            {
+                thread.join();
+            }
+        };
+        std::vector<EntityId> roots = instantiate(r, prefab, parent3Id, 5, parallelFor);
+        ASSERT_EQ(roots.size(), 5);
+        ASSERT_EQ(r.entityCount(), 1 + 5 * 3);
+
+        for (EntityId root: roots)
+        {
+            ASSERT_TRUE(isRoot(r, root)); // link to root2 was removed
+            auto& hierarchy = r.getComponent<HierarchyComponent>(root);
+            ASSERT_EQ(hierarchy.previous, kNullEntityId);
+            ASSERT_EQ(hierarchy.childCount, 2);
+            ASSERT_EQ(r.getComponent<int>(root), static_cast<int>(parent3Id));
+
+            EntityId const child6 = getChild(r, root, 0);
+            EntityId const child7 = getChild(r, root, 1);
+            ASSERT_TRUE(isChildOf(r, child6, root));
+            ASSERT_TRUE(isChildOf(r, child7, root));
+            ASSERT_EQ(r.getComponent<HierarchyComponent>(child6).next, child7);
+            ASSERT_EQ(r.getComponent<int>(child6), static_cast<int>(child6Id));
+            ASSERT_EQ(r.getComponent<int>(child7), static_cast<int>(child7Id));
+        }
+
+        // modifying an instance does not affect the others
+        ASSERT_TRUE(setParent(r, roots[1], roots[0], 0));
+        ASSERT_EQ(r.getComponent<HierarchyComponent>(roots[0]).childCount, 3);
+        ASSERT_EQ(r.getComponent<HierarchyComponent>(roots[2]).childCount, 2);
+        ASSERT_EQ(prefab.getComponent<HierarchyComponent>(parent3Id).parent, root2Id);
+    }
+
+    TEST(Hierarchy, AddHierarchy)
+    {
+        EntityRegistry expected;
+        createTestHierarchy(expected);
+
+        // the test hierarchy in depth first order, parents as indices into entities
+        EntityRegistry r;
+        EntityId const firstId = r.createEntities(child7Id + 1);
+        ASSERT_EQ(firstId, 0);
+        std::vector<EntityId> entities(child7Id + 1);
+        std::iota(entities.begin(), entities.end(), firstId);
+        std::vector<size_type> const parents{kNullEntityId, 0, 1, 1, 1, kNullEntityId, 5, 6, 6, 5, 9, 9};
+        ASSERT_TRUE(addHierarchy(r, entities, parents));
+
+        for (EntityId entityId: entities)
+        {
+            auto const& a = r.getComponent<HierarchyComponent>(entityId);
+            auto const& b = expected.getComponent<HierarchyComponent>(entityId);
+            ASSERT_EQ(a.hierarchyCount, b.hierarchyCount) << entityId;
+            ASSERT_EQ(a.childCount, b.childCount) << entityId;
+            ASSERT_EQ(a.parent, b.parent) << entityId;
+            ASSERT_EQ(a.firstChild, b.firstChild) << entityId;
+            ASSERT_EQ(a.previous, b.previous) << entityId;
+            ASSERT_EQ(a.next, b.next) << entityId;
+        }
+
+        // iterated in the given order, so parents are visited before their children
+        std::vector<EntityId> visited;
+        for (auto [entityId, hierarchy]: r.view<HierarchyComponent>())
+        {
+            visited.emplace_back(entityId);
         }
+        ASSERT_EQ(visited, entities);
+
+        // parents should come before their children, and entities can't be added twice
+        EntityRegistry invalid;
+        invalid.createEntities(2);
+        std::vector<EntityId> const two{0, 1};
+        ASSERT_FALSE(addHierarchy(invalid, two, std::vector<size_type>{1, kNullEntityId}));
+        ASSERT_TRUE(addHierarchy(invalid, two, std::vector<size_type>{kNullEntityId, 0}));
+        ASSERT_FALSE(addHierarchy(invalid, two, std::vector<size_type>{kNullEntityId, 0}));
     }
-}
\ No newline at end of file
+}
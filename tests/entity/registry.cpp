@@ -7,6 +7,8 @@
 
 #include "entity/entity_registry.h"
 
+#include <memory>
+
 using namespace entity;
 
 TEST(Registry, CreateDestroyEntities)
@@ -70,6 +72,60 @@ TEST(Registry, AddRemoveComponents)
     ASSERT_FALSE(success);
 }
 
+TEST(Registry, CreateEntitiesAddComponents)
+{
+    EntityRegistry r;
+    r.createEntity(3);
+
+    // consecutive ids after the existing entities
+    EntityId const first = r.createEntities(5);
+    ASSERT_EQ(first, 4);
+    ASSERT_EQ(r.entityCount(), 6);
+    for (EntityId i = first; i < first + 5; i++)
+    {
+        ASSERT_TRUE(r.entityExists(i));
+    }
+    ASSERT_EQ(r.createEntities(0), kNullEntityId);
+
+    std::vector<EntityId> const entities{8, 3, 5};
+    ASSERT_TRUE(r.addComponents<int>(entities, std::vector<int>{80, 30, 50}));
+    ASSERT_EQ(r.getComponent<int>(8), 80);
+    ASSERT_EQ(r.getComponent<int>(3), 30);
+    ASSERT_EQ(r.getComponent<int>(5), 50);
+
+    // nothing is added if any entity does not exist or already contains the component
+    ASSERT_FALSE(r.addComponents<int>(std::vector<EntityId>{4, 5}, std::vector<int>{40, 50}));
+    ASSERT_FALSE(r.addComponents<int>(std::vector<EntityId>{4, 9}, std::vector<int>{40, 90}));
+    ASSERT_FALSE(r.addComponents<int>(std::vector<EntityId>{4, 4}, std::vector<int>{40, 40}));
+    ASSERT_FALSE(r.entityContainsComponent<int>(4));
+    ASSERT_EQ(r.getComponentType<int>()->denseSize(), 3);
+
+    ASSERT_FALSE(r.addComponents<float>(std::vector<EntityId>{4}, std::vector<float>{}));
+    ASSERT_FALSE(r.componentTypeExists<float>());
+}
+
+TEST(Registry, InstantiateMoveOnlyComponent)
+{
+    EntityRegistry prefab;
+    prefab.createEntity(0);
+    ASSERT_TRUE(prefab.addComponent<int>(0, 7));
+    ASSERT_TRUE(prefab.addComponent<std::unique_ptr<int>>(0, std::make_unique<int>(3)));
+
+    // the move-only component is skipped, the other components are copied
+    EntityRegistry r;
+    EntityId const first = r.instantiate(prefab, std::vector<EntityId>{0}, 2);
+    ASSERT_EQ(first, 0);
+    ASSERT_EQ(r.entityCount(), 2);
+    ASSERT_EQ(r.getComponent<int>(1), 7);
+    ASSERT_FALSE(r.componentTypeExists<std::unique_ptr<int>>());
+
+    // existing move-only components of the registry are kept
+    ASSERT_TRUE(r.addComponent<std::unique_ptr<int>>(0, std::make_unique<int>(5)));
+    ASSERT_EQ(r.instantiate(prefab, std::vector<EntityId>{0}, 1), 2);
+    ASSERT_EQ(r.getComponentType<std::unique_ptr<int>>()->denseSize(), 1);
+    ASSERT_FALSE(r.entityContainsComponent<std::unique_ptr<int>>(2));
+}
+
 TEST(Registry, Clear)
 {
     EntityRegistry r;
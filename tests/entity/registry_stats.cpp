@@ -0,0 +1,67 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <entity/entity_registry.h>
+#include <reflection/class.h>
+#include <reflection/reflection.h>
+
+using namespace entity;
+
+namespace registry_stats_tests
+{
+    struct StatsPosition
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    struct StatsTag
+    {
+        int value = 0;
+    };
+
+    TEST(RegistryStats, Occupancy)
+    {
+        reflection::Reflection& reflection = reflection::Reflection::shared();
+        reflection::register_::Class<StatsPosition>("StatsPosition").emplace(reflection.types);
+
+        EntityRegistry r;
+        for (EntityId i = 0; i < 100; i++)
+        {
+            r.createEntity(i);
+            r.addComponent<StatsPosition>(i);
+        }
+        r.addComponent<StatsTag>(99); // sparse array of 100 entries for a single component
+
+        RegistryStats stats = r.stats(reflection.types);
+        ASSERT_EQ(stats.entities.liveCount, 100);
+        ASSERT_EQ(stats.components.size(), 2);
+        ASSERT_EQ(stats.componentCount, 101);
+
+        // sorted by bytes, so the position pool comes first
+        PoolStats& position = stats.components[0];
+        ASSERT_EQ(position.name, "StatsPosition");
+        ASSERT_EQ(position.liveCount, 100);
+        ASSERT_EQ(position.sparseSize, 100);
+        ASSERT_EQ(position.valueSize, sizeof(StatsPosition));
+        ASSERT_GE(position.bytes, 100 * (2 * sizeof(size_type) + sizeof(StatsPosition)));
+        ASSERT_FLOAT_EQ(position.tombstoneRatio, 0.0f);
+
+        PoolStats& tag = stats.components[1];
+        ASSERT_EQ(tag.name, "unregistered");
+        ASSERT_EQ(tag.liveCount, 1);
+        ASSERT_EQ(tag.sparseSize, 100);
+        ASSERT_FLOAT_EQ(tag.tombstoneRatio, 0.99f);
+        ASSERT_GT(stats.wastedBytes, 0);
+
+        size_type bytes = stats.entities.bytes;
+        for (auto& pool: stats.components)
+        {
+            bytes += pool.bytes;
+        }
+        ASSERT_EQ(stats.bytes, bytes);
+    }
+}
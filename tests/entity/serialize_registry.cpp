@@ -5,10 +5,14 @@
 #include <gtest/gtest.h>
 
 #include <entity/entity_registry.h>
+#include <entity/serialize.h>
 #include <reflection/class.h>
 #include <reflection/serialize/json.h>
 #include <reflection/reflection.h>
 
+#include <cstring>
+#include <sstream>
+
 using namespace reflection;
 using namespace entity;
 
@@ -49,4 +53,130 @@ namespace serialize_registry_test
         std::string result = reflection.json.toJsonString(scene, 2);
         std::cout << "scene: \n" << result << std::endl;
     }
-}
\ No newline at end of file
+
+    struct SnapshotPosition
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    struct SnapshotName
+    {
+        std::string name;
+    };
+
+    class ConstructObserver final : public IComponentObserver
+    {
+    public:
+        std::vector<EntityId> constructed;
+
+        void onConstruct(EntityRegistry& r, TypeId typeId, std::span<EntityId const> entities) override
+        {
+            constructed.insert(constructed.end(), entities.begin(), entities.end());
+        }
+    };
+
+    TEST(Entity, SerializeRegistryBinarySnapshot)
+    {
+        Reflection& reflection = Reflection::shared();
+        register_::Class<SnapshotPosition>("SnapshotPosition")
+            .member<&SnapshotPosition::x>("x")
+            .member<&SnapshotPosition::y>("y")
+            .emplace(reflection.types);
+        register_::Class<SnapshotName>("SnapshotName")
+            .member<&SnapshotName::name>("name")
+            .emplace(reflection.types);
+
+        RegistrySerializer serializer(reflection);
+        serializer.emplace<SnapshotPosition>();
+        serializer.emplace<SnapshotName>();
+
+        EntityRegistry source;
+        for (EntityId i = 0; i < 10; i++)
+        {
+            source.createEntity(i * 3);
+            source.addComponent<SnapshotPosition>(i * 3, SnapshotPosition{static_cast<float>(i), 1.0f});
+            if (i % 2 == 0)
+            {
+                source.addComponent<SnapshotName>(i * 3, SnapshotName{"entity " + std::to_string(i)});
+            }
+        }
+        source.destroyEntity(9);
+
+        std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+        ASSERT_TRUE(serializer.save(source, stream));
+
+        EntityRegistry target;
+        target.createEntity(100); // should get cleared on load
+        ConstructObserver observer;
+        target.addObserver<SnapshotPosition>(&observer);
+        ASSERT_TRUE(serializer.load(stream, target));
+
+        // loaded components are delivered as construct events
+        target.flushEvents();
+        ASSERT_EQ(observer.constructed.size(), 9);
+        target.removeObserver<SnapshotPosition>(&observer);
+
+        ASSERT_FALSE(target.entityExists(100));
+        ASSERT_FALSE(target.entityExists(9));
+        for (EntityId i = 0; i < 10; i++)
+        {
+            EntityId id = i * 3;
+            if (id == 9)
+            {
+                continue;
+            }
+            ASSERT_TRUE(target.entityExists(id));
+            ASSERT_EQ(target.getComponent<SnapshotPosition>(id).x, static_cast<float>(i));
+            ASSERT_EQ(target.entityContainsComponent<SnapshotName>(id), i % 2 == 0);
+            if (i % 2 == 0)
+            {
+                ASSERT_EQ(target.getComponent<SnapshotName>(id).name, "entity " + std::to_string(i));
+            }
+        }
+
+        // dense order is retained
+        std::vector<EntityId> sourceOrder;
+        std::vector<EntityId> targetOrder;
+        for (auto [entity, position]: source.view<SnapshotPosition>())
+        {
+            sourceOrder.emplace_back(entity);
+        }
+        for (auto [entity, position]: target.view<SnapshotPosition>())
+        {
+            targetOrder.emplace_back(entity);
+        }
+        ASSERT_EQ(sourceOrder, targetOrder);
+
+        // invalid data leaves the registry empty
+        std::stringstream invalid("not a snapshot");
+        ASSERT_FALSE(serializer.load(invalid, target));
+        ASSERT_FALSE(target.entityExists(0));
+
+        // loading from memory
+        std::string const bytes = stream.str();
+        common::binary::MemoryStreamBuffer buffer(std::span(reinterpret_cast<uint8_t const*>(bytes.data()), bytes.size()));
+        std::istream memory(&buffer);
+        ASSERT_TRUE(serializer.load(memory, target));
+        ASSERT_TRUE(target.entityExists(3));
+
+        // truncated snapshots fail
+        for (size_t size = 0; size < bytes.size(); size += 7)
+        {
+            std::stringstream truncated(bytes.substr(0, size));
+            ASSERT_FALSE(serializer.load(truncated, target));
+        }
+
+        // corrupt lengths fail without allocating them
+        auto const corrupt = [&](size_t offset, uint64_t value) {
+            std::string copy = bytes;
+            std::memcpy(copy.data() + offset, &value, sizeof(uint64_t));
+            std::stringstream in(copy);
+            return serializer.load(in, target);
+        };
+        size_t const header = 3 * sizeof(uint32_t);
+        ASSERT_FALSE(corrupt(header + sizeof(uint64_t), uint64_t(1) << 40)); // dense count of the entities
+        size_t const firstPool = header + 2 * sizeof(uint64_t) + 9 * (sizeof(size_type) + sizeof(EntityId)) + sizeof(uint64_t);
+        ASSERT_FALSE(corrupt(firstPool, uint64_t(1) << 40)); // name of the first pool
+    }
+}
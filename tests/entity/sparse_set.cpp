@@ -45,4 +45,62 @@ namespace sparse_set_tests
             ASSERT_TRUE(test1.value < lastValue);
         }
     }
-}
\ No newline at end of file
+
+    TEST(SparseSet, SortByKey)
+    {
+        EntityRegistry r;
+        for (int i = 0; i < 1000; i++)
+        {
+            r.createEntity(i);
+            r.addComponent<Test1>(i, Test1{static_cast<float>(rand() % 2000) - 1000.0f});
+            r.addComponent<int>(i, i % 7 - 3);
+        }
+
+        // float keys, including negative values
+        ASSERT_TRUE(r.sortByKey<Test1>([](EntityId, Test1 const& value) { return value.value; }));
+
+        // iteration visits elements by descending key
+        float lastValue = std::numeric_limits<float>::max();
+        for (auto [entityId, test1]: r.view<Test1>())
+        {
+            ASSERT_LE(test1.value, lastValue);
+            ASSERT_EQ(r.getComponent<Test1>(entityId).value, test1.value); // sparse array is updated
+            lastValue = test1.value;
+        }
+
+        // signed integer keys, sorting is stable (entities with equal keys retain their order)
+        r.sort<int>([](EntityId lhs, EntityId rhs) { return lhs > rhs; });
+        ASSERT_TRUE(r.sortByKey<int>([](EntityId, int const& value) { return value; }));
+
+        int lastKey = std::numeric_limits<int>::max();
+        EntityId lastEntityId = kNullEntityId;
+        for (auto [entityId, value]: r.view<int>())
+        {
+            ASSERT_LE(value, lastKey);
+            if (value == lastKey)
+            {
+                ASSERT_GT(entityId, lastEntityId);
+            }
+            lastKey = value;
+            lastEntityId = entityId;
+        }
+
+        ASSERT_FALSE(r.sortByKey<double>([](EntityId, double const& value) { return value; }));
+    }
+
+    TEST(SparseSet, EmplaceAllUnchangedOnFailure)
+    {
+        SparseSet<int> set;
+        ASSERT_TRUE(set.emplaceAll(std::vector<size_type>{2, 0}, std::vector<int>{20, 0}));
+        ASSERT_EQ(set.size(), 3);
+
+        // an existing index, a duplicate index or an index out of range don't resize the sparse array
+        ASSERT_FALSE(set.emplaceAll(std::vector<size_type>{10, 2}, std::vector<int>{100, 20}));
+        ASSERT_FALSE(set.emplaceAll(std::vector<size_type>{10, 10}, std::vector<int>{100, 100}));
+        ASSERT_FALSE(set.emplaceAll(std::vector<size_type>{10, kMaxSize}, std::vector<int>{100, 0}));
+        ASSERT_EQ(set.size(), 3);
+        ASSERT_EQ(set.denseSize(), 2);
+        ASSERT_FALSE(set.contains(10));
+        ASSERT_EQ(set.get(2), 20);
+    }
+}
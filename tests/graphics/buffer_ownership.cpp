@@ -0,0 +1,109 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <graphics/backends/cpu/cpu_device.h>
+#include <graphics/buffer.h>
+#include <renderer/mesh.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace buffer_ownership_test
+{
+    using namespace graphics;
+
+    // memory allocated using malloc, as required when handing it to a buffer
+    [[nodiscard]] void* allocate(std::vector<uint8_t> const& contents)
+    {
+        void* data = std::malloc(contents.size());
+        std::memcpy(data, contents.data(), contents.size());
+        return data;
+    }
+
+    [[nodiscard]] std::vector<uint8_t> contents(Buffer& buffer)
+    {
+        auto const* data = static_cast<uint8_t const*>(buffer.get());
+        return {data, data + buffer.descriptor().size};
+    }
+
+    TEST(BufferOwnership, CreateBuffer)
+    {
+        cpu::CpuDevice device;
+        std::vector<uint8_t> expected(64);
+        std::iota(expected.begin(), expected.end(), 0);
+        BufferDescriptor const descriptor{.size = expected.size()};
+
+        // taken, so the buffer uses the memory directly and frees it
+        void* taken = allocate(expected);
+        std::unique_ptr<Buffer> a = device.createBuffer(descriptor, taken, true);
+        ASSERT_EQ(a->get(), taken);
+        ASSERT_EQ(contents(*a), expected);
+
+        // copied, so the caller keeps owning the memory
+        void* copied = allocate(expected);
+        std::unique_ptr<Buffer> b = device.createBuffer(descriptor, copied, false);
+        ASSERT_NE(b->get(), copied);
+        std::memset(copied, 0, expected.size());
+        ASSERT_EQ(contents(*b), expected);
+        std::free(copied);
+    }
+
+    [[nodiscard]] renderer::MeshDescriptor triangle()
+    {
+        return renderer::MeshDescriptor{
+            .primitiveType = PrimitiveType::Triangle,
+            .attributes = {renderer::VertexAttributeDescriptor{
+                .type = renderer::VertexAttribute_Position,
+                .elementType = renderer::ElementType::Vector3
+            }},
+            .vertexCount = 3,
+            .hasIndexBuffer = true,
+            .indexCount = 3,
+            .indexType = renderer::ComponentType::UnsignedShort
+        };
+    }
+
+    TEST(BufferOwnership, Mesh)
+    {
+        cpu::CpuDevice device;
+        std::vector<float> const positions{0, 0, 0, 1, 0, 0, 0, 1, 0};
+        std::vector<uint16_t> const indices{0, 1, 2};
+        std::vector<uint8_t> vertexBytes(sizeof(float) * positions.size());
+        std::memcpy(vertexBytes.data(), positions.data(), vertexBytes.size());
+        std::vector<uint8_t> indexBytes(sizeof(uint16_t) * indices.size());
+        std::memcpy(indexBytes.data(), indices.data(), indexBytes.size());
+
+        // the mesh hands its vertex and index data to the buffers without copying
+        void* vertexData = allocate(vertexBytes);
+        void* indexData = allocate(indexBytes);
+        renderer::Mesh taken(&device, triangle(), vertexData, indexData, true);
+        ASSERT_EQ(taken.vertexBuffer()->get(), vertexData);
+        ASSERT_EQ(taken.indexBuffer()->get(), indexData);
+        ASSERT_EQ(contents(*taken.vertexBuffer()), vertexBytes);
+        ASSERT_EQ(contents(*taken.indexBuffer()), indexBytes);
+
+        // MeshData gets handed over as well
+        renderer::MeshData data = renderer::MeshData::allocate(triangle());
+        std::memcpy(data.vertexData.get(), vertexBytes.data(), vertexBytes.size());
+        std::memcpy(data.indexData.get(), indexBytes.data(), indexBytes.size());
+        void const* meshVertexData = data.vertexData.get();
+        renderer::Mesh fromData(&device, std::move(data));
+        ASSERT_EQ(fromData.vertexBuffer()->get(), meshVertexData);
+        ASSERT_EQ(contents(*fromData.vertexBuffer()), vertexBytes);
+
+        // copied, so the caller keeps owning the memory
+        vertexData = allocate(vertexBytes);
+        indexData = allocate(indexBytes);
+        renderer::Mesh copied(&device, triangle(), vertexData, indexData, false);
+        ASSERT_NE(copied.vertexBuffer()->get(), vertexData);
+        std::memset(vertexData, 0, vertexBytes.size());
+        ASSERT_EQ(contents(*copied.vertexBuffer()), vertexBytes);
+        std::free(vertexData);
+        std::free(indexData);
+    }
+}
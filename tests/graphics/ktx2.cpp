@@ -0,0 +1,133 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <graphics/ktx2.h>
+#include <graphics/backends/cpu/cpu_device.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ktx2_test
+{
+    using namespace graphics;
+
+    [[nodiscard]] std::vector<uint8_t> write(ITexture const& texture)
+    {
+        std::stringstream stream;
+        EXPECT_TRUE(writeKtx2(texture, stream));
+        std::string const string = stream.str();
+        return {string.begin(), string.end()};
+    }
+
+    template<typename Type>
+    [[nodiscard]] Type readAt(std::vector<uint8_t> const& file, size_t offset)
+    {
+        Type value;
+        std::memcpy(&value, file.data() + offset, sizeof(Type));
+        return value;
+    }
+
+    [[nodiscard]] std::vector<uint8_t> getLevels(ITexture const& texture)
+    {
+        PixelFormat const pixelFormat = texture.getPixelFormat();
+        unsigned int const width = texture.getWidth();
+        unsigned int const height = texture.getHeight();
+        std::vector<uint8_t> out(getMipmapLevelOffset(pixelFormat, width, height, texture.getMipmapLevelCount()));
+        for (unsigned int level = 0; level < texture.getMipmapLevelCount(); level++)
+        {
+            EXPECT_TRUE(texture.getBytes(out.data() + getMipmapLevelOffset(pixelFormat, width, height, level),
+                                         getBytesPerRow(pixelFormat, getMipmapLevelSize(width, level)), level));
+        }
+        return out;
+    }
+
+    TEST(Ktx2, RoundTrip)
+    {
+        cpu::CpuDevice device;
+        for (PixelFormat pixelFormat: {PixelFormat::RGBA8Unorm_sRGB, PixelFormat::BC1_RGBA, PixelFormat::BC7_RGBAUnorm_sRGB})
+        {
+            // 9x5 -> 4x2 -> 2x1 -> 1x1, with partial blocks
+            TextureDescriptor descriptor{
+                .width = 9,
+                .height = 5,
+                .pixelFormat = pixelFormat,
+                .usage = TextureUsage_ShaderRead,
+                .mipmapLevelCount = 4
+            };
+            std::vector<uint8_t> data(getTextureSize(descriptor));
+            for (size_t i = 0; i < data.size(); i++)
+            {
+                data[i] = static_cast<uint8_t>(i * 31 + 7);
+            }
+            descriptor.data = data.data();
+            std::unique_ptr<ITexture> texture = device.createTexture(descriptor);
+
+            std::vector<uint8_t> const file = write(*texture);
+            ASSERT_GE(file.size(), 80);
+            EXPECT_EQ(readAt<uint32_t>(file, 12), getVkFormat(pixelFormat));
+            EXPECT_EQ(readAt<uint32_t>(file, 36), 1); // face count
+            EXPECT_EQ(readAt<uint32_t>(file, 40), 4); // level count
+
+            // levels are stored from smallest to largest, aligned to the block size
+            uint64_t previousOffset = 0;
+            size_t const alignment = std::max<size_t>(getPixelFormatBlock(pixelFormat).size, 4);
+            for (unsigned int level = 4; level-- > 0;)
+            {
+                auto const offset = readAt<uint64_t>(file, 80 + level * 24);
+                EXPECT_GT(offset, previousOffset);
+                EXPECT_EQ(offset % alignment, 0);
+                EXPECT_EQ(readAt<uint64_t>(file, 80 + level * 24 + 8),
+                          getImageSize(pixelFormat, getMipmapLevelSize(9, level), getMipmapLevelSize(5, level)));
+                previousOffset = offset;
+            }
+
+            std::unique_ptr<ITexture> read = readKtx2(&device, std::span<uint8_t const>(file));
+            ASSERT_NE(read, nullptr);
+            EXPECT_EQ(read->getPixelFormat(), pixelFormat);
+            EXPECT_EQ(read->getWidth(), 9);
+            EXPECT_EQ(read->getHeight(), 5);
+            EXPECT_EQ(read->getMipmapLevelCount(), 4);
+            EXPECT_EQ(getLevels(*read), data);
+        }
+    }
+
+    TEST(Ktx2, Invalid)
+    {
+        cpu::CpuDevice device;
+        std::vector<uint8_t> data(16 * 16 * 4, 255);
+        std::unique_ptr<ITexture> texture = device.createTexture(TextureDescriptor{
+            .width = 16,
+            .height = 16,
+            .pixelFormat = PixelFormat::RGBA8Unorm,
+            .usage = TextureUsage_ShaderRead,
+            .data = data.data()
+        });
+        std::vector<uint8_t> const file = write(*texture);
+        ASSERT_NE(readKtx2(&device, std::span<uint8_t const>(file)), nullptr);
+
+        std::vector<uint8_t> truncated(file.begin(), file.end() - 1);
+        EXPECT_EQ(readKtx2(&device, std::span<uint8_t const>(truncated)), nullptr);
+
+        std::vector<uint8_t> identifier = file;
+        identifier[5] = '1'; // KTX 1
+        EXPECT_EQ(readKtx2(&device, std::span<uint8_t const>(identifier)), nullptr);
+
+        std::vector<uint8_t> supercompressed = file;
+        uint32_t const zstandard = static_cast<uint32_t>(Ktx2Supercompression::Zstandard);
+        std::memcpy(supercompressed.data() + 44, &zstandard, sizeof(uint32_t));
+        EXPECT_EQ(readKtx2(&device, std::span<uint8_t const>(supercompressed)), nullptr);
+
+        std::vector<uint8_t> array = file;
+        uint32_t const layerCount = 6;
+        std::memcpy(array.data() + 32, &layerCount, sizeof(uint32_t));
+        EXPECT_EQ(readKtx2(&device, std::span<uint8_t const>(array)), nullptr);
+
+        // pixel formats without a vkFormat mapping can't be written
+        EXPECT_EQ(getVkFormat(PixelFormat::R16Float), 0);
+    }
+}
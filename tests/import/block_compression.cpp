@@ -0,0 +1,291 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <texture/block_compression.h>
+#include <graphics/texture.h>
+
+#include <BS_thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace block_compression_test
+{
+    using namespace import_::texture;
+
+    using Pixel = std::array<int, 4>;
+
+    // reference decoders, only for the modes the encoder uses
+
+    [[nodiscard]] Pixel fromRgb565(uint16_t color)
+    {
+        int const r = (color >> 11) & 31;
+        int const g = (color >> 5) & 63;
+        int const b = color & 31;
+        return {r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2, 255};
+    }
+
+    void decodeColorBlock(uint8_t const* block, bool alwaysFourColors, std::array<Pixel, 16>& out)
+    {
+        uint16_t color0;
+        uint16_t color1;
+        uint32_t indices;
+        std::memcpy(&color0, block, 2);
+        std::memcpy(&color1, block + 2, 2);
+        std::memcpy(&indices, block + 4, 4);
+        Pixel const a = fromRgb565(color0);
+        Pixel const b = fromRgb565(color1);
+        std::array<Pixel, 4> palette{a, b};
+        for (size_t c = 0; c < 3; c++)
+        {
+            if (color0 > color1 || alwaysFourColors)
+            {
+                palette[2][c] = (2 * a[c] + b[c]) / 3;
+                palette[3][c] = (a[c] + 2 * b[c]) / 3;
+            }
+            else
+            {
+                palette[2][c] = (a[c] + b[c]) / 2;
+                palette[3][c] = 0;
+            }
+        }
+        palette[2][3] = 255;
+        palette[3][3] = color0 > color1 || alwaysFourColors ? 255 : 0;
+        for (size_t i = 0; i < 16; i++)
+        {
+            Pixel const& pixel = palette[(indices >> (2 * i)) & 3];
+            std::copy(pixel.begin(), pixel.begin() + 3, out[i].begin());
+            out[i][3] = alwaysFourColors ? out[i][3] : pixel[3];
+        }
+    }
+
+    void decodeChannelBlock(uint8_t const* block, size_t channel, std::array<Pixel, 16>& out)
+    {
+        int const a = block[0];
+        int const b = block[1];
+        std::array<int, 8> palette{a, b};
+        for (int k = 1; k < (a > b ? 7 : 5); k++)
+        {
+            palette[k + 1] = a > b ? ((7 - k) * a + k * b) / 7 : ((5 - k) * a + k * b) / 5;
+        }
+        if (a <= b)
+        {
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+        uint64_t indices = 0;
+        std::memcpy(&indices, block + 2, 6);
+        for (size_t i = 0; i < 16; i++)
+        {
+            out[i][channel] = palette[(indices >> (3 * i)) & 7];
+        }
+    }
+
+    void decodeBc7Mode6Block(uint8_t const* block, std::array<Pixel, 16>& out)
+    {
+        size_t position = 0;
+        auto read = [&](size_t count) {
+            uint32_t value = 0;
+            for (size_t i = 0; i < count; i++, position++)
+            {
+                value |= ((block[position / 8] >> (position % 8)) & 1u) << i;
+            }
+            return value;
+        };
+        ASSERT_EQ(read(7), 1u << 6);
+        std::array<std::array<uint32_t, 4>, 2> endpoints{};
+        for (size_t c = 0; c < 4; c++)
+        {
+            endpoints[0][c] = read(7);
+            endpoints[1][c] = read(7);
+        }
+        uint32_t const p0 = read(1);
+        uint32_t const p1 = read(1);
+        constexpr std::array<int, 16> weights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        for (size_t i = 0; i < 16; i++)
+        {
+            int const w = weights[read(i == 0 ? 3 : 4)];
+            for (size_t c = 0; c < 4; c++)
+            {
+                int const a = static_cast<int>(endpoints[0][c] << 1 | p0);
+                int const b = static_cast<int>(endpoints[1][c] << 1 | p1);
+                out[i][c] = ((64 - w) * a + w * b + 32) >> 6;
+            }
+        }
+        EXPECT_EQ(position, 128);
+    }
+
+    // decodes level 0 and returns the root mean square error of the channels in the channel mask
+    [[nodiscard]] float decodeError(std::vector<uint8_t> const& image, std::vector<uint8_t> const& compressed,
+                                    unsigned int width, unsigned int height, TextureCompression compression,
+                                    std::array<bool, 4> channels)
+    {
+        size_t const blockSize = graphics::getPixelFormatBlock(getPixelFormat(compression, false)).size;
+        float error = 0.0f;
+        size_t count = 0;
+        for (unsigned int by = 0; by < (height + 3) / 4; by++)
+        {
+            for (unsigned int bx = 0; bx < (width + 3) / 4; bx++)
+            {
+                uint8_t const* block = compressed.data() + (by * ((width + 3) / 4) + bx) * blockSize;
+                std::array<Pixel, 16> decoded{};
+                switch (compression)
+                {
+                    case TextureCompression::BC1: decodeColorBlock(block, false, decoded); break;
+                    case TextureCompression::BC3:
+                        decodeColorBlock(block + 8, true, decoded);
+                        decodeChannelBlock(block, 3, decoded);
+                        break;
+                    case TextureCompression::BC5:
+                        decodeChannelBlock(block, 0, decoded);
+                        decodeChannelBlock(block + 8, 1, decoded);
+                        break;
+                    case TextureCompression::BC7: decodeBc7Mode6Block(block, decoded); break;
+                    case TextureCompression::None: break;
+                }
+                for (unsigned int i = 0; i < 16; i++)
+                {
+                    unsigned int const x = bx * 4 + i % 4;
+                    unsigned int const y = by * 4 + i / 4;
+                    if (x >= width || y >= height)
+                    {
+                        continue;
+                    }
+                    for (size_t c = 0; c < 4; c++)
+                    {
+                        if (channels[c])
+                        {
+                            float const difference = static_cast<float>(decoded[i][c] - image[(y * width + x) * 4 + c]);
+                            error += difference * difference;
+                            count++;
+                        }
+                    }
+                }
+            }
+        }
+        return std::sqrt(error / static_cast<float>(count));
+    }
+
+    // smooth gradients with some noise
+    [[nodiscard]] std::vector<uint8_t> testImage(unsigned int width, unsigned int height)
+    {
+        std::vector<uint8_t> out;
+        uint32_t random = 12345;
+        for (unsigned int y = 0; y < height; y++)
+        {
+            for (unsigned int x = 0; x < width; x++)
+            {
+                random = random * 1664525u + 1013904223u;
+                auto const noise = static_cast<int>(random >> 29);
+                out.push_back(static_cast<uint8_t>(x * 255 / width));
+                out.push_back(static_cast<uint8_t>(y * 255 / height));
+                out.push_back(static_cast<uint8_t>(std::clamp(128 + static_cast<int>(100 * std::sin(x * 0.2f)) + noise, 0, 255)));
+                out.push_back(static_cast<uint8_t>((x + y) * 255 / (width + height)));
+            }
+        }
+        return out;
+    }
+
+    TEST(BlockCompression, Layout)
+    {
+        BS::thread_pool threadPool(4);
+        EXPECT_EQ(graphics::getImageSize(graphics::PixelFormat::BC1_RGBA, 7, 3), 2 * 8);
+        EXPECT_EQ(graphics::getImageSize(graphics::PixelFormat::BC7_RGBAUnorm, 1, 1), 16);
+        EXPECT_EQ(graphics::getBytesPerRow(graphics::PixelFormat::BC3_RGBA, 9), 3 * 16);
+
+        // 7x3 -> 3x1 -> 1x1, one block or more per level
+        std::vector<uint8_t> const image = testImage(7, 3 + 3 + 1); // enough pixels for all levels
+        std::span<uint8_t const> const levels(image.data(), graphics::getMipmapLevelOffset(graphics::PixelFormat::RGBA8Unorm, 7, 3, 3));
+        std::vector<uint8_t> const bc1 = compressTexture(levels, 7, 3, 3, TextureCompression::BC1, threadPool);
+        EXPECT_EQ(bc1.size(), (2 + 1 + 1) * 8);
+        std::vector<uint8_t> const bc7 = compressTexture(levels, 7, 3, 3, TextureCompression::BC7, threadPool);
+        EXPECT_EQ(bc7.size(), (2 + 1 + 1) * 16);
+        EXPECT_EQ(bc7.size(), graphics::getMipmapLevelOffset(graphics::PixelFormat::BC7_RGBAUnorm, 7, 3, 3));
+    }
+
+    TEST(BlockCompression, Quality)
+    {
+        // large enough to be split into multiple tasks, and not a multiple of 4
+        BS::thread_pool threadPool(4);
+        unsigned int const width = 130;
+        unsigned int const height = 70;
+        std::vector<uint8_t> const image = testImage(width, height);
+        std::vector<uint8_t> opaque = image; // BC1 only has 1-bit alpha
+        for (size_t i = 3; i < opaque.size(); i += 4)
+        {
+            opaque[i] = 255;
+        }
+        struct Expected
+        {
+            TextureCompression compression;
+            std::array<bool, 4> channels;
+            float maximumError;
+        };
+        for (Expected const& expected: {
+            Expected{TextureCompression::BC1, {true, true, true, false}, 4.0f},
+            Expected{TextureCompression::BC3, {true, true, true, true}, 3.5f},
+            Expected{TextureCompression::BC5, {true, true, false, false}, 1.0f},
+            Expected{TextureCompression::BC7, {true, true, true, true}, 2.5f}})
+        {
+            float previousError = std::numeric_limits<float>::max();
+            for (CompressionQuality quality: {CompressionQuality::Fast, CompressionQuality::Normal, CompressionQuality::High})
+            {
+                std::vector<uint8_t> const& in = expected.compression == TextureCompression::BC1 ? opaque : image;
+                std::vector<uint8_t> const compressed = compressTexture(in, width, height, 1, expected.compression, threadPool, quality);
+                float const error = decodeError(in, compressed, width, height, expected.compression, expected.channels);
+                EXPECT_LT(error, expected.maximumError);
+                EXPECT_LE(error, previousError * 1.01f); // higher quality isn't worse
+                previousError = error;
+            }
+        }
+    }
+
+    TEST(BlockCompression, SolidAndTransparent)
+    {
+        BS::thread_pool threadPool(1);
+        std::vector<uint8_t> image;
+        for (size_t i = 0; i < 16; i++)
+        {
+            // left half transparent
+            image.insert(image.end(), {200, 100, 50, static_cast<uint8_t>(i % 4 < 2 ? 0 : 255)});
+        }
+
+        std::vector<uint8_t> const bc1 = compressTexture(image, 4, 4, 1, TextureCompression::BC1, threadPool);
+        std::array<Pixel, 16> decoded{};
+        decodeColorBlock(bc1.data(), false, decoded);
+        for (size_t i = 0; i < 16; i++)
+        {
+            EXPECT_EQ(decoded[i][3], image[i * 4 + 3]);
+            if (decoded[i][3] != 0)
+            {
+                EXPECT_NEAR(decoded[i][0], 200, 4);
+                EXPECT_NEAR(decoded[i][1], 100, 2);
+                EXPECT_NEAR(decoded[i][2], 50, 4);
+            }
+        }
+
+        // alpha of 0 and 255 are exact in BC3
+        std::vector<uint8_t> const bc3 = compressTexture(image, 4, 4, 1, TextureCompression::BC3, threadPool);
+        decodeChannelBlock(bc3.data(), 3, decoded);
+        for (size_t i = 0; i < 16; i++)
+        {
+            EXPECT_EQ(decoded[i][3], image[i * 4 + 3]);
+        }
+
+        std::vector<uint8_t> const bc7 = compressTexture(image, 4, 4, 1, TextureCompression::BC7, threadPool, CompressionQuality::High);
+        decodeBc7Mode6Block(bc7.data(), decoded);
+        for (size_t i = 0; i < 16; i++)
+        {
+            for (size_t c = 0; c < 4; c++)
+            {
+                EXPECT_NEAR(decoded[i][c], image[i * 4 + c], 1);
+            }
+        }
+    }
+}
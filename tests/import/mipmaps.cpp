@@ -0,0 +1,132 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <texture/mipmaps.h>
+#include <graphics/texture.h>
+
+#include <BS_thread_pool.hpp>
+
+#include <cstdlib>
+
+namespace mipmaps_test
+{
+    using namespace import_::texture;
+
+    [[nodiscard]] std::vector<uint8_t> fill(unsigned int width, unsigned int height, std::array<uint8_t, 4> color)
+    {
+        std::vector<uint8_t> out;
+        for (size_t i = 0; i < static_cast<size_t>(width) * height; i++)
+        {
+            out.insert(out.end(), color.begin(), color.end());
+        }
+        return out;
+    }
+
+    TEST(Mipmaps, Layout)
+    {
+        BS::thread_pool threadPool(4);
+        EXPECT_EQ(graphics::getFullMipmapLevelCount(1, 1), 1);
+        EXPECT_EQ(graphics::getFullMipmapLevelCount(256, 1), 9);
+        EXPECT_EQ(graphics::getFullMipmapLevelCount(7, 3), 3);
+
+        // 7x3 -> 3x1 -> 1x1
+        std::vector<uint8_t> image = fill(7, 3, {1, 2, 3, 4});
+        EXPECT_EQ(generateMipmaps(image, 7, 3, threadPool), 3);
+        EXPECT_EQ(image.size(), (7 * 3 + 3 * 1 + 1 * 1) * 4);
+        EXPECT_EQ(graphics::getMipmapLevelOffset(graphics::PixelFormat::RGBA8Unorm, 7, 3, 2), (7 * 3 + 3 * 1) * 4);
+
+        std::vector<uint8_t> single = fill(1, 1, {1, 2, 3, 4});
+        EXPECT_EQ(generateMipmaps(single, 1, 1, threadPool), 1);
+        EXPECT_EQ(single.size(), 4);
+    }
+
+    TEST(Mipmaps, ConstantColor)
+    {
+        // large enough to be split into multiple tasks
+        BS::thread_pool threadPool(4);
+        for (MipmapFilter filter: {MipmapFilter::Box, MipmapFilter::Kaiser})
+        {
+            for (bool sRGB: {true, false})
+            {
+                std::vector<uint8_t> image = fill(300, 257, {200, 100, 7, 128});
+                unsigned int const levelCount = generateMipmaps(image, 300, 257, threadPool, MipmapParameters{.filter = filter, .sRGB = sRGB});
+                ASSERT_EQ(levelCount, 9);
+                ASSERT_EQ(image.size(), graphics::getMipmapLevelOffset(graphics::PixelFormat::RGBA8Unorm, 300, 257, levelCount));
+                for (size_t i = 0; i < image.size(); i += 4)
+                {
+                    ASSERT_EQ(image[i], 200);
+                    ASSERT_EQ(image[i + 1], 100);
+                    ASSERT_EQ(image[i + 2], 7);
+                    ASSERT_EQ(image[i + 3], 128);
+                }
+            }
+        }
+    }
+
+    TEST(Mipmaps, GammaCorrect)
+    {
+        // black and white checkerboard averages to half the light, not to 128. the Kaiser filter
+        // doesn't fully remove the frequency of the checkerboard, so is only roughly the average
+        BS::thread_pool threadPool(4);
+        std::vector<uint8_t> image;
+        for (unsigned int y = 0; y < 16; y++)
+        {
+            for (unsigned int x = 0; x < 16; x++)
+            {
+                uint8_t const value = (x + y) % 2 == 0 ? 255 : 0;
+                image.insert(image.end(), {value, value, value, value});
+            }
+        }
+        std::vector<uint8_t> linear = image;
+        for (MipmapFilter filter: {MipmapFilter::Box, MipmapFilter::Kaiser})
+        {
+            std::vector<uint8_t> srgb = image;
+            generateMipmaps(srgb, 16, 16, threadPool, MipmapParameters{.filter = filter, .sRGB = true, .alphaWeighted = false});
+            int const tolerance = filter == MipmapFilter::Box ? 1 : 8;
+            for (size_t i = 16 * 16 * 4; i < srgb.size(); i += 4)
+            {
+                EXPECT_NEAR(srgb[i], 188, tolerance); // linear 0.5
+                EXPECT_NEAR(srgb[i + 3], 128, tolerance); // alpha is always linear
+            }
+        }
+        generateMipmaps(linear, 16, 16, threadPool, MipmapParameters{.filter = MipmapFilter::Box, .sRGB = false, .alphaWeighted = false});
+        EXPECT_EQ(linear[16 * 16 * 4], 128);
+    }
+
+    TEST(Mipmaps, BoxOddSize)
+    {
+        // 3x1 -> 1x1 averages all three pixels equally
+        BS::thread_pool threadPool(1);
+        std::vector<uint8_t> image{0, 0, 0, 0, 90, 90, 90, 90, 210, 210, 210, 210};
+        ASSERT_EQ(generateMipmaps(image, 3, 1, threadPool, MipmapParameters{.filter = MipmapFilter::Box, .sRGB = false, .alphaWeighted = false}), 2);
+        ASSERT_EQ(image.size(), 16);
+        for (size_t c = 0; c < 4; c++)
+        {
+            EXPECT_EQ(image[12 + c], 100);
+        }
+    }
+
+    TEST(Mipmaps, AlphaWeighted)
+    {
+        // the color of the transparent pixel doesn't bleed into the opaque one
+        BS::thread_pool threadPool(1);
+        for (bool alphaWeighted: {true, false})
+        {
+            std::vector<uint8_t> image{255, 0, 0, 255, 0, 255, 0, 0};
+            MipmapParameters const parameters{.filter = MipmapFilter::Box, .sRGB = false, .alphaWeighted = alphaWeighted};
+            ASSERT_EQ(generateMipmaps(image, 2, 1, threadPool, parameters), 2);
+            EXPECT_EQ(image[8], alphaWeighted ? 255 : 128);
+            EXPECT_EQ(image[9], alphaWeighted ? 0 : 128);
+            EXPECT_EQ(image[11], 128);
+        }
+
+        // fully transparent pixels become black
+        std::vector<uint8_t> transparent = fill(2, 2, {255, 255, 255, 0});
+        ASSERT_EQ(generateMipmaps(transparent, 2, 2, threadPool), 2);
+        EXPECT_EQ(transparent[16], 0);
+        EXPECT_EQ(transparent[19], 0);
+    }
+}
@@ -0,0 +1,135 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <renderer/mesh_optimization.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <set>
+
+namespace mesh_optimization_test
+{
+    using namespace renderer;
+
+    using Triangle = std::array<std::array<float, 3>, 3>;
+
+    constexpr size_t kGridSize = 40;
+
+    // triangles of a grid in shuffled order
+    [[nodiscard]] std::vector<Triangle> shuffledGrid()
+    {
+        std::vector<Triangle> triangles;
+        for (size_t y = 0; y < kGridSize; y++)
+        {
+            for (size_t x = 0; x < kGridSize; x++)
+            {
+                auto const fx = static_cast<float>(x);
+                auto const fy = static_cast<float>(y);
+                triangles.emplace_back(Triangle{{{fx, fy, 0}, {fx + 1, fy, 0}, {fx + 1, fy + 1, 0}}});
+                triangles.emplace_back(Triangle{{{fx, fy, 0}, {fx + 1, fy + 1, 0}, {fx, fy + 1, 0}}});
+            }
+        }
+        std::shuffle(triangles.begin(), triangles.end(), std::mt19937(42));
+        return triangles;
+    }
+
+    // rotates the vertices of the triangle so that the smallest comes first, which keeps the winding order
+    [[nodiscard]] Triangle canonical(Triangle triangle)
+    {
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        return triangle;
+    }
+
+    TEST(MeshOptimization, OptimizesWithoutChangingTriangles)
+    {
+        std::vector<Triangle> const triangles = shuffledGrid();
+
+        // non-indexed, so each vertex is duplicated 6 times on average
+        MeshDescriptor descriptor{
+            .primitiveType = graphics::PrimitiveType::Triangle,
+            .attributes = {VertexAttributeDescriptor{.type = VertexAttribute_Position, .elementType = ElementType::Vector3}},
+            .vertexCount = triangles.size() * 3
+        };
+        MeshData data = MeshData::allocate(descriptor);
+        std::memcpy(data.vertexData.get(), triangles.data(), triangles.size() * sizeof(Triangle));
+
+        MeshData out = optimize(std::move(data));
+        EXPECT_EQ(out.descriptor.vertexCount, (kGridSize + 1) * (kGridSize + 1));
+        ASSERT_TRUE(out.descriptor.hasIndexBuffer);
+        ASSERT_EQ(out.descriptor.indexCount, triangles.size() * 3);
+        ASSERT_EQ(out.descriptor.indexType, ComponentType::UnsignedShort);
+
+        auto const* indices16 = reinterpret_cast<uint16_t const*>(out.indexData.get());
+        std::vector<uint32_t> const indices(indices16, indices16 + out.descriptor.indexCount);
+
+        // same triangles with the same winding order
+        auto const* positions = reinterpret_cast<std::array<float, 3> const*>(out.vertexData.get());
+        std::multiset<Triangle> expected;
+        std::multiset<Triangle> actual;
+        for (size_t t = 0; t < triangles.size(); t++)
+        {
+            expected.emplace(canonical(triangles[t]));
+            actual.emplace(canonical(Triangle{positions[indices[t * 3]], positions[indices[t * 3 + 1]], positions[indices[t * 3 + 2]]}));
+        }
+        EXPECT_EQ(expected, actual);
+
+        // vertices are ordered by their first use
+        uint32_t next = 0;
+        for (uint32_t index: indices)
+        {
+            ASSERT_LE(index, next);
+            next = std::max(next, index + 1);
+        }
+
+        EXPECT_LT(averageCacheMissRatio(indices), 1.0f);
+    }
+
+    TEST(MeshOptimization, VertexCache)
+    {
+        // indexed grid in shuffled triangle order
+        constexpr auto kRow = static_cast<uint32_t>(kGridSize + 1);
+        std::vector<uint32_t> indices;
+        for (uint32_t y = 0; y < kGridSize; y++)
+        {
+            for (uint32_t x = 0; x < kGridSize; x++)
+            {
+                uint32_t const i = y * kRow + x;
+                uint32_t const quad[6] = {i, i + 1, i + kRow + 1, i, i + kRow + 1, i + kRow};
+                indices.insert(indices.end(), std::begin(quad), std::end(quad));
+            }
+        }
+        std::vector<std::array<uint32_t, 3>> shuffled(indices.size() / 3);
+        std::memcpy(shuffled.data(), indices.data(), indices.size() * sizeof(uint32_t));
+        std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+        std::memcpy(indices.data(), shuffled.data(), indices.size() * sizeof(uint32_t));
+
+        std::vector<uint32_t> const optimized = optimizeVertexCache(indices, kRow * kRow);
+        ASSERT_EQ(optimized.size(), indices.size());
+        EXPECT_GT(averageCacheMissRatio(indices), 2.0f);
+        EXPECT_LT(averageCacheMissRatio(optimized), 0.9f);
+    }
+
+    TEST(MeshOptimization, IndicesOutsideOfVertices)
+    {
+        MeshDescriptor const descriptor{
+            .primitiveType = graphics::PrimitiveType::Triangle,
+            .attributes = {VertexAttributeDescriptor{.type = VertexAttribute_Position, .elementType = ElementType::Vector3}},
+            .vertexCount = 3,
+            .hasIndexBuffer = true,
+            .indexCount = 6
+        };
+        MeshData data = MeshData::allocate(descriptor);
+        std::vector<uint32_t> const indices{0, 1, 2, 0, 2, 3};
+        writeIndices(data, indices);
+
+        // returned unchanged instead of reading outside of the vertices
+        MeshData out = optimize(std::move(data));
+        EXPECT_EQ(out.descriptor.vertexCount, 3);
+        EXPECT_EQ(readIndices(out), indices);
+    }
+}
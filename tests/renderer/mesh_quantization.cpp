@@ -0,0 +1,102 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <renderer/mesh_quantization.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace mesh_quantization_test
+{
+    using namespace renderer;
+
+    TEST(MeshQuantization, OctahedralRoundTrip)
+    {
+        for (math::Vector3 direction: {math::Vector3{0, 0, 1}, math::Vector3{0, 0, -1}, math::Vector3{1, 2, 3},
+                                       math::Vector3{-1, 0.5f, -2}, math::Vector3{0.3f, -0.9f, -0.1f}})
+        {
+            math::Vector3 const expected = direction.normalized();
+            math::Vector2 const encoded = encodeOctahedral(expected);
+            EXPECT_LE(std::abs(encoded.x()), 1.0f);
+            EXPECT_LE(std::abs(encoded.y()), 1.0f);
+            math::Vector3 const decoded = decodeOctahedral(encoded);
+            for (int i = 0; i < 3; i++)
+            {
+                EXPECT_NEAR(decoded[i], expected[i], 1e-5f);
+            }
+        }
+    }
+
+    TEST(MeshQuantization, QuantizesAttributes)
+    {
+        MeshDescriptor descriptor{
+            .primitiveType = graphics::PrimitiveType::Triangle,
+            .attributes = {
+                VertexAttributeDescriptor{.type = VertexAttribute_Position, .elementType = ElementType::Vector3},
+                VertexAttributeDescriptor{.type = VertexAttribute_Normal, .elementType = ElementType::Vector3},
+                VertexAttributeDescriptor{.type = VertexAttribute_TextureCoordinate, .elementType = ElementType::Vector2},
+                VertexAttributeDescriptor{.index = 1, .type = VertexAttribute_TextureCoordinate, .elementType = ElementType::Vector2}
+            },
+            .vertexCount = 3,
+            .hasIndexBuffer = true,
+            .indexCount = 3,
+            .indexType = ComponentType::UnsignedShort
+        };
+        float const positions[] = {-1, 2, 5, 3, 2, 7, 1, 2, 6};
+        float const normals[] = {0, 0, 1, 0, 1, 0, -1, 0, 0};
+        float const uvs[] = {0, 0, 1, 1, 0.5f, 0.25f};
+        float const repeatingUvs[] = {0, 0, 2, 2, -1, 0.5f};
+        uint16_t const indices[] = {0, 1, 2};
+
+        MeshData data = MeshData::allocate(descriptor);
+        std::vector<size_t> offsets = attributeOffsets(descriptor);
+        std::memcpy(data.vertexData.get() + offsets[0], positions, sizeof(positions));
+        std::memcpy(data.vertexData.get() + offsets[1], normals, sizeof(normals));
+        std::memcpy(data.vertexData.get() + offsets[2], uvs, sizeof(uvs));
+        std::memcpy(data.vertexData.get() + offsets[3], repeatingUvs, sizeof(repeatingUvs));
+        std::memcpy(data.indexData.get(), indices, sizeof(indices));
+
+        MeshData out = quantize(std::move(data));
+        std::vector<VertexAttributeDescriptor> const& attributes = out.descriptor.attributes;
+        ASSERT_EQ(attributes.size(), 4);
+        EXPECT_EQ(attributes[0].componentType, ComponentType::UnsignedShort);
+        EXPECT_EQ(attributes[1].componentType, ComponentType::SignedShort);
+        EXPECT_EQ(attributes[1].elementType, ElementType::Vector2);
+        EXPECT_EQ(attributes[1].encoding, VertexAttributeEncoding::Octahedral);
+        EXPECT_EQ(attributes[2].componentType, ComponentType::UnsignedShort);
+        EXPECT_EQ(attributes[3].componentType, ComponentType::Float); // outside of [0, 1]
+        EXPECT_TRUE(attributes[0].normalized && attributes[1].normalized && attributes[2].normalized);
+        EXPECT_FALSE(attributes[3].normalized);
+
+        // 3 * 12 + 3 * 12 + 3 * 8 + 3 * 8 bytes -> 3 * 6 (+ 2 padding) + 3 * 4 + 3 * 4 + 3 * 8 bytes
+        EXPECT_EQ(vertexBufferSize(out.descriptor), 20 + 12 + 12 + 24);
+        ASSERT_NE(out.indexData, nullptr);
+        EXPECT_EQ(std::memcmp(out.indexData.get(), indices, sizeof(indices)), 0);
+
+        offsets = attributeOffsets(out.descriptor);
+        auto const* quantizedPositions = reinterpret_cast<uint16_t const*>(out.vertexData.get() + offsets[0]);
+        for (size_t i = 0; i < 9; i++)
+        {
+            size_t const k = i % 3;
+            float const position = out.descriptor.positionOffset[k] +
+                                   out.descriptor.positionScale[k] * (static_cast<float>(quantizedPositions[i]) / 65535.0f);
+            EXPECT_NEAR(position, positions[i], 1e-4f);
+        }
+
+        auto const* quantizedNormals = reinterpret_cast<int16_t const*>(out.vertexData.get() + offsets[1]);
+        for (size_t i = 0; i < 3; i++)
+        {
+            math::Vector3 const normal = decodeOctahedral(math::Vector2{quantizedNormals[i * 2] / 32767.0f,
+                                                                        quantizedNormals[i * 2 + 1] / 32767.0f});
+            for (int k = 0; k < 3; k++)
+            {
+                EXPECT_NEAR(normal[k], normals[i * 3 + k], 1e-3f);
+            }
+        }
+
+        EXPECT_EQ(std::memcmp(out.vertexData.get() + offsets[3], repeatingUvs, sizeof(repeatingUvs)), 0);
+    }
+}
@@ -0,0 +1,229 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <renderer/mesh_simplification.h>
+
+#include <BS_thread_pool.hpp>
+
+#include "mesh_test_data.h"
+
+#include "math/matrix.inl"
+#include "math/vector.inl"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <set>
+
+namespace mesh_simplification_test
+{
+    using namespace renderer;
+    using renderer_test::sphere;
+
+    TEST(MeshSimplification, Sphere)
+    {
+        MeshData const data = sphere(32, 64);
+        std::vector<uint32_t> const indices = readIndices(data);
+
+        float error = 0.0f;
+        std::vector<uint32_t> const simplified = simplify(data, indices, indices.size() / 4, 0.05f, {}, &error);
+        EXPECT_LE(simplified.size(), indices.size() / 4);
+        EXPECT_EQ(simplified.size() % 3, 0);
+        EXPECT_GT(error, 0.0f);
+        EXPECT_LE(error, 0.05f);
+
+        // the remaining vertices still lie on the sphere, and no triangle is degenerate
+        auto const* positions = reinterpret_cast<float const*>(data.vertexData.get());
+        for (size_t i = 0; i < simplified.size(); i++)
+        {
+            ASSERT_LT(simplified[i], data.descriptor.vertexCount);
+            float const* p = positions + simplified[i] * 3;
+            EXPECT_NEAR(p[0] * p[0] + p[1] * p[1] + p[2] * p[2], 1.0f, 1e-4f);
+            if (i % 3 == 0)
+            {
+                EXPECT_NE(simplified[i], simplified[i + 1]);
+                EXPECT_NE(simplified[i + 1], simplified[i + 2]);
+                EXPECT_NE(simplified[i], simplified[i + 2]);
+            }
+        }
+
+        // a tiny error budget only allows collapsing the smallest triangles (around the poles)
+        std::vector<uint32_t> const limited = simplify(data, indices, indices.size() / 4, 1e-6f);
+        EXPECT_GT(limited.size(), indices.size() * 9 / 10);
+    }
+
+    // distance from point p to triangle abc, see Ericson, "Real-Time Collision Detection" (2004), section 5.1.5
+    [[nodiscard]] float pointTriangleDistance(math::Vector3 p, math::Vector3 a, math::Vector3 b, math::Vector3 c)
+    {
+        math::Vector3 const ab = b - a;
+        math::Vector3 const ac = c - a;
+        math::Vector3 const ap = p - a;
+        float const d1 = ab.dot(ap);
+        float const d2 = ac.dot(ap);
+        if (d1 <= 0.0f && d2 <= 0.0f)
+        {
+            return (p - a).magnitude();
+        }
+        math::Vector3 const bp = p - b;
+        float const d3 = ab.dot(bp);
+        float const d4 = ac.dot(bp);
+        if (d3 >= 0.0f && d4 <= d3)
+        {
+            return (p - b).magnitude();
+        }
+        float const vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        {
+            return (p - (a + ab * (d1 / (d1 - d3)))).magnitude();
+        }
+        math::Vector3 const cp = p - c;
+        float const d5 = ab.dot(cp);
+        float const d6 = ac.dot(cp);
+        if (d6 >= 0.0f && d5 <= d6)
+        {
+            return (p - c).magnitude();
+        }
+        float const vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        {
+            return (p - (a + ac * (d2 / (d2 - d6)))).magnitude();
+        }
+        float const va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        {
+            return (p - (b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))))).magnitude();
+        }
+        float const denominator = 1.0f / (va + vb + vc);
+        return (p - (a + ab * (vb * denominator) + ac * (vc * denominator))).magnitude();
+    }
+
+    TEST(MeshSimplification, ReportedErrorMatchesDistance)
+    {
+        MeshData const data = sphere(32, 64);
+        std::vector<uint32_t> const indices = readIndices(data);
+        auto const* positions = reinterpret_cast<float const*>(data.vertexData.get());
+        auto position = [&](uint32_t i) { return math::Vector3{{positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]}}; };
+
+        for (float maxError: {0.005f, 0.02f, 0.05f})
+        {
+            float error = 0.0f;
+            std::vector<uint32_t> const simplified = simplify(data, indices, 0, maxError, {}, &error);
+            ASSERT_LT(simplified.size(), indices.size());
+
+            // largest distance from the original vertices to the simplified surface, relative to the extent (2)
+            float measured = 0.0f;
+            for (uint32_t v = 0; v < data.descriptor.vertexCount; v++)
+            {
+                float distance = std::numeric_limits<float>::max();
+                for (size_t i = 0; i < simplified.size(); i += 3)
+                {
+                    distance = std::min(distance, pointTriangleDistance(position(v), position(simplified[i]),
+                                                                        position(simplified[i + 1]), position(simplified[i + 2])));
+                }
+                measured = std::max(measured, distance / 2.0f);
+            }
+
+            // the reported error is a conservative distance, in the same units as the measured distance
+            EXPECT_LE(error, maxError);
+            EXPECT_LE(measured, error) << maxError;
+            EXPECT_GT(measured, error * 0.25f) << maxError;
+        }
+    }
+
+    TEST(MeshSimplification, LocksBorder)
+    {
+        // flat grid, its interior can be removed without error
+        constexpr uint32_t kSize = 10;
+        constexpr uint32_t kRow = kSize + 1;
+        std::vector<float> positions;
+        for (uint32_t y = 0; y < kRow; y++)
+        {
+            for (uint32_t x = 0; x < kRow; x++)
+            {
+                positions.insert(positions.end(), {static_cast<float>(x), static_cast<float>(y), 0});
+            }
+        }
+        std::vector<uint32_t> indices;
+        for (uint32_t y = 0; y < kSize; y++)
+        {
+            for (uint32_t x = 0; x < kSize; x++)
+            {
+                uint32_t const i = y * kRow + x;
+                indices.insert(indices.end(), {i, i + 1, i + kRow + 1, i, i + kRow + 1, i + kRow});
+            }
+        }
+        MeshData data = MeshData::allocate(MeshDescriptor{
+            .primitiveType = graphics::PrimitiveType::Triangle,
+            .attributes = {VertexAttributeDescriptor{.type = VertexAttribute_Position, .elementType = ElementType::Vector3}},
+            .vertexCount = positions.size() / 3
+        });
+        std::memcpy(data.vertexData.get(), positions.data(), positions.size() * sizeof(float));
+
+        float error = 1.0f;
+        std::vector<uint32_t> const simplified = simplify(data, indices, 0, 0.01f, {}, &error);
+        EXPECT_LT(simplified.size(), indices.size() / 4);
+        EXPECT_FLOAT_EQ(error, 0.0f);
+
+        // all border vertices are still used
+        std::set<uint32_t> const used(simplified.begin(), simplified.end());
+        for (uint32_t i = 0; i < kRow; i++)
+        {
+            for (uint32_t border: {i, kSize * kRow + i, i * kRow, i * kRow + kSize})
+            {
+                EXPECT_TRUE(used.contains(border)) << border;
+            }
+        }
+    }
+
+    TEST(MeshSimplification, GenerateLods)
+    {
+        MeshData data = sphere(32, 64);
+        ASSERT_TRUE(computeBoundingSphere(data));
+        EXPECT_NEAR(data.descriptor.boundsRadius, 1.0f, 1e-5f);
+
+        BS::thread_pool pool(4);
+        std::vector<MeshData> const levels = generateLods(data, pool, LodParameters{.levelCount = 3, .maxError = 0.2f});
+        ASSERT_EQ(levels.size(), 3);
+
+        std::vector<float> screenSizes{data.descriptor.lodScreenSize};
+        size_t previousIndexCount = data.descriptor.indexCount;
+        for (size_t i = 0; i < levels.size(); i++)
+        {
+            MeshDescriptor const& descriptor = levels[i].descriptor;
+            EXPECT_EQ(descriptor.lodLevel, i + 1);
+            EXPECT_LT(descriptor.indexCount, previousIndexCount);
+            EXPECT_LT(descriptor.vertexCount, data.descriptor.vertexCount); // unused vertices are removed
+            EXPECT_LT(descriptor.lodScreenSize, screenSizes.back());
+            EXPECT_FLOAT_EQ(descriptor.boundsRadius, data.descriptor.boundsRadius);
+            previousIndexCount = descriptor.indexCount;
+            screenSizes.emplace_back(descriptor.lodScreenSize);
+        }
+
+        EXPECT_EQ(selectLod(screenSizes, std::numeric_limits<float>::infinity()), 0);
+        EXPECT_EQ(selectLod(screenSizes, 0.0f), 3);
+        EXPECT_EQ(selectLod(screenSizes, screenSizes[2]), 2);
+        float const fieldOfView = std::numbers::pi_v<float> / 3.0f;
+        EXPECT_GT(projectedScreenSize(1.0f, 10.0f, fieldOfView), projectedScreenSize(1.0f, 100.0f, fieldOfView));
+    }
+
+    TEST(MeshSimplification, ProjectedScreenSize)
+    {
+        MeshDescriptor descriptor{.boundsCenter = math::Vector3{1, 0, 0}, .boundsRadius = 1.0f};
+        float const fieldOfView = std::numbers::pi_v<float> / 3.0f;
+
+        // the bounding sphere gets scaled by the largest scale of the transform, and its center transformed
+        math::Matrix4 const localToWorld = math::createTranslationMatrix(math::Vector3{0, 0, -10}) *
+                                           math::createScaleMatrix(math::Vector3{1, 2, 1});
+        math::Vector3 const cameraPosition{2, 0, 0};
+        EXPECT_FLOAT_EQ(projectedScreenSize(descriptor, localToWorld, cameraPosition, fieldOfView),
+                        projectedScreenSize(2.0f, std::sqrt(1.0f + 100.0f), fieldOfView));
+
+        // inside the bounding sphere
+        EXPECT_EQ(projectedScreenSize(descriptor, localToWorld, math::Vector3{1, 0, -10}, fieldOfView),
+                  std::numeric_limits<float>::infinity());
+    }
+}
@@ -0,0 +1,64 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#ifndef SHAPEREALITY_MESH_TEST_DATA_H
+#define SHAPEREALITY_MESH_TEST_DATA_H
+
+#include <renderer/mesh.h>
+
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <vector>
+
+// shared meshes for the renderer tests
+namespace renderer_test
+{
+    // sphere with radius 1 around the origin without seams, counter-clockwise when seen from the outside
+    [[nodiscard]] inline renderer::MeshData sphere(uint32_t rings, uint32_t segments)
+    {
+        std::vector<float> positions{0, 1, 0};
+        for (uint32_t r = 1; r < rings; r++)
+        {
+            float const theta = std::numbers::pi_v<float> * static_cast<float>(r) / static_cast<float>(rings);
+            for (uint32_t s = 0; s < segments; s++)
+            {
+                float const phi = 2.0f * std::numbers::pi_v<float> * static_cast<float>(s) / static_cast<float>(segments);
+                positions.insert(positions.end(), {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)});
+            }
+        }
+        positions.insert(positions.end(), {0, -1, 0});
+        auto const bottom = static_cast<uint32_t>(positions.size() / 3 - 1);
+
+        std::vector<uint32_t> indices;
+        auto ring = [&](uint32_t r, uint32_t s) { return 1 + (r - 1) * segments + s % segments; };
+        for (uint32_t s = 0; s < segments; s++)
+        {
+            indices.insert(indices.end(), {0, ring(1, s + 1), ring(1, s)});
+            indices.insert(indices.end(), {bottom, ring(rings - 1, s), ring(rings - 1, s + 1)});
+            for (uint32_t r = 1; r + 1 < rings; r++)
+            {
+                indices.insert(indices.end(), {ring(r, s), ring(r, s + 1), ring(r + 1, s + 1)});
+                indices.insert(indices.end(), {ring(r, s), ring(r + 1, s + 1), ring(r + 1, s)});
+            }
+        }
+
+        renderer::MeshData data = renderer::MeshData::allocate(renderer::MeshDescriptor{
+            .primitiveType = graphics::PrimitiveType::Triangle,
+            .attributes = {renderer::VertexAttributeDescriptor{
+                .type = renderer::VertexAttribute_Position,
+                .elementType = renderer::ElementType::Vector3
+            }},
+            .vertexCount = positions.size() / 3,
+            .hasIndexBuffer = true,
+            .indexCount = indices.size(),
+            .indexType = renderer::ComponentType::UnsignedInt
+        });
+        std::memcpy(data.vertexData.get(), positions.data(), positions.size() * sizeof(float));
+        std::memcpy(data.indexData.get(), indices.data(), indices.size() * sizeof(uint32_t));
+        return data;
+    }
+}
+
+#endif //SHAPEREALITY_MESH_TEST_DATA_H
@@ -0,0 +1,152 @@
+//
+// Created by Arjo Nagelhout on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <renderer/meshlet.h>
+#include <renderer/mesh.h>
+
+#include "math/matrix.inl"
+
+#include "mesh_test_data.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <set>
+
+namespace meshlet_test
+{
+    using namespace renderer;
+    using renderer_test::sphere;
+
+    [[nodiscard]] math::Vector3 position(MeshData const& data, uint32_t index)
+    {
+        auto const* positions = reinterpret_cast<float const*>(data.vertexData.get());
+        return math::Vector3{positions[index * 3], positions[index * 3 + 1], positions[index * 3 + 2]};
+    }
+
+    [[nodiscard]] math::Vector3 normal(MeshData const& data, std::span<uint32_t const> triangle)
+    {
+        math::Vector3 const a = position(data, triangle[0]);
+        return math::Vector3::cross(position(data, triangle[1]) - a, position(data, triangle[2]) - a).normalized();
+    }
+
+    TEST(Meshlet, Build)
+    {
+        MeshData data = sphere(32, 64);
+        std::vector<uint32_t> const original = readIndices(data);
+        ASSERT_TRUE(buildMeshlets(data));
+        std::vector<uint32_t> const indices = readIndices(data);
+        ASSERT_EQ(indices.size(), original.size());
+
+        // the same triangles, split into meshlets that cover the index buffer in order
+        auto triangles = [](std::vector<uint32_t> const& indices) {
+            std::multiset<std::array<uint32_t, 3>> out;
+            for (size_t i = 0; i < indices.size(); i += 3)
+            {
+                out.emplace(std::array<uint32_t, 3>{indices[i], indices[i + 1], indices[i + 2]});
+            }
+            return out;
+        };
+        EXPECT_EQ(triangles(original), triangles(indices));
+
+        uint32_t next = 0;
+        for (Meshlet const& meshlet: data.meshlets)
+        {
+            EXPECT_EQ(meshlet.indexOffset, next);
+            next += meshlet.triangleCount * 3;
+            EXPECT_GT(meshlet.triangleCount, 0);
+            EXPECT_LE(meshlet.triangleCount, 124);
+
+            std::span<uint32_t const> const meshletIndices(indices.data() + meshlet.indexOffset, meshlet.triangleCount * 3);
+            std::set<uint32_t> const vertices(meshletIndices.begin(), meshletIndices.end());
+            EXPECT_EQ(meshlet.vertexCount, vertices.size());
+            EXPECT_LE(meshlet.vertexCount, 64);
+
+            // bounds contain all vertices, and the normal cone contains all triangle normals
+            float const minimumDot = std::sqrt(1.0f - meshlet.coneCutoff * meshlet.coneCutoff);
+            for (size_t i = 0; i < meshletIndices.size(); i += 3)
+            {
+                for (size_t k = 0; k < 3; k++)
+                {
+                    EXPECT_LE((position(data, meshletIndices[i + k]) - meshlet.boundsCenter).magnitude(), meshlet.boundsRadius * 1.0001f);
+                }
+                if (meshlet.coneCutoff < 1.0f)
+                {
+                    EXPECT_GE(math::Vector3::dot(normal(data, meshletIndices.subspan(i, 3)), meshlet.coneAxis), minimumDot - 1e-4f);
+                }
+            }
+        }
+        EXPECT_EQ(next, indices.size());
+
+        // meshlets are mostly full
+        EXPECT_LT(data.meshlets.size(), indices.size() / 3 / 80);
+    }
+
+    TEST(Meshlet, Culling)
+    {
+        MeshData data = sphere(32, 64);
+        ASSERT_TRUE(buildMeshlets(data));
+        std::vector<uint32_t> const indices = readIndices(data);
+
+        // camera in front of the sphere, looking along +z
+        math::Vector3 const cameraPosition{0, 0, -3};
+        math::Matrix4 const viewProjection = math::createPerspectiveProjectionMatrix(std::numbers::pi_v<float> / 3.0f, 1.0f, 0.1f, 100.0f) *
+                                             math::createTranslationMatrix(-cameraPosition);
+        math::Matrix4 const localToWorld = math::Matrix4::identity;
+        MeshletCullingView const view = createMeshletCullingView(viewProjection, localToWorld, cameraPosition);
+
+        // culled meshlets don't have any visible triangles, i.e. triangles inside the frustum that face the camera
+        size_t visibleCount = 0;
+        for (Meshlet const& meshlet: data.meshlets)
+        {
+            if (meshletVisible(meshlet, view))
+            {
+                visibleCount++;
+                continue;
+            }
+            for (uint32_t i = meshlet.indexOffset; i < meshlet.indexOffset + meshlet.triangleCount * 3; i += 3)
+            {
+                std::span<uint32_t const> const triangle(indices.data() + i, 3);
+                EXPECT_GE(math::Vector3::dot(position(data, triangle[0]) - cameraPosition, normal(data, triangle)), -1e-5f);
+            }
+        }
+
+        // about half of the sphere faces the camera
+        EXPECT_GT(visibleCount, data.meshlets.size() / 4);
+        EXPECT_LT(visibleCount, data.meshlets.size() * 3 / 4);
+
+        // visible meshlets get merged into ranges
+        std::vector<IndexRange> ranges{IndexRange{.offset = 0, .count = 3}}; // existing ranges are kept
+        EXPECT_EQ(cullMeshlets(data.meshlets, view, ranges), visibleCount);
+        ASSERT_GT(ranges.size(), 1);
+        EXPECT_LT(ranges.size(), visibleCount + 1);
+        size_t indexCount = 0;
+        for (size_t i = 1; i < ranges.size(); i++)
+        {
+            indexCount += ranges[i].count;
+        }
+        size_t expectedIndexCount = 0;
+        for (Meshlet const& meshlet: data.meshlets)
+        {
+            expectedIndexCount += meshletVisible(meshlet, view) ? meshlet.triangleCount * 3 : 0;
+        }
+        EXPECT_EQ(indexCount, expectedIndexCount);
+
+        // without backface culling, the back of the sphere is visible as well
+        MeshletCullingView doubleSided = view;
+        doubleSided.backfaceCulling = false;
+        EXPECT_EQ(std::ranges::count_if(data.meshlets, [&](Meshlet const& meshlet) {
+            return meshletVisible(meshlet, doubleSided);
+        }), data.meshlets.size());
+
+        // sphere moved behind the camera
+        math::Matrix4 const behind = math::createTranslationMatrix(math::Vector3{0, 0, -10});
+        std::vector<IndexRange> none;
+        EXPECT_EQ(cullMeshlets(data.meshlets, createMeshletCullingView(viewProjection, behind, cameraPosition), none), 0);
+        EXPECT_TRUE(none.empty());
+    }
+}